@@ -0,0 +1,377 @@
+#include "benchmark.h"
+#include "synthetic.h"
+
+#include "assets/baked_pack.h"
+#include "assets/fit_parser.h"
+#include "assets/fst_reader.h"
+#include "assets/lz_decompress.h"
+#include "assets/shape_reader.h"
+#include "assets/tga_loader.h"
+#include "assets/vfs.h"
+#include "core/log.h"
+#include "core/jobs.h"
+
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace mcgng {
+namespace bench {
+
+static void BM_LzDecompress(State& state) {
+    std::vector<uint8_t> original = makeGameLikeData(static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> compressed = lzCompress(original);
+    std::vector<uint8_t> output(original.size());
+
+    if (lzDecompress(compressed.data(), compressed.size(), output.data(), output.size()) != original.size() ||
+        output != original) {
+        state.skipWithError("LZ round trip failed");
+        return;
+    }
+
+    while (state.keepRunning()) {
+        doNotOptimize(lzDecompress(compressed.data(), compressed.size(), output.data(), output.size()));
+        clobberMemory();
+    }
+
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * original.size()));
+    state.setLabel("ratio " + std::to_string(compressed.size() * 100 / original.size()) + "%");
+}
+MCGNG_BENCHMARK(BM_LzDecompress)->arg(4 << 10)->arg(64 << 10)->arg(1 << 20);
+
+static void BM_ZlibDecompress(State& state) {
+    std::vector<uint8_t> original = makeGameLikeData(static_cast<size_t>(state.range(0)));
+    std::vector<uint8_t> compressed = zlibCompress(original);
+    if (compressed.empty()) {
+        state.skipWithError("built without zlib");
+        return;
+    }
+
+    std::vector<uint8_t> output(original.size());
+    while (state.keepRunning()) {
+        doNotOptimize(zlibDecompress(compressed.data(), compressed.size(), output.data(), output.size()));
+        clobberMemory();
+    }
+
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * original.size()));
+}
+MCGNG_BENCHMARK(BM_ZlibDecompress)->arg(4 << 10)->arg(64 << 10)->arg(1 << 20);
+
+static void BM_FstFindEntry(State& state) {
+    size_t entryCount = static_cast<size_t>(state.range(0));
+    std::string path = (std::filesystem::path(tempDirectory()) /
+                        ("bench_" + std::to_string(entryCount) + ".fst")).string();
+    std::vector<std::string> names = writeFstArchive(path, entryCount);
+
+    FstReader reader;
+    if (!reader.open(path)) {
+        state.skipWithError("failed to open synthetic FST");
+        return;
+    }
+
+    // Look up a spread of names with mismatched case, like game code does
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < names.size(); i += std::max<size_t>(1, names.size() / 64)) {
+        std::string query = names[i];
+        for (auto& c : query) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        queries.push_back(query);
+    }
+
+    size_t index = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(reader.findEntry(queries[index]));
+        index = (index + 1) % queries.size();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+MCGNG_BENCHMARK(BM_FstFindEntry)->arg(64)->arg(1024)->arg(8192);
+
+static void BM_VfsExists(State& state) {
+    // Same archive mounted N times under different prefixes; a lookup should
+    // cost one hash probe no matter how many are mounted.
+    size_t archiveCount = static_cast<size_t>(state.range(0));
+    std::string path = (std::filesystem::path(tempDirectory()) / "bench_vfs.fst").string();
+    std::vector<std::string> names = writeFstArchive(path, 1024);
+
+    // The harness reruns this function while calibrating; keep the mount
+    // messages out of the results
+    auto& log = Log::instance();
+    LogLevel assetsLevel = log.getLevel(LogCategory::Assets);
+    log.setLevel(LogCategory::Assets, LogLevel::Warning);
+
+    auto& vfs = Vfs::instance();
+    vfs.unmountAll();
+    bool mounted = true;
+    for (size_t i = 0; i < archiveCount && mounted; ++i) {
+        mounted = vfs.mountFst(path, "a" + std::to_string(i));
+    }
+    log.setLevel(LogCategory::Assets, assetsLevel);
+    if (!mounted) {
+        state.skipWithError("failed to mount synthetic FST");
+        return;
+    }
+
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < names.size(); i += 16) {
+        std::string query = "A" + std::to_string(i % archiveCount) + "\\" + names[i];
+        for (auto& c : query) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        queries.push_back(query);
+    }
+
+    size_t index = 0;
+    while (state.keepRunning()) {
+        doNotOptimize(vfs.exists(queries[index]));
+        index = (index + 1) % queries.size();
+    }
+
+    vfs.unmountAll();
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+MCGNG_BENCHMARK(BM_VfsExists)->arg(1)->arg(8)->arg(32);
+
+static void BM_FitParseString(State& state) {
+    std::string text = makeFitText(static_cast<size_t>(state.range(0)), 12);
+
+    while (state.keepRunning()) {
+        FitParser parser;
+        doNotOptimize(parser.parseString(text));
+    }
+
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+MCGNG_BENCHMARK(BM_FitParseString)->arg(8)->arg(128)->arg(1024);
+
+static void BM_ShapeDecode(State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::vector<uint8_t> table = makeShapeTable(16, size, size);
+
+    ShapeReader reader;
+    if (!reader.load(table.data(), table.size())) {
+        state.skipWithError("failed to load synthetic shape table");
+        return;
+    }
+
+    uint32_t index = 0;
+    while (state.keepRunning()) {
+        ShapeData shape = reader.decodeShape(index);
+        doNotOptimize(shape.pixels.data());
+        index = (index + 1) % reader.getShapeCount();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+MCGNG_BENCHMARK(BM_ShapeDecode)->arg(32)->arg(64)->arg(128);
+
+static void BM_BakedShapeLookup(State& state) {
+    // Same shapes as BM_ShapeDecode, decoded once by the baker
+    int size = static_cast<int>(state.range(0));
+    std::vector<uint8_t> table = makeShapeTable(16, size, size);
+    std::string path = (std::filesystem::path(tempDirectory()) /
+                        ("bench_shapes_" + std::to_string(size) + ".pack")).string();
+
+    ShapeReader reader;
+    BakedPackWriter writer;
+    if (!reader.load(table.data(), table.size())) {
+        state.skipWithError("failed to load synthetic shape table");
+        return;
+    }
+    for (uint32_t i = 0; i < reader.getShapeCount(); ++i) {
+        writer.addShape("shapes.pak/0/" + std::to_string(i), reader.decodeShape(i));
+    }
+
+    BakedPack pack;
+    if (!writer.write(path) || !pack.open(path)) {
+        state.skipWithError("failed to write synthetic pack");
+        return;
+    }
+
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < reader.getShapeCount(); ++i) {
+        names.push_back("shapes.pak/0/" + std::to_string(i));
+    }
+
+    size_t index = 0;
+    while (state.keepRunning()) {
+        BakedShape shape;
+        pack.getShape(names[index], shape);
+        doNotOptimize(shape.pixels);
+        index = (index + 1) % names.size();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+MCGNG_BENCHMARK(BM_BakedShapeLookup)->arg(32)->arg(64)->arg(128);
+
+static void BM_MechShapeDecode(State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::vector<uint8_t> frame = makeMechFrame(size, size);
+
+    MechShapeReader reader;
+    if (!reader.load(frame.data(), frame.size())) {
+        state.skipWithError("failed to load synthetic mech frame");
+        return;
+    }
+
+    while (state.keepRunning()) {
+        ShapeData shape = reader.decode();
+        doNotOptimize(shape.pixels.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+MCGNG_BENCHMARK(BM_MechShapeDecode)->arg(26)->arg(64)->arg(128);
+
+static void BM_MechShapeDecodeInto(State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::vector<uint8_t> frame = makeMechFrame(size, size);
+
+    MechShapeReader reader;
+    if (!reader.load(frame.data(), frame.size())) {
+        state.skipWithError("failed to load synthetic mech frame");
+        return;
+    }
+
+    std::vector<uint8_t> surface(static_cast<size_t>(size) * size);
+    while (state.keepRunning()) {
+        reader.decodeTo(surface.data(), static_cast<size_t>(size));
+        doNotOptimize(surface.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations()) * size * size);
+}
+MCGNG_BENCHMARK(BM_MechShapeDecodeInto)->arg(26)->arg(64)->arg(128);
+
+/**
+ * Every frame of one mech (8 directions x 8 animation frames) decoded
+ * into a reused surface, the way the sprite cache fills its atlas.
+ * Items are frames.
+ */
+static void BM_MechFramesPerMech(State& state) {
+    constexpr int FRAME_COUNT = 64;
+    int size = static_cast<int>(state.range(0));
+
+    std::vector<std::vector<uint8_t>> frameData;
+    std::vector<MechShapeReader> frames(FRAME_COUNT);
+    frameData.reserve(FRAME_COUNT);
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        frameData.push_back(makeMechFrame(size, size));
+        if (!frames[i].load(frameData.back().data(), frameData.back().size())) {
+            state.skipWithError("failed to load synthetic mech frame");
+            return;
+        }
+    }
+
+    std::vector<uint8_t> surface(static_cast<size_t>(size) * size);
+    while (state.keepRunning()) {
+        for (const auto& frame : frames) {
+            std::memset(surface.data(), 0, surface.size());
+            frame.decodeTo(surface.data(), static_cast<size_t>(size));
+        }
+        doNotOptimize(surface.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * FRAME_COUNT);
+}
+MCGNG_BENCHMARK(BM_MechFramesPerMech)->arg(26)->arg(64)->arg(128);
+
+/**
+ * 640x480 TGA decode: arg 0 = raw 24-bit, 1 = RLE 24-bit, 2 = RLE 32-bit,
+ * 3 = RLE colormapped.
+ */
+static void BM_TgaDecode(State& state) {
+    static const int types[][2] = {{2, 24}, {10, 24}, {10, 32}, {9, 8}};
+    const int* type = types[state.range(0)];
+    std::vector<uint8_t> data = makeTgaImage(type[0], 640, 480, type[1]);
+
+    while (state.keepRunning()) {
+        TgaImage image = TgaLoader::loadFromMemory(data.data(), data.size());
+        doNotOptimize(image.pixels.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * 640 * 480);
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+MCGNG_BENCHMARK(BM_TgaDecode)->arg(0)->arg(1)->arg(2)->arg(3);
+
+/**
+ * Load a 640x480 RLE TGA from disk.
+ */
+static void BM_TgaLoadFile(State& state) {
+    std::vector<uint8_t> data = makeTgaImage(10, 640, 480, 24);
+    std::string path = tempDirectory() + "/bench_image.tga";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    if (!std::filesystem::exists(path)) {
+        state.skipWithError("failed to write TGA");
+        return;
+    }
+
+    while (state.keepRunning()) {
+        TgaImage image = TgaLoader::loadFromFile(path);
+        doNotOptimize(image.pixels.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * 640 * 480);
+}
+MCGNG_BENCHMARK(BM_TgaLoadFile);
+
+/**
+ * Decode a batch of 64 assets (alternating 256x256 RLE TGAs and 64 KB LZ
+ * blobs) with parallelFor. Arg = threads including the caller, so 1 is the
+ * serial baseline and the rest show how the job system scales.
+ */
+static void BM_JobsDecode(State& state) {
+    constexpr size_t ASSET_COUNT = 64;
+    const size_t threads = static_cast<size_t>(state.range(0));
+
+    std::vector<uint8_t> tga = makeTgaImage(10, 256, 256, 24);
+    std::vector<uint8_t> original = makeGameLikeData(64 << 10);
+    std::vector<uint8_t> compressed = lzCompress(original);
+    std::vector<std::vector<uint8_t>> outputs(ASSET_COUNT, std::vector<uint8_t>(original.size()));
+
+    // Left uninitialized for one thread: parallelFor then runs inline
+    auto& jobs = JobSystem::instance();
+    jobs.shutdown();
+    if (threads > 1) {
+        jobs.initialize(threads - 1);
+    }
+    if (jobs.getWorkerCount() != threads - 1) {
+        state.skipWithError("failed to start workers");
+        jobs.shutdown();
+        return;
+    }
+
+    while (state.keepRunning()) {
+        jobs.parallelFor(0, ASSET_COUNT, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (i & 1) {
+                    doNotOptimize(lzDecompress(compressed.data(), compressed.size(),
+                                               outputs[i].data(), outputs[i].size()));
+                } else {
+                    TgaImage image = TgaLoader::loadFromMemory(tga.data(), tga.size());
+                    doNotOptimize(image.pixels.data());
+                }
+            }
+        });
+        clobberMemory();
+    }
+
+    jobs.shutdown();
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * ASSET_COUNT));
+    state.setLabel(std::to_string(threads) + " threads");
+}
+MCGNG_BENCHMARK(BM_JobsDecode)->arg(1)->arg(2)->arg(4)->arg(8);
+
+} // namespace bench
+} // namespace mcgng
@@ -0,0 +1,381 @@
+#include "benchmark.h"
+#include "synthetic.h"
+
+#include "game/combat.h"
+#include "game/mission.h"
+#include "game/skirmish.h"
+#include "net/lockstep.h"
+#include "net/match_server.h"
+#include "core/log.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace mcgng {
+namespace bench {
+
+namespace {
+
+const char* BENCH_CHASSIS = "BenchMech";
+
+/**
+ * Register a synthetic chassis with the mech database (once).
+ */
+bool ensureChassis() {
+    static bool loaded = [] {
+        std::string path = (std::filesystem::path(tempDirectory()) / "bench_mechs.fit").string();
+        std::ofstream file(path);
+        file << "FITini\n"
+             << "[" << BENCH_CHASSIS << "]\n"
+             << "st Variant = \"BM-1\"\n"
+             << "l Tonnage = 60\n"
+             << "l MaxSpeed = 64\n"
+             << "l HeatSinks = 12\n"
+             // Heavy armor so targets survive long benchmark runs
+             << "l HeadArmor = 100000\n"
+             << "l CenterTorsoArmor = 100000\n"
+             << "l SideTorsoArmor = 100000\n"
+             << "l ArmArmor = 100000\n"
+             << "l LegArmor = 100000\n"
+             << "l HeadStructure = 3\n"
+             << "l CenterTorsoStructure = 20\n"
+             << "l SideTorsoStructure = 14\n"
+             << "l ArmStructure = 10\n"
+             << "l LegStructure = 14\n"
+             << "FITend\n";
+        file.close();
+        return MechDatabase::instance().loadFromFile(path);
+    }();
+    return loaded && MechDatabase::instance().getChassis(BENCH_CHASSIS) != nullptr;
+}
+
+/**
+ * Write a mission with mechCount spawns split between two teams.
+ */
+std::string writeMission(int mechCount) {
+    std::string path = (std::filesystem::path(tempDirectory()) /
+                        ("bench_mission_" + std::to_string(mechCount) + ".fit")).string();
+    std::ofstream file(path);
+    file << "FITini\n"
+         << "[MissionInfo]\n"
+         << "st Name = \"Benchmark\"\n"
+         << "[Objective0]\n"
+         << "st Name = \"Destroy all\"\n"
+         << "st Type = \"DestroyAll\"\n"
+         << "b Primary = TRUE\n";
+    for (int i = 0; i < mechCount; ++i) {
+        file << "[Spawn" << i << "]\n"
+             << "f X = " << (i % 32) * 40.0 << "\n"
+             << "f Y = " << (i / 32) * 40.0 << "\n"
+             << "l Team = " << (i % 2) << "\n"
+             << "st MechType = \"" << BENCH_CHASSIS << "\"\n"
+             << "st Pilot = \"Pilot" << i << "\"\n";
+    }
+    file << "FITend\n";
+    return path;
+}
+
+} // anonymous namespace
+
+static void BM_MissionUpdate(State& state) {
+    int mechCount = static_cast<int>(state.range(0));
+    if (!ensureChassis()) {
+        state.skipWithError("failed to register synthetic chassis");
+        return;
+    }
+
+    Mission mission;
+    if (!mission.load(writeMission(mechCount)) || !mission.initialize()) {
+        state.skipWithError("failed to load synthetic mission");
+        return;
+    }
+    mission.start();
+
+    // Keep everyone walking across the map
+    for (const auto& mech : mission.getMechs()) {
+        mech->moveTo(mech->getX() + 100000.0f, mech->getY() + 50000.0f);
+    }
+
+    const float dt = 1.0f / 60.0f;
+    while (state.keepRunning()) {
+        mission.update(dt);
+    }
+
+    if (mission.getState() != MissionState::InProgress) {
+        state.skipWithError("mission ended during benchmark");
+        return;
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * mechCount);
+}
+MCGNG_BENCHMARK(BM_MissionUpdate)->arg(8)->arg(64)->arg(512);
+
+static void BM_CombatUpdate(State& state) {
+    size_t projectileTarget = static_cast<size_t>(state.range(0));
+    if (!ensureChassis()) {
+        state.skipWithError("failed to register synthetic chassis");
+        return;
+    }
+
+    const MechChassis* chassis = MechDatabase::instance().getChassis(BENCH_CHASSIS);
+    const Weapon* lrm = WeaponDatabase::instance().getWeapon("LRM 20");
+    if (!lrm) {
+        state.skipWithError("LRM 20 missing from weapon database");
+        return;
+    }
+
+    // Attackers line up 600m from their targets so missiles stay in flight
+    // for several seconds of simulated time.
+    constexpr int WEAPONS_PER_MECH = 4;
+    size_t pairCount = (projectileTarget + WEAPONS_PER_MECH - 1) / WEAPONS_PER_MECH;
+    std::vector<std::shared_ptr<Mech>> mechs;
+    for (size_t i = 0; i < pairCount; ++i) {
+        auto attacker = std::make_shared<Mech>();
+        attacker->initialize(*chassis);
+        attacker->setPosition(0.0f, static_cast<float>(i) * 10.0f);
+        for (int w = 0; w < WEAPONS_PER_MECH; ++w) {
+            attacker->addWeapon(lrm, MechLocation::LeftTorso, 1000000);
+        }
+
+        auto target = std::make_shared<Mech>();
+        target->initialize(*chassis);
+        target->setPosition(600.0f, static_cast<float>(i) * 10.0f);
+        target->setTeam(1);
+
+        mechs.push_back(attacker);
+        mechs.push_back(target);
+    }
+
+    CombatSystem& combat = CombatSystem::instance();
+    combat.initialize();
+    combat.setMechList(&mechs);
+    combat.setEventCallback(nullptr);
+
+    auto refill = [&]() {
+        for (size_t i = 0; i + 1 < mechs.size(); i += 2) {
+            Mech* attacker = mechs[i].get();
+            Mech* target = mechs[i + 1].get();
+            if (target->isDestroyed()) {
+                target->initialize(*chassis);
+            }
+            attacker->update(10.0f);  // Clear cooldowns and heat
+            for (int w = 0; w < WEAPONS_PER_MECH; ++w) {
+                combat.attack(attacker, w, target);
+            }
+        }
+    };
+
+    refill();
+    if (combat.getProjectiles().empty()) {
+        state.skipWithError("no projectiles launched");
+        return;
+    }
+
+    const float dt = 1.0f / 60.0f;
+    while (state.keepRunning()) {
+        if (combat.getProjectiles().size() < projectileTarget / 2) {
+            state.pauseTiming();
+            refill();
+            state.resumeTiming();
+        }
+        combat.update(dt);
+    }
+
+    combat.initialize();
+    combat.setMechList(nullptr);
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * projectileTarget));
+}
+MCGNG_BENCHMARK(BM_CombatUpdate)->arg(16)->arg(256)->arg(2048);
+
+/**
+ * Synchronous baseline: the old std::cout-style formatted line with a
+ * flush, here to a file so the output stays quiet.
+ */
+static void BM_LogStream(State& state) {
+    std::ofstream file(tempDirectory() + "/bench_stream.log");
+    std::string callsign = "Hunter 2";
+    float heat = 31.5f;
+
+    while (state.keepRunning()) {
+        file << callsign << " shutdown from overheating! heat " << heat << std::endl;
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+MCGNG_BENCHMARK(BM_LogStream);
+
+/**
+ * Caller-side cost of an asynchronous log line (the writer thread formats
+ * and writes it). Lines go out in bursts of 256 and the ring is drained
+ * untimed between bursts, so none are dropped.
+ */
+static void BM_LogAsync(State& state) {
+    constexpr int BURST = 256;
+    auto& log = Log::instance();
+    log.shutdown();
+    log.setConsoleOutput(false);
+    log.initialize(tempDirectory() + "/bench_async.log");
+    std::string callsign = "Hunter 2";
+    float heat = 31.5f;
+    LogStats before = log.getStats();
+
+    while (state.keepRunning()) {
+        for (int i = 0; i < BURST; ++i) {
+            log.write(LogLevel::Info, LogCategory::Game, 0, "{} shutdown from overheating! heat {}",
+                      callsign, heat);
+        }
+        state.pauseTiming();
+        log.flush();
+        state.resumeTiming();
+    }
+
+    log.shutdown();
+    log.setConsoleOutput(true);
+    LogStats after = log.getStats();
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * BURST);
+    state.setLabel("dropped " + std::to_string(after.dropped - before.dropped));
+}
+MCGNG_BENCHMARK(BM_LogAsync);
+
+/**
+ * A message repeated from one call site, as from a per-frame update:
+ * the rate limiter turns most of them into a counter increment.
+ */
+static void BM_LogRateLimited(State& state) {
+    auto& log = Log::instance();
+    log.shutdown();
+    log.setConsoleOutput(false);
+    log.initialize();
+    std::string callsign = "Hunter 2";
+
+    while (state.keepRunning()) {
+        MCGNG_LOG_INFO(Game, "{} shutdown from overheating!", callsign);
+    }
+
+    log.shutdown();
+    log.setConsoleOutput(true);
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+MCGNG_BENCHMARK(BM_LogRateLimited);
+
+/**
+ * Per-tick desync checksum over a skirmish of the given size.
+ */
+static void BM_SkirmishChecksum(State& state) {
+    int mechCount = static_cast<int>(state.range(0));
+    if (!ensureChassis()) {
+        state.skipWithError("failed to register synthetic chassis");
+        return;
+    }
+
+    const MechChassis* chassis = MechDatabase::instance().getChassis(BENCH_CHASSIS);
+    const Weapon* laser = WeaponDatabase::instance().getWeapon("Medium Laser");
+    Skirmish world(1);
+    for (int i = 0; i < mechCount; ++i) {
+        uint16_t unit = world.addMech(*chassis, i % 2, static_cast<float>(i % 2) * 600.0f,
+                                      static_cast<float>(i / 2) * 10.0f);
+        world.getMech(unit)->addWeapon(laser, MechLocation::RightArm);
+    }
+
+    while (state.keepRunning()) {
+        doNotOptimize(world.checksum());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * mechCount);
+}
+MCGNG_BENCHMARK(BM_SkirmishChecksum)->arg(8)->arg(64)->arg(512);
+
+/**
+ * One lockstep tick between two sessions over loopback, with the given
+ * number of orders per player per tick. The label shows the wire cost.
+ */
+static void BM_LockstepTick(State& state) {
+    size_t commandsPerTick = static_cast<size_t>(state.range(0));
+    auto transports = LoopbackTransport::createPair();
+
+    LockstepSession sessions[2];
+    for (uint8_t player = 0; player < 2; ++player) {
+        LockstepConfig config;
+        config.localPlayer = player;
+        sessions[player].initialize(config);
+    }
+    sessions[0].addPeer(1, transports.first.get());
+    sessions[1].addPeer(0, transports.second.get());
+
+    Command command;
+    command.type = CommandType::Move;
+    uint64_t ticks = 0;
+
+    while (state.keepRunning()) {
+        for (auto& session : sessions) {
+            for (size_t i = 0; i < commandsPerTick; ++i) {
+                command.unit = static_cast<uint16_t>(i);
+                session.issue(command);
+            }
+            session.update();
+        }
+        for (auto& session : sessions) {
+            session.update();
+            if (session.isTickReady()) {
+                session.getTickCommands();
+                session.advance(session.getTick());
+                ++ticks;
+            }
+        }
+    }
+
+    if (ticks < state.iterations() * 2) {
+        state.skipWithError("sessions stalled");
+        return;
+    }
+    const LockstepStats& stats = sessions[0].getStats();
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.setLabel(std::to_string(stats.bytesSent / std::max<uint64_t>(sessions[0].getTick(), 1)) +
+                   " bytes/tick");
+}
+MCGNG_BENCHMARK(BM_LockstepTick)->arg(0)->arg(8)->arg(64);
+
+/**
+ * One dedicated server tick over the given number of bot matches (8 units
+ * each), with no observers. The label shows the footprint of one match.
+ */
+static void BM_MatchServerTick(State& state) {
+    int matchCount = static_cast<int>(state.range(0));
+    if (!ensureChassis()) {
+        state.skipWithError("failed to register synthetic chassis");
+        return;
+    }
+
+    ServerConfig config;
+    config.port = 0;        // Any free port
+    MatchServer server;
+    if (!server.initialize(config) || server.getPort() == 0) {
+        state.skipWithError("cannot open server socket");
+        return;
+    }
+
+    const MechChassis* chassis = MechDatabase::instance().getChassis(BENCH_CHASSIS);
+    const Weapon* laser = WeaponDatabase::instance().getWeapon("Medium Laser");
+    for (int i = 0; i < matchCount; ++i) {
+        Match* match = server.createMatch(static_cast<uint32_t>(i));
+        for (int unit = 0; unit < 8; ++unit) {
+            uint16_t id = match->getWorld().addMech(*chassis, unit % 2, static_cast<float>(unit % 2) * 600.0f,
+                                                    static_cast<float>(unit / 2) * 80.0f);
+            match->getWorld().getMech(id)->addWeapon(laser, MechLocation::RightArm);
+        }
+        match->addBot(0, static_cast<uint32_t>(i) * 2);
+        match->addBot(1, static_cast<uint32_t>(i) * 2 + 1);
+    }
+
+    while (state.keepRunning()) {
+        server.tick();
+    }
+
+    size_t memory = server.getMatch(0)->getMemoryUsage();
+    server.shutdown();
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * matchCount);
+    state.setLabel(std::to_string(memory / 1024) + " KB/match");
+}
+MCGNG_BENCHMARK(BM_MatchServerTick)->arg(1)->arg(16)->arg(256);
+
+} // namespace bench
+} // namespace mcgng
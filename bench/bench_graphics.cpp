@@ -0,0 +1,679 @@
+#include "benchmark.h"
+#include "synthetic.h"
+
+#include "graphics/animation.h"
+#include "graphics/font.h"
+#include "graphics/mech_sprite_cache.h"
+#include "graphics/palette.h"
+#include "graphics/palette_effects.h"
+#include "graphics/particles.h"
+#include "graphics/scene_renderer.h"
+#include "graphics/sprite.h"
+#include "graphics/ui.h"
+#include "graphics/ui_screen.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mcgng {
+namespace bench {
+
+static void BM_PaletteConvertToRGBA(State& state) {
+    size_t pixelCount = static_cast<size_t>(state.range(0));
+
+    std::vector<uint8_t> paletteData = makePaletteData();
+    Palette palette;
+    palette.load(paletteData.data(), paletteData.size());
+
+    std::vector<uint8_t> indexed = makeGameLikeData(pixelCount, 0.5);
+    std::vector<uint8_t> rgba(pixelCount * 4);
+
+    while (state.keepRunning()) {
+        palette.convertToRGBA(indexed.data(), rgba.data(), pixelCount);
+        clobberMemory();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * pixelCount));
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * pixelCount));
+}
+MCGNG_BENCHMARK(BM_PaletteConvertToRGBA)->arg(64 * 64)->arg(256 * 256)->arg(800 * 600);
+
+/**
+ * Palette cycling by regenerating every sprite's RGBA texture each frame.
+ */
+static void BM_PaletteCycleRegenerate(State& state) {
+    const int spriteCount = static_cast<int>(state.range(0));
+    std::vector<uint8_t> paletteData = makePaletteData();
+    Palette palette;
+    palette.load(paletteData.data(), paletteData.size());
+    PaletteEffects effects;
+    effects.setBasePalette(palette);
+    effects.addCycle(224, 16, 10.0f);
+
+    std::vector<uint8_t> sprite = makeIndexedSprite(64, 64);
+    std::vector<uint8_t> rgba(sprite.size() * 4);
+    auto& renderer = Renderer::instance();
+
+    while (state.keepRunning()) {
+        effects.update(1.0f / 60.0f);
+        for (int i = 0; i < spriteCount; ++i) {
+            effects.getPalette().convertToRGBA(sprite.data(), rgba.data(), sprite.size());
+            TextureHandle texture = renderer.createTexture(rgba.data(), 64, 64);
+            renderer.destroyTexture(texture);
+        }
+        clobberMemory();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * spriteCount);
+}
+MCGNG_BENCHMARK(BM_PaletteCycleRegenerate)->arg(16)->arg(128);
+
+/**
+ * Same scene through PaletteVariantCache with a team remap on half the
+ * sprites: textures are built once per cycle phase, then reused.
+ */
+static void BM_PaletteCycleCached(State& state) {
+    const int spriteCount = static_cast<int>(state.range(0));
+    std::vector<uint8_t> paletteData = makePaletteData();
+    Palette palette;
+    palette.load(paletteData.data(), paletteData.size());
+    PaletteEffects effects;
+    effects.setBasePalette(palette);
+    effects.addCycle(224, 16, 10.0f);
+
+    PaletteVariantCache cache(effects);
+    uint32_t team = cache.addRemap(RemapTable::range(16, 16, 48));
+    std::vector<uint8_t> sprite = makeIndexedSprite(64, 64);
+
+    while (state.keepRunning()) {
+        effects.update(1.0f / 60.0f);
+        for (int i = 0; i < spriteCount; ++i) {
+            uint32_t remap = (i & 1) ? team : PaletteVariantCache::NO_REMAP;
+            doNotOptimize(cache.getTexture(0, sprite.data(), 64, 64, remap));
+        }
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * spriteCount);
+}
+MCGNG_BENCHMARK(BM_PaletteCycleCached)->arg(16)->arg(128);
+
+/**
+ * Build the frame cache of one mech type (8 facings x 8 frames, 64x64).
+ * Arg 0 decodes every facing, arg 1 reuses mirrored facings.
+ * Items are source frames.
+ */
+static void BM_MechFrameCacheBuild(State& state) {
+    constexpr int DIRECTIONS = 8;
+    constexpr int FRAMES = 8;
+
+    std::vector<uint8_t> pak = makeMechSpriteSet(DIRECTIONS, FRAMES, 64);
+    MechSpriteSet set;
+    if (!set.load(pak.data(), pak.size())) {
+        state.skipWithError("failed to load synthetic mech sprite set");
+        return;
+    }
+
+    MechAnimLayout layout;
+    layout.directions = DIRECTIONS;
+    layout.mirror = state.range(0) != 0;
+
+    while (state.keepRunning()) {
+        MechFrameCache cache;
+        cache.build(set, layout);
+        doNotOptimize(cache.getFrames().data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * DIRECTIONS * FRAMES);
+}
+MCGNG_BENCHMARK(BM_MechFrameCacheBuild)->arg(0)->arg(1);
+
+/**
+ * A lance of mechs drawn through MechSprite's variant mode: half with a
+ * team remap, under a cycle the art uses (224-239) and a faster one it
+ * does not (240-247). Textures are built once per variant and phase of
+ * the used cycle; the label reports how many were built.
+ */
+static void BM_MechSpriteVariants(State& state) {
+    const int unitCount = static_cast<int>(state.range(0));
+    std::vector<uint8_t> pak = makeMechSpriteSet(8, 8, 64);
+    MechSpriteSet set;
+    auto cache = std::make_shared<MechFrameCache>();
+    if (!set.load(pak.data(), pak.size()) || !cache->build(set)) {
+        state.skipWithError("failed to load synthetic mech sprite set");
+        return;
+    }
+
+    std::vector<uint8_t> paletteData = makePaletteData();
+    Palette palette;
+    palette.load(paletteData.data(), paletteData.size());
+    PaletteEffects effects;
+    effects.setBasePalette(palette);
+    effects.addCycle(224, 16, 10.0f);
+    effects.addCycle(240, 8, 60.0f);
+
+    PaletteVariantCache variants(effects);
+    uint32_t team = variants.addRemap(RemapTable::range(16, 16, 48));
+    MechSprite sprite;
+    if (!sprite.load(cache, variants, 0)) {
+        state.skipWithError("failed to load mech sprite");
+        return;
+    }
+
+    SceneRenderer scene;
+    int frame = 0;
+    while (state.keepRunning()) {
+        variants.beginFrame();
+        effects.update(1.0f / 60.0f);
+        scene.begin();
+        for (int i = 0; i < unitCount; ++i) {
+            sprite.setRemap((i & 1) ? team : PaletteVariantCache::NO_REMAP);
+            sprite.submit(scene, static_cast<uint32_t>(i), i % 8, frame, i * 10, 100);
+        }
+        doNotOptimize(scene.getItemCount());
+        frame = (frame + 1) % 8;
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * unitCount);
+    state.setLabel(std::to_string(variants.getBuildCount()) + " textures built");
+}
+MCGNG_BENCHMARK(BM_MechSpriteVariants)->arg(16)->arg(64);
+
+namespace {
+
+/**
+ * HUD-like strings: unit names, damage numbers and timers.
+ */
+std::vector<std::string> makeHudStrings(size_t count) {
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0: strings.push_back("Atlas AS7-D #" + std::to_string(i)); break;
+            case 1: strings.push_back(std::to_string(i * 7 % 100) + " dmg"); break;
+            default: strings.push_back("T+00:" + std::to_string(10 + i % 50)); break;
+        }
+    }
+    return strings;
+}
+
+} // anonymous namespace
+
+/**
+ * Lay out every HUD string every frame (no caching). Items are strings.
+ */
+static void BM_TextLayoutPerFrame(State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> data = makeFontData(10);
+    FontReader reader;
+    Font font;
+    if (!reader.load(data.data(), data.size()) || !font.load(reader)) {
+        state.skipWithError("failed to load synthetic font");
+        return;
+    }
+
+    std::vector<std::string> strings = makeHudStrings(count);
+    auto& text = TextRenderer::instance();
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < count; ++i) {
+            text.drawText(font, strings[i], 10, static_cast<int>(i) * 12, Color::white());
+        }
+        doNotOptimize(text.getPendingQuads());
+        text.flush();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+MCGNG_BENCHMARK(BM_TextLayoutPerFrame)->arg(16)->arg(128);
+
+/**
+ * Same HUD with cached layouts: only the submit and batch flush remain.
+ */
+static void BM_TextCachedLayout(State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> data = makeFontData(10);
+    FontReader reader;
+    Font font;
+    if (!reader.load(data.data(), data.size()) || !font.load(reader)) {
+        state.skipWithError("failed to load synthetic font");
+        return;
+    }
+
+    std::vector<std::string> strings = makeHudStrings(count);
+    std::vector<CachedText> labels(count);
+    for (size_t i = 0; i < count; ++i) {
+        labels[i].setFont(&font);
+        labels[i].setText(strings[i]);
+    }
+
+    auto& text = TextRenderer::instance();
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < count; ++i) {
+            labels[i].setText(strings[i]);
+            labels[i].draw({10, static_cast<int>(i) * 12, 200, 12}, 0, 0, Color::white());
+        }
+        doNotOptimize(text.getPendingQuads());
+        text.flush();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+}
+MCGNG_BENCHMARK(BM_TextCachedLayout)->arg(16)->arg(128);
+
+namespace {
+
+struct HeapFactory {
+    template<typename T>
+    std::shared_ptr<T> create() { return std::make_shared<T>(); }
+};
+
+/**
+ * Dense command panel: panels of 8x8 small buttons side by side, each
+ * with a status bar and a caption.
+ */
+template<typename Factory>
+void fillCommandPanel(Factory& factory, UIElement& root, size_t buttonCount) {
+    root.setBounds(0, 0, 800, 600);
+
+    const int buttonSize = 24;
+    const size_t perPanel = 64;
+    for (size_t first = 0; first < buttonCount; first += perPanel) {
+        int panelIndex = static_cast<int>(first / perPanel);
+        auto panel = factory.template create<UIPanel>();
+        int panelX = (panelIndex % 4) * 8 * buttonSize;
+        int panelY = (panelIndex / 4) * 8 * buttonSize;
+        panel->setBounds(panelX, panelY, 8 * buttonSize, 8 * buttonSize);
+
+        for (size_t i = first; i < std::min(buttonCount, first + perPanel); ++i) {
+            int slot = static_cast<int>(i - first);
+            auto button = factory.template create<UIButton>();
+            button->setBounds(panelX + (slot % 8) * buttonSize, panelY + (slot / 8) * buttonSize,
+                              buttonSize - 2, buttonSize - 2);
+            button->setText("Fire");
+            panel->addChild(button);
+        }
+
+        auto bar = factory.template create<UIProgressBar>();
+        bar->setBounds(panelX, panelY + 8 * buttonSize - 4, 8 * buttonSize, 4);
+        bar->setValue(0.5f);
+        panel->addChild(bar);
+
+        auto caption = factory.template create<UILabel>();
+        caption->setBounds(panelX, panelY, 8 * buttonSize, 12);
+        caption->setText("Weapons");
+        panel->addChild(caption);
+
+        root.addChild(panel);
+    }
+}
+
+std::shared_ptr<UIElement> makeCommandPanel(size_t buttonCount) {
+    HeapFactory factory;
+    auto root = std::make_shared<UIPanel>();
+    fillCommandPanel(factory, *root, buttonCount);
+    return root;
+}
+
+std::vector<UIEvent> makeMouseMoves(size_t count) {
+    std::vector<UIEvent> events(count);
+    uint32_t seed = 12345;
+    for (auto& event : events) {
+        seed = seed * 1103515245u + 12345u;
+        event.type = UIEventType::MouseMove;
+        event.mouseX = static_cast<int>((seed >> 8) % 800);
+        event.mouseY = static_cast<int>((seed >> 20) % 600);
+    }
+    return events;
+}
+
+} // anonymous namespace
+
+/**
+ * Mouse-move flood dispatched down the whole tree (every element visited).
+ */
+static void BM_UIMouseMoveTree(State& state) {
+    std::shared_ptr<UIElement> root = makeCommandPanel(static_cast<size_t>(state.range(0)));
+    std::vector<UIEvent> events = makeMouseMoves(1024);
+
+    while (state.keepRunning()) {
+        for (auto& event : events) {
+            event.handled = false;
+            doNotOptimize(root->handleEvent(event));
+        }
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * events.size()));
+}
+MCGNG_BENCHMARK(BM_UIMouseMoveTree)->arg(64)->arg(512);
+
+/**
+ * Same flood through UIManager's hit-test index (one lookup per event).
+ */
+static void BM_UIMouseMoveIndexed(State& state) {
+    auto& ui = UIManager::instance();
+    ui.setRoot(makeCommandPanel(static_cast<size_t>(state.range(0))));
+    std::vector<UIEvent> events = makeMouseMoves(1024);
+
+    while (state.keepRunning()) {
+        for (auto& event : events) {
+            event.handled = false;
+            doNotOptimize(ui.handleEvent(event));
+        }
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * events.size()));
+    ui.setRoot(nullptr);
+}
+MCGNG_BENCHMARK(BM_UIMouseMoveIndexed)->arg(64)->arg(512);
+
+/**
+ * Build and tear down a command screen: arg 0 = shared_ptr per element,
+ * arg 1 = UIScreen arena.
+ */
+static void BM_UIScreenBuild(State& state) {
+    bool arena = state.range(0) != 0;
+    const size_t buttonCount = 256;
+
+    while (state.keepRunning()) {
+        if (arena) {
+            UIScreen screen;
+            fillCommandPanel(screen, *screen.getRoot(), buttonCount);
+            doNotOptimize(screen.getRoot()->getChildren().size());
+        } else {
+            std::shared_ptr<UIElement> root = makeCommandPanel(buttonCount);
+            doNotOptimize(root->getChildren().size());
+        }
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * buttonCount));
+}
+MCGNG_BENCHMARK(BM_UIScreenBuild)->arg(0)->arg(1);
+
+/**
+ * Render traversal: arg 0 = recursive render(), arg 1 = UIScreen nodes.
+ */
+static void BM_UIRender(State& state) {
+    bool flat = state.range(0) != 0;
+    const size_t buttonCount = 512;
+
+    UIScreen screen;
+    fillCommandPanel(screen, *screen.getRoot(), buttonCount);
+    auto& text = TextRenderer::instance();
+
+    while (state.keepRunning()) {
+        if (flat) {
+            screen.render();
+        } else {
+            screen.getRoot()->render();
+        }
+        text.flush();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * screen.getNodes().size()));
+}
+MCGNG_BENCHMARK(BM_UIRender)->arg(0)->arg(1);
+
+/**
+ * Rebuild a screen's draw order. Captions and bars overlap the buttons, a
+ * button sits on a caption and a status line covers the first panel, so
+ * first check that anything overlapping an earlier node in tree order is
+ * still drawn after it.
+ */
+static void BM_UIDrawOrder(State& state) {
+    UIScreen screen;
+    UIPanel& root = *screen.getRoot();
+    fillCommandPanel(screen, root, static_cast<size_t>(state.range(0)));
+
+    auto close = screen.create<UIButton>();
+    close->setBounds(170, 0, 12, 12);
+    root.getChildren().front()->addChild(close);
+
+    auto status = screen.create<UILabel>();
+    status->setBounds(0, 20, 800, 12);
+    status->setText("Lance ready");
+    root.addChild(status);
+
+    const std::vector<UINode>& nodes = screen.getNodes();
+    const std::vector<uint32_t>& order = screen.getDrawOrder();
+    std::vector<size_t> position(nodes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+    }
+    for (uint32_t a = 0; a < nodes.size(); ++a) {
+        for (uint32_t b = a + 1; b < nodes.size(); ++b) {
+            if (nodes[a].element->getBounds().intersects(nodes[b].element->getBounds()) &&
+                position[a] > position[b]) {
+                state.skipWithError("overlapping elements drawn out of tree order");
+                return;
+            }
+        }
+    }
+
+    while (state.keepRunning()) {
+        UIElement::markLayoutChanged();
+        doNotOptimize(screen.getDrawOrder().size());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * nodes.size()));
+}
+MCGNG_BENCHMARK(BM_UIDrawOrder)->arg(64)->arg(512);
+
+namespace {
+
+Animation makeClip(const std::string& name, int firstFrame, int frameCount, float frameTime) {
+    Animation anim;
+    anim.name = name;
+    anim.frameTime = frameTime;
+    for (int i = 0; i < frameCount; ++i) {
+        anim.frames.push_back(firstFrame + i);
+    }
+    return anim;
+}
+
+} // anonymous namespace
+
+/**
+ * Units animated one Sprite at a time (each with its own clip set).
+ */
+static void BM_SpriteAnimationUpdate(State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<std::unique_ptr<Sprite>> sprites;
+    for (size_t i = 0; i < count; ++i) {
+        auto sprite = std::make_unique<Sprite>();
+        sprite->addAnimation(makeClip("idle", 0, 4, 0.25f));
+        sprite->addAnimation(makeClip("walk", 4, 8, 0.1f));
+        sprite->addAnimation(makeClip("fire", 12, 6, 0.05f));
+        sprite->playAnimation(i % 3 == 0 ? "fire" : "walk");
+        sprites.push_back(std::move(sprite));
+    }
+
+    while (state.keepRunning()) {
+        for (auto& sprite : sprites) {
+            sprite->update(1.0f / 60.0f);
+        }
+        doNotOptimize(sprites[0]->getCurrentFrame());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+MCGNG_BENCHMARK(BM_SpriteAnimationUpdate)->arg(64)->arg(1024);
+
+/**
+ * Same units sharing one clip library, advanced by AnimationSystem.
+ */
+static void BM_AnimationSystemUpdate(State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    auto library = std::make_shared<AnimationLibrary>();
+    library->addClip(makeClip("idle", 0, 4, 0.25f));
+    AnimClipId walk = library->addClip(makeClip("walk", 4, 8, 0.1f));
+    AnimClipId fire = library->addClip(makeClip("fire", 12, 6, 0.05f));
+
+    auto& system = AnimationSystem::instance();
+    std::vector<AnimHandle> handles;
+    for (size_t i = 0; i < count; ++i) {
+        AnimHandle handle = system.create(library);
+        system.play(handle, i % 3 == 0 ? fire : walk);
+        handles.push_back(handle);
+    }
+
+    while (state.keepRunning()) {
+        system.update(1.0f / 60.0f);
+        doNotOptimize(system.getFrame(handles[0]));
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    system.clear();
+}
+MCGNG_BENCHMARK(BM_AnimationSystemUpdate)->arg(64)->arg(1024);
+
+/**
+ * Baseline: array-of-structs particles integrated one at a time.
+ */
+static void BM_ParticleIntegrateAoS(State& state) {
+    struct Particle {
+        float x, y, vx, vy, ay, life, invLifetime;
+        uint16_t effect;
+    };
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<Particle> particles(count);
+    for (size_t i = 0; i < count; ++i) {
+        particles[i] = {0.0f, 0.0f, 1.0f + i % 7, 2.0f - i % 5, 50.0f, 1e6f, 1e-6f, 0};
+    }
+
+    while (state.keepRunning()) {
+        for (Particle& p : particles) {
+            p.x += p.vx * (1.0f / 60.0f);
+            p.y += p.vy * (1.0f / 60.0f);
+            p.vy += p.ay * (1.0f / 60.0f);
+            p.life -= 1.0f / 60.0f;
+        }
+        clobberMemory();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+MCGNG_BENCHMARK(BM_ParticleIntegrateAoS)->arg(1024)->arg(16384);
+
+/**
+ * Structure-of-arrays pool integrated four particles at a time.
+ */
+static void BM_ParticleIntegrateSoA(State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> x(count), y(count), vx(count), vy(count), ay(count, 50.0f), life(count, 1e6f);
+    for (size_t i = 0; i < count; ++i) {
+        vx[i] = 1.0f + i % 7;
+        vy[i] = 2.0f - i % 5;
+    }
+
+    while (state.keepRunning()) {
+        ParticleSystem::integrate(x.data(), y.data(), vx.data(), vy.data(), ay.data(), life.data(),
+                                  static_cast<uint32_t>(count), 1.0f / 60.0f);
+        clobberMemory();
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+MCGNG_BENCHMARK(BM_ParticleIntegrateSoA)->arg(1024)->arg(16384);
+
+/**
+ * Full frame (emit, update, batch build) with a steady particle population.
+ */
+static void BM_ParticleSystemFrame(State& state) {
+    const uint32_t target = static_cast<uint32_t>(state.range(0));
+    auto& particles = ParticleSystem::instance();
+    particles.initialize(target);
+
+    ParticleEffect sparks;
+    sparks.count = 32;
+    sparks.lifeMin = 0.5f;
+    sparks.lifeMax = 1.0f;
+    sparks.gravity = 200.0f;
+    ParticleEffectId additive = particles.addEffect(sparks);
+    ParticleEffect smoke = sparks;
+    smoke.blend = BlendMode::Alpha;
+    smoke.frameCount = 4;
+    ParticleEffectId alpha = particles.addEffect(smoke);
+
+    // ~0.75s average life at 60 fps: emit enough per frame to hold the target
+    const uint32_t emitsPerFrame = std::max<uint32_t>(1, target / (32 * 45));
+    float position = 0.0f;
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < emitsPerFrame; ++i) {
+            position += 7.0f;
+            particles.emit(i % 2 ? additive : alpha, std::fmod(position, 800.0f), 300.0f);
+        }
+        particles.update(1.0f / 60.0f);
+        particles.render();
+        doNotOptimize(particles.getStats().alive);
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * particles.getStats().alive));
+    state.setLabel(std::to_string(particles.getStats().lastDropped) + " dropped in the last frame");
+    particles.shutdown();
+}
+MCGNG_BENCHMARK(BM_ParticleSystemFrame)->arg(4096)->arg(65536);
+
+namespace {
+
+/**
+ * Depth entries for a visible isometric window: ground tiles in row order
+ * plus units scattered between them.
+ */
+std::vector<uint64_t> makeSceneEntries(size_t count) {
+    std::vector<uint64_t> entries;
+    entries.reserve(count);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t key;
+        if (i % 4 != 0) {
+            int tile = static_cast<int>(i / 4 * 3 + i % 4);
+            key = SceneRenderer::depthKey(static_cast<float>(tile % 64), static_cast<float>(tile / 64),
+                                          SceneLayer::Ground, (seed >> 20) & 3);
+        } else {
+            key = SceneRenderer::depthKey((seed >> 8) % 6400 / 100.0f, (seed >> 16) % 6400 / 100.0f,
+                                          SceneLayer::Unit);
+        }
+        entries.push_back((static_cast<uint64_t>(key) << 32) | i);
+    }
+    return entries;
+}
+
+} // anonymous namespace
+
+/**
+ * Baseline: comparison sort of the draw list.
+ */
+static void BM_SceneSortStable(State& state) {
+    const std::vector<uint64_t> source = makeSceneEntries(static_cast<size_t>(state.range(0)));
+    std::vector<uint64_t> entries;
+
+    while (state.keepRunning()) {
+        entries = source;
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](uint64_t a, uint64_t b) { return (a >> 32) < (b >> 32); });
+        doNotOptimize(entries.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+MCGNG_BENCHMARK(BM_SceneSortStable)->arg(1024)->arg(16384)->arg(65536);
+
+/**
+ * Radix sort used by SceneRenderer::flush().
+ */
+static void BM_SceneSortRadix(State& state) {
+    const std::vector<uint64_t> source = makeSceneEntries(static_cast<size_t>(state.range(0)));
+    std::vector<uint64_t> entries;
+    std::vector<uint64_t> scratch;
+
+    while (state.keepRunning()) {
+        entries = source;
+        SceneRenderer::radixSort(entries, scratch);
+        doNotOptimize(entries.data());
+    }
+
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+MCGNG_BENCHMARK(BM_SceneSortRadix)->arg(1024)->arg(16384)->arg(65536);
+
+} // namespace bench
+} // namespace mcgng
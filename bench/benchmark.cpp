@@ -0,0 +1,402 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace mcgng {
+namespace bench {
+
+// State implementation
+
+State::State(uint64_t maxIterations, std::vector<int64_t> args)
+    : m_maxIterations(maxIterations), m_args(std::move(args)) {
+}
+
+void State::startTimer() {
+    if (m_running) {
+        return;
+    }
+    m_running = true;
+    m_realStart = std::chrono::steady_clock::now();
+    m_cpuStart = std::clock();
+}
+
+void State::stopTimer() {
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    m_realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_realStart).count();
+    m_cpuSeconds += static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+}
+
+void State::skipWithError(const std::string& message) {
+    m_error = message;
+    m_maxIterations = 0;
+    stopTimer();
+}
+
+// Benchmark implementation
+
+Benchmark::Benchmark(std::string name, BenchmarkFunction function)
+    : m_name(std::move(name)), m_function(function) {
+}
+
+Benchmark* Benchmark::arg(int64_t value) {
+    m_argSets.push_back({value});
+    return this;
+}
+
+Benchmark* Benchmark::args(std::vector<int64_t> values) {
+    m_argSets.push_back(std::move(values));
+    return this;
+}
+
+Benchmark* Benchmark::range(int64_t start, int64_t limit, int64_t multiplier) {
+    for (int64_t value = start; value <= limit; value *= std::max<int64_t>(2, multiplier)) {
+        m_argSets.push_back({value});
+    }
+    return this;
+}
+
+std::vector<Benchmark*>& getRegistry() {
+    static std::vector<Benchmark*> registry;
+    return registry;
+}
+
+Benchmark* registerBenchmark(const char* name, BenchmarkFunction function) {
+    // Owned for the lifetime of the process
+    static std::vector<std::unique_ptr<Benchmark>> storage;
+    storage.push_back(std::make_unique<Benchmark>(name, function));
+    getRegistry().push_back(storage.back().get());
+    return storage.back().get();
+}
+
+namespace {
+
+struct RunResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double realNs = 0.0;        // Per iteration
+    double cpuNs = 0.0;         // Per iteration
+    double bytesPerSecond = 0.0;
+    double itemsPerSecond = 0.0;
+    std::string label;
+    std::string error;
+    std::string aggregate;      // "", "mean", "median", "stddev"
+};
+
+struct Options {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.5;       // Seconds per benchmark
+    int repetitions = 1;
+    bool list = false;
+};
+
+std::string runName(const Benchmark& benchmark, const std::vector<int64_t>& args) {
+    std::string name = benchmark.getName();
+    for (int64_t value : args) {
+        name += "/" + std::to_string(value);
+    }
+    return name;
+}
+
+RunResult runOnce(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTime) {
+    RunResult result;
+    result.name = runName(benchmark, args);
+
+    // Grow the iteration count until a run takes at least minTime,
+    // the same way Google Benchmark calibrates.
+    uint64_t iterations = 1;
+    for (;;) {
+        State state(iterations, args);
+        benchmark.getFunction()(state);
+
+        if (state.hasError()) {
+            result.error = state.getError();
+            return result;
+        }
+
+        double seconds = state.getRealSeconds();
+        bool done = seconds >= minTime || iterations >= 1000000000ull;
+        if (done) {
+            double n = static_cast<double>(state.iterations());
+            result.iterations = state.iterations();
+            result.realNs = seconds * 1.0e9 / n;
+            result.cpuNs = state.getCpuSeconds() * 1.0e9 / n;
+            if (seconds > 0.0) {
+                result.bytesPerSecond = static_cast<double>(state.getBytesProcessed()) / seconds;
+                result.itemsPerSecond = static_cast<double>(state.getItemsProcessed()) / seconds;
+            }
+            result.label = state.getLabel();
+            return result;
+        }
+
+        // Predict the count needed, with headroom, but never grow more than 10x
+        double multiplier = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+        multiplier = std::clamp(multiplier, 2.0, 10.0);
+        iterations = static_cast<uint64_t>(static_cast<double>(iterations) * multiplier);
+    }
+}
+
+std::vector<RunResult> aggregate(const std::vector<RunResult>& runs) {
+    std::vector<RunResult> out;
+    if (runs.size() < 2 || !runs.front().error.empty()) {
+        return out;
+    }
+
+    auto stat = [&runs](const char* kind, auto fn) {
+        RunResult r = runs.front();
+        r.name += std::string("_") + kind;
+        r.aggregate = kind;
+        r.realNs = fn([](const RunResult& x) { return x.realNs; });
+        r.cpuNs = fn([](const RunResult& x) { return x.cpuNs; });
+        r.bytesPerSecond = fn([](const RunResult& x) { return x.bytesPerSecond; });
+        r.itemsPerSecond = fn([](const RunResult& x) { return x.itemsPerSecond; });
+        return r;
+    };
+
+    auto mean = [&runs](auto get) {
+        double sum = 0.0;
+        for (const auto& r : runs) sum += get(r);
+        return sum / static_cast<double>(runs.size());
+    };
+    auto median = [&runs](auto get) {
+        std::vector<double> values;
+        for (const auto& r : runs) values.push_back(get(r));
+        std::sort(values.begin(), values.end());
+        size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+    };
+    auto stddev = [&runs, &mean](auto get) {
+        double m = mean(get);
+        double sum = 0.0;
+        for (const auto& r : runs) sum += (get(r) - m) * (get(r) - m);
+        return std::sqrt(sum / static_cast<double>(runs.size() - 1));
+    };
+
+    out.push_back(stat("mean", mean));
+    out.push_back(stat("median", median));
+    out.push_back(stat("stddev", stddev));
+    return out;
+}
+
+std::string formatTime(double ns) {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(ns < 10.0 ? 2 : (ns < 1000.0 ? 1 : 0)) << ns << " ns";
+    return ss.str();
+}
+
+std::string formatRate(double perSecond, const char* unit) {
+    static const char* prefixes[] = {"", "k", "M", "G", "T"};
+    int index = 0;
+    while (perSecond >= 1000.0 && index < 4) {
+        perSecond /= 1000.0;
+        index++;
+    }
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << perSecond << " " << prefixes[index] << unit;
+    return ss.str();
+}
+
+void printResult(const RunResult& r) {
+    std::cout << std::setfill(' ') << std::left << std::setw(48) << r.name << std::right;
+    if (!r.error.empty()) {
+        std::cout << " ERROR: " << r.error << "\n";
+        return;
+    }
+    std::cout << std::setw(16) << formatTime(r.realNs)
+              << std::setw(16) << formatTime(r.cpuNs)
+              << std::setw(12) << r.iterations;
+    if (r.bytesPerSecond > 0.0) {
+        std::cout << "  " << formatRate(r.bytesPerSecond, "B/s");
+    }
+    if (r.itemsPerSecond > 0.0) {
+        std::cout << "  " << formatRate(r.itemsPerSecond, "items/s");
+    }
+    if (!r.label.empty()) {
+        std::cout << "  " << r.label;
+    }
+    std::cout << "\n";
+}
+
+std::string jsonEscape(const std::string& str) {
+    std::string out;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+    return out;
+}
+
+bool writeJson(const std::string& path, const std::vector<RunResult>& results) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "mcgng_bench: Failed to open " << path << "\n";
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char date[64] = {0};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    // Same layout as Google Benchmark's JSON reporter so its compare.py
+    // tooling can diff two runs directly.
+    file << std::setprecision(10);
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << "    \"date\": \"" << date << "\",\n";
+    file << "    \"executable\": \"mcgng_bench\",\n";
+    file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    file << "    \"library_build_type\": \"release\"\n";
+#else
+    file << "    \"library_build_type\": \"debug\"\n";
+#endif
+    file << "  },\n";
+    file << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const RunResult& r = results[i];
+        file << "    {\n";
+        file << "      \"name\": \"" << jsonEscape(r.name) << "\",\n";
+        file << "      \"run_type\": \"" << (r.aggregate.empty() ? "iteration" : "aggregate") << "\",\n";
+        if (!r.aggregate.empty()) {
+            file << "      \"aggregate_name\": \"" << r.aggregate << "\",\n";
+        }
+        if (!r.error.empty()) {
+            file << "      \"error_occurred\": true,\n";
+            file << "      \"error_message\": \"" << jsonEscape(r.error) << "\"\n";
+        } else {
+            file << "      \"iterations\": " << r.iterations << ",\n";
+            file << "      \"real_time\": " << r.realNs << ",\n";
+            file << "      \"cpu_time\": " << r.cpuNs << ",\n";
+            file << "      \"time_unit\": \"ns\"";
+            if (r.bytesPerSecond > 0.0) {
+                file << ",\n      \"bytes_per_second\": " << r.bytesPerSecond;
+            }
+            if (r.itemsPerSecond > 0.0) {
+                file << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+            }
+            if (!r.label.empty()) {
+                file << ",\n      \"label\": \"" << jsonEscape(r.label) << "\"";
+            }
+            file << "\n";
+        }
+        file << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+
+    return static_cast<bool>(file);
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --filter <text>      Only run benchmarks whose name contains text\n";
+    std::cout << "  --json <path>        Write results as JSON (Google Benchmark layout)\n";
+    std::cout << "  --min-time <sec>     Minimum measured time per benchmark (default 0.5)\n";
+    std::cout << "  --repetitions <n>    Repeat each benchmark and report mean/median/stddev\n";
+    std::cout << "  --list               List benchmarks and exit\n";
+    std::cout << "  --help               Show this help message\n";
+}
+
+} // anonymous namespace
+
+} // namespace bench
+} // namespace mcgng
+
+int main(int argc, char* argv[]) {
+    using namespace mcgng::bench;
+
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTime = std::stod(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Expand argument sets into runnable entries
+    std::vector<std::pair<Benchmark*, std::vector<int64_t>>> runs;
+    for (Benchmark* benchmark : getRegistry()) {
+        std::vector<std::vector<int64_t>> argSets = benchmark->getArgSets();
+        if (argSets.empty()) {
+            argSets.push_back({});
+        }
+        for (const auto& args : argSets) {
+            if (options.filter.empty() ||
+                runName(*benchmark, args).find(options.filter) != std::string::npos) {
+                runs.push_back({benchmark, args});
+            }
+        }
+    }
+
+    if (options.list) {
+        for (const auto& run : runs) {
+            std::cout << runName(*run.first, run.second) << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << std::setfill(' ') << std::left << std::setw(48) << "Benchmark" << std::right
+              << std::setw(16) << "Time" << std::setw(16) << "CPU"
+              << std::setw(12) << "Iterations" << "\n";
+    std::cout << std::string(92, '-') << "\n";
+
+    std::vector<RunResult> results;
+    bool anyError = false;
+    for (const auto& run : runs) {
+        std::vector<RunResult> reps;
+        for (int rep = 0; rep < options.repetitions; ++rep) {
+            RunResult result = runOnce(*run.first, run.second, options.minTime);
+            printResult(result);
+            anyError = anyError || !result.error.empty();
+            reps.push_back(result);
+            if (!result.error.empty()) {
+                break;
+            }
+        }
+        results.insert(results.end(), reps.begin(), reps.end());
+        for (const auto& agg : aggregate(reps)) {
+            printResult(agg);
+            results.push_back(agg);
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        if (!writeJson(options.jsonPath, results)) {
+            return 1;
+        }
+        std::cout << "\nResults written to " << options.jsonPath << "\n";
+    }
+
+    return anyError ? 1 : 0;
+}
@@ -0,0 +1,177 @@
+#ifndef MCGNG_BENCHMARK_H
+#define MCGNG_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+namespace bench {
+
+/**
+ * Per-run benchmark state.
+ *
+ * Modeled on Google Benchmark's State so results (and habits) carry over:
+ *
+ *   static void BM_Thing(State& state) {
+ *       auto input = makeInput(state.range(0));   // untimed setup
+ *       while (state.keepRunning()) {
+ *           doNotOptimize(thing(input));
+ *       }
+ *       state.setBytesProcessed(state.iterations() * input.size());
+ *   }
+ *   MCGNG_BENCHMARK(BM_Thing)->arg(1024)->arg(65536);
+ */
+class State {
+public:
+    State(uint64_t maxIterations, std::vector<int64_t> args);
+
+    /**
+     * Loop condition. Starts the timer on the first call and stops it
+     * once the iteration budget is used up.
+     */
+    bool keepRunning() {
+        if (m_iterations < m_maxIterations) {
+            if (m_iterations++ == 0) {
+                startTimer();
+            }
+            return true;
+        }
+        if (m_running) {
+            stopTimer();
+        }
+        return false;
+    }
+
+    /**
+     * Exclude the following code from timing (e.g. per-iteration setup).
+     */
+    void pauseTiming() { stopTimer(); }
+    void resumeTiming() { startTimer(); }
+
+    /**
+     * Benchmark argument (set with Benchmark::arg / args).
+     */
+    int64_t range(size_t index = 0) const {
+        return index < m_args.size() ? m_args[index] : 0;
+    }
+
+    uint64_t iterations() const { return m_iterations; }
+
+    void setBytesProcessed(int64_t bytes) { m_bytesProcessed = bytes; }
+    void setItemsProcessed(int64_t items) { m_itemsProcessed = items; }
+    void setLabel(const std::string& label) { m_label = label; }
+
+    /**
+     * Abort the benchmark and report an error instead of timings.
+     */
+    void skipWithError(const std::string& message);
+
+    // Results (read by the runner)
+    double getRealSeconds() const { return m_realSeconds; }
+    double getCpuSeconds() const { return m_cpuSeconds; }
+    int64_t getBytesProcessed() const { return m_bytesProcessed; }
+    int64_t getItemsProcessed() const { return m_itemsProcessed; }
+    const std::string& getLabel() const { return m_label; }
+    const std::string& getError() const { return m_error; }
+    bool hasError() const { return !m_error.empty(); }
+
+private:
+    void startTimer();
+    void stopTimer();
+
+    uint64_t m_maxIterations;
+    uint64_t m_iterations = 0;
+    std::vector<int64_t> m_args;
+
+    bool m_running = false;
+    std::chrono::steady_clock::time_point m_realStart;
+    std::clock_t m_cpuStart = 0;
+    double m_realSeconds = 0.0;
+    double m_cpuSeconds = 0.0;
+
+    int64_t m_bytesProcessed = 0;
+    int64_t m_itemsProcessed = 0;
+    std::string m_label;
+    std::string m_error;
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+/**
+ * A registered benchmark and its argument sets.
+ */
+class Benchmark {
+public:
+    Benchmark(std::string name, BenchmarkFunction function);
+
+    /**
+     * Add a run with a single argument.
+     */
+    Benchmark* arg(int64_t value);
+
+    /**
+     * Add a run with several arguments.
+     */
+    Benchmark* args(std::vector<int64_t> values);
+
+    /**
+     * Add runs for value, value*multiplier, ... up to limit (inclusive).
+     */
+    Benchmark* range(int64_t start, int64_t limit, int64_t multiplier = 8);
+
+    const std::string& getName() const { return m_name; }
+    BenchmarkFunction getFunction() const { return m_function; }
+    const std::vector<std::vector<int64_t>>& getArgSets() const { return m_argSets; }
+
+private:
+    std::string m_name;
+    BenchmarkFunction m_function;
+    std::vector<std::vector<int64_t>> m_argSets;
+};
+
+/**
+ * Register a benchmark. Usually called through MCGNG_BENCHMARK.
+ */
+Benchmark* registerBenchmark(const char* name, BenchmarkFunction function);
+
+/**
+ * All registered benchmarks in registration order.
+ */
+std::vector<Benchmark*>& getRegistry();
+
+/**
+ * Prevent the compiler from discarding a computed value.
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Force pending memory writes to be considered observable.
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace bench
+} // namespace mcgng
+
+#define MCGNG_BENCH_CONCAT_INNER(a, b) a##b
+#define MCGNG_BENCH_CONCAT(a, b) MCGNG_BENCH_CONCAT_INNER(a, b)
+
+#define MCGNG_BENCHMARK(function)                                              \
+    static ::mcgng::bench::Benchmark* MCGNG_BENCH_CONCAT(s_benchmark_, __LINE__) \
+        = ::mcgng::bench::registerBenchmark(#function, function)
+
+#endif // MCGNG_BENCHMARK_H
@@ -0,0 +1,512 @@
+#include "synthetic.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#ifdef MCGNG_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace mcgng {
+namespace bench {
+
+std::mt19937& rng() {
+    static std::mt19937 generator(0x4D434721u);  // "MCG!"
+    return generator;
+}
+
+std::vector<uint8_t> makeGameLikeData(size_t size, double noise) {
+    std::vector<uint8_t> data;
+    data.reserve(size);
+
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<int> lengthDist(3, 40);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+    while (data.size() < size) {
+        double roll = chance(rng());
+        int length = lengthDist(rng());
+        if (roll < noise) {
+            // Incompressible noise
+            for (int i = 0; i < length; ++i) {
+                data.push_back(static_cast<uint8_t>(byteDist(rng())));
+            }
+        } else if (roll < noise + (1.0 - noise) * 0.5 || data.size() < 64) {
+            // Run of a single value (transparent spans, solid fills)
+            uint8_t value = static_cast<uint8_t>(byteDist(rng()) & 0x3F);
+            data.insert(data.end(), static_cast<size_t>(length), value);
+        } else {
+            // Repeat an earlier fragment
+            std::uniform_int_distribution<size_t> backDist(1, std::min<size_t>(data.size() - 1, 4096));
+            size_t start = data.size() - backDist(rng());
+            for (int i = 0; i < length; ++i) {
+                data.push_back(data[start + static_cast<size_t>(i) % (data.size() - start)]);
+            }
+        }
+    }
+
+    data.resize(size);
+    return data;
+}
+
+std::vector<uint8_t> lzCompress(const std::vector<uint8_t>& data) {
+    // Mirrors the decoder in assets/lz_decompress.cpp: LSB-first codes that
+    // start at 9 bits and widen when the decoder's table fills, up to 12.
+    constexpr uint32_t CLEAR = 256;
+    constexpr uint32_t END = 257;
+    constexpr uint32_t FIRST_FREE = 258;
+    constexpr uint32_t MAX_CODE = 4096;
+
+    std::vector<uint8_t> out;
+    uint64_t bitBuffer = 0;
+    uint32_t bitCount = 0;
+
+    // Decoder-side state, to know what width it expects each code at
+    uint32_t decoderBits = 9;
+    uint32_t decoderMax = 512;
+    uint32_t decoderFree = FIRST_FREE;
+    bool firstAfterClear = true;
+
+    auto emit = [&](uint32_t code) {
+        bitBuffer |= static_cast<uint64_t>(code) << bitCount;
+        bitCount += decoderBits;
+        while (bitCount >= 8) {
+            out.push_back(static_cast<uint8_t>(bitBuffer & 0xFF));
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+
+        if (code == CLEAR) {
+            decoderBits = 9;
+            decoderMax = 512;
+            decoderFree = FIRST_FREE;
+            firstAfterClear = true;
+        } else if (code != END) {
+            if (firstAfterClear) {
+                firstAfterClear = false;
+            } else {
+                decoderFree++;
+                if (decoderFree >= decoderMax && decoderBits < 12) {
+                    decoderBits++;
+                    decoderMax <<= 1;
+                }
+            }
+        }
+    };
+
+    std::unordered_map<uint32_t, uint32_t> dictionary;
+    dictionary.reserve(MAX_CODE * 2);
+    uint32_t nextCode = FIRST_FREE;
+
+    int64_t prefix = -1;
+    for (uint8_t c : data) {
+        if (prefix < 0) {
+            prefix = c;
+            continue;
+        }
+
+        uint32_t key = (static_cast<uint32_t>(prefix) << 8) | c;
+        auto it = dictionary.find(key);
+        if (it != dictionary.end()) {
+            prefix = it->second;
+            continue;
+        }
+
+        emit(static_cast<uint32_t>(prefix));
+        if (nextCode < MAX_CODE) {
+            dictionary[key] = nextCode++;
+        } else {
+            emit(CLEAR);
+            dictionary.clear();
+            nextCode = FIRST_FREE;
+        }
+        prefix = c;
+    }
+
+    if (prefix >= 0) {
+        emit(static_cast<uint32_t>(prefix));
+    }
+    emit(END);
+
+    if (bitCount > 0) {
+        out.push_back(static_cast<uint8_t>(bitBuffer & 0xFF));
+    }
+
+    // The decoder refuses to start with fewer than 3 bytes of input
+    while (out.size() < 4) {
+        out.push_back(0);
+    }
+    return out;
+}
+
+std::vector<uint8_t> zlibCompress(const std::vector<uint8_t>& data) {
+#ifdef MCGNG_HAS_ZLIB
+    uLongf size = compressBound(static_cast<uLong>(data.size()));
+    std::vector<uint8_t> out(size);
+    if (compress2(out.data(), &size, data.data(), static_cast<uLong>(data.size()), 6) != Z_OK) {
+        return {};
+    }
+    out.resize(size);
+    return out;
+#else
+    (void)data;
+    return {};
+#endif
+}
+
+std::vector<std::string> writeFstArchive(const std::string& path, size_t entryCount) {
+    static const char* directories[] = {
+        "data\\shapes\\", "data\\missions\\", "data\\sprites\\", "data\\palette\\",
+        "data\\interface\\", "data\\terrain\\", "data\\sound\\", "data\\art\\"
+    };
+    static const char* extensions[] = {".shp", ".fit", ".pak", ".pal", ".tga", ".abl"};
+
+    std::vector<std::string> names;
+    names.reserve(entryCount);
+
+    std::ofstream file(path, std::ios::binary);
+    uint32_t count = static_cast<uint32_t>(entryCount);
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    uint32_t dataOffset = static_cast<uint32_t>(4 + entryCount * 262);
+    for (size_t i = 0; i < entryCount; ++i) {
+        std::string name = std::string(directories[i % 8]) + "asset" + std::to_string(i) + extensions[i % 6];
+
+        uint32_t zero = 0;
+        char pathBuffer[250] = {0};
+        std::memcpy(pathBuffer, name.c_str(), std::min(name.size(), sizeof(pathBuffer) - 1));
+
+        file.write(reinterpret_cast<const char*>(&dataOffset), sizeof(dataOffset));
+        file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+        file.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+        file.write(pathBuffer, sizeof(pathBuffer));
+
+        // FstReader normalizes separators on load
+        std::replace(name.begin(), name.end(), '\\', '/');
+        names.push_back(name);
+    }
+
+    return names;
+}
+
+std::string makeFitText(size_t blockCount, size_t variablesPerBlock) {
+    std::string text = "FITini\n";
+    for (size_t b = 0; b < blockCount; ++b) {
+        text += "[Block" + std::to_string(b) + "]\n";
+        for (size_t v = 0; v < variablesPerBlock; ++v) {
+            std::string name = "Var" + std::to_string(v);
+            switch (v % 5) {
+                case 0: text += "l " + name + " = " + std::to_string(b * 100 + v) + "\n"; break;
+                case 1: text += "f " + name + " = " + std::to_string(static_cast<double>(v) * 0.25) + "\n"; break;
+                case 2: text += "st " + name + " = \"value_" + std::to_string(v) + "\"\n"; break;
+                case 3: text += "b " + name + " = " + (v % 2 ? "TRUE" : "FALSE") + "\n"; break;
+                default: text += "ul[4] " + name + " = 1, 2, 3, 4\n"; break;
+            }
+        }
+    }
+    text += "FITend\n";
+    return text;
+}
+
+std::vector<uint8_t> makeIndexedSprite(int width, int height) {
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height, 0);
+    std::uniform_int_distribution<int> colorDist(16, 239);
+    std::uniform_int_distribution<int> patchDist(0, 7);
+
+    int cx = width / 2;
+    int cy = height / 2;
+    uint8_t color = static_cast<uint8_t>(colorDist(rng()));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            // Diamond footprint, solid patches with occasional detail pixels
+            int dx = std::abs(x - cx) * height;
+            int dy = std::abs(y - cy) * width;
+            if (dx + dy > width * height / 2) {
+                continue;
+            }
+            int roll = patchDist(rng());
+            if (roll == 0) {
+                color = static_cast<uint8_t>(colorDist(rng()));
+            }
+            pixels[static_cast<size_t>(y) * width + x] =
+                roll == 1 ? static_cast<uint8_t>(colorDist(rng())) : color;
+        }
+    }
+    return pixels;
+}
+
+std::vector<uint8_t> encodeVfxRle(const std::vector<uint8_t>& pixels, int width, int height) {
+    std::vector<uint8_t> out;
+    out.reserve(pixels.size());
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = pixels.data() + static_cast<size_t>(y) * width;
+
+        // Trailing transparency is implied by the end-of-line marker
+        int end = width;
+        while (end > 0 && row[end - 1] == 0) {
+            end--;
+        }
+
+        int x = 0;
+        while (x < end) {
+            if (row[x] == 0) {
+                int count = 0;
+                while (x + count < end && row[x + count] == 0 && count < 255) {
+                    count++;
+                }
+                out.push_back(1);
+                out.push_back(static_cast<uint8_t>(count));
+                x += count;
+                continue;
+            }
+
+            int run = 1;
+            while (x + run < end && row[x + run] == row[x] && run < 127) {
+                run++;
+            }
+            if (run >= 3) {
+                out.push_back(static_cast<uint8_t>(run << 1));
+                out.push_back(row[x]);
+                x += run;
+                continue;
+            }
+
+            // Literal string up to the next transparent pixel or run of 3+
+            int count = 0;
+            while (x + count < end && row[x + count] != 0 && count < 127) {
+                if (x + count + 2 < end && row[x + count] == row[x + count + 1] &&
+                    row[x + count] == row[x + count + 2]) {
+                    break;
+                }
+                count++;
+            }
+            if (count == 0) {
+                count = 1;
+            }
+            out.push_back(static_cast<uint8_t>((count << 1) | 1));
+            out.insert(out.end(), row + x, row + x + count);
+            x += count;
+        }
+
+        out.push_back(0);
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> makeShapeTable(uint32_t shapeCount, int width, int height) {
+    std::vector<uint8_t> table;
+    table.insert(table.end(), {'1', '.', '1', '0'});
+    table.resize(8 + static_cast<size_t>(shapeCount) * 8, 0);
+    std::memcpy(table.data() + 4, &shapeCount, sizeof(shapeCount));
+
+    for (uint32_t i = 0; i < shapeCount; ++i) {
+        uint32_t offset = static_cast<uint32_t>(table.size());
+        std::memcpy(table.data() + 8 + i * 8, &offset, sizeof(offset));
+
+        int32_t header[6] = {
+            0,
+            ((width / 2) << 16) | (height / 2),
+            0, 0, width - 1, height - 1
+        };
+        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(header);
+        table.insert(table.end(), headerBytes, headerBytes + sizeof(header));
+
+        std::vector<uint8_t> rle = encodeVfxRle(makeIndexedSprite(width, height), width, height);
+        table.insert(table.end(), rle.begin(), rle.end());
+    }
+
+    return table;
+}
+
+namespace {
+
+std::vector<uint8_t> encodeMechFrame(const std::vector<uint8_t>& pixels, int width, int height) {
+    std::vector<uint8_t> frame = {
+        0x00, 0x01,
+        static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width & 0xFF),
+        static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height & 0xFF),
+        0x00,
+        '1', '.', '1', '0'
+    };
+
+    std::vector<uint8_t> rle = encodeVfxRle(pixels, width, height);
+    frame.insert(frame.end(), rle.begin(), rle.end());
+    return frame;
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> makeMechFrame(int width, int height) {
+    return encodeMechFrame(makeIndexedSprite(width, height), width, height);
+}
+
+std::vector<uint8_t> makeMechSpriteSet(int directions, int framesPerDirection, int size) {
+    // Art for facings 0..directions/2; the rest mirror them
+    std::vector<std::vector<uint8_t>> art;
+    for (int d = 0; d <= directions / 2; ++d) {
+        for (int f = 0; f < framesPerDirection; ++f) {
+            art.push_back(makeIndexedSprite(size, size));
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> packets;
+    for (int d = 0; d < directions; ++d) {
+        int source = d <= directions / 2 ? d : directions - d;
+        for (int f = 0; f < framesPerDirection; ++f) {
+            std::vector<uint8_t> pixels = art[static_cast<size_t>(source * framesPerDirection + f)];
+            if (source != d) {
+                for (int y = 0; y < size; ++y) {
+                    std::reverse(pixels.begin() + y * size, pixels.begin() + (y + 1) * size);
+                }
+            }
+            packets.push_back(encodeMechFrame(pixels, size, size));
+        }
+    }
+
+    // Inner PAK: magic, first offset, then the seek table (raw packets)
+    uint32_t count = static_cast<uint32_t>(packets.size());
+    uint32_t offset = 8 + count * 4;
+    std::vector<uint8_t> pak(offset);
+    uint32_t magic = 0xFEEDFACE;
+    std::memcpy(pak.data(), &magic, 4);
+    std::memcpy(pak.data() + 4, &offset, 4);
+    for (uint32_t i = 0; i < count; ++i) {
+        std::memcpy(pak.data() + 8 + i * 4, &offset, 4);
+        offset += static_cast<uint32_t>(packets[i].size());
+    }
+    for (const auto& packet : packets) {
+        pak.insert(pak.end(), packet.begin(), packet.end());
+    }
+    return pak;
+}
+
+std::vector<uint8_t> makeFontData(int height) {
+    constexpr int32_t COUNT = 128;
+    std::vector<uint8_t> font(16 + COUNT * 4, 0);
+    int32_t header[4] = {1, COUNT, height, 0};
+    std::memcpy(font.data(), header, sizeof(header));
+
+    std::uniform_int_distribution<int> ink(0, 2);
+    for (int32_t ch = 32; ch < 127; ++ch) {
+        int32_t offset = static_cast<int32_t>(font.size());
+        int32_t width = 3 + ch % 5;
+        std::memcpy(font.data() + 16 + ch * 4, &offset, 4);
+        font.resize(font.size() + 4);
+        std::memcpy(font.data() + offset, &width, 4);
+        for (int i = 0; i < width * height; ++i) {
+            font.push_back(ch == ' ' ? 0 : static_cast<uint8_t>(ink(rng()) == 0 ? 0 : 15));
+        }
+    }
+    return font;
+}
+
+std::vector<uint8_t> makeTgaImage(int imageType, int width, int height, int bitsPerPixel) {
+    bool colorMapped = imageType == 1 || imageType == 9;
+    bool rle = imageType >= 9;
+    int bytesPerPixel = colorMapped ? 1 : bitsPerPixel / 8;
+
+    std::vector<uint8_t> tga(18, 0);
+    tga[2] = static_cast<uint8_t>(imageType);
+    if (colorMapped) {
+        tga[1] = 1;
+        tga[5] = 0;             // 256 entries
+        tga[6] = 1;
+        tga[7] = 24;
+    }
+    tga[12] = static_cast<uint8_t>(width);
+    tga[13] = static_cast<uint8_t>(width >> 8);
+    tga[14] = static_cast<uint8_t>(height);
+    tga[15] = static_cast<uint8_t>(height >> 8);
+    tga[16] = static_cast<uint8_t>(colorMapped ? 8 : bitsPerPixel);
+    tga[17] = static_cast<uint8_t>(bitsPerPixel == 32 ? 8 : 0);
+
+    if (colorMapped) {
+        for (int i = 0; i < 256; ++i) {
+            tga.push_back(static_cast<uint8_t>(i));
+            tga.push_back(static_cast<uint8_t>(255 - i));
+            tga.push_back(static_cast<uint8_t>(i * 7));
+        }
+    }
+
+    // Panels of flat color with a noisy band, like menu backgrounds
+    std::uniform_int_distribution<int> noise(0, 15);
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * bytesPerPixel);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t* p = pixels.data() + (static_cast<size_t>(y) * width + x) * bytesPerPixel;
+            int shade = ((x / 64) + (y / 48)) * 20;
+            if (y % 48 > 40) {
+                shade += noise(rng());
+            }
+            for (int c = 0; c < bytesPerPixel; ++c) {
+                p[c] = static_cast<uint8_t>(shade + c * 40);
+            }
+        }
+    }
+
+    if (!rle) {
+        tga.insert(tga.end(), pixels.begin(), pixels.end());
+        return tga;
+    }
+
+    // Runs of identical pixels become run packets, the rest raw packets
+    auto same = [&](size_t a, size_t b) {
+        return std::memcmp(&pixels[a * bytesPerPixel], &pixels[b * bytesPerPixel], bytesPerPixel) == 0;
+    };
+    for (int y = 0; y < height; ++y) {
+        size_t rowStart = static_cast<size_t>(y) * width;
+        size_t x = 0;
+        while (x < static_cast<size_t>(width)) {
+            size_t run = 1;
+            while (x + run < static_cast<size_t>(width) && run < 128 && same(rowStart + x, rowStart + x + run)) {
+                ++run;
+            }
+            if (run > 1) {
+                tga.push_back(static_cast<uint8_t>(0x80 | (run - 1)));
+                tga.insert(tga.end(), &pixels[(rowStart + x) * bytesPerPixel],
+                           &pixels[(rowStart + x) * bytesPerPixel] + bytesPerPixel);
+                x += run;
+                continue;
+            }
+            size_t raw = 1;
+            while (x + raw < static_cast<size_t>(width) && raw < 128 &&
+                   (x + raw + 1 >= static_cast<size_t>(width) || !same(rowStart + x + raw, rowStart + x + raw + 1))) {
+                ++raw;
+            }
+            tga.push_back(static_cast<uint8_t>(raw - 1));
+            tga.insert(tga.end(), &pixels[(rowStart + x) * bytesPerPixel],
+                       &pixels[(rowStart + x + raw) * bytesPerPixel]);
+            x += raw;
+        }
+    }
+    return tga;
+}
+
+std::vector<uint8_t> makePaletteData() {
+    std::vector<uint8_t> palette(768);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& value : palette) {
+        value = static_cast<uint8_t>(dist(rng()));
+    }
+    return palette;
+}
+
+const std::string& tempDirectory() {
+    static const std::string path = [] {
+        fs::path dir = fs::temp_directory_path() / "mcgng_bench";
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        return dir.string();
+    }();
+    return path;
+}
+
+} // namespace bench
+} // namespace mcgng
@@ -0,0 +1,108 @@
+#ifndef MCGNG_BENCH_SYNTHETIC_H
+#define MCGNG_BENCH_SYNTHETIC_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+namespace bench {
+
+/**
+ * Synthetic data generators.
+ *
+ * Every benchmark builds its input from these so the suite runs without the
+ * original game files. Generators are seeded deterministically so numbers
+ * are comparable between runs and machines.
+ */
+
+/**
+ * Fixed-seed RNG shared by the generators.
+ */
+std::mt19937& rng();
+
+/**
+ * Bytes resembling game data: runs, repeated fragments and noise.
+ * @param size Output size in bytes
+ * @param noise Fraction of random bytes (0 = highly compressible)
+ */
+std::vector<uint8_t> makeGameLikeData(size_t size, double noise = 0.1);
+
+/**
+ * Compress with the MCG LZD scheme (9-12 bit LZW, CLEAR=256, EOF=257).
+ * Output round-trips through lzDecompress.
+ */
+std::vector<uint8_t> lzCompress(const std::vector<uint8_t>& data);
+
+/**
+ * Compress with zlib. Returns empty if zlib support is not compiled in.
+ */
+std::vector<uint8_t> zlibCompress(const std::vector<uint8_t>& data);
+
+/**
+ * Write an FST archive with the given number of entries (no payload).
+ * @return Entry paths in archive order
+ */
+std::vector<std::string> writeFstArchive(const std::string& path, size_t entryCount);
+
+/**
+ * FITini text with the given number of blocks of mixed typed variables.
+ */
+std::string makeFitText(size_t blockCount, size_t variablesPerBlock);
+
+/**
+ * Indexed 8-bit sprite with a transparent border (index 0), roughly diamond
+ * shaped like MCG unit art.
+ */
+std::vector<uint8_t> makeIndexedSprite(int width, int height);
+
+/**
+ * Encode indexed pixels with VFX RLE (0 = end of line, 1 = skip,
+ * even = run, odd = literal string).
+ */
+std::vector<uint8_t> encodeVfxRle(const std::vector<uint8_t>& pixels, int width, int height);
+
+/**
+ * VFX shape table ("1.10") holding shapeCount shapes of the given size.
+ */
+std::vector<uint8_t> makeShapeTable(uint32_t shapeCount, int width, int height);
+
+/**
+ * Single MCG mech frame: 7-byte prefix with big-endian size, "1.10",
+ * then VFX RLE rows.
+ */
+std::vector<uint8_t> makeMechFrame(int width, int height);
+
+/**
+ * Inner PAK of one mech type: directions x framesPerDirection mech frames,
+ * facing-major, with facings past directions/2 mirroring the right half.
+ */
+std::vector<uint8_t> makeMechSpriteSet(int directions, int framesPerDirection, int size);
+
+/**
+ * VFX bitmap font with printable ASCII glyphs (32..126) of the given height.
+ */
+std::vector<uint8_t> makeFontData(int height);
+
+/**
+ * TGA image that looks like UI art (flat panels, gradients, some noise),
+ * stored bottom-up. imageType is 1, 2, 9 or 10; bitsPerPixel 24 or 32
+ * for true color (colormapped images use 8-bit indices).
+ */
+std::vector<uint8_t> makeTgaImage(int imageType, int width, int height, int bitsPerPixel);
+
+/**
+ * Random 768-byte RGB palette.
+ */
+std::vector<uint8_t> makePaletteData();
+
+/**
+ * Temporary directory for generated files (created on first use).
+ */
+const std::string& tempDirectory();
+
+} // namespace bench
+} // namespace mcgng
+
+#endif // MCGNG_BENCH_SYNTHETIC_H
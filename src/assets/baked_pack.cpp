@@ -0,0 +1,304 @@
+#include "assets/baked_pack.h"
+#include "assets/fit_parser.h"
+#include "assets/shape_reader.h"
+#include "assets/vfs.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace mcgng {
+
+namespace {
+
+constexpr size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint32_t hashCapacityFor(size_t entryCount) {
+    // Keep the load factor at or below 1/2 so probes stay short
+    uint32_t capacity = 16;
+    while (capacity < entryCount * 2) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // anonymous namespace
+
+uint64_t BakedPack::hashPath(const std::string& normalizedPath) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : normalizedPath) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool BakedPack::open(const std::string& path) {
+    close();
+
+    if (!m_file.open(path)) {
+        return false;
+    }
+
+    const uint8_t* base = m_file.data();
+    size_t size = m_file.size();
+    if (size < sizeof(BakedPackHeader)) {
+        std::cerr << "BakedPack: File too small: " << path << "\n";
+        close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const BakedPackHeader*>(base);
+    if (std::memcmp(header->magic, MAGIC, 4) != 0 || header->version != VERSION) {
+        std::cerr << "BakedPack: Not a version " << VERSION << " pack: " << path << "\n";
+        close();
+        return false;
+    }
+
+    // Validate every section once so lookups can trust the offsets
+    uint64_t tocEnd = header->tocOffset + static_cast<uint64_t>(header->entryCount) * sizeof(BakedEntry);
+    uint64_t hashEnd = header->hashOffset + static_cast<uint64_t>(header->hashCapacity) * sizeof(uint32_t);
+    bool valid = header->fileSize == size && tocEnd <= size && hashEnd <= size &&
+                 header->namesOffset <= size && header->dataOffset <= size &&
+                 header->tocOffset % alignof(BakedEntry) == 0 &&
+                 header->hashOffset % alignof(uint32_t) == 0 &&
+                 header->hashCapacity != 0 &&
+                 (header->hashCapacity & (header->hashCapacity - 1)) == 0;
+
+    const auto* entries = reinterpret_cast<const BakedEntry*>(base + header->tocOffset);
+    for (uint32_t i = 0; valid && i < header->entryCount; ++i) {
+        const BakedEntry& entry = entries[i];
+        valid = entry.dataOffset + entry.dataSize <= size &&
+                header->namesOffset + entry.nameOffset + entry.nameLength <= size;
+    }
+
+    if (!valid) {
+        std::cerr << "BakedPack: Corrupt table of contents: " << path << "\n";
+        close();
+        return false;
+    }
+
+    m_header = header;
+    m_entries = entries;
+    m_hashTable = reinterpret_cast<const uint32_t*>(base + header->hashOffset);
+    m_names = reinterpret_cast<const char*>(base + header->namesOffset);
+    return true;
+}
+
+void BakedPack::close() {
+    m_file.close();
+    m_header = nullptr;
+    m_entries = nullptr;
+    m_hashTable = nullptr;
+    m_names = nullptr;
+}
+
+const BakedEntry* BakedPack::find(const std::string& path) const {
+    if (!m_header) {
+        return nullptr;
+    }
+
+    std::string normalized = Vfs::normalizePath(path);
+    uint64_t hash = hashPath(normalized);
+    uint32_t mask = m_header->hashCapacity - 1;
+
+    for (uint32_t slot = static_cast<uint32_t>(hash) & mask, probes = 0;
+         probes < m_header->hashCapacity; slot = (slot + 1) & mask, ++probes) {
+        uint32_t index = m_hashTable[slot];
+        if (index == 0 || index > m_header->entryCount) {
+            return nullptr;
+        }
+
+        const BakedEntry& entry = m_entries[index - 1];
+        if (entry.pathHash == hash && entry.nameLength == normalized.size() &&
+            std::memcmp(m_names + entry.nameOffset, normalized.data(), normalized.size()) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* BakedPack::getData(const BakedEntry& entry) const {
+    return m_file.data() + entry.dataOffset;
+}
+
+std::string BakedPack::getName(const BakedEntry& entry) const {
+    return std::string(m_names + entry.nameOffset, entry.nameLength);
+}
+
+bool BakedPack::getShape(const std::string& path, BakedShape& shape) const {
+    const BakedEntry* entry = find(path);
+    if (!entry || entry->type != BakedEntryType::Shape ||
+        static_cast<size_t>(entry->width) * entry->height != entry->dataSize) {
+        return false;
+    }
+
+    shape.width = entry->width;
+    shape.height = entry->height;
+    shape.hotspotX = entry->hotspotX;
+    shape.hotspotY = entry->hotspotY;
+    shape.pixels = getData(*entry);
+    return true;
+}
+
+bool BakedPack::getFit(const std::string& path, FitParser& parser) const {
+    const BakedEntry* entry = find(path);
+    if (!entry || entry->type != BakedEntryType::Fit) {
+        return false;
+    }
+    return parser.parseBinary(getData(*entry), entry->dataSize);
+}
+
+// BakedPackWriter
+
+BakedPackWriter::PendingEntry& BakedPackWriter::add(const std::string& path, BakedEntryType type,
+                                                    std::vector<uint8_t> data) {
+    std::string normalized = Vfs::normalizePath(path);
+    auto result = m_lookup.try_emplace(normalized, m_entries.size());
+    if (result.second) {
+        m_entries.emplace_back();
+    }
+
+    PendingEntry& pending = m_entries[result.first->second];
+    pending.path = std::move(normalized);
+    pending.entry = BakedEntry{};
+    pending.entry.type = type;
+    pending.data = std::move(data);
+    return pending;
+}
+
+void BakedPackWriter::addRaw(const std::string& path, std::vector<uint8_t> data) {
+    add(path, BakedEntryType::Raw, std::move(data));
+}
+
+void BakedPackWriter::addFit(const std::string& path, const FitParser& parser) {
+    add(path, BakedEntryType::Fit, parser.toBinary());
+}
+
+void BakedPackWriter::addShape(const std::string& path, const ShapeData& shape) {
+    PendingEntry& pending = add(path, BakedEntryType::Shape, shape.pixels);
+    pending.entry.width = static_cast<uint16_t>(shape.width);
+    pending.entry.height = static_cast<uint16_t>(shape.height);
+    pending.entry.hotspotX = static_cast<int16_t>(shape.hotspotX);
+    pending.entry.hotspotY = static_cast<int16_t>(shape.hotspotY);
+}
+
+void BakedPackWriter::addPalette(const std::string& path, std::vector<uint8_t> rgb) {
+    add(path, BakedEntryType::Palette, std::move(rgb));
+}
+
+void BakedPackWriter::addMechFrames(const std::string& path, std::vector<uint8_t> data) {
+    add(path, BakedEntryType::MechFrames, std::move(data));
+}
+
+bool BakedPackWriter::contains(const std::string& path) const {
+    return m_lookup.count(Vfs::normalizePath(path)) != 0;
+}
+
+size_t BakedPackWriter::getDataSize() const {
+    size_t total = 0;
+    for (const auto& pending : m_entries) {
+        total += pending.data.size();
+    }
+    return total;
+}
+
+bool BakedPackWriter::write(const std::string& path) const {
+    if (m_entries.size() > std::numeric_limits<uint32_t>::max() / 2) {
+        std::cerr << "BakedPackWriter: Too many entries\n";
+        return false;
+    }
+
+    BakedPackHeader header{};
+    std::memcpy(header.magic, BakedPack::MAGIC, 4);
+    header.version = BakedPack::VERSION;
+    header.entryCount = static_cast<uint32_t>(m_entries.size());
+    header.hashCapacity = hashCapacityFor(m_entries.size());
+
+    // Names
+    std::string names;
+    std::vector<BakedEntry> toc;
+    toc.reserve(m_entries.size());
+    for (const auto& pending : m_entries) {
+        if (pending.path.size() > std::numeric_limits<uint16_t>::max() ||
+            pending.data.size() > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "BakedPackWriter: Entry too large: " << pending.path << "\n";
+            return false;
+        }
+
+        BakedEntry entry = pending.entry;
+        entry.pathHash = BakedPack::hashPath(pending.path);
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint16_t>(pending.path.size());
+        entry.dataSize = static_cast<uint32_t>(pending.data.size());
+        names += pending.path;
+        toc.push_back(entry);
+    }
+
+    // Section layout
+    size_t offset = sizeof(BakedPackHeader);
+    header.tocOffset = offset;
+    offset = alignUp(offset + toc.size() * sizeof(BakedEntry), BakedPack::BAKED_ALIGNMENT);
+    header.hashOffset = offset;
+    offset = alignUp(offset + header.hashCapacity * sizeof(uint32_t), BakedPack::BAKED_ALIGNMENT);
+    header.namesOffset = offset;
+    offset = alignUp(offset + names.size(), BakedPack::BAKED_ALIGNMENT);
+    header.dataOffset = offset;
+
+    for (size_t i = 0; i < toc.size(); ++i) {
+        toc[i].dataOffset = offset;
+        offset = alignUp(offset + m_entries[i].data.size(), BakedPack::BAKED_ALIGNMENT);
+    }
+    header.fileSize = offset;
+
+    // Hash table (linear probing, entry index + 1)
+    std::vector<uint32_t> hashTable(header.hashCapacity, 0);
+    uint32_t mask = header.hashCapacity - 1;
+    for (uint32_t i = 0; i < toc.size(); ++i) {
+        uint32_t slot = static_cast<uint32_t>(toc[i].pathHash) & mask;
+        while (hashTable[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        hashTable[slot] = i + 1;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "BakedPackWriter: Failed to create file: " << path << "\n";
+        return false;
+    }
+
+    auto padTo = [&file](uint64_t target) {
+        static const char zeros[BakedPack::BAKED_ALIGNMENT] = {};
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        if (target > position) {
+            file.write(zeros, static_cast<std::streamsize>(target - position));
+        }
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.tocOffset);
+    file.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(BakedEntry)));
+    padTo(header.hashOffset);
+    file.write(reinterpret_cast<const char*>(hashTable.data()),
+               static_cast<std::streamsize>(hashTable.size() * sizeof(uint32_t)));
+    padTo(header.namesOffset);
+    file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    for (size_t i = 0; i < toc.size(); ++i) {
+        padTo(toc[i].dataOffset);
+        const auto& data = m_entries[i].data;
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    padTo(header.fileSize);
+
+    if (!file) {
+        std::cerr << "BakedPackWriter: Failed to write file: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace mcgng
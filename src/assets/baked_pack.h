@@ -0,0 +1,244 @@
+#ifndef MCGNG_BAKED_PACK_H
+#define MCGNG_BAKED_PACK_H
+
+#include "assets/mapped_file.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+class FitParser;
+struct ShapeData;
+
+/**
+ * Kind of data stored in a baked pack entry.
+ */
+enum class BakedEntryType : uint8_t {
+    Raw     = 0,    // File or packet bytes, already decompressed
+    Fit     = 1,    // Binary FIT (see FitParser::toBinary)
+    Shape   = 2,    // 8-bit indexed pixels, width * height, size in the entry
+    Palette = 3,    // 256 * RGB, expanded to 8 bits per channel
+    MechFrames = 4  // Decoded mech sprite set (see MechFrameCache::toBinary)
+};
+
+/**
+ * Baked pack file header.
+ */
+struct BakedPackHeader {
+    char magic[4];              // "MCGB"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t hashCapacity;      // Slots in the hash table (power of two)
+    uint64_t tocOffset;         // BakedEntry[entryCount]
+    uint64_t hashOffset;        // uint32_t[hashCapacity], entry index + 1 (0 = empty)
+    uint64_t namesOffset;       // Entry paths, not terminated
+    uint64_t dataOffset;        // Start of the data section
+    uint64_t fileSize;
+    uint64_t reserved;
+};
+
+/**
+ * Baked pack table of contents entry.
+ */
+struct BakedEntry {
+    uint64_t pathHash;          // BakedPack::hashPath of the normalized path
+    uint64_t dataOffset;        // Absolute offset, BAKED_ALIGNMENT aligned
+    uint32_t dataSize;
+    uint32_t nameOffset;        // Relative to namesOffset
+    uint16_t nameLength;
+    BakedEntryType type;
+    uint8_t flags;
+    uint16_t width;             // Shape only
+    uint16_t height;
+    int16_t hotspotX;
+    int16_t hotspotY;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(BakedPackHeader) == 64, "BakedPackHeader layout changed");
+static_assert(sizeof(BakedEntry) == 40, "BakedEntry layout changed");
+
+/**
+ * Pre-decoded shape stored in a pack; pixels point into the mapping.
+ */
+struct BakedShape {
+    int width = 0;
+    int height = 0;
+    int hotspotX = 0;
+    int hotspotY = 0;
+    const uint8_t* pixels = nullptr;
+};
+
+/**
+ * Engine-native asset pack written by mcg-bake.
+ *
+ * Holds the original game data with all the load-time work already done:
+ * archive entries decompressed, shape tables RLE-decoded, mech sprite
+ * sets decoded into frame caches, FIT files in binary form and palettes
+ * expanded to 8 bits. The pack is memory-mapped
+ * and used in place; a lookup is one hash probe into the table of
+ * contents and every data blob is 16-byte aligned.
+ *
+ * Layout: header | TOC | hash table | names | data. All values are
+ * little-endian.
+ */
+class BakedPack {
+public:
+    static constexpr const char* MAGIC = "MCGB";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t BAKED_ALIGNMENT = 16;
+
+    BakedPack() = default;
+    ~BakedPack() = default;
+
+    // Disable copy, enable move
+    BakedPack(const BakedPack&) = delete;
+    BakedPack& operator=(const BakedPack&) = delete;
+    BakedPack(BakedPack&&) = default;
+    BakedPack& operator=(BakedPack&&) = default;
+
+    /**
+     * Map a pack and validate its header and table of contents.
+     * @param path Path to the .pack file
+     * @return true on success
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Unmap the pack.
+     */
+    void close();
+
+    /**
+     * Check if a pack is open.
+     */
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * Find an entry by path (normalized like Vfs paths).
+     * @return Entry or nullptr if not found
+     */
+    const BakedEntry* find(const std::string& path) const;
+
+    /**
+     * Get an entry's data (points into the mapping).
+     */
+    const uint8_t* getData(const BakedEntry& entry) const;
+
+    /**
+     * Get an entry's path.
+     */
+    std::string getName(const BakedEntry& entry) const;
+
+    /**
+     * Look up a pre-decoded shape.
+     * @return true if found
+     */
+    bool getShape(const std::string& path, BakedShape& shape) const;
+
+    /**
+     * Load a binary FIT entry.
+     * @return true if found and parsed
+     */
+    bool getFit(const std::string& path, FitParser& parser) const;
+
+    /**
+     * Get number of entries.
+     */
+    size_t getEntryCount() const { return m_header ? m_header->entryCount : 0; }
+
+    /**
+     * Get the table of contents.
+     */
+    const BakedEntry* getEntries() const { return m_entries; }
+
+    /**
+     * Get path of the open pack.
+     */
+    const std::string& getPath() const { return m_file.getPath(); }
+
+    /**
+     * Hash a normalized path (64-bit FNV-1a).
+     */
+    static uint64_t hashPath(const std::string& normalizedPath);
+
+private:
+    MappedFile m_file;
+    const BakedPackHeader* m_header = nullptr;
+    const BakedEntry* m_entries = nullptr;
+    const uint32_t* m_hashTable = nullptr;
+    const char* m_names = nullptr;
+};
+
+/**
+ * Builds a baked pack (used by mcg-bake).
+ */
+class BakedPackWriter {
+public:
+    /**
+     * Add raw bytes.
+     * Adding a path twice replaces the earlier entry.
+     */
+    void addRaw(const std::string& path, std::vector<uint8_t> data);
+
+    /**
+     * Add a parsed FIT file in binary form.
+     */
+    void addFit(const std::string& path, const FitParser& parser);
+
+    /**
+     * Add a decoded shape.
+     */
+    void addShape(const std::string& path, const ShapeData& shape);
+
+    /**
+     * Add a palette of 256 RGB triplets (8 bits per channel).
+     */
+    void addPalette(const std::string& path, std::vector<uint8_t> rgb);
+
+    /**
+     * Add a serialized mech frame cache.
+     */
+    void addMechFrames(const std::string& path, std::vector<uint8_t> data);
+
+    /**
+     * Check if a path has been added.
+     */
+    bool contains(const std::string& path) const;
+
+    /**
+     * Get number of entries added.
+     */
+    size_t getEntryCount() const { return m_entries.size(); }
+
+    /**
+     * Get total data bytes added.
+     */
+    size_t getDataSize() const;
+
+    /**
+     * Write the pack.
+     * @param path Output path
+     * @return true on success
+     */
+    bool write(const std::string& path) const;
+
+private:
+    struct PendingEntry {
+        std::string path;           // Normalized
+        BakedEntry entry{};
+        std::vector<uint8_t> data;
+    };
+
+    PendingEntry& add(const std::string& path, BakedEntryType type, std::vector<uint8_t> data);
+
+    std::vector<PendingEntry> m_entries;
+    std::unordered_map<std::string, size_t> m_lookup;   // Path -> index in m_entries
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_BAKED_PACK_H
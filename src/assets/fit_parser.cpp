@@ -3,6 +3,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <iostream>
 #include <regex>
 
@@ -122,9 +123,202 @@ bool FitParser::parseBuffer(const uint8_t* data, size_t size) {
         m_errorMessage = "Empty buffer";
         return false;
     }
+    if (isBinary(data, size)) {
+        return parseBinary(data, size);
+    }
     return parseString(std::string(reinterpret_cast<const char*>(data), size));
 }
 
+// Binary FIT
+//
+// Layout (little-endian):
+//   "FITB", uint32 version, uint32 blockCount
+//   block:    string name, uint32 variableCount
+//   variable: string name, string typePrefix, uint8 kind (FitValue index),
+//             uint8 isArray, uint32 arraySize, value
+//   value:    int64 | double | uint8 | string | uint32 n + n * int64 | uint32 n + n * double
+//   string:   uint32 length + bytes
+
+namespace {
+
+class BinaryWriter {
+public:
+    template <typename T>
+    void put(T value) {
+        size_t offset = m_data.size();
+        m_data.resize(offset + sizeof(T));
+        std::memcpy(m_data.data() + offset, &value, sizeof(T));
+    }
+
+    void putString(const std::string& str) {
+        put(static_cast<uint32_t>(str.size()));
+        m_data.insert(m_data.end(), str.begin(), str.end());
+    }
+
+    std::vector<uint8_t>& data() { return m_data; }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (m_size - m_pos < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string& str) {
+        uint32_t length = 0;
+        if (!get(length) || m_size - m_pos < length) {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+        m_pos += length;
+        return true;
+    }
+
+    template <typename T>
+    bool getArray(std::vector<T>& values) {
+        uint32_t count = 0;
+        if (!get(count) || (m_size - m_pos) / sizeof(T) < count) {
+            return false;
+        }
+        values.resize(count);
+        if (count > 0) {
+            std::memcpy(values.data(), m_data + m_pos, count * sizeof(T));
+        }
+        m_pos += count * sizeof(T);
+        return true;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
+
+} // anonymous namespace
+
+bool FitParser::isBinary(const uint8_t* data, size_t size) {
+    return data && size >= 8 && std::memcmp(data, FIT_BINARY_MAGIC, 4) == 0;
+}
+
+std::vector<uint8_t> FitParser::toBinary() const {
+    BinaryWriter writer;
+    for (int i = 0; i < 4; ++i) {
+        writer.put(static_cast<uint8_t>(FIT_BINARY_MAGIC[i]));
+    }
+    writer.put(FIT_BINARY_VERSION);
+    writer.put(static_cast<uint32_t>(m_blocks.size()));
+
+    for (const auto& block : m_blocks) {
+        writer.putString(block.name);
+        writer.put(static_cast<uint32_t>(block.variables.size()));
+
+        for (const auto& var : block.variables) {
+            writer.putString(var.name);
+            writer.putString(var.typePrefix);
+            writer.put(static_cast<uint8_t>(var.value.index()));
+            writer.put(static_cast<uint8_t>(var.isArray ? 1 : 0));
+            writer.put(static_cast<uint32_t>(var.arraySize));
+
+            if (auto* value = std::get_if<int64_t>(&var.value)) {
+                writer.put(*value);
+            } else if (auto* value = std::get_if<double>(&var.value)) {
+                writer.put(*value);
+            } else if (auto* value = std::get_if<bool>(&var.value)) {
+                writer.put(static_cast<uint8_t>(*value ? 1 : 0));
+            } else if (auto* value = std::get_if<std::string>(&var.value)) {
+                writer.putString(*value);
+            } else if (auto* values = std::get_if<std::vector<int64_t>>(&var.value)) {
+                writer.put(static_cast<uint32_t>(values->size()));
+                for (int64_t v : *values) {
+                    writer.put(v);
+                }
+            } else if (auto* values = std::get_if<std::vector<double>>(&var.value)) {
+                writer.put(static_cast<uint32_t>(values->size()));
+                for (double v : *values) {
+                    writer.put(v);
+                }
+            }
+        }
+    }
+
+    return std::move(writer.data());
+}
+
+bool FitParser::parseBinary(const uint8_t* data, size_t size) {
+    clear();
+
+    if (!isBinary(data, size)) {
+        m_errorMessage = "Missing binary FIT header";
+        return false;
+    }
+
+    BinaryReader reader(data + 4, size - 4);
+    uint32_t version = 0;
+    uint32_t blockCount = 0;
+    if (!reader.get(version) || version != FIT_BINARY_VERSION || !reader.get(blockCount)) {
+        m_errorMessage = "Unsupported binary FIT version";
+        return false;
+    }
+
+    m_blocks.reserve(blockCount);
+    for (uint32_t b = 0; b < blockCount; ++b) {
+        FitBlock block;
+        uint32_t variableCount = 0;
+        if (!reader.getString(block.name) || !reader.get(variableCount)) {
+            m_errorMessage = "Truncated binary FIT block";
+            return false;
+        }
+
+        block.variables.reserve(variableCount);
+        for (uint32_t v = 0; v < variableCount; ++v) {
+            FitVariable var;
+            uint8_t kind = 0;
+            uint8_t isArray = 0;
+            uint32_t arraySize = 0;
+            bool ok = reader.getString(var.name) && reader.getString(var.typePrefix) &&
+                      reader.get(kind) && reader.get(isArray) && reader.get(arraySize);
+
+            if (ok) {
+                switch (kind) {
+                    case 0: { int64_t value = 0; ok = reader.get(value); var.value = value; break; }
+                    case 1: { double value = 0; ok = reader.get(value); var.value = value; break; }
+                    case 2: { uint8_t value = 0; ok = reader.get(value); var.value = value != 0; break; }
+                    case 3: { std::string value; ok = reader.getString(value); var.value = std::move(value); break; }
+                    case 4: { std::vector<int64_t> values; ok = reader.getArray(values); var.value = std::move(values); break; }
+                    case 5: { std::vector<double> values; ok = reader.getArray(values); var.value = std::move(values); break; }
+                    default: ok = false; break;
+                }
+            }
+
+            if (!ok) {
+                m_errorMessage = "Truncated binary FIT variable in block " + block.name;
+                m_blocks.clear();
+                return false;
+            }
+
+            var.isArray = isArray != 0;
+            var.arraySize = arraySize;
+            block.variables.push_back(std::move(var));
+        }
+
+        m_blocks.push_back(std::move(block));
+    }
+
+    m_valid = true;
+    return true;
+}
+
 bool FitParser::parseString(const std::string& content) {
     clear();
 
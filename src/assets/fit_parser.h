@@ -88,6 +88,8 @@ class FitParser {
 public:
     static constexpr const char* FIT_HEADER = "FITini";
     static constexpr const char* FIT_FOOTER = "FITend";
+    static constexpr const char* FIT_BINARY_MAGIC = "FITB";
+    static constexpr uint32_t FIT_BINARY_VERSION = 1;
 
     FitParser() = default;
 
@@ -106,6 +108,25 @@ public:
      */
     bool parseBuffer(const uint8_t* data, size_t size);
 
+    /**
+     * Parse binary FIT data produced by toBinary().
+     * parseBuffer() detects binary data automatically.
+     * @return true on success
+     */
+    bool parseBinary(const uint8_t* data, size_t size);
+
+    /**
+     * Serialize the parsed blocks to binary FIT.
+     * Loading binary FIT skips tokenizing and number parsing entirely;
+     * mcg-bake stores FIT files this way.
+     */
+    std::vector<uint8_t> toBinary() const;
+
+    /**
+     * Check if a buffer holds binary FIT.
+     */
+    static bool isBinary(const uint8_t* data, size_t size);
+
     /**
      * Parse FIT data from a string.
      * @param content File content as string
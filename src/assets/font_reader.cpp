@@ -0,0 +1,86 @@
+#include "assets/font_reader.h"
+#include <cstring>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+int32_t readInt32(const uint8_t* data) {
+    int32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+} // anonymous namespace
+
+bool FontReader::load(const uint8_t* data, size_t size) {
+    constexpr size_t HEADER_SIZE = 16;
+
+    m_glyphs.clear();
+    m_pixels.clear();
+    m_height = 0;
+
+    if (!data || size < HEADER_SIZE) {
+        return false;
+    }
+
+    int32_t count = readInt32(data + 4);
+    int32_t height = readInt32(data + 8);
+    int32_t background = readInt32(data + 12);
+
+    if (count <= 0 || count > MAX_CHARACTERS || height <= 0 || height > MAX_HEIGHT ||
+        background < 0 || background > 255) {
+        return false;
+    }
+
+    size_t tableEnd = HEADER_SIZE + static_cast<size_t>(count) * 4;
+    if (tableEnd > size) {
+        return false;
+    }
+
+    std::vector<Glyph> glyphs(count);
+    std::vector<uint8_t> pixels;
+    for (int32_t ch = 0; ch < count; ++ch) {
+        int32_t offset = readInt32(data + HEADER_SIZE + ch * 4);
+        if (offset == 0) {
+            continue;
+        }
+        if (offset < static_cast<int32_t>(tableEnd) || static_cast<size_t>(offset) + 4 > size) {
+            std::cerr << "FontReader: Character " << ch << " offset out of range" << std::endl;
+            return false;
+        }
+
+        int32_t width = readInt32(data + offset);
+        size_t bytes = static_cast<size_t>(width) * height;
+        if (width < 0 || width > MAX_WIDTH || static_cast<size_t>(offset) + 4 + bytes > size) {
+            std::cerr << "FontReader: Character " << ch << " has invalid size or truncated data" << std::endl;
+            return false;
+        }
+
+        glyphs[ch].width = width;
+        glyphs[ch].offset = pixels.size();
+        glyphs[ch].present = true;
+        pixels.insert(pixels.end(), data + offset + 4, data + offset + 4 + bytes);
+    }
+
+    m_glyphs = std::move(glyphs);
+    m_pixels = std::move(pixels);
+    m_height = height;
+    m_background = static_cast<uint8_t>(background);
+    return true;
+}
+
+bool FontReader::hasGlyph(int ch) const {
+    return ch >= 0 && ch < static_cast<int>(m_glyphs.size()) && m_glyphs[ch].present;
+}
+
+int FontReader::getGlyphWidth(int ch) const {
+    return hasGlyph(ch) ? m_glyphs[ch].width : 0;
+}
+
+const uint8_t* FontReader::getGlyphPixels(int ch) const {
+    return hasGlyph(ch) ? m_pixels.data() + m_glyphs[ch].offset : nullptr;
+}
+
+} // namespace mcgng
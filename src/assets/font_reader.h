@@ -0,0 +1,90 @@
+#ifndef MCGNG_FONT_READER_H
+#define MCGNG_FONT_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * VFX bitmap font reader (MCG .FNT files in MISC.FST).
+ *
+ * Format (little-endian):
+ *   Offset 0:  Version (int32)
+ *   Offset 4:  Character count (int32, up to 256)
+ *   Offset 8:  Character height (int32)
+ *   Offset 12: Background color index (int32)
+ *   Offset 16: Character offsets (int32 x count, from start of file; 0 = absent)
+ *   Then per character: width (int32) followed by width x height pixels
+ *
+ * Pixel value 0 (and the background index) is transparent; everything
+ * else is ink.
+ */
+class FontReader {
+public:
+    static constexpr int MAX_CHARACTERS = 256;
+    static constexpr int MAX_HEIGHT = 128;
+    static constexpr int MAX_WIDTH = 128;
+
+    FontReader() = default;
+
+    /**
+     * Parse a font from memory. The data is copied.
+     * @param data Font file data
+     * @param size Size of data in bytes
+     * @return true on success
+     */
+    bool load(const uint8_t* data, size_t size);
+
+    /**
+     * Check if loaded.
+     */
+    bool isLoaded() const { return m_height > 0; }
+
+    /**
+     * Get character height in pixels.
+     */
+    int getHeight() const { return m_height; }
+
+    /**
+     * Get number of character slots.
+     */
+    int getCharacterCount() const { return static_cast<int>(m_glyphs.size()); }
+
+    /**
+     * Check if a character has a glyph.
+     */
+    bool hasGlyph(int ch) const;
+
+    /**
+     * Get width of a character's glyph (0 if absent).
+     */
+    int getGlyphWidth(int ch) const;
+
+    /**
+     * Get glyph pixels (width x height, row-major), or nullptr if absent.
+     */
+    const uint8_t* getGlyphPixels(int ch) const;
+
+    /**
+     * Check if a pixel value is ink (drawn) rather than background.
+     */
+    bool isInk(uint8_t pixel) const { return pixel != 0 && pixel != m_background; }
+
+private:
+    struct Glyph {
+        int width = 0;
+        size_t offset = 0;      // Into m_pixels
+        bool present = false;
+    };
+
+    std::vector<Glyph> m_glyphs;
+    std::vector<uint8_t> m_pixels;
+    int m_height = 0;
+    uint8_t m_background = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_FONT_READER_H
@@ -1,5 +1,6 @@
 #include "assets/fst_reader.h"
 #include "assets/lz_decompress.h"
+#include "core/profiler.h"
 #include <algorithm>
 #include <filesystem>
 #include <cstring>
@@ -148,6 +149,7 @@ std::vector<uint8_t> FstReader::readRawData(uint32_t offset, uint32_t size) {
 }
 
 std::vector<uint8_t> FstReader::readFile(const FstEntry& entry) {
+    MCGNG_PROFILE_ZONE("FstReader::readFile");
     if (!m_file.is_open()) {
         return {};
     }
@@ -164,11 +166,27 @@ std::vector<uint8_t> FstReader::readFile(const FstEntry& entry) {
         return {};
     }
 
+    return decodeEntry(entry, rawData.data(), rawData.size());
+}
+
+std::vector<uint8_t> FstReader::decodeEntry(const FstEntry& entry, const uint8_t* raw, size_t available) {
+    // Same size selection as readFile: uncompressedSize if it fits, else compressedSize
+    size_t size = 0;
+    if (entry.uncompressedSize > 0 && available >= entry.uncompressedSize) {
+        size = entry.uncompressedSize;
+    } else if (entry.compressedSize > 0 && entry.compressedSize != entry.uncompressedSize &&
+               available >= entry.compressedSize) {
+        size = entry.compressedSize;
+    }
+
+    if (!raw || size == 0) {
+        return {};
+    }
+
     // If sizes differ, try decompression
-    if (entry.compressedSize < entry.uncompressedSize && entry.compressedSize > 0) {
+    if (entry.isCompressed()) {
         // Try LZ decompression
-        auto result = decompress(rawData.data(),
-                                 std::min(rawData.size(), size_t(entry.compressedSize)),
+        auto result = decompress(raw, std::min(size, size_t(entry.compressedSize)),
                                  entry.uncompressedSize, false);
         if (!result.empty() && result.size() >= entry.uncompressedSize / 2) {
             return result;
@@ -176,7 +194,7 @@ std::vector<uint8_t> FstReader::readFile(const FstEntry& entry) {
     }
 
     // Return raw data
-    return rawData;
+    return std::vector<uint8_t>(raw, raw + size);
 }
 
 std::vector<uint8_t> FstReader::readFile(const std::string& path) {
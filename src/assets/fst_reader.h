@@ -110,6 +110,15 @@ public:
      */
     std::vector<uint8_t> readFile(const std::string& path);
 
+    /**
+     * Decode an entry from archive bytes already in memory (e.g. a mapping).
+     * @param entry Entry to decode
+     * @param raw Archive bytes starting at entry.dataOffset
+     * @param available Number of readable bytes at raw
+     * @return Decompressed file data, or empty vector on error
+     */
+    static std::vector<uint8_t> decodeEntry(const FstEntry& entry, const uint8_t* raw, size_t available);
+
     /**
      * Extract a file to disk.
      * @param entry Entry to extract
@@ -1,4 +1,5 @@
 #include "assets/lz_decompress.h"
+#include "core/profiler.h"
 #include <cstring>
 #include <stdexcept>
 
@@ -27,6 +28,7 @@ struct HashEntry {
  * This reimplements the x86 assembly from the original MC2 source.
  */
 size_t lzDecompress(const uint8_t* src, size_t srcLen, uint8_t* dest, size_t destLen) {
+    MCGNG_PROFILE_ZONE("lzDecompress");
     if (!src || !dest || srcLen < 3 || destLen == 0) {
         return 0;
     }
@@ -171,6 +173,7 @@ size_t lzDecompress(const uint8_t* src, size_t srcLen, uint8_t* dest, size_t des
 }
 
 size_t zlibDecompress(const uint8_t* src, size_t srcLen, uint8_t* dest, size_t destLen) {
+    MCGNG_PROFILE_ZONE("zlibDecompress");
     if (!src || !dest || srcLen == 0 || destLen == 0) {
         return 0;
     }
@@ -0,0 +1,77 @@
+#ifndef MCGNG_MAPPED_FILE_H
+#define MCGNG_MAPPED_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace mcgng {
+
+/**
+ * Read-only memory-mapped file.
+ *
+ * Archives are read in small scattered pieces, so mapping them once and
+ * slicing the mapping avoids a seek + read + copy per entry. The mapping
+ * stays valid until close() or destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Disable copy, enable move
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Map a file for reading.
+     * Empty files open successfully with a null data pointer.
+     * @param path Path to the file
+     * @return true on success
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Unmap and close the file.
+     */
+    void close();
+
+    /**
+     * Check if a file is mapped.
+     */
+    bool isOpen() const { return m_open; }
+
+    /**
+     * Get the mapped bytes.
+     */
+    const uint8_t* data() const { return m_data; }
+
+    /**
+     * Get the file size in bytes.
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * Get the path of the mapped file.
+     */
+    const std::string& getPath() const { return m_path; }
+
+private:
+    std::string m_path;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;   // HANDLE
+    void* m_mappingHandle = nullptr; // HANDLE
+#else
+    int m_fd = -1;
+#endif
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_MAPPED_FILE_H
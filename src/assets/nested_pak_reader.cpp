@@ -107,22 +107,10 @@ bool MechSpriteSet::load(const uint8_t* data, size_t size) {
         // Try to parse as mech shape first (more specific format)
         MechShapeReader mechShape;
         if (mechShape.load(decompressed.data(), decompressed.size())) {
+            // Moving the buffer keeps its storage, so the parsed row table stays valid
             m_frameData.push_back(std::move(decompressed));
-            m_mechFrames.push_back(mechShape);
-            m_mechFrames.back().load(m_frameData.back().data(), m_frameData.back().size());
+            m_mechFrames.push_back(std::move(mechShape));
             ++successCount;
-
-            // Log first few successes
-            if (successCount <= 5) {
-                std::cout << "  -> Mech shape " << i << ": " << mechShape.getWidth()
-                          << "x" << mechShape.getHeight() << std::endl;
-            }
-
-            // Limit frames for faster loading during testing
-            if (successCount >= 30) {
-                std::cout << "  (limiting to 30 frames for testing)" << std::endl;
-                break;
-            }
             continue;
         }
 
@@ -163,6 +151,15 @@ const MechShapeReader* MechSpriteSet::getMechFrame(uint32_t index) const {
     return &m_mechFrames[index];
 }
 
+size_t MechSpriteSet::getMemoryUsage() const {
+    size_t bytes = m_frames.capacity() * sizeof(ShapeReader) +
+                   m_mechFrames.capacity() * sizeof(MechShapeReader);
+    for (const auto& data : m_frameData) {
+        bytes += sizeof(data) + data.capacity();
+    }
+    return bytes;
+}
+
 // NestedPakReader implementation
 
 bool NestedPakReader::open(const std::string& path) {
@@ -208,4 +205,12 @@ const MechSpriteSet* NestedPakReader::getMech(uint32_t index) const {
     return &m_mechSprites[index];
 }
 
+size_t NestedPakReader::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& mech : m_mechSprites) {
+        bytes += sizeof(mech) + mech.getMemoryUsage();
+    }
+    return bytes;
+}
+
 } // namespace mcgng
@@ -68,6 +68,11 @@ public:
      */
     bool isLoaded() const { return !m_frames.empty() || !m_mechFrames.empty(); }
 
+    /**
+     * Get bytes held by decompressed frame data and parsed frames.
+     */
+    size_t getMemoryUsage() const;
+
 private:
     std::vector<std::vector<uint8_t>> m_frameData;   // Decompressed frame data
     std::vector<ShapeReader> m_frames;                // Parsed shape tables (standard format)
@@ -105,6 +110,11 @@ public:
      */
     const PakReader& getPak() const { return m_pak; }
 
+    /**
+     * Get bytes held by all loaded sprite sets.
+     */
+    size_t getMemoryUsage() const;
+
 private:
     PakReader m_pak;
     std::vector<MechSpriteSet> m_mechSprites;
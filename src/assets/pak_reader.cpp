@@ -1,6 +1,8 @@
 #include "assets/pak_reader.h"
 #include "assets/lz_decompress.h"
+#include "core/profiler.h"
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
@@ -198,6 +200,7 @@ std::vector<uint8_t> PakReader::readPacketRaw(size_t index) {
 }
 
 std::vector<uint8_t> PakReader::readPacket(size_t index) {
+    MCGNG_PROFILE_ZONE("PakReader::readPacket");
     const PakEntry* entry = getEntry(index);
     if (!entry) {
         return {};
@@ -211,30 +214,48 @@ std::vector<uint8_t> PakReader::readPacket(size_t index) {
         case PakStorageType::FWF:
             return readRawData(entry->offset, entry->packedSize);
 
-        case PakStorageType::LZD: {
-            // First read the uncompressed size from the data
-            auto sizeData = readRawData(entry->offset, sizeof(uint32_t));
-            if (sizeData.size() < 4) {
-                return {};
-            }
-            uint32_t storedSize;
-            std::memcpy(&storedSize, sizeData.data(), 4);
+        case PakStorageType::LZD:
+        case PakStorageType::ZLIB: {
+            auto rawData = readRawData(entry->offset, entry->packedSize);
+            return decodePacket(*entry, rawData.data(), rawData.size());
+        }
+
+        case PakStorageType::HF:
+            std::cerr << "PakReader: Huffman compression not supported for packet " << index << std::endl;
+            return {};
+
+        default:
+            std::cerr << "PakReader: Unknown storage type for packet " << index << std::endl;
+            return {};
+    }
+}
+
+std::vector<uint8_t> PakReader::decodePacket(const PakEntry& entry, const uint8_t* packed, size_t size) {
+    if (!packed || size == 0) {
+        return {};
+    }
+
+    switch (entry.storageType) {
+        case PakStorageType::RAW:
+        case PakStorageType::FWF:
+            return std::vector<uint8_t>(packed, packed + size);
 
-            // Read the compressed data
-            auto rawData = readRawData(entry->offset + sizeof(uint32_t),
-                                       entry->packedSize - sizeof(uint32_t));
-            if (rawData.empty()) {
+        case PakStorageType::LZD: {
+            // Skip the uncompressed size field (4 bytes) at the start
+            if (size <= sizeof(uint32_t)) {
                 return {};
             }
+            const uint8_t* data = packed + sizeof(uint32_t);
+            size_t length = size - sizeof(uint32_t);
 
             // Try decompression
-            auto result = decompress(rawData.data(), rawData.size(), entry->unpackedSize, false);
+            auto result = decompress(data, length, entry.unpackedSize, false);
 
             // If decompression returned much less than expected, maybe data isn't actually compressed
             // MCG might use different format markers - return raw data as fallback
-            if (result.size() < entry->unpackedSize / 2 && result.size() < rawData.size()) {
+            if (result.size() < entry.unpackedSize / 2 && result.size() < length) {
                 // Return raw data without the size prefix
-                return rawData;
+                return std::vector<uint8_t>(data, data + length);
             }
 
             return result;
@@ -242,20 +263,13 @@ std::vector<uint8_t> PakReader::readPacket(size_t index) {
 
         case PakStorageType::ZLIB: {
             // Skip the uncompressed size field (4 bytes) at the start
-            auto rawData = readRawData(entry->offset + sizeof(uint32_t),
-                                       entry->packedSize - sizeof(uint32_t));
-            if (rawData.empty()) {
+            if (size <= sizeof(uint32_t)) {
                 return {};
             }
-            return decompress(rawData.data(), rawData.size(), entry->unpackedSize, true);
+            return decompress(packed + sizeof(uint32_t), size - sizeof(uint32_t), entry.unpackedSize, true);
         }
 
-        case PakStorageType::HF:
-            std::cerr << "PakReader: Huffman compression not supported for packet " << index << std::endl;
-            return {};
-
         default:
-            std::cerr << "PakReader: Unknown storage type for packet " << index << std::endl;
             return {};
     }
 }
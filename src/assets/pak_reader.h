@@ -115,6 +115,16 @@ public:
      */
     std::vector<uint8_t> readPacketRaw(size_t index);
 
+    /**
+     * Decode a packet from its packed bytes already in memory (e.g. a mapping).
+     * NUL and Huffman packets decode to nothing.
+     * @param entry Packet entry
+     * @param packed Archive bytes starting at entry.offset
+     * @param size Number of packed bytes (entry.packedSize)
+     * @return Decompressed packet data, or empty vector on error
+     */
+    static std::vector<uint8_t> decodePacket(const PakEntry& entry, const uint8_t* packed, size_t size);
+
     /**
      * Get the storage type of a packet.
      */
@@ -0,0 +1,261 @@
+#include "assets/pak_scan.h"
+#include "assets/nested_pak_reader.h"
+#include "assets/shape_reader.h"
+#include "core/jobs.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+
+namespace fs = std::filesystem;
+
+namespace mcgng {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double microsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+bool hasPakExtension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".pak";
+}
+
+void growTo(PacketStats& stats, const ShapeData& shape) {
+    stats.width = std::max(stats.width, shape.width);
+    stats.height = std::max(stats.height, shape.height);
+}
+
+} // anonymous namespace
+
+const char* getStorageTypeName(PakStorageType type) {
+    switch (type) {
+        case PakStorageType::RAW: return "RAW";
+        case PakStorageType::FWF: return "FWF";
+        case PakStorageType::LZD: return "LZD";
+        case PakStorageType::HF: return "HF";
+        case PakStorageType::ZLIB: return "ZLIB";
+        case PakStorageType::NUL: return "NUL";
+    }
+    return "UNKNOWN";
+}
+
+const char* getPacketContentName(PacketContent content) {
+    switch (content) {
+        case PacketContent::Null: return "null";
+        case PacketContent::Data: return "data";
+        case PacketContent::ShapeTable: return "shapes";
+        case PacketContent::NestedPak: return "nested";
+        case PacketContent::Unreadable: return "unreadable";
+    }
+    return "unknown";
+}
+
+std::vector<std::string> findPakFiles(const std::string& path) {
+    std::vector<std::string> paks;
+    std::error_code ec;
+
+    if (fs::is_regular_file(path, ec)) {
+        paks.push_back(path);
+        return paks;
+    }
+
+    for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, ec), end;
+         it != end; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        if (it->is_regular_file(ec) && hasPakExtension(it->path())) {
+            paks.push_back(it->path().string());
+        }
+    }
+
+    std::sort(paks.begin(), paks.end());
+    return paks;
+}
+
+std::vector<PacketStats> scanPak(const std::string& path, bool decodeShapes) {
+    std::vector<PacketStats> results;
+
+    PakReader reader;
+    if (!reader.open(path)) {
+        return results;
+    }
+
+    results.reserve(reader.getNumPackets());
+    for (size_t i = 0; i < reader.getNumPackets(); ++i) {
+        const PakEntry* entry = reader.getEntry(i);
+        PacketStats stats;
+        stats.pak = path;
+        stats.index = static_cast<uint32_t>(i);
+        stats.storage = entry->storageType;
+        stats.packedSize = entry->packedSize;
+
+        if (entry->storageType == PakStorageType::NUL || entry->packedSize == 0) {
+            results.push_back(std::move(stats));
+            continue;
+        }
+
+        auto readStart = Clock::now();
+        std::vector<uint8_t> data = reader.readPacket(i);
+        stats.readMicros = microsSince(readStart);
+        stats.unpackedSize = static_cast<uint32_t>(data.size());
+
+        if (data.empty()) {
+            stats.content = PacketContent::Unreadable;
+            results.push_back(std::move(stats));
+            continue;
+        }
+
+        uint32_t magic = 0;
+        if (data.size() >= sizeof(magic)) {
+            std::memcpy(&magic, data.data(), sizeof(magic));
+        }
+
+        auto decodeStart = Clock::now();
+        if (magic == PakReader::PAK_MAGIC) {
+            stats.content = PacketContent::NestedPak;
+            MechSpriteSet set;
+            if (set.load(data.data(), data.size())) {
+                stats.shapeCount = set.getFrameCount() + set.getMechFrameCount();
+                if (decodeShapes) {
+                    for (uint32_t f = 0; f < set.getFrameCount(); ++f) {
+                        const ShapeReader* frame = set.getFrame(f);
+                        if (frame && frame->getShapeCount() > 0) {
+                            growTo(stats, frame->decodeShape(0));
+                        }
+                    }
+                    for (uint32_t f = 0; f < set.getMechFrameCount(); ++f) {
+                        growTo(stats, set.getMechFrame(f)->decode());
+                    }
+                }
+            }
+        } else {
+            ShapeReader shapes;
+            if (data.size() >= 8 && shapes.load(data.data(), data.size())) {
+                stats.content = PacketContent::ShapeTable;
+                stats.shapeCount = shapes.getShapeCount();
+                if (decodeShapes) {
+                    for (uint32_t s = 0; s < shapes.getShapeCount(); ++s) {
+                        growTo(stats, shapes.decodeShape(s));
+                    }
+                }
+            } else {
+                stats.content = PacketContent::Data;
+            }
+        }
+        if (decodeShapes && stats.shapeCount > 0) {
+            stats.decodeMicros = microsSince(decodeStart);
+        }
+
+        results.push_back(std::move(stats));
+    }
+
+    return results;
+}
+
+void startScanWorkers(size_t threads) {
+    // The caller runs jobs while it waits, so it counts as one of the threads
+    if (threads != 1) {
+        JobSystem::instance().initialize(threads > 1 ? threads - 1 : 0);
+    }
+}
+
+std::vector<PacketStats> scanPaks(const std::vector<std::string>& paths, bool decodeShapes) {
+    // Biggest PAKs first so a large one doesn't start last and run alone
+    std::vector<size_t> order(paths.size());
+    std::vector<uintmax_t> sizes(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::error_code ec;
+        order[i] = i;
+        sizes[i] = fs::file_size(paths[i], ec);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    std::vector<std::vector<PacketStats>> perPak(paths.size());
+    JobSystem::instance().parallelFor(0, order.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            perPak[order[i]] = scanPak(paths[order[i]], decodeShapes);
+        }
+    });
+
+    std::vector<PacketStats> results;
+    for (auto& stats : perPak) {
+        results.insert(results.end(), std::make_move_iterator(stats.begin()),
+                       std::make_move_iterator(stats.end()));
+    }
+    return results;
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+std::string escapeCsv(const std::string& str) {
+    if (str.find_first_of(",\"\n") == std::string::npos) {
+        return str;
+    }
+    std::string quoted = "\"";
+    for (char c : str) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+void writePacketStatsJson(std::ostream& out, const std::vector<PacketStats>& stats) {
+    out << "[\n";
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const PacketStats& s = stats[i];
+        out << "  {\"pak\": \"" << escapeJson(s.pak) << "\", \"index\": " << s.index
+            << ", \"storage\": \"" << getStorageTypeName(s.storage) << "\""
+            << ", \"packedSize\": " << s.packedSize << ", \"unpackedSize\": " << s.unpackedSize
+            << ", \"ratio\": " << s.getRatio()
+            << ", \"content\": \"" << getPacketContentName(s.content) << "\""
+            << ", \"shapes\": " << s.shapeCount << ", \"width\": " << s.width << ", \"height\": " << s.height
+            << ", \"readUs\": " << s.readMicros << ", \"decodeUs\": " << s.decodeMicros << "}"
+            << (i + 1 < stats.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+void writePacketStatsCsv(std::ostream& out, const std::vector<PacketStats>& stats) {
+    out << "pak,index,storage,packed_size,unpacked_size,ratio,content,shapes,width,height,read_us,decode_us\n";
+    for (const auto& s : stats) {
+        out << escapeCsv(s.pak) << ',' << s.index << ',' << getStorageTypeName(s.storage) << ','
+            << s.packedSize << ',' << s.unpackedSize << ',' << s.getRatio() << ','
+            << getPacketContentName(s.content) << ',' << s.shapeCount << ',' << s.width << ','
+            << s.height << ',' << s.readMicros << ',' << s.decodeMicros << '\n';
+    }
+}
+
+} // namespace mcgng
@@ -0,0 +1,106 @@
+#ifndef MCGNG_PAK_SCAN_H
+#define MCGNG_PAK_SCAN_H
+
+#include "assets/pak_reader.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * What a PAK packet turned out to contain.
+ */
+enum class PacketContent {
+    Null,           // NUL storage, no data
+    Data,           // Opaque bytes (tiles, sounds, ...)
+    ShapeTable,     // VFX shape table
+    NestedPak,      // Nested PAK (mech sprite set)
+    Unreadable      // Failed to read or decompress
+};
+
+/**
+ * Per-packet statistics gathered by scanPak().
+ */
+struct PacketStats {
+    std::string pak;                // PAK file path
+    uint32_t index = 0;
+    PakStorageType storage = PakStorageType::RAW;
+    uint32_t packedSize = 0;
+    uint32_t unpackedSize = 0;      // Bytes after decompression
+    PacketContent content = PacketContent::Null;
+    uint32_t shapeCount = 0;        // Shapes in a table, or frames in a nested PAK
+    int width = 0;                  // Largest decoded shape
+    int height = 0;
+    double readMicros = 0.0;        // Read + decompress
+    double decodeMicros = 0.0;      // Shape decode (all shapes / frames)
+
+    /**
+     * Compressed size as a fraction of the decompressed size.
+     */
+    double getRatio() const {
+        return unpackedSize > 0 ? static_cast<double>(packedSize) / unpackedSize : 1.0;
+    }
+};
+
+/**
+ * Get display name for a storage type.
+ */
+const char* getStorageTypeName(PakStorageType type);
+
+/**
+ * Get display name for packet content.
+ */
+const char* getPacketContentName(PacketContent content);
+
+/**
+ * Find PAK files (case-insensitive .pak extension).
+ * @param path A .pak file or a directory searched recursively
+ * @return Sorted list of PAK paths
+ */
+std::vector<std::string> findPakFiles(const std::string& path);
+
+/**
+ * Read every packet of a PAK and classify it.
+ * @param path Path to the .pak file
+ * @param decodeShapes Also decode shape tables / nested frames and time it
+ * @return One entry per packet (empty if the PAK can't be opened)
+ */
+std::vector<PacketStats> scanPak(const std::string& path, bool decodeShapes = true);
+
+/**
+ * Scan many PAKs in parallel on the JobSystem (one PAK per job).
+ * Each job opens its own reader; results keep the order of paths.
+ */
+std::vector<PacketStats> scanPaks(const std::vector<std::string>& paths, bool decodeShapes = true);
+
+/**
+ * Start the JobSystem for a batch tool.
+ * @param threads Threads including the caller (0 = hardware concurrency, 1 = no workers)
+ */
+void startScanWorkers(size_t threads);
+
+/**
+ * Write packet statistics as a JSON array.
+ */
+void writePacketStatsJson(std::ostream& out, const std::vector<PacketStats>& stats);
+
+/**
+ * Write packet statistics as CSV with a header row.
+ */
+void writePacketStatsCsv(std::ostream& out, const std::vector<PacketStats>& stats);
+
+/**
+ * Escape a string for a JSON string literal.
+ */
+std::string escapeJson(const std::string& str);
+
+/**
+ * Quote a CSV field if it contains separators or quotes.
+ */
+std::string escapeCsv(const std::string& str);
+
+} // namespace mcgng
+
+#endif // MCGNG_PAK_SCAN_H
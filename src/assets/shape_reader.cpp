@@ -1,12 +1,8 @@
 #include "assets/shape_reader.h"
 #include "assets/pak_reader.h"
+#include "core/log.h"
 #include <cstring>
-#include <iostream>
-#include <iomanip>
-#include <set>
-#include <map>
 #include <algorithm>
-#include <fstream>
 
 namespace mcgng {
 
@@ -52,7 +48,7 @@ bool ShapeReader::load(const uint8_t* data, size_t size) {
     size_t tableStart = m_headerOffset + 8;  // version(4) + count(4)
     size_t tableSize = tableStart + m_shapeCount * 8;
     if (size < tableSize) {
-        std::cerr << "ShapeReader: File too small for offset table" << std::endl;
+        MCGNG_LOG_ERROR(Assets, "ShapeReader: File too small for offset table");
         return false;
     }
 
@@ -126,8 +122,7 @@ ShapeData ShapeReader::decodeShape(uint32_t index) const {
 
     if (result.width <= 0 || result.height <= 0 ||
         result.width > 1024 || result.height > 1024) {
-        std::cerr << "ShapeReader: Invalid shape dimensions: "
-                  << result.width << "x" << result.height << std::endl;
+        MCGNG_LOG_WARN(Assets, "ShapeReader: Invalid shape dimensions: {}x{}", result.width, result.height);
         return ShapeData{};
     }
 
@@ -150,7 +145,7 @@ ShapeData ShapeReader::decodeShape(uint32_t index) const {
 
     // Decode RLE
     if (!decodeRLE(rleData, rleSize, result.pixels.data(), result.width, result.height)) {
-        std::cerr << "ShapeReader: Failed to decode RLE for shape " << index << std::endl;
+        MCGNG_LOG_WARN(Assets, "ShapeReader: Failed to decode RLE for shape {}", index);
         // Return partial result anyway
     }
 
@@ -167,16 +162,8 @@ bool ShapeReader::decodeRLE(const uint8_t* src, size_t srcSize,
      * Marker byte with bit 0 = 1: String packet - copy (marker >> 1) literal bytes
      */
 
-    // Debug: dump first 20 bytes of RLE data
-    static int debugCount = 0;
-    if (debugCount++ < 2) {
-        std::cout << "ShapeReader RLE (" << width << "x" << height << "): ";
-        for (size_t i = 0; i < std::min(srcSize, size_t(20)); ++i) {
-            std::cout << std::hex << std::setw(2) << std::setfill('0')
-                      << static_cast<int>(src[i]) << " ";
-        }
-        std::cout << std::dec << std::endl;
-    }
+    MCGNG_LOG_TRACE(Assets, "ShapeReader RLE ({}x{}): {}", width, height,
+                    LogHex{src, std::min(srcSize, size_t(20))});
 
     size_t srcPos = 0;
     int x = 0;
@@ -240,10 +227,7 @@ bool MechShapeReader::load(const uint8_t* data, size_t size) {
     // Bytes 4-5: Padding or height
     // Byte 6: Padding (00)
     // Bytes 7-10: Version "1.10"
-    // Bytes 11+: Shape table (count + offsets + shape data)
-    //
-    // Key insight: "Delete the first 6 bytes" makes it a standard SHP
-    // But the version starts at byte 7, so there's 7 bytes of header
+    // Bytes 11+: Optional row table, then the VFX RLE stream
 
     // Check for version "1.10" at offset 7
     if (size > 11 && data[7] == '1' && data[8] == '.' && data[9] == '1' && data[10] == '0') {
@@ -268,636 +252,143 @@ bool MechShapeReader::load(const uint8_t* data, size_t size) {
     m_size = size;
     m_width = width;
     m_height = height;
-    m_loaded = true;
-
-    return true;
-}
 
-ShapeData MechShapeReader::decode() const {
-    ShapeData result;
-
-    if (!m_loaded || !m_data) {
-        std::cerr << "MechShapeReader::decode() - not loaded" << std::endl;
-        return result;
+    if (!buildRowTable(findStreamStart())) {
+        m_data = nullptr;
+        m_size = 0;
+        return false;
     }
 
-    // MCG mech sprite format analysis:
-    // Bytes 0-1: Format ID (0x0100)
-    // Bytes 2-3: Width (big-endian)
-    // Bytes 4-5: Height (big-endian)
-    // Byte 6: Padding (0x00)
-    // Bytes 7-10: Version "1.10"
-    // Bytes 11+: Pixel data (format TBD)
-    //
-    // The data starting at byte 11 does NOT follow standard VFX RLE format.
-    // Run counts like 0xD8=108 pixels in a 26-wide row indicate different encoding.
-
-    result.width = m_width;
-    result.height = m_height;
-    result.hotspotX = m_width / 2;
-    result.hotspotY = m_height / 2;
-    result.pixels.resize(result.width * result.height, 0);
-
-    // Debug: save raw binary data and analyze
-    static int hexDumpCount = 0;
-    if (hexDumpCount++ < 1) {
-        std::cout << "MechShapeReader: Raw data (" << m_size << " bytes)" << std::endl;
-
-        // Save raw binary for external analysis
-        {
-            std::ofstream bin("mech_sprite_raw.bin", std::ios::binary);
-            bin.write(reinterpret_cast<const char*>(m_data), m_size);
-            std::cout << "  Saved: mech_sprite_raw.bin" << std::endl;
-        }
+    m_loaded = true;
+    return true;
+}
 
-        // Print first 80 bytes in hex for analysis
-        std::cout << "  First 80 bytes:" << std::endl << "  ";
-        for (size_t i = 0; i < std::min(m_size, size_t(80)); ++i) {
-            std::cout << std::hex << std::setw(2) << std::setfill('0')
-                      << static_cast<int>(m_data[i]) << " ";
-            if ((i + 1) % 20 == 0) std::cout << std::endl << "  ";
-        }
-        std::cout << std::dec << std::endl;
-    }
-
-    // Analyze the data structure - look for row table pattern "NN 02 00 XX"
-    // Find where row entries start
-    size_t tableStart = 0;
-    for (size_t i = 11; i + 4 < m_size; ++i) {
-        // Look for sequential row numbers with 0x02 0x00 pattern
-        if (m_data[i+1] == 0x02 && m_data[i+2] == 0x00 &&
-            i + 8 < m_size &&
-            m_data[i+4] == m_data[i] + 1 &&  // Next row number
-            m_data[i+5] == 0x02 && m_data[i+6] == 0x00) {
-            tableStart = i;
+size_t MechShapeReader::findStreamStart() const {
+    constexpr size_t ENTRY_SIZE = 4;
+    const size_t headerSize = m_headerOffset + 4;   // Prefix + "1.10"
+
+    // Row table: consecutive {row, 0x02, 0x00, offsetFromEnd} entries with
+    // increasing row numbers. Without one the stream follows the header.
+    size_t pos = headerSize;
+    int lastRow = -1;
+    size_t furthest = 0;
+    while (pos + ENTRY_SIZE <= m_size) {
+        int row = m_data[pos];
+        if (row <= lastRow || row >= m_height || m_data[pos + 1] != 0x02 || m_data[pos + 2] != 0x00) {
             break;
         }
+        furthest = std::max<size_t>(furthest, m_data[pos + 3]);
+        lastRow = row;
+        pos += ENTRY_SIZE;
     }
 
-    // Scan table region for row entries with pattern "NN 02 00 XX"
-    std::vector<std::pair<int, uint16_t>> rowEntries;  // (rowNum, 16-bit offset)
-    std::set<int> foundRows;
-
-    // Limit search to table region
-    size_t tableEndEstimate = std::min(m_size, size_t(11 + m_height * 6));
-
-    for (size_t pos = 11; pos + 4 < tableEndEstimate; ++pos) {
-        uint8_t rowNum = m_data[pos];
-        // Check for pattern: row_num, 0x02, 0x00, offset_lo, offset_hi (sometimes just offset_lo)
-        if (rowNum < m_height && m_data[pos+1] == 0x02 && m_data[pos+2] == 0x00) {
-            // Use 16-bit little-endian offset from bytes 3-4, but fall back to 8-bit if out of range
-            uint16_t offset = m_data[pos+3];
-            if (pos + 4 < m_size) {
-                uint16_t offset16 = m_data[pos+3] | (m_data[pos+4] << 8);
-                // If 16-bit offset is reasonable (less than file size), use it
-                if (offset16 < m_size) {
-                    offset = offset16;
-                }
-            }
-
-            // Only add if we haven't seen this row yet
-            if (foundRows.find(rowNum) == foundRows.end()) {
-                // Validate: skip entries that look like false positives
-                bool isValidEntry = true;
-                if (!rowEntries.empty()) {
-                    int lastRowNum = rowEntries.back().first;
-                    // If we jump backwards by more than 3 rows, likely a false positive
-                    if (rowNum < lastRowNum && lastRowNum - rowNum > 3) {
-                        isValidEntry = false;
-                    }
-                }
-
-                if (isValidEntry) {
-                    rowEntries.push_back({rowNum, offset});
-                    foundRows.insert(rowNum);
-                }
-            }
-        }
-    }
-
-    // Debug: output row count
-    static int mechDebugCount = 0;
-    if (mechDebugCount++ < 1) {
-        std::cout << "MechShapeReader: Found " << rowEntries.size() << " row entries" << std::endl;
+    if (lastRow < 0 || furthest == 0 || furthest > m_size - pos) {
+        return headerSize;
     }
+    return m_size - furthest;
+}
 
-    // Data starts at byte 11 (after 7-byte prefix + 4-byte version)
-    size_t dataOffset = 11;
-    if (dataOffset >= m_size) {
-        return result;
+bool MechShapeReader::buildRowTable(size_t streamStart) {
+    m_rowOffsets.clear();
+    if (streamStart >= m_size) {
+        return false;
     }
+    m_rowOffsets.reserve(m_height);
 
-    const uint8_t* pixelData = m_data + dataOffset;
-    size_t dataSize = m_size - dataOffset;
-
-    // Try multiple decoding strategies and pick the one that produces best results
-
-    // Strategy 0: Use row offset table for simple raw bytes decode
-    // The offsets point into the data section - just read pixels directly
-    // Format appears to be: each row's data starts at offset, read until end marker
-    {
-        std::cout << "MechShapeReader: Analyzing row offset table..." << std::endl;
-
-        // Build row offset map from the table we found
-        std::map<int, size_t> rowOffsets;  // row -> file offset
-
-        // Scan for row entries with pattern "NN 02 00 XX"
-        for (size_t pos = 11; pos + 4 < m_size && pos < 200; ++pos) {
-            uint8_t rowNum = m_data[pos];
-            if (rowNum < m_height && m_data[pos+1] == 0x02 && m_data[pos+2] == 0x00) {
-                uint8_t offsetFromEnd = m_data[pos+3];
-                if (offsetFromEnd > 0 && offsetFromEnd < 250) {
-                    size_t fileOffset = m_size - offsetFromEnd;
-                    if (fileOffset > 100 && fileOffset < m_size && rowOffsets.find(rowNum) == rowOffsets.end()) {
-                        rowOffsets[rowNum] = fileOffset;
-                    }
-                }
-            }
-        }
-
-        std::cout << "  Found " << rowOffsets.size() << " row offsets" << std::endl;
-
-        // Sort offsets to find data regions
-        std::vector<std::pair<size_t, int>> sortedOffsets;
-        for (auto& entry : rowOffsets) {
-            sortedOffsets.push_back({entry.second, entry.first});
-        }
-        std::sort(sortedOffsets.begin(), sortedOffsets.end());
-
-        // The rows overlap in the file, suggesting RLE compression
-        // Try different RLE approaches starting from earliest offset
-        if (!sortedOffsets.empty()) {
-            size_t dataStart = sortedOffsets.front().first;
-            std::cout << "  Data region starts at offset " << dataStart << std::endl;
-
-            // Try simple VFX RLE from data start
-            std::vector<uint8_t> rlePixels(m_width * m_height, 0);
-            const uint8_t* rle = m_data + dataStart;
-            size_t rleSize = m_size - dataStart;
-            size_t srcPos = 0;
-            int x = 0, y = 0;
-
-            while (y < m_height && srcPos < rleSize) {
-                uint8_t marker = rle[srcPos++];
-
-                if (marker == 0) {
-                    x = 0; y++;
-                } else if (marker == 1) {
-                    if (srcPos >= rleSize) break;
-                    x += rle[srcPos++];
-                } else if ((marker & 1) == 0) {
-                    if (srcPos >= rleSize) break;
-                    uint8_t color = rle[srcPos++];
-                    int count = marker >> 1;
-                    for (int i = 0; i < count && x < m_width; ++i) {
-                        if (y < m_height) rlePixels[y * m_width + x++] = color;
-                    }
-                } else {
-                    int count = marker >> 1;
-                    for (int i = 0; i < count && srcPos < rleSize && x < m_width; ++i) {
-                        if (y < m_height) rlePixels[y * m_width + x++] = rle[srcPos++];
-                    }
-                }
-            }
-
-            int nonZero = 0;
-            for (uint8_t p : rlePixels) if (p != 0) nonZero++;
-
-            std::cout << "  VFX RLE from " << dataStart << ": " << nonZero << "/" << rlePixels.size()
-                      << " pixels, " << y << " rows" << std::endl;
-
-            if (nonZero > m_width * m_height / 4 && y >= m_height / 2) {
-                result.pixels = std::move(rlePixels);
-                static int rleSaveCount = 0;
-                if (rleSaveCount++ < 1) {
-                    std::string filename = "mech_vfxrle_" + std::to_string(m_width) + "x" + std::to_string(m_height) + ".pgm";
-                    std::ofstream pgm(filename, std::ios::binary);
-                    if (pgm.is_open()) {
-                        pgm << "P5\n" << m_width << " " << m_height << "\n255\n";
-                        pgm.write(reinterpret_cast<const char*>(result.pixels.data()), result.pixels.size());
-                        std::cout << "  Saved: " << filename << std::endl;
-                    }
-                }
-                std::cout << "MechShapeReader: Using VFX RLE from data region" << std::endl;
-                return result;
+    // Walk packet headers only; a row ends at a 0 marker
+    size_t pos = streamStart;
+    m_rowOffsets.push_back(static_cast<uint32_t>(pos));
+    while (pos < m_size && static_cast<int>(m_rowOffsets.size()) <= m_height) {
+        uint8_t marker = m_data[pos++];
+        if (marker == 0) {
+            if (static_cast<int>(m_rowOffsets.size()) == m_height) {
+                break;
             }
+            m_rowOffsets.push_back(static_cast<uint32_t>(pos));
+        } else if (marker == 1 || (marker & 1) == 0) {
+            pos += 1;                   // Skip count or run colour
+        } else {
+            pos += marker >> 1;         // String bytes
         }
     }
 
-    // Strategy 1: Scan all offsets for best VFX RLE decode
-    {
-        std::cout << "MechShapeReader: Scanning for VFX RLE start..." << std::endl;
-
-        int bestNonZero = 0;
-        size_t bestOffset = 0;
-        std::vector<uint8_t> bestPixels;
-        int bestScore = 0;  // Score based on distribution
-
-        // Focus on likely data region (after header/table, before end)
-        for (size_t rleStart = 100; rleStart < m_size - 100; rleStart += 1) {
-            std::vector<uint8_t> vfxPixels(m_width * m_height, 0);
-            const uint8_t* rle = m_data + rleStart;
-            size_t rleSize = m_size - rleStart;
-            size_t srcPos = 0;
-            int x = 0, y = 0;
-            bool valid = true;
-
-            while (y < m_height && srcPos < rleSize && valid) {
-                uint8_t marker = rle[srcPos++];
-
-                if (marker == 0) {
-                    x = 0;
-                    y++;
-                } else if (marker == 1) {
-                    if (srcPos >= rleSize) { valid = false; break; }
-                    int skip = rle[srcPos++];
-                    if (skip > m_width) { valid = false; break; }
-                    x += skip;
-                } else if ((marker & 1) == 0) {
-                    if (srcPos >= rleSize) { valid = false; break; }
-                    uint8_t color = rle[srcPos++];
-                    int count = marker >> 1;
-                    if (x + count > m_width + 5) { valid = false; break; }
-                    for (int i = 0; i < count && x < m_width; ++i) {
-                        if (y < m_height) vfxPixels[y * m_width + x++] = color;
-                    }
-                } else {
-                    int count = marker >> 1;
-                    if (x + count > m_width + 5) { valid = false; break; }
-                    for (int i = 0; i < count && srcPos < rleSize && x < m_width; ++i) {
-                        if (y < m_height) vfxPixels[y * m_width + x++] = rle[srcPos++];
-                    }
-                }
-            }
-
-            if (!valid || y < m_height / 2) continue;
-
-            int nonZero = 0;
-            for (uint8_t p : vfxPixels) if (p != 0) nonZero++;
-
-            // Look for diamond-like distribution (more in middle rows)
-            int topQuarter = 0, midHalf = 0, bottomQuarter = 0;
-            for (int row = 0; row < m_height / 4; ++row)
-                for (int col = 0; col < m_width; ++col)
-                    if (vfxPixels[row * m_width + col] != 0) topQuarter++;
-            for (int row = m_height / 4; row < 3 * m_height / 4; ++row)
-                for (int col = 0; col < m_width; ++col)
-                    if (vfxPixels[row * m_width + col] != 0) midHalf++;
-            for (int row = 3 * m_height / 4; row < m_height; ++row)
-                for (int col = 0; col < m_width; ++col)
-                    if (vfxPixels[row * m_width + col] != 0) bottomQuarter++;
-
-            // Diamond shape: middle should have most pixels
-            bool diamondLike = midHalf > topQuarter && midHalf > bottomQuarter;
-
-            if (nonZero > bestNonZero && diamondLike && nonZero > m_width * m_height / 5) {
-                bestNonZero = nonZero;
-                bestOffset = rleStart;
-                bestPixels = std::move(vfxPixels);
-            }
-        }
-
-        if (bestNonZero > 0) {
-            std::cout << "  Best offset " << bestOffset << ": " << bestNonZero << "/" << (m_width * m_height) << std::endl;
-            result.pixels = std::move(bestPixels);
-
-            static int scanSaveCount = 0;
-            if (scanSaveCount++ < 1) {
-                std::string filename = "mech_scan_" + std::to_string(m_width) + "x" + std::to_string(m_height) + ".pgm";
-                std::ofstream pgm(filename, std::ios::binary);
-                if (pgm.is_open()) {
-                    pgm << "P5\n" << m_width << " " << m_height << "\n255\n";
-                    pgm.write(reinterpret_cast<const char*>(result.pixels.data()), result.pixels.size());
-                    std::cout << "  Saved: " << filename << std::endl;
-                }
-            }
-
-            std::cout << "MechShapeReader: Using scan result from offset " << bestOffset << std::endl;
-            return result;
-        }
+    // A stream that runs off the end keeps the rows that started inside it
+    while (!m_rowOffsets.empty() && m_rowOffsets.back() >= m_size) {
+        m_rowOffsets.pop_back();
     }
+    return !m_rowOffsets.empty();
+}
 
-    // Strategy 1: Raw pixels from end of file
-    if (m_size >= 676) {
-        size_t pixelStart = m_size - 676;
-        std::vector<uint8_t> rawPixels(m_width * m_height, 0);
-        std::memcpy(rawPixels.data(), m_data + pixelStart, m_width * m_height);
-
-        int nonZero = 0;
-        for (uint8_t p : rawPixels) if (p != 0) nonZero++;
-
-        std::cout << "MechShapeReader: Raw from end: " << nonZero << "/" << rawPixels.size() << std::endl;
-
-        if (nonZero > 100) {
-            result.pixels = std::move(rawPixels);
-            return result;
-        }
+bool MechShapeReader::decodeRow(int row, uint8_t* dest, int destWidth) const {
+    if (!m_loaded || row < 0 || row >= static_cast<int>(m_rowOffsets.size())) {
+        return false;
     }
 
-    std::cout << "MechShapeReader: Checking for embedded shape table..." << std::endl;
-
-    // Strategy 0b: MCG-specific format with skip-run pairs
-    // Looking at pattern: 00 1a 1a 00 d8 1a 00 d8 1a 1a 00 b9...
-    // Hypothesis: pairs of (skip_count, literal_count) then literal pixels
-    // 00 1a = skip 0, then 26 literals
-    // After 26 literals, next pair...
-    std::cout << "MechShapeReader: Trying skip-literal pairs..." << std::endl;
-    {
-        std::vector<uint8_t> pairPixels(m_width * m_height, 0);
-        size_t srcPos = 0;
-        int pixelIndex = 0;  // Linear pixel index
-        int totalPixels = m_width * m_height;
-
-        while (srcPos + 1 < dataSize && pixelIndex < totalPixels) {
-            uint8_t skipCount = pixelData[srcPos++];
-            uint8_t literalCount = pixelData[srcPos++];
-
-            // Skip transparent pixels (advance pixel index)
-            pixelIndex += skipCount;
-            if (pixelIndex >= totalPixels) break;
-
-            // Read literal pixels
-            for (int i = 0; i < literalCount && srcPos < dataSize && pixelIndex < totalPixels; ++i) {
-                pairPixels[pixelIndex] = pixelData[srcPos];
-                pixelIndex++;
-                srcPos++;
-            }
-        }
-
-        // Calculate y position for debug
-        int y = pixelIndex / m_width;
-
-        int nonZero = 0;
-        for (uint8_t p : pairPixels) if (p != 0) nonZero++;
-
-        std::cout << "  Skip-literal pairs: " << nonZero << "/" << pairPixels.size()
-                  << " non-zero, processed to pixel " << pixelIndex << "/" << totalPixels << std::endl;
-
-        // If this gives reasonable coverage
-        if (nonZero > m_width * m_height / 3) {
-            result.pixels = std::move(pairPixels);
-            std::cout << "MechShapeReader: Using skip-literal pairs" << std::endl;
-
-            // Debug: show row distribution
-            std::cout << "  Row counts: ";
-            for (int row = 0; row < std::min(m_height, 8); ++row) {
-                int cnt = 0;
-                for (int col = 0; col < m_width; ++col) {
-                    if (result.pixels[row * m_width + col] != 0) cnt++;
-                }
-                std::cout << cnt << " ";
-            }
-            std::cout << "..." << std::endl;
-
-            // Debug: show first 8 pixels of a few rows
-            std::cout << "  Row 0: ";
-            for (int col = 0; col < std::min(m_width, 8); ++col) {
-                std::cout << std::hex << std::setw(2) << std::setfill('0')
-                          << static_cast<int>(result.pixels[col]) << " ";
-            }
-            std::cout << std::dec << std::endl;
-            if (m_height > 1) {
-                std::cout << "  Row 1: ";
-                for (int col = 0; col < std::min(m_width, 8); ++col) {
-                    std::cout << std::hex << std::setw(2) << std::setfill('0')
-                              << static_cast<int>(result.pixels[m_width + col]) << " ";
-                }
-                std::cout << std::dec << std::endl;
-            }
+    int width = std::min(m_width, destWidth);
+    const uint8_t* src = m_data + m_rowOffsets[row];
+    const uint8_t* end = m_data + m_size;
+    int x = 0;
 
-            return result;
+    while (src < end) {
+        uint8_t marker = *src++;
+        if (marker == 0) {
+            break;
         }
-    }
-
-    // Strategy 0c: Row-based RLE with (skip, run) packets per row
-    // Each row: skip_count, then RLE packets until end-of-row marker
-    std::cout << "MechShapeReader: Trying row-based skip-run..." << std::endl;
-    {
-        std::vector<uint8_t> rowSkipPixels(m_width * m_height, 0);
-        size_t srcPos = 0;
-
-        for (int y = 0; y < m_height && srcPos < dataSize; ++y) {
-            int x = 0;
 
-            // Process packets until row is full or we hit a 0-length marker
-            while (x < m_width && srcPos < dataSize) {
-                uint8_t marker = pixelData[srcPos++];
-
-                if (marker == 0) {
-                    // End of row or skip to end
-                    break;
-                }
-
-                // Check if high bit set (RLE run vs literal)
-                if (marker >= 128) {
-                    // RLE: repeat next byte (256-marker) or (marker-128) times
-                    if (srcPos >= dataSize) break;
-                    uint8_t value = pixelData[srcPos++];
-                    int count = marker - 128;  // Could also try 256 - marker
-                    for (int i = 0; i < count && x < m_width; ++i) {
-                        rowSkipPixels[y * m_width + x++] = value;
-                    }
-                } else {
-                    // Literal: copy marker bytes
-                    for (int i = 0; i < marker && srcPos < dataSize && x < m_width; ++i) {
-                        rowSkipPixels[y * m_width + x++] = pixelData[srcPos++];
-                    }
-                }
+        if (marker == 1) {
+            if (src >= end) {
+                break;
             }
+            x += *src++;
+            continue;
         }
 
-        int nonZero = 0;
-        for (uint8_t p : rowSkipPixels) if (p != 0) nonZero++;
-
-        std::cout << "  Row-based skip-run: " << nonZero << "/" << rowSkipPixels.size()
-                  << " non-zero" << std::endl;
-
-        if (nonZero > m_width * m_height / 3) {
-            result.pixels = std::move(rowSkipPixels);
-            std::cout << "MechShapeReader: Using row-based skip-run" << std::endl;
-
-            // Debug: show row distribution
-            std::cout << "  Row counts: ";
-            for (int row = 0; row < std::min(m_height, 10); ++row) {
-                int cnt = 0;
-                for (int col = 0; col < m_width; ++col) {
-                    if (result.pixels[row * m_width + col] != 0) cnt++;
-                }
-                std::cout << cnt << " ";
+        int count = marker >> 1;
+        int visible = std::max(0, std::min(count, width - x));
+        if ((marker & 1) == 0) {
+            // Run packet
+            if (src >= end) {
+                break;
             }
-            std::cout << "..." << std::endl;
-
-            // Save decoded sprite as PGM (grayscale) for visual inspection
-            static int saveCount = 0;
-            if (saveCount++ < 1) {
-                std::string filename = "mech_debug_" + std::to_string(m_width) + "x" + std::to_string(m_height) + ".pgm";
-                std::ofstream pgm(filename, std::ios::binary);
-                if (pgm.is_open()) {
-                    pgm << "P5\n" << m_width << " " << m_height << "\n255\n";
-                    pgm.write(reinterpret_cast<const char*>(result.pixels.data()), result.pixels.size());
-                    std::cout << "  Saved debug image: " << filename << std::endl;
-                }
+            if (visible > 0) {
+                std::memset(dest + x, *src, visible);
             }
-
-            return result;
-        }
-    }
-
-    // Strategy 1: Uncompressed indexed pixels (most straightforward)
-    // If dataSize >= width*height, could be direct pixel data
-    if (dataSize >= static_cast<size_t>(m_width * m_height)) {
-        std::cout << "MechShapeReader: Trying uncompressed pixels..." << std::endl;
-        std::vector<uint8_t> uncompPixels(m_width * m_height);
-        std::memcpy(uncompPixels.data(), pixelData, m_width * m_height);
-
-        int nonZero = 0;
-        for (uint8_t p : uncompPixels) if (p != 0) nonZero++;
-
-        // Check if this looks like valid pixel data (should have varied values)
-        std::set<uint8_t> uniqueValues(uncompPixels.begin(), uncompPixels.end());
-        std::cout << "  Uncompressed: " << nonZero << " non-zero, "
-                  << uniqueValues.size() << " unique values" << std::endl;
-
-        // Don't use uncompressed if row-prefix looks better
-        // (This is fallback only)
-    }
-
-    // Strategy 2: MCG-specific RLE (different from VFX standard)
-    // Format hypothesis: Each row starts fresh, counts are limited to row width
-    // 0 = end of row
-    // 1-127 = copy N literal bytes
-    // 128-255 = repeat next byte (256-N) times
-    std::cout << "MechShapeReader: Trying MCG RLE format..." << std::endl;
-    {
-        std::vector<uint8_t> rlePixels(m_width * m_height, 0);
-        size_t srcPos = 0;
-        int x = 0;
-        int y = 0;
-
-        while (srcPos < dataSize && y < m_height) {
-            uint8_t marker = pixelData[srcPos++];
-
-            if (marker == 0) {
-                // End of row
-                x = 0;
-                y++;
-                continue;
-            }
-
-            if (marker < 128) {
-                // Copy N literal bytes
-                int count = marker;
-                for (int i = 0; i < count && srcPos < dataSize && x < m_width; ++i) {
-                    rlePixels[y * m_width + x] = pixelData[srcPos++];
-                    x++;
-                }
-            } else {
-                // Run-length: repeat next byte (256 - marker) times
-                // Or could be (marker - 128) times - try both
-                if (srcPos >= dataSize) break;
-                uint8_t value = pixelData[srcPos++];
-                int count = 256 - marker;  // e.g., 0xD8 (216) -> 40 pixels
-
-                for (int i = 0; i < count && x < m_width; ++i) {
-                    rlePixels[y * m_width + x] = value;
-                    x++;
-                }
+            ++src;
+        } else {
+            // String packet
+            int available = static_cast<int>(std::min<ptrdiff_t>(count, end - src));
+            visible = std::min(visible, available);
+            if (visible > 0) {
+                std::memcpy(dest + x, src, visible);
             }
+            src += available;
         }
-
-        int nonZero = 0;
-        for (uint8_t p : rlePixels) if (p != 0) nonZero++;
-
-        std::cout << "  MCG RLE (256-N): " << nonZero << "/" << rlePixels.size()
-                  << " non-zero pixels" << std::endl;
-
-        // If this gives reasonable results, use it
-        if (nonZero > m_width * m_height / 4) {
-            result.pixels = std::move(rlePixels);
-            return result;
-        }
+        x += count;
     }
 
-    // Strategy 3: Standard VFX RLE (original attempt)
-    std::cout << "MechShapeReader: Trying standard VFX RLE..." << std::endl;
-    {
-        std::vector<uint8_t> vfxPixels(m_width * m_height, 0);
-        size_t srcPos = 0;
-        int x = 0;
-        int y = 0;
-
-        while (srcPos < dataSize && y < m_height) {
-            uint8_t marker = pixelData[srcPos++];
-
-            if (marker == 0) {
-                x = 0;
-                y++;
-                continue;
-            }
-
-            if (marker == 1) {
-                if (srcPos >= dataSize) break;
-                uint8_t count = pixelData[srcPos++];
-                x += count;
-                continue;
-            }
-
-            uint8_t count = marker >> 1;
-
-            if (marker & 1) {
-                // String packet
-                for (int i = 0; i < count && srcPos < dataSize; ++i) {
-                    if (x < m_width && y < m_height) {
-                        vfxPixels[y * m_width + x] = pixelData[srcPos];
-                    }
-                    x++;
-                    srcPos++;
-                }
-            } else {
-                // Run packet
-                if (srcPos >= dataSize) break;
-                uint8_t value = pixelData[srcPos++];
-                for (int i = 0; i < count; ++i) {
-                    if (x < m_width && y < m_height) {
-                        vfxPixels[y * m_width + x] = value;
-                    }
-                    x++;
-                }
-            }
-        }
-
-        int nonZero = 0;
-        for (uint8_t p : vfxPixels) if (p != 0) nonZero++;
-        std::cout << "  VFX RLE: " << nonZero << "/" << vfxPixels.size() << " non-zero" << std::endl;
+    return true;
+}
 
-        result.pixels = std::move(vfxPixels);
+void MechShapeReader::decodeTo(uint8_t* dest, size_t pitch) const {
+    for (int row = 0; row < static_cast<int>(m_rowOffsets.size()); ++row) {
+        decodeRow(row, dest + row * pitch, m_width);
     }
+}
 
-    // Debug: show pixel distribution per row
-    std::cout << "MechShapeReader: Row pixel counts: ";
-    for (int y = 0; y < std::min(m_height, 10); ++y) {
-        int count = 0;
-        for (int x = 0; x < m_width; ++x) {
-            if (result.pixels[y * m_width + x] != 0) count++;
-        }
-        std::cout << count << " ";
-    }
-    std::cout << "..." << std::endl;
+ShapeData MechShapeReader::decode() const {
+    ShapeData result;
 
-    // Check if image might need vertical flip (common issue)
-    int topHalfNonZero = 0, bottomHalfNonZero = 0;
-    for (int y = 0; y < m_height / 2; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (result.pixels[y * m_width + x] != 0) topHalfNonZero++;
-        }
-    }
-    for (int y = m_height / 2; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (result.pixels[y * m_width + x] != 0) bottomHalfNonZero++;
-        }
+    if (!m_loaded || !m_data) {
+        MCGNG_LOG_ERROR(Assets, "MechShapeReader::decode() - not loaded");
+        return result;
     }
-    std::cout << "MechShapeReader: Top half: " << topHalfNonZero
-              << ", Bottom half: " << bottomHalfNonZero << std::endl;
+
+    result.width = m_width;
+    result.height = m_height;
+    result.hotspotX = m_width / 2;
+    result.hotspotY = m_height / 2;
+    result.pixels.assign(static_cast<size_t>(m_width) * m_height, 0);
+    decodeTo(result.pixels.data(), static_cast<size_t>(m_width));
 
     return result;
 }
@@ -907,13 +398,13 @@ ShapeData MechShapeReader::decode() const {
 bool ShapePackReader::loadFromPak(const std::string& pakPath) {
     PakReader pak;
     if (!pak.open(pakPath)) {
-        std::cerr << "ShapePackReader: Failed to open PAK: " << pakPath << std::endl;
+        MCGNG_LOG_ERROR(Assets, "ShapePackReader: Failed to open PAK: {}", pakPath);
         return false;
     }
 
     size_t packetCount = pak.getNumPackets();
     if (packetCount == 0) {
-        std::cerr << "ShapePackReader: No packets in PAK" << std::endl;
+        MCGNG_LOG_ERROR(Assets, "ShapePackReader: No packets in PAK");
         return false;
     }
 
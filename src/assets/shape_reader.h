@@ -115,11 +115,21 @@ private:
 /**
  * Mech Shape Reader - simplified format for mech sprites.
  *
- * MCG mech sprites have a 6-byte prefix before standard SHP format:
+ * MCG mech sprites have a short prefix before the shape data:
  *   Bytes 0-1:  Format ID (0x0100)
  *   Bytes 2-3:  Width (big-endian)
  *   Bytes 4-5:  Height (big-endian)
- *   Byte 6+:    Standard shape data or version string
+ *   Byte 6:     Padding
+ *   Bytes 7-10: Version "1.10" (some frames start it at byte 6)
+ *   Then:       Optional row table, then a VFX RLE stream
+ *
+ * The optional row table is a run of 4-byte entries
+ * {row, 0x02, 0x00, offsetFromEnd} with increasing row numbers; the RLE
+ * stream starts at the entry furthest from the end of the frame.
+ *
+ * load() parses the header and walks the RLE stream once to record where
+ * each row starts (the row table cache), so rows can then be decoded
+ * independently and straight into a destination surface.
  *
  * According to thegameengine.org: "Delete the first 6 bytes" for standard editors
  */
@@ -128,7 +138,8 @@ public:
     MechShapeReader() = default;
 
     /**
-     * Load mech shape from memory.
+     * Load mech shape from memory and build its row table.
+     * The data must outlive the reader.
      * @param data Pointer to shape data
      * @param size Size of data in bytes
      * @return true on success
@@ -146,12 +157,38 @@ public:
     int getWidth() const { return m_width; }
     int getHeight() const { return m_height; }
 
+    /**
+     * Get number of rows present in the RLE stream (rows past it are transparent).
+     */
+    int getEncodedRows() const { return static_cast<int>(m_rowOffsets.size()); }
+
+    /**
+     * Decode one row.
+     * Transparent pixels are left untouched so rows can be composited.
+     * @param row Row index (0 = top)
+     * @param dest Destination pixels
+     * @param destWidth Pixels available in dest; the row is clipped to it
+     * @return true if the row exists
+     */
+    bool decodeRow(int row, uint8_t* dest, int destWidth) const;
+
+    /**
+     * Decode every row into a surface.
+     * Transparent pixels are left untouched.
+     * @param dest Top-left pixel of the destination
+     * @param pitch Bytes between destination rows
+     */
+    void decodeTo(uint8_t* dest, size_t pitch) const;
+
     /**
      * Decode the shape to pixel data.
      */
     ShapeData decode() const;
 
 private:
+    size_t findStreamStart() const;
+    bool buildRowTable(size_t streamStart);
+
     const uint8_t* m_data = nullptr;
     size_t m_size = 0;
     bool m_loaded = false;
@@ -159,6 +196,7 @@ private:
     int m_height = 0;
     size_t m_headerOffset = 6;  // Offset to shape data (after 6-byte prefix)
     std::string m_version;
+    std::vector<uint32_t> m_rowOffsets;     // Start of each row in the RLE stream
 };
 
 /**
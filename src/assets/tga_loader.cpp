@@ -1,5 +1,6 @@
 #include "assets/tga_loader.h"
-#include <fstream>
+#include "assets/mapped_file.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -36,23 +37,149 @@ enum TgaImageType {
     TGA_GRAYSCALE_RLE = 11
 };
 
-TgaImage TgaLoader::loadFromFile(const std::string& path) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file) {
-        std::cerr << "TgaLoader: Failed to open file: " << path << "\n";
-        return TgaImage{};
+namespace {
+
+// RGBA pixel as stored in TgaImage::pixels (little-endian byte order)
+inline uint32_t packRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) |
+           (static_cast<uint32_t>(b) << 16) | (static_cast<uint32_t>(a) << 24);
+}
+
+// Source pixel formats, one decode loop each
+struct Indexed8 {               // Color-mapped or 8-bit grayscale, via lookup table
+    static constexpr int BYTES = 1;
+    static uint32_t read(const uint8_t* src, const uint32_t* lut) { return lut[src[0]]; }
+};
+
+struct GrayAlpha16 {
+    static constexpr int BYTES = 2;
+    static uint32_t read(const uint8_t* src, const uint32_t*) {
+        return packRGBA(src[0], src[0], src[0], src[1]);
+    }
+};
+
+struct Bgr15 {                  // ARRRRRGG GGGBBBBB
+    static constexpr int BYTES = 2;
+    static uint32_t read(const uint8_t* src, const uint32_t*) {
+        uint16_t pixel = static_cast<uint16_t>(src[0] | (src[1] << 8));
+        return packRGBA(static_cast<uint8_t>(((pixel >> 10) & 0x1F) << 3),
+                        static_cast<uint8_t>(((pixel >> 5) & 0x1F) << 3),
+                        static_cast<uint8_t>((pixel & 0x1F) << 3),
+                        (pixel & 0x8000) ? 255 : 0);
+    }
+};
+
+struct Bgr24 {
+    static constexpr int BYTES = 3;
+    static uint32_t read(const uint8_t* src, const uint32_t*) {
+        return packRGBA(src[2], src[1], src[0], 255);
+    }
+};
+
+struct Bgra32 {
+    static constexpr int BYTES = 4;
+    static uint32_t read(const uint8_t* src, const uint32_t*) {
+        return packRGBA(src[2], src[1], src[0], src[3]);
+    }
+};
+
+template<typename Format>
+inline void convertSpan(const uint8_t* src, uint32_t* dst, int count, const uint32_t* lut) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = Format::read(src + i * Format::BYTES, lut);
+    }
+}
+
+/**
+ * Decode pixel data into top-down RGBA rows. Bottom-up images are written
+ * straight to their flipped rows; RLE packets may span rows. Truncated
+ * data leaves the remaining pixels zero, like the original per-pixel loop.
+ */
+template<typename Format>
+void decodePixels(const uint8_t* data, size_t size, bool rle, bool topOrigin,
+                  int width, int height, const uint32_t* lut, uint32_t* out) {
+    auto rowStart = [&](int y) {
+        return out + static_cast<size_t>(topOrigin ? y : height - 1 - y) * width;
+    };
+
+    if (!rle) {
+        size_t rowBytes = static_cast<size_t>(width) * Format::BYTES;
+        for (int y = 0; y < height; ++y) {
+            size_t offset = static_cast<size_t>(y) * rowBytes;
+            if (offset + rowBytes > size) {
+                int partial = offset < size ? static_cast<int>((size - offset) / Format::BYTES) : 0;
+                convertSpan<Format>(data + offset, rowStart(y), partial, lut);
+                return;
+            }
+            convertSpan<Format>(data + offset, rowStart(y), width, lut);
+        }
+        return;
+    }
+
+    int x = 0;
+    int y = 0;
+    uint32_t* row = rowStart(0);
+    size_t pos = 0;
+    while (y < height && pos < size) {
+        uint8_t packet = data[pos++];
+        int count = (packet & 0x7F) + 1;
+
+        if (packet & 0x80) {
+            // Run packet: one pixel repeated, filled span by span
+            if (pos + Format::BYTES > size) {
+                return;
+            }
+            uint32_t value = Format::read(data + pos, lut);
+            pos += Format::BYTES;
+            while (count > 0) {
+                int span = std::min(count, width - x);
+                std::fill_n(row + x, span, value);
+                x += span;
+                count -= span;
+                if (x == width) {
+                    x = 0;
+                    if (++y == height) {
+                        return;
+                    }
+                    row = rowStart(y);
+                }
+            }
+        } else {
+            // Raw packet: convert as many pixels as the data holds
+            int available = static_cast<int>((size - pos) / Format::BYTES);
+            bool truncated = count > available;
+            count = std::min(count, available);
+            while (count > 0) {
+                int span = std::min(count, width - x);
+                convertSpan<Format>(data + pos, row + x, span, lut);
+                pos += static_cast<size_t>(span) * Format::BYTES;
+                x += span;
+                count -= span;
+                if (x == width) {
+                    x = 0;
+                    if (++y == height) {
+                        return;
+                    }
+                    row = rowStart(y);
+                }
+            }
+            if (truncated) {
+                return;
+            }
+        }
     }
+}
 
-    size_t size = static_cast<size_t>(file.tellg());
-    file.seekg(0, std::ios::beg);
+} // anonymous namespace
 
-    std::vector<uint8_t> data(size);
-    if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
-        std::cerr << "TgaLoader: Failed to read file: " << path << "\n";
+TgaImage TgaLoader::loadFromFile(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "TgaLoader: Failed to open file: " << path << "\n";
         return TgaImage{};
     }
 
-    return loadFromMemory(data.data(), data.size());
+    return loadFromMemory(file.data(), file.size());
 }
 
 TgaImage TgaLoader::loadFromMemory(const uint8_t* data, size_t size) {
@@ -80,24 +207,22 @@ TgaImage TgaLoader::loadFromMemory(const uint8_t* data, size_t size) {
     // Calculate data offset
     size_t dataOffset = sizeof(TgaHeader) + header.idLength;
 
-    // Read color map if present
-    std::vector<uint8_t> colorMap;
+    // Color map, if present, is skipped for non-mapped images
+    const uint8_t* colorMap = nullptr;
+    size_t colorMapSize = 0;
     if (header.colorMapType == 1 && header.colorMapLength > 0) {
-        size_t colorMapSize = header.colorMapLength * (header.colorMapDepth / 8);
+        colorMapSize = static_cast<size_t>(header.colorMapLength) * (header.colorMapDepth / 8);
         if (dataOffset + colorMapSize > size) {
             std::cerr << "TgaLoader: Color map extends past end of data\n";
             return TgaImage{};
         }
-        colorMap.resize(colorMapSize);
-        std::memcpy(colorMap.data(), data + dataOffset, colorMapSize);
+        colorMap = data + dataOffset;
         dataOffset += colorMapSize;
     }
-
-    // Allocate RGBA output buffer
-    result.pixels.resize(result.width * result.height * 4);
-
-    const uint8_t* pixelData = data + dataOffset;
-    size_t pixelDataSize = size - dataOffset;
+    if (dataOffset > size) {
+        std::cerr << "TgaLoader: Image ID extends past end of data\n";
+        return TgaImage{};
+    }
 
     bool isRLE = (header.imageType == TGA_COLORMAPPED_RLE ||
                   header.imageType == TGA_TRUECOLOR_RLE ||
@@ -109,96 +234,59 @@ TgaImage TgaLoader::loadFromMemory(const uint8_t* data, size_t size) {
     bool isGrayscale = (header.imageType == TGA_GRAYSCALE ||
                         header.imageType == TGA_GRAYSCALE_RLE);
 
-    int bytesPerPixel = header.pixelDepth / 8;
-    int totalPixels = result.width * result.height;
+    bool isTrueColor = (header.imageType == TGA_TRUECOLOR ||
+                        header.imageType == TGA_TRUECOLOR_RLE);
 
-    // Decode pixels
-    size_t srcPos = 0;
-    int pixelIndex = 0;
-
-    while (pixelIndex < totalPixels && srcPos < pixelDataSize) {
-        int count = 1;
-        bool isRunPacket = false;
-
-        if (isRLE) {
-            uint8_t packetHeader = pixelData[srcPos++];
-            isRunPacket = (packetHeader & 0x80) != 0;
-            count = (packetHeader & 0x7F) + 1;
-        }
+    int bytesPerPixel = header.pixelDepth / 8;
+    if ((!isColorMapped && !isGrayscale && !isTrueColor) ||
+        (isTrueColor && (bytesPerPixel < 2 || bytesPerPixel > 4))) {
+        std::cerr << "TgaLoader: Unsupported image type " << static_cast<int>(header.imageType)
+                  << " (" << static_cast<int>(header.pixelDepth) << " bpp)\n";
+        return TgaImage{};
+    }
 
-        for (int i = 0; i < count && pixelIndex < totalPixels; ++i) {
-            uint8_t r = 0, g = 0, b = 0, a = 255;
-
-            // Read pixel value (only once for run packets)
-            if (!isRLE || !isRunPacket || i == 0) {
-                if (srcPos >= pixelDataSize) break;
-
-                if (isColorMapped) {
-                    // Color-mapped: pixel is index into color map
-                    uint8_t index = pixelData[srcPos++];
-                    int cmBpp = header.colorMapDepth / 8;
-                    int cmIndex = (index - header.colorMapOrigin) * cmBpp;
-
-                    if (cmIndex >= 0 && cmIndex + cmBpp <= static_cast<int>(colorMap.size())) {
-                        if (cmBpp >= 3) {
-                            b = colorMap[cmIndex];
-                            g = colorMap[cmIndex + 1];
-                            r = colorMap[cmIndex + 2];
-                            if (cmBpp >= 4) a = colorMap[cmIndex + 3];
-                        }
-                    }
-                } else if (isGrayscale) {
-                    // Grayscale
-                    uint8_t gray = pixelData[srcPos++];
-                    r = g = b = gray;
-                    if (bytesPerPixel >= 2) {
-                        a = pixelData[srcPos++];
-                    }
-                } else {
-                    // True color (BGR or BGRA)
-                    if (bytesPerPixel >= 3 && srcPos + 2 < pixelDataSize) {
-                        b = pixelData[srcPos++];
-                        g = pixelData[srcPos++];
-                        r = pixelData[srcPos++];
-                    }
-                    if (bytesPerPixel >= 4 && srcPos < pixelDataSize) {
-                        a = pixelData[srcPos++];
-                    }
-                    if (bytesPerPixel == 2 && srcPos + 1 < pixelDataSize) {
-                        // 16-bit (ARRRRRGG GGGBBBBB or similar)
-                        uint16_t pixel = pixelData[srcPos] | (pixelData[srcPos + 1] << 8);
-                        srcPos += 2;
-                        b = (pixel & 0x1F) << 3;
-                        g = ((pixel >> 5) & 0x1F) << 3;
-                        r = ((pixel >> 10) & 0x1F) << 3;
-                        a = (pixel & 0x8000) ? 255 : 0;
-                    }
-                }
+    // 8-bit indices (color map or gray level) go through a lookup table
+    uint32_t lut[256];
+    if (isColorMapped) {
+        int cmBpp = header.colorMapDepth / 8;
+        for (int index = 0; index < 256; ++index) {
+            lut[index] = packRGBA(0, 0, 0, 255);
+            int cmIndex = (index - header.colorMapOrigin) * cmBpp;
+            if (cmBpp >= 3 && cmIndex >= 0 && static_cast<size_t>(cmIndex + cmBpp) <= colorMapSize) {
+                const uint8_t* entry = colorMap + cmIndex;
+                lut[index] = packRGBA(entry[2], entry[1], entry[0], cmBpp >= 4 ? entry[3] : 255);
             }
-
-            // Write RGBA pixel
-            int outIndex = pixelIndex * 4;
-            result.pixels[outIndex + 0] = r;
-            result.pixels[outIndex + 1] = g;
-            result.pixels[outIndex + 2] = b;
-            result.pixels[outIndex + 3] = a;
-            pixelIndex++;
+        }
+    } else if (isGrayscale) {
+        for (int gray = 0; gray < 256; ++gray) {
+            uint8_t value = static_cast<uint8_t>(gray);
+            lut[gray] = packRGBA(value, value, value, 255);
         }
     }
 
-    // Handle origin (TGA can be top-left or bottom-left origin)
+    // Allocate RGBA output buffer
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+    const uint8_t* pixelData = data + dataOffset;
+    size_t pixelDataSize = size - dataOffset;
     bool topOrigin = (header.imageDescriptor & 0x20) != 0;
-    if (!topOrigin) {
-        // Flip vertically (TGA is bottom-to-top by default)
-        int rowSize = result.width * 4;
-        std::vector<uint8_t> tempRow(rowSize);
-        for (int y = 0; y < result.height / 2; ++y) {
-            int topRow = y * rowSize;
-            int bottomRow = (result.height - 1 - y) * rowSize;
-            std::memcpy(tempRow.data(), &result.pixels[topRow], rowSize);
-            std::memcpy(&result.pixels[topRow], &result.pixels[bottomRow], rowSize);
-            std::memcpy(&result.pixels[bottomRow], tempRow.data(), rowSize);
-        }
+    uint32_t* out = reinterpret_cast<uint32_t*>(result.pixels.data());
+
+    auto decode = [&](auto format) {
+        decodePixels<decltype(format)>(pixelData, pixelDataSize, isRLE, topOrigin,
+                                       result.width, result.height, lut, out);
+    };
+
+    if (isColorMapped || (isGrayscale && bytesPerPixel < 2)) {
+        decode(Indexed8());
+    } else if (isGrayscale) {
+        decode(GrayAlpha16());
+    } else if (bytesPerPixel == 2) {
+        decode(Bgr15());
+    } else if (bytesPerPixel == 3) {
+        decode(Bgr24());
+    } else {
+        decode(Bgra32());
     }
 
     return result;
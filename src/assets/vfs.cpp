@@ -0,0 +1,416 @@
+#include "assets/vfs.h"
+#include "assets/fit_parser.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+namespace mcgng {
+
+Vfs& Vfs::instance() {
+    static Vfs instance;
+    return instance;
+}
+
+std::string Vfs::normalizePath(const std::string& path) {
+    std::string normalized;
+    normalized.reserve(path.size());
+
+    for (char c : path) {
+        if (c == '\\') {
+            c = '/';
+        }
+        if (c == '/' && (normalized.empty() || normalized.back() == '/')) {
+            continue;   // Leading or duplicate separator
+        }
+        normalized += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    if (!normalized.empty() && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+namespace {
+
+std::string joinVirtual(const std::string& mountPoint, const std::string& path) {
+    std::string prefix = Vfs::normalizePath(mountPoint);
+    std::string name = Vfs::normalizePath(path);
+    if (prefix.empty()) {
+        return name;
+    }
+    return name.empty() ? prefix : prefix + "/" + name;
+}
+
+} // anonymous namespace
+
+bool Vfs::mountDirectory(const std::string& path, const std::string& mountPoint, int priority) {
+    std::error_code ec;
+    if (!fs::is_directory(path, ec)) {
+        std::cerr << "Vfs: Not a directory: " << path << std::endl;
+        return false;
+    }
+
+    auto mount = std::make_unique<Mount>();
+    mount->info.source = path;
+    mount->info.mountPoint = normalizePath(mountPoint);
+    mount->info.type = VfsSourceType::Directory;
+    mount->info.priority = priority;
+
+    for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, ec), end;
+         it != end; it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+        std::string relative = fs::relative(it->path(), path, ec).generic_string();
+        mount->files.push_back(it->path().string());
+        mount->virtualPaths.push_back(joinVirtual(mountPoint, relative));
+    }
+
+    return addMount(std::move(mount));
+}
+
+bool Vfs::mountFst(const std::string& path, const std::string& mountPoint, int priority) {
+    FstReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+
+    auto mount = std::make_unique<Mount>();
+    mount->archive = std::make_shared<MappedFile>();
+    if (!mount->archive->open(path)) {
+        return false;
+    }
+
+    mount->info.source = path;
+    mount->info.mountPoint = normalizePath(mountPoint);
+    mount->info.type = VfsSourceType::Fst;
+    mount->info.priority = priority;
+    mount->fstEntries = reader.getEntries();
+    for (const auto& entry : mount->fstEntries) {
+        mount->virtualPaths.push_back(joinVirtual(mountPoint, entry.filePath));
+    }
+
+    return addMount(std::move(mount));
+}
+
+bool Vfs::mountPak(const std::string& path, const std::string& mountPoint, int priority) {
+    PakReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+
+    auto mount = std::make_unique<Mount>();
+    mount->archive = std::make_shared<MappedFile>();
+    if (!mount->archive->open(path)) {
+        return false;
+    }
+
+    mount->info.source = path;
+    mount->info.mountPoint = normalizePath(mountPoint);
+    mount->info.type = VfsSourceType::Pak;
+    mount->info.priority = priority;
+    mount->pakEntries = reader.getEntries();
+    for (size_t i = 0; i < mount->pakEntries.size(); ++i) {
+        mount->virtualPaths.push_back(joinVirtual(mountPoint, std::to_string(i)));
+    }
+
+    return addMount(std::move(mount));
+}
+
+bool Vfs::mountBaked(std::shared_ptr<const BakedPack> pack, int priority) {
+    if (!pack || !pack->isOpen()) {
+        return false;
+    }
+
+    auto mount = std::make_unique<Mount>();
+    mount->info.source = pack->getPath();
+    mount->info.type = VfsSourceType::Baked;
+    mount->info.priority = priority;
+
+    const BakedEntry* entries = pack->getEntries();
+    for (size_t i = 0; i < pack->getEntryCount(); ++i) {
+        if (entries[i].type == BakedEntryType::Raw) {
+            mount->bakedEntries.push_back(&entries[i]);
+            mount->virtualPaths.push_back(pack->getName(entries[i]));
+        }
+    }
+    mount->pack = std::move(pack);
+
+    return addMount(std::move(mount));
+}
+
+bool Vfs::addMount(std::unique_ptr<Mount> mount) {
+    MCGNG_PROFILE_ZONE("Vfs::mount");
+    mount->info.fileCount = mount->virtualPaths.size();
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_mounts.push_back(std::move(mount));
+    indexMount(static_cast<uint32_t>(m_mounts.size() - 1));
+
+    const VfsMountInfo& info = m_mounts.back()->info;
+    MCGNG_LOG_INFO(Assets, "Vfs: Mounted {} ({} files, priority {})", info.source, info.fileCount,
+                   info.priority);
+    return true;
+}
+
+void Vfs::indexMount(uint32_t mountIndex) {
+    const Mount& mount = *m_mounts[mountIndex];
+    m_index.reserve(m_index.size() + mount.virtualPaths.size());
+
+    for (uint32_t i = 0; i < mount.virtualPaths.size(); ++i) {
+        auto result = m_index.try_emplace(mount.virtualPaths[i], IndexEntry{mountIndex, i});
+        if (!result.second) {
+            // Equal priority: the later mount wins
+            const Mount& existing = *m_mounts[result.first->second.mount];
+            if (mount.info.priority >= existing.info.priority) {
+                result.first->second = IndexEntry{mountIndex, i};
+            }
+        }
+    }
+}
+
+bool Vfs::unmount(const std::string& source) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto it = std::find_if(m_mounts.begin(), m_mounts.end(),
+                           [&source](const auto& mount) { return mount->info.source == source; });
+    if (it == m_mounts.end()) {
+        return false;
+    }
+
+    m_mounts.erase(it);
+    m_index.clear();
+    for (uint32_t i = 0; i < m_mounts.size(); ++i) {
+        indexMount(i);
+    }
+    return true;
+}
+
+void Vfs::unmountAll() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_index.clear();
+    m_mounts.clear();
+}
+
+const Vfs::IndexEntry* Vfs::lookup(const std::string& path) const {
+    auto it = m_index.find(normalizePath(path));
+    return it != m_index.end() ? &it->second : nullptr;
+}
+
+bool Vfs::exists(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return lookup(path) != nullptr;
+}
+
+VfsView Vfs::read(const std::string& path) const {
+    MCGNG_PROFILE_ZONE("Vfs::read");
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const IndexEntry* entry = lookup(path);
+    if (!entry) {
+        return {};
+    }
+    return readEntry(*m_mounts[entry->mount], entry->entry);
+}
+
+bool Vfs::readFit(const std::string& path, FitParser& parser) const {
+    MCGNG_PROFILE_ZONE("Vfs::readFit");
+    VfsView text;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        const IndexEntry* entry = lookup(path);
+
+        // Same override rules as the index: higher priority, then later mount
+        for (uint32_t i = static_cast<uint32_t>(m_mounts.size()); i-- > 0;) {
+            const Mount& mount = *m_mounts[i];
+            if (mount.info.type != VfsSourceType::Baked) {
+                continue;
+            }
+            if (entry) {
+                int textPriority = m_mounts[entry->mount]->info.priority;
+                if (mount.info.priority < textPriority ||
+                    (mount.info.priority == textPriority && i < entry->mount)) {
+                    continue;
+                }
+            }
+            if (mount.pack->getFit(path, parser)) {
+                return true;
+            }
+        }
+
+        if (!entry) {
+            return false;
+        }
+        text = readEntry(*m_mounts[entry->mount], entry->entry);
+    }
+    return text && parser.parseBuffer(text.data(), text.size());
+}
+
+VfsView Vfs::readEntry(const Mount& mount, uint32_t index) const {
+    // Failures return a fresh (invalid) view
+    VfsView view;
+    view.m_valid = true;
+
+    switch (mount.info.type) {
+        case VfsSourceType::Directory: {
+            auto file = std::make_shared<MappedFile>();
+            if (!file->open(mount.files[index])) {
+                return {};
+            }
+            view.m_data = file->data();
+            view.m_size = file->size();
+            view.m_zeroCopy = true;
+            view.m_owner = std::move(file);
+            return view;
+        }
+
+        case VfsSourceType::Fst: {
+            const FstEntry& entry = mount.fstEntries[index];
+            const MappedFile& archive = *mount.archive;
+            if (entry.dataOffset >= archive.size()) {
+                return {};
+            }
+            const uint8_t* raw = archive.data() + entry.dataOffset;
+            size_t available = archive.size() - entry.dataOffset;
+
+            if (!entry.isCompressed() && entry.uncompressedSize <= available) {
+                view.m_data = raw;
+                view.m_size = entry.uncompressedSize;
+                view.m_zeroCopy = true;
+                view.m_owner = mount.archive;
+                return view;
+            }
+
+            auto decoded = std::make_shared<std::vector<uint8_t>>(
+                FstReader::decodeEntry(entry, raw, available));
+            if (decoded->empty()) {
+                return {};
+            }
+            view.m_data = decoded->data();
+            view.m_size = decoded->size();
+            view.m_owner = std::move(decoded);
+            return view;
+        }
+
+        case VfsSourceType::Pak: {
+            const PakEntry& entry = mount.pakEntries[index];
+            const MappedFile& archive = *mount.archive;
+            if (entry.storageType == PakStorageType::NUL || entry.packedSize == 0 ||
+                static_cast<size_t>(entry.offset) + entry.packedSize > archive.size()) {
+                return {};
+            }
+            const uint8_t* packed = archive.data() + entry.offset;
+
+            if (entry.storageType == PakStorageType::RAW || entry.storageType == PakStorageType::FWF) {
+                view.m_data = packed;
+                view.m_size = entry.packedSize;
+                view.m_zeroCopy = true;
+                view.m_owner = mount.archive;
+                return view;
+            }
+
+            auto decoded = std::make_shared<std::vector<uint8_t>>(
+                PakReader::decodePacket(entry, packed, entry.packedSize));
+            if (decoded->empty()) {
+                return {};
+            }
+            view.m_data = decoded->data();
+            view.m_size = decoded->size();
+            view.m_owner = std::move(decoded);
+            return view;
+        }
+
+        case VfsSourceType::Baked: {
+            const BakedEntry& entry = *mount.bakedEntries[index];
+            view.m_data = mount.pack->getData(entry);
+            view.m_size = entry.dataSize;
+            view.m_zeroCopy = true;
+            view.m_owner = mount.pack;
+            return view;
+        }
+    }
+
+    return {};
+}
+
+size_t Vfs::getFileSize(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const IndexEntry* entry = lookup(path);
+    if (!entry) {
+        return 0;
+    }
+
+    const Mount& mount = *m_mounts[entry->mount];
+    switch (mount.info.type) {
+        case VfsSourceType::Directory: {
+            std::error_code ec;
+            auto size = fs::file_size(mount.files[entry->entry], ec);
+            return ec ? 0 : static_cast<size_t>(size);
+        }
+        case VfsSourceType::Fst:
+            return mount.fstEntries[entry->entry].uncompressedSize;
+        case VfsSourceType::Pak:
+            return mount.pakEntries[entry->entry].unpackedSize;
+        case VfsSourceType::Baked:
+            return mount.bakedEntries[entry->entry]->dataSize;
+    }
+    return 0;
+}
+
+std::string Vfs::getSource(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const IndexEntry* entry = lookup(path);
+    return entry ? m_mounts[entry->mount]->info.source : std::string();
+}
+
+std::string Vfs::resolveDiskPath(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const IndexEntry* entry = lookup(path);
+    if (!entry) {
+        return {};
+    }
+    const Mount& mount = *m_mounts[entry->mount];
+    return mount.info.type == VfsSourceType::Directory ? mount.files[entry->entry] : std::string();
+}
+
+std::vector<std::string> Vfs::list(const std::string& prefix) const {
+    std::string normalized = normalizePath(prefix);
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::vector<std::string> paths;
+    for (const auto& pair : m_index) {
+        if (pair.first.compare(0, normalized.size(), normalized) == 0) {
+            paths.push_back(pair.first);
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::vector<VfsMountInfo> Vfs::getMounts() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::vector<VfsMountInfo> mounts;
+    mounts.reserve(m_mounts.size());
+    for (const auto& mount : m_mounts) {
+        mounts.push_back(mount->info);
+    }
+    return mounts;
+}
+
+size_t Vfs::getFileCount() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_index.size();
+}
+
+} // namespace mcgng
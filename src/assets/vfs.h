@@ -0,0 +1,232 @@
+#ifndef MCGNG_VFS_H
+#define MCGNG_VFS_H
+
+#include "assets/baked_pack.h"
+#include "assets/fst_reader.h"
+#include "assets/mapped_file.h"
+#include "assets/pak_reader.h"
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Where a mounted source comes from.
+ */
+enum class VfsSourceType {
+    Directory,  // Loose files on disk
+    Fst,        // FST archive
+    Pak,        // PAK archive (packets named by index)
+    Baked       // Baked pack from mcg-bake (raw entries)
+};
+
+/**
+ * Mounted source description.
+ */
+struct VfsMountInfo {
+    std::string source;         // Disk path of the directory or archive
+    std::string mountPoint;     // Virtual prefix ("" = root)
+    VfsSourceType type = VfsSourceType::Directory;
+    int priority = 0;           // Higher wins when paths collide
+    size_t fileCount = 0;       // Files contributed at mount time
+};
+
+/**
+ * Read-only view of a file's contents.
+ *
+ * Uncompressed archive entries and loose files point straight into a
+ * memory mapping (zero-copy); compressed entries own a decoded buffer.
+ * Either way the view keeps its backing memory alive.
+ */
+class VfsView {
+public:
+    VfsView() = default;
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * Check if the file was found and read (an empty file is still valid).
+     */
+    bool isValid() const { return m_valid; }
+    explicit operator bool() const { return m_valid; }
+
+    /**
+     * Check if the view points into a mapping rather than a decoded copy.
+     */
+    bool isZeroCopy() const { return m_zeroCopy; }
+
+    /**
+     * Copy the contents into a vector.
+     */
+    std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(m_data, m_data + m_size); }
+
+private:
+    friend class Vfs;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_zeroCopy = false;
+    bool m_valid = false;
+    std::shared_ptr<const void> m_owner;
+};
+
+/**
+ * Virtual file system over directories, FST/PAK archives and baked packs.
+ *
+ * Every mount adds its files to one hashed path index, so a lookup is a
+ * single probe however many sources are mounted. Paths are
+ * case-insensitive and accept either slash. When two sources provide the
+ * same path the higher priority wins, and on a tie the later mount wins;
+ * a mod directory mounted at high priority therefore overrides game
+ * archives without code changes.
+ *
+ * PAK packets have no names, so a PAK mounted at "sprites/torsos" exposes
+ * "sprites/torsos/0", "sprites/torsos/1", ...
+ *
+ * Lookups and reads are thread-safe and may run concurrently; mounting
+ * takes an exclusive lock.
+ */
+class Vfs {
+public:
+    static Vfs& instance();
+
+    /**
+     * Mount a directory tree of loose files.
+     * @param path Directory on disk
+     * @param mountPoint Virtual prefix for its files ("" = root)
+     * @param priority Override priority
+     * @return true on success
+     */
+    bool mountDirectory(const std::string& path, const std::string& mountPoint = "", int priority = 0);
+
+    /**
+     * Mount an FST archive.
+     */
+    bool mountFst(const std::string& path, const std::string& mountPoint = "", int priority = 0);
+
+    /**
+     * Mount a PAK archive; packets appear as <mountPoint>/<index>.
+     */
+    bool mountPak(const std::string& path, const std::string& mountPoint, int priority = 0);
+
+    /**
+     * Mount the raw entries of an open baked pack.
+     * Binary FIT, shapes, palettes and mech frames keep their original
+     * paths free (readers of the text or PAK form would misparse them);
+     * they are used through readFit() or the pack itself.
+     */
+    bool mountBaked(std::shared_ptr<const BakedPack> pack, int priority = 0);
+
+    /**
+     * Unmount a source and rebuild the index from the remaining mounts.
+     * @param source Path the source was mounted from
+     * @return true if it was mounted
+     */
+    bool unmount(const std::string& source);
+
+    /**
+     * Unmount everything.
+     */
+    void unmountAll();
+
+    /**
+     * Check if a file exists.
+     */
+    bool exists(const std::string& path) const;
+
+    /**
+     * Read a file.
+     * @return View of the contents, or an empty view if missing or unreadable
+     */
+    VfsView read(const std::string& path) const;
+
+    /**
+     * Parse a FIT file, preferring the binary form from a mounted baked
+     * pack unless a source of higher priority (e.g. a mod) overrides the
+     * text file.
+     * @return true if found and parsed
+     */
+    bool readFit(const std::string& path, FitParser& parser) const;
+
+    /**
+     * Get a file's (uncompressed) size without reading it.
+     * @return Size in bytes, or 0 if missing
+     */
+    size_t getFileSize(const std::string& path) const;
+
+    /**
+     * Get the source (directory or archive path) that serves a file.
+     * @return Source path, or empty if missing
+     */
+    std::string getSource(const std::string& path) const;
+
+    /**
+     * Get the on-disk path of a file served from a mounted directory.
+     * Useful for loaders that still take a path.
+     * @return Disk path, or empty if missing or inside an archive
+     */
+    std::string resolveDiskPath(const std::string& path) const;
+
+    /**
+     * List indexed paths starting with a prefix (normalized form).
+     */
+    std::vector<std::string> list(const std::string& prefix = "") const;
+
+    /**
+     * Get mounted sources in mount order.
+     */
+    std::vector<VfsMountInfo> getMounts() const;
+
+    /**
+     * Get number of distinct paths in the index.
+     */
+    size_t getFileCount() const;
+
+    /**
+     * Normalize a virtual path: lowercase, forward slashes, no leading
+     * "./" or "/", no duplicate separators.
+     */
+    static std::string normalizePath(const std::string& path);
+
+private:
+    Vfs() = default;
+    ~Vfs() = default;
+
+    Vfs(const Vfs&) = delete;
+    Vfs& operator=(const Vfs&) = delete;
+
+    struct Mount {
+        VfsMountInfo info;
+        std::shared_ptr<MappedFile> archive;            // Fst / Pak
+        std::shared_ptr<const BakedPack> pack;          // Baked
+        std::vector<FstEntry> fstEntries;
+        std::vector<PakEntry> pakEntries;
+        std::vector<const BakedEntry*> bakedEntries;
+        std::vector<std::string> files;                 // Directory: disk paths
+        std::vector<std::string> virtualPaths;          // Parallel to entries/files
+    };
+
+    struct IndexEntry {
+        uint32_t mount = 0;     // Index into m_mounts
+        uint32_t entry = 0;     // Index into the mount's entry list
+    };
+
+    bool addMount(std::unique_ptr<Mount> mount);
+    void indexMount(uint32_t mountIndex);   // Caller holds the exclusive lock
+    const IndexEntry* lookup(const std::string& path) const;
+    VfsView readEntry(const Mount& mount, uint32_t entry) const;
+
+    mutable std::shared_mutex m_mutex;
+    std::vector<std::unique_ptr<Mount>> m_mounts;
+    std::unordered_map<std::string, IndexEntry> m_index;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_VFS_H
@@ -0,0 +1,251 @@
+#include "core/asset_cache.h"
+#include "assets/nested_pak_reader.h"
+#include "assets/tga_loader.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace mcgng {
+
+const char* getAssetCategoryName(AssetCategory category) {
+    switch (category) {
+        case AssetCategory::Archive: return "Archive";
+        case AssetCategory::Image:   return "Image";
+        case AssetCategory::Sprite:  return "Sprite";
+        case AssetCategory::Audio:   return "Audio";
+        case AssetCategory::Misc:    return "Misc";
+        default:                     return "Unknown";
+    }
+}
+
+size_t assetCpuBytes(const std::vector<uint8_t>& data) {
+    return sizeof(data) + data.capacity();
+}
+
+size_t assetCpuBytes(const TgaImage& image) {
+    return sizeof(image) + image.pixels.capacity();
+}
+
+size_t assetCpuBytes(const NestedPakReader& reader) {
+    return sizeof(reader) + reader.getMemoryUsage();
+}
+
+AssetCache& AssetCache::instance() {
+    static AssetCache instance;
+    return instance;
+}
+
+AssetCache::AssetCache() {
+    // Defaults sized for a full campaign; tune with setBudget()
+    constexpr size_t MB = 1024 * 1024;
+    stateFor(AssetCategory::Archive).budget = {64 * MB, 0};
+    stateFor(AssetCategory::Image).budget = {64 * MB, 0};
+    stateFor(AssetCategory::Sprite).budget = {128 * MB, 256 * MB};
+    stateFor(AssetCategory::Audio).budget = {64 * MB, 0};
+    stateFor(AssetCategory::Misc).budget = {32 * MB, 64 * MB};
+}
+
+std::shared_ptr<const void> AssetCache::findErased(const AssetKey& key, const std::type_info& type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_misses++;
+        return nullptr;
+    }
+
+    auto entry = it->second;
+    CategoryState& state = stateFor(entry->category);
+    if (*entry->type != type) {
+        std::cerr << "AssetCache: " << key.toString() << " requested as the wrong type\n";
+        m_misses++;
+        return nullptr;
+    }
+
+    state.lru.splice(state.lru.begin(), state.lru, entry);
+    state.usage.hits++;
+    return entry->asset;
+}
+
+std::shared_ptr<const void> AssetCache::insertErased(const AssetKey& key, std::shared_ptr<const void> asset,
+                                                     const std::type_info& type, AssetCategory category,
+                                                     size_t cpuBytes, size_t textureBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto existing = m_index.find(key);
+    if (existing != m_index.end() && *existing->second->type == type) {
+        auto entry = existing->second;
+        CategoryState& state = stateFor(entry->category);
+        state.lru.splice(state.lru.begin(), state.lru, entry);
+        return entry->asset;
+    }
+    if (existing != m_index.end()) {
+        removeEntry(stateFor(existing->second->category), existing->second);
+    }
+
+    CategoryState& state = stateFor(category);
+    state.lru.push_front({key, std::move(asset), &type, category, cpuBytes, textureBytes});
+    m_index[key] = state.lru.begin();
+
+    state.usage.entries++;
+    state.usage.cpuBytes += cpuBytes;
+    state.usage.textureBytes += textureBytes;
+
+    // Hold a reference while trimming so the new entry can't evict itself
+    std::shared_ptr<const void> result = state.lru.front().asset;
+    trimCategory(state, false);
+    return result;
+}
+
+bool AssetCache::contains(const AssetKey& key) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.count(key) > 0;
+}
+
+bool AssetCache::erase(const AssetKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return false;
+    }
+    removeEntry(stateFor(it->second->category), it->second);
+    return true;
+}
+
+void AssetCache::setBudget(AssetCategory category, const AssetMemoryBudget& budget) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CategoryState& state = stateFor(category);
+    state.budget = budget;
+    trimCategory(state, false);
+}
+
+AssetMemoryBudget AssetCache::getBudget(AssetCategory category) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_categories[static_cast<size_t>(category)].budget;
+}
+
+size_t AssetCache::trim() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t evicted = 0;
+    for (auto& state : m_categories) {
+        evicted += trimCategory(state, false);
+    }
+    return evicted;
+}
+
+size_t AssetCache::evictUnreferenced() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t evicted = 0;
+    for (auto& state : m_categories) {
+        evicted += trimCategory(state, true);
+    }
+    return evicted;
+}
+
+void AssetCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    for (auto& state : m_categories) {
+        state.lru.clear();
+        state.usage.entries = 0;
+        state.usage.cpuBytes = 0;
+        state.usage.textureBytes = 0;
+    }
+}
+
+size_t AssetCache::trimCategory(CategoryState& state, bool all) {
+    auto overBudget = [&state]() {
+        return (state.budget.cpuBytes > 0 && state.usage.cpuBytes > state.budget.cpuBytes) ||
+               (state.budget.textureBytes > 0 && state.usage.textureBytes > state.budget.textureBytes);
+    };
+
+    size_t evicted = 0;
+    auto it = state.lru.end();
+    while (it != state.lru.begin() && (all || overBudget())) {
+        --it;
+        // The cache's own reference is the only one left: safe to drop.
+        // Nobody can take a new reference without m_mutex.
+        if (it->asset.use_count() == 1) {
+            auto victim = it++;
+            removeEntry(state, victim);
+            state.usage.evictions++;
+            evicted++;
+        }
+    }
+    return evicted;
+}
+
+void AssetCache::removeEntry(CategoryState& state, LruList::iterator it) {
+    state.usage.entries--;
+    state.usage.cpuBytes -= it->cpuBytes;
+    state.usage.textureBytes -= it->textureBytes;
+    m_index.erase(it->key);
+    state.lru.erase(it);
+}
+
+AssetCacheUsage AssetCache::getUsage(AssetCategory category) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const CategoryState& state = m_categories[static_cast<size_t>(category)];
+    AssetCacheUsage usage = state.usage;
+    usage.referenced = 0;
+    for (const auto& entry : state.lru) {
+        if (entry.asset.use_count() > 1) {
+            usage.referenced++;
+        }
+    }
+    return usage;
+}
+
+AssetCacheUsage AssetCache::getTotalUsage() const {
+    AssetCacheUsage total;
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i) {
+        AssetCacheUsage usage = getUsage(static_cast<AssetCategory>(i));
+        total.cpuBytes += usage.cpuBytes;
+        total.textureBytes += usage.textureBytes;
+        total.entries += usage.entries;
+        total.referenced += usage.referenced;
+        total.hits += usage.hits;
+        total.evictions += usage.evictions;
+    }
+
+    // The category of a miss is unknown, so misses only appear in the total
+    std::lock_guard<std::mutex> lock(m_mutex);
+    total.misses = m_misses;
+    return total;
+}
+
+void AssetCache::printUsage() const {
+    auto mb = [](size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+
+    std::ios::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+
+    std::cout << "AssetCache: memory usage (MB used / budget)\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i <= CATEGORY_COUNT; ++i) {
+        bool total = i == CATEGORY_COUNT;
+        AssetCategory category = static_cast<AssetCategory>(i);
+        AssetCacheUsage usage = total ? getTotalUsage() : getUsage(category);
+        AssetMemoryBudget budget;
+        if (!total) {
+            budget = getBudget(category);
+        }
+
+        std::cout << "  " << std::left << std::setw(8) << (total ? "Total" : getAssetCategoryName(category))
+                  << std::right << " cpu " << std::setw(7) << mb(usage.cpuBytes);
+        if (budget.cpuBytes > 0) {
+            std::cout << " / " << std::setw(6) << mb(budget.cpuBytes);
+        }
+        std::cout << "  tex " << std::setw(7) << mb(usage.textureBytes);
+        if (budget.textureBytes > 0) {
+            std::cout << " / " << std::setw(6) << mb(budget.textureBytes);
+        }
+        std::cout << "  entries " << usage.entries << " (" << usage.referenced << " in use)"
+                  << "  hits " << usage.hits << "  evictions " << usage.evictions << "\n";
+    }
+
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+} // namespace mcgng
@@ -0,0 +1,244 @@
+#ifndef MCGNG_ASSET_CACHE_H
+#define MCGNG_ASSET_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+class NestedPakReader;
+struct TgaImage;
+
+/**
+ * Asset categories, each with its own memory budget.
+ */
+enum class AssetCategory : uint8_t {
+    Archive,    // Raw archive entries (FST files, PAK packets)
+    Image,      // Decoded images (TGA, shapes)
+    Sprite,     // Sprite sets and their textures
+    Audio,      // Sound and music data
+    Misc,       // Everything else
+    Count
+};
+
+/**
+ * Get display name for an asset category.
+ */
+const char* getAssetCategoryName(AssetCategory category);
+
+/**
+ * Cache key: the archive an asset came from and its entry within it.
+ * Loose files use an empty archive.
+ */
+struct AssetKey {
+    std::string archive;
+    std::string entry;
+
+    bool operator==(const AssetKey& other) const {
+        return archive == other.archive && entry == other.entry;
+    }
+
+    std::string toString() const { return archive.empty() ? entry : archive + "|" + entry; }
+};
+
+struct AssetKeyHash {
+    size_t operator()(const AssetKey& key) const {
+        size_t h = std::hash<std::string>()(key.archive);
+        return h ^ (std::hash<std::string>()(key.entry) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2));
+    }
+};
+
+/**
+ * Per-category memory budget (0 = unlimited).
+ */
+struct AssetMemoryBudget {
+    size_t cpuBytes = 0;
+    size_t textureBytes = 0;
+};
+
+/**
+ * Memory usage for one category (or all of them).
+ */
+struct AssetCacheUsage {
+    size_t cpuBytes = 0;
+    size_t textureBytes = 0;
+    size_t entries = 0;
+    size_t referenced = 0;      // Entries held outside the cache
+    uint64_t hits = 0;
+    uint64_t misses = 0;        // Only tracked in the total
+    uint64_t evictions = 0;
+};
+
+/**
+ * Approximate CPU memory held by an asset, used for budgeting.
+ * Add overloads next to new asset types; the fallback counts sizeof(T).
+ */
+size_t assetCpuBytes(const std::vector<uint8_t>& data);
+size_t assetCpuBytes(const TgaImage& image);
+size_t assetCpuBytes(const NestedPakReader& reader);
+
+template <typename T>
+size_t assetCpuBytes(const T&) {
+    return sizeof(T);
+}
+
+/**
+ * Central cache for loaded assets.
+ *
+ * Assets are shared_ptr handles: the cache keeps one reference and anyone
+ * using the asset holds another. An entry whose only reference is the
+ * cache's own is unreferenced and may be evicted, least recently used
+ * first, once its category goes over budget. Referenced entries are never
+ * evicted; a category can exceed its budget while they stay in use.
+ *
+ * Thread-safe; AssetManager inserts from its worker threads.
+ */
+class AssetCache {
+public:
+    static AssetCache& instance();
+
+    /**
+     * Find a cached asset and mark it recently used.
+     * @return The asset, or nullptr if absent or stored as another type
+     */
+    template <typename T>
+    std::shared_ptr<const T> find(const AssetKey& key) {
+        return std::static_pointer_cast<const T>(findErased(key, typeid(T)));
+    }
+
+    /**
+     * Add an asset. If the key is already cached the existing asset is
+     * kept and returned, so racing loaders converge on one copy.
+     * @param cpuBytes CPU memory to charge (see assetCpuBytes)
+     * @param textureBytes GPU memory to charge
+     * @return The cached asset
+     */
+    template <typename T>
+    std::shared_ptr<const T> insert(const AssetKey& key, std::shared_ptr<const T> asset,
+                                    AssetCategory category, size_t cpuBytes,
+                                    size_t textureBytes = 0) {
+        if (!asset) {
+            return nullptr;
+        }
+        return std::static_pointer_cast<const T>(
+            insertErased(key, std::move(asset), typeid(T), category, cpuBytes, textureBytes));
+    }
+
+    /**
+     * Add an asset, charging assetCpuBytes() for it.
+     */
+    template <typename T>
+    std::shared_ptr<const T> insert(const AssetKey& key, std::shared_ptr<const T> asset,
+                                    AssetCategory category) {
+        size_t cpuBytes = asset ? assetCpuBytes(*asset) : 0;
+        return insert<T>(key, std::move(asset), category, cpuBytes, 0);
+    }
+
+    /**
+     * Check if a key is cached.
+     */
+    bool contains(const AssetKey& key) const;
+
+    /**
+     * Remove an entry. Outstanding handles keep the asset alive.
+     * @return true if the key was cached
+     */
+    bool erase(const AssetKey& key);
+
+    /**
+     * Set the memory budget for a category and evict down to it.
+     */
+    void setBudget(AssetCategory category, const AssetMemoryBudget& budget);
+
+    /**
+     * Get the memory budget for a category.
+     */
+    AssetMemoryBudget getBudget(AssetCategory category) const;
+
+    /**
+     * Evict unreferenced entries until every category is within budget.
+     * @return Number of entries evicted
+     */
+    size_t trim();
+
+    /**
+     * Evict every unreferenced entry (e.g. between missions).
+     * @return Number of entries evicted
+     */
+    size_t evictUnreferenced();
+
+    /**
+     * Drop all entries.
+     */
+    void clear();
+
+    /**
+     * Get memory usage for one category.
+     */
+    AssetCacheUsage getUsage(AssetCategory category) const;
+
+    /**
+     * Get memory usage summed over all categories.
+     */
+    AssetCacheUsage getTotalUsage() const;
+
+    /**
+     * Print a per-category usage table to stdout.
+     */
+    void printUsage() const;
+
+private:
+    AssetCache();
+    ~AssetCache() = default;
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    struct Entry {
+        AssetKey key;
+        std::shared_ptr<const void> asset;
+        const std::type_info* type = nullptr;
+        AssetCategory category = AssetCategory::Misc;
+        size_t cpuBytes = 0;
+        size_t textureBytes = 0;
+    };
+
+    using LruList = std::list<Entry>;   // Front = most recently used
+
+    struct CategoryState {
+        LruList lru;
+        AssetMemoryBudget budget;
+        AssetCacheUsage usage;
+    };
+
+    std::shared_ptr<const void> findErased(const AssetKey& key, const std::type_info& type);
+    std::shared_ptr<const void> insertErased(const AssetKey& key, std::shared_ptr<const void> asset,
+                                             const std::type_info& type, AssetCategory category,
+                                             size_t cpuBytes, size_t textureBytes);
+
+    // Callers hold m_mutex
+    size_t trimCategory(CategoryState& state, bool all);
+    void removeEntry(CategoryState& state, LruList::iterator it);
+    CategoryState& stateFor(AssetCategory category) {
+        return m_categories[static_cast<size_t>(category)];
+    }
+
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(AssetCategory::Count);
+
+    mutable std::mutex m_mutex;
+    std::array<CategoryState, CATEGORY_COUNT> m_categories;
+    std::unordered_map<AssetKey, LruList::iterator, AssetKeyHash> m_index;
+    uint64_t m_misses = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_ASSET_CACHE_H
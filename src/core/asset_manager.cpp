@@ -0,0 +1,472 @@
+#include "core/asset_manager.h"
+#include "core/profiler.h"
+#include "assets/pak_reader.h"
+#include "assets/nested_pak_reader.h"
+#include "assets/tga_loader.h"
+#include "assets/vfs.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+
+namespace mcgng {
+
+namespace {
+
+/**
+ * Pool of open readers for one archive.
+ *
+ * PakReader owns an ifstream, so each worker checks out its
+ * own handle instead of serializing every read on one file.
+ */
+template <typename Reader>
+class ReaderPool {
+public:
+    explicit ReaderPool(std::string path) : m_path(std::move(path)) {}
+
+    std::unique_ptr<Reader> acquire() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_idle.empty()) {
+                auto reader = std::move(m_idle.back());
+                m_idle.pop_back();
+                return reader;
+            }
+        }
+
+        auto reader = std::make_unique<Reader>();
+        if (!reader->open(m_path)) {
+            return nullptr;
+        }
+        return reader;
+    }
+
+    void release(std::unique_ptr<Reader> reader) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle.push_back(std::move(reader));
+    }
+
+private:
+    std::string m_path;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Reader>> m_idle;
+};
+
+AssetPtr<AssetBytes> wrapBytes(std::vector<uint8_t>&& data) {
+    if (data.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<const AssetBytes>(std::move(data));
+}
+
+} // anonymous namespace
+
+struct AssetManager::ArchivePool {
+    explicit ArchivePool(const std::string& archivePath)
+        : path(archivePath), pakReaders(archivePath) {}
+
+    std::string path;
+    ReaderPool<PakReader> pakReaders;
+};
+
+AssetManager& AssetManager::instance() {
+    // Runners are jobs, so the job system must be destroyed after the manager
+    JobSystem::instance();
+    static AssetManager instance;
+    return instance;
+}
+
+AssetManager::~AssetManager() {
+    shutdown();
+}
+
+bool AssetManager::initialize(size_t maxLoads) {
+    if (m_initialized) {
+        return true;
+    }
+
+    // Loads share the job workers with the simulation. Decoding is mostly
+    // memory bound, so a handful at once is plenty and leaves workers free.
+    size_t workers = JobSystem::instance().getWorkerCount();
+    if (maxLoads == 0) {
+        maxLoads = 4;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+        m_maxLoads = std::min(maxLoads, workers);
+        m_runners = 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        m_deferReleases = true;
+    }
+
+    m_initialized = true;
+    std::cout << "AssetManager: Loading up to " << m_maxLoads << " assets at once on "
+              << workers << " job workers\n";
+    return true;
+}
+
+void AssetManager::shutdown() {
+    if (!m_initialized) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<Job>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        for (auto& queue : m_queues) {
+            for (auto& job : queue) {
+                if (!job->claimed.exchange(true)) {
+                    cancelled.push_back(job);
+                }
+            }
+            queue.clear();
+        }
+    }
+
+    // Running loads finish; runners started after this find the queues empty
+    JobSystem::instance().wait(m_runnerJobs);
+
+    // Anyone still holding a future gets a null result rather than hanging
+    for (auto& job : cancelled) {
+        job->cancel();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight.clear();
+        m_activeJobs = 0;
+        m_runners = 0;
+        m_maxLoads = 0;
+        m_stopping = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completed.clear();
+    }
+    std::vector<UploadTask> releases;
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        for (auto& queue : m_uploads) {
+            queue.clear();
+        }
+        releases.swap(m_releases);
+        m_deferReleases = false;
+    }
+    for (auto& release : releases) {
+        release();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_archiveMutex);
+        m_pakPools.clear();
+    }
+
+    m_initialized = false;
+    std::cout << "AssetManager: Shutdown (" << cancelled.size() << " queued loads cancelled)\n";
+}
+
+std::string AssetManager::diskKey(const std::string& path) {
+    std::string key = std::filesystem::path(path).lexically_normal().generic_string();
+    std::replace(key.begin(), key.end(), '\\', '/');
+    for (char& c : key) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+std::shared_ptr<AssetManager::ArchivePool> AssetManager::getPakPool(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_archiveMutex);
+    auto& pool = m_pakPools[diskKey(path)];
+    if (!pool) {
+        pool = std::make_shared<ArchivePool>(path);
+    }
+    return pool;
+}
+
+AssetFuture<AssetBytes> AssetManager::requestFile(const std::string& path, AssetPriority priority,
+                                                  AssetCallback<AssetBytes> callback) {
+    // Key by the serving source so a remount or override never aliases
+    std::string normalized = Vfs::normalizePath(path);
+    std::string source = Vfs::instance().getSource(normalized);
+
+    AssetKey key{source.empty() ? "vfs" : source, normalized};
+    AssetLoader<AssetBytes> loader = [normalized]() -> AssetPtr<AssetBytes> {
+        VfsView view = Vfs::instance().read(normalized);
+        if (!view) {
+            return nullptr;
+        }
+        return std::make_shared<const AssetBytes>(view.data(), view.data() + view.size());
+    };
+
+    return requestCached<AssetBytes>(key, AssetCategory::Archive, std::move(loader),
+                                     priority, std::move(callback));
+}
+
+AssetFuture<AssetBytes> AssetManager::requestPacket(const std::string& pakPath, size_t index,
+                                                    AssetPriority priority,
+                                                    AssetCallback<AssetBytes> callback) {
+    auto pool = getPakPool(pakPath);
+
+    AssetLoader<AssetBytes> loader = [pool, index]() -> AssetPtr<AssetBytes> {
+        auto reader = pool->pakReaders.acquire();
+        if (!reader) {
+            return nullptr;
+        }
+        auto data = reader->readPacket(index);
+        pool->pakReaders.release(std::move(reader));
+        return wrapBytes(std::move(data));
+    };
+
+    return requestCached<AssetBytes>({diskKey(pakPath), std::to_string(index)},
+                                     AssetCategory::Archive, std::move(loader), priority,
+                                     std::move(callback));
+}
+
+AssetFuture<NestedPakReader> AssetManager::requestNestedPak(const std::string& path,
+                                                            AssetPriority priority,
+                                                            AssetCallback<NestedPakReader> callback) {
+    AssetLoader<NestedPakReader> loader = [path]() -> AssetPtr<NestedPakReader> {
+        auto reader = std::make_shared<NestedPakReader>();
+        if (!reader->open(path)) {
+            return nullptr;
+        }
+        return reader;
+    };
+
+    return requestCached<NestedPakReader>({diskKey(path), "*"}, AssetCategory::Sprite, std::move(loader),
+                                          priority, std::move(callback));
+}
+
+AssetFuture<TgaImage> AssetManager::requestTga(const std::string& path, AssetPriority priority,
+                                               AssetCallback<TgaImage> callback) {
+    AssetLoader<TgaImage> loader = [path]() -> AssetPtr<TgaImage> {
+        auto image = std::make_shared<TgaImage>(TgaLoader::loadFromFile(path));
+        if (!image->isValid()) {
+            return nullptr;
+        }
+        return image;
+    };
+
+    return requestCached<TgaImage>({"", diskKey(path)}, AssetCategory::Image, std::move(loader),
+                                   priority, std::move(callback));
+}
+
+bool AssetManager::reserveRunner() {
+    // Called with m_mutex held
+    if (m_runners >= m_maxLoads) {
+        return false;
+    }
+    m_runners++;
+    return true;
+}
+
+void AssetManager::startRunner() {
+    JobSystem::instance().run([this]() { runNext(); }, &m_runnerJobs);
+}
+
+void AssetManager::runNext() {
+    std::shared_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Highest priority first; promoted jobs leave a stale entry
+        // behind in their old queue, which is skipped here.
+        for (auto& queue : m_queues) {
+            while (!queue.empty() && !job) {
+                auto candidate = std::move(queue.front());
+                queue.pop_front();
+                if (!candidate->claimed.exchange(true)) {
+                    job = std::move(candidate);
+                }
+            }
+            if (job) {
+                break;
+            }
+        }
+        if (!job) {
+            m_runners--;
+            return;
+        }
+        m_activeJobs++;
+    }
+
+    {
+        MCGNG_PROFILE_ZONE("AssetManager::load");
+        job->run();
+    }
+    finish(job);
+
+    // One load per job, so other jobs get the worker between loads
+    startRunner();
+}
+
+void AssetManager::finish(const std::shared_ptr<Job>& job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_inFlight.find(job->key);
+        if (it != m_inFlight.end() && it->second == job) {
+            m_inFlight.erase(it);
+        }
+        m_stats.completed++;
+        if (!job->succeeded()) {
+            m_stats.failed++;
+        }
+        if (m_activeJobs > 0) {
+            m_activeJobs--;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completed.push_back(job);
+    }
+    m_idle.notify_all();
+}
+
+void AssetManager::queueUpload(UploadTask task, size_t bytes, AssetPriority priority) {
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_uploads[static_cast<size_t>(priority)].push_back({std::move(task), bytes});
+}
+
+void AssetManager::releaseOnRenderThread(UploadTask task) {
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        if (m_deferReleases) {
+            m_releases.push_back(std::move(task));
+            return;
+        }
+    }
+    task();
+}
+
+void AssetManager::setUploadBudget(size_t bytesPerFrame, double millisecondsPerFrame) {
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_uploadBudgetBytes = bytesPerFrame;
+    m_uploadBudgetMs = millisecondsPerFrame;
+}
+
+size_t AssetManager::update() {
+    MCGNG_PROFILE_ZONE("AssetManager::update");
+
+    std::vector<std::shared_ptr<Job>> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        completed.swap(m_completed);
+    }
+
+    for (auto& job : completed) {
+        job->dispatch();
+    }
+    return completed.size();
+}
+
+size_t AssetManager::processUploads() {
+    MCGNG_PROFILE_ZONE("AssetManager::processUploads");
+    auto start = std::chrono::steady_clock::now();
+
+    size_t budgetBytes;
+    double budgetMs;
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        budgetBytes = m_uploadBudgetBytes;
+        budgetMs = m_uploadBudgetMs;
+    }
+
+    // Resources the cache let go of; freeing them never waits on the budget
+    std::vector<UploadTask> releases;
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        releases.swap(m_releases);
+    }
+    for (auto& release : releases) {
+        release();
+    }
+
+    size_t count = 0;
+    size_t bytes = 0;
+    for (;;) {
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            auto queue = std::find_if(m_uploads.begin(), m_uploads.end(),
+                                      [](const auto& q) { return !q.empty(); });
+            if (queue == m_uploads.end()) {
+                break;
+            }
+
+            // Critical uploads ignore the budget; everything else stops once
+            // it would overrun, but one upload always goes through.
+            bool critical = queue == m_uploads.begin();
+            if (!critical && count > 0 && budgetBytes > 0 &&
+                bytes + queue->front().bytes > budgetBytes) {
+                break;
+            }
+
+            upload = std::move(queue->front());
+            queue->pop_front();
+        }
+
+        if (upload.task) {
+            upload.task();
+        }
+        count++;
+        bytes += upload.bytes;
+
+        double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (budgetMs > 0.0 && elapsedMs >= budgetMs) {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            if (m_uploads.front().empty()) {
+                break;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        m_lastUploadBytes = bytes;
+    }
+    return count;
+}
+
+void AssetManager::waitIdle() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this] { return m_inFlight.empty() && m_activeJobs == 0; });
+        }
+
+        // Callbacks may queue follow-up loads
+        if (update() == 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_inFlight.empty() && m_activeJobs == 0) {
+                return;
+            }
+        }
+    }
+}
+
+AssetManagerStats AssetManager::getStats() const {
+    AssetManagerStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats = m_stats;
+        stats.queued = m_inFlight.size() > m_activeJobs ? m_inFlight.size() - m_activeJobs : 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        for (const auto& queue : m_uploads) {
+            stats.pendingUploads += queue.size();
+        }
+        stats.uploadedBytes = m_lastUploadBytes;
+    }
+    return stats;
+}
+
+} // namespace mcgng
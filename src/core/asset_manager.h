@@ -0,0 +1,457 @@
+#ifndef MCGNG_ASSET_MANAGER_H
+#define MCGNG_ASSET_MANAGER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/asset_cache.h"
+#include "core/jobs.h"
+
+namespace mcgng {
+
+class NestedPakReader;
+struct TgaImage;
+
+/**
+ * Asset request priority.
+ *
+ * Workers always take the highest-priority queued request first.
+ */
+enum class AssetPriority : uint8_t {
+    Critical = 0,   // Needed this frame (blocking UI, current mission)
+    High,           // Needed soon (units entering view)
+    Normal,         // Default
+    Low,            // Prefetch / speculative
+    Count
+};
+
+/**
+ * Loaded assets are shared and immutable once published.
+ * A null pointer means the load failed.
+ */
+template <typename T>
+using AssetPtr = std::shared_ptr<const T>;
+
+template <typename T>
+using AssetFuture = std::shared_future<AssetPtr<T>>;
+
+template <typename T>
+using AssetCallback = std::function<void(const AssetPtr<T>&)>;
+
+template <typename T>
+using AssetLoader = std::function<AssetPtr<T>()>;
+
+using AssetBytes = std::vector<uint8_t>;
+
+/**
+ * Work queued for the render thread (texture creation and similar).
+ */
+using UploadTask = std::function<void()>;
+
+/**
+ * Asset loading statistics.
+ */
+struct AssetManagerStats {
+    uint64_t requested = 0;     // Requests made
+    uint64_t deduplicated = 0;  // Requests served by an in-flight load
+    uint64_t cacheHits = 0;     // Requests served from AssetCache
+    uint64_t completed = 0;     // Loads finished (including failures)
+    uint64_t failed = 0;        // Loads that returned nothing
+    size_t queued = 0;          // Loads waiting for a worker
+    size_t pendingUploads = 0;  // Uploads waiting for the render thread
+    size_t uploadedBytes = 0;   // Bytes uploaded in the last processUploads()
+};
+
+/**
+ * Asynchronous, prioritized asset loader.
+ *
+ * Archive reads and decoding run as JobSystem jobs, at most a few at a
+ * time so loads leave workers free for the simulation. Each request
+ * returns a shared future; an optional callback runs on the main thread
+ * from update(), so game code never sees a worker thread. Two requests
+ * for the same asset while it is in flight share one load, and a higher
+ * priority request promotes the queued one.
+ *
+ * Archive-backed requests go through AssetCache first, so an asset that
+ * is still resident resolves immediately without touching a worker.
+ *
+ * GPU work is marshalled back with queueUpload() and drained by the render
+ * thread under a per-frame byte and time budget, so streaming sprites in
+ * mid-mission spreads texture creation across frames instead of stalling.
+ */
+class AssetManager {
+public:
+    static AssetManager& instance();
+
+    /**
+     * Start background loading on the JobSystem workers.
+     * Initialize the JobSystem first; without workers loads run synchronously.
+     * @param maxLoads Loads running at once (0 = pick from the worker count)
+     * @return true on success
+     */
+    bool initialize(size_t maxLoads = 0);
+
+    /**
+     * Wait for running loads, drop queued loads and pending uploads, and close archives.
+     * Queued futures are resolved with a null result.
+     */
+    void shutdown();
+
+    /**
+     * Check if background loading is running.
+     */
+    bool isInitialized() const { return m_initialized; }
+
+    /**
+     * Get how many loads may run at once (0 = loads are synchronous).
+     */
+    size_t getMaxLoads() const { return m_maxLoads; }
+
+    /**
+     * Request a file from the virtual file system (see Vfs).
+     * @param path Virtual path (case-insensitive)
+     */
+    AssetFuture<AssetBytes> requestFile(const std::string& path,
+                                        AssetPriority priority = AssetPriority::Normal,
+                                        AssetCallback<AssetBytes> callback = nullptr);
+
+    /**
+     * Request a decompressed packet from a PAK archive.
+     * @param pakPath Path to the .PAK file
+     * @param index Packet index
+     */
+    AssetFuture<AssetBytes> requestPacket(const std::string& pakPath, size_t index,
+                                          AssetPriority priority = AssetPriority::Normal,
+                                          AssetCallback<AssetBytes> callback = nullptr);
+
+    /**
+     * Request a nested sprite PAK (TORSOS.PAK, LEGS.PAK, ...).
+     */
+    AssetFuture<NestedPakReader> requestNestedPak(const std::string& path,
+                                                  AssetPriority priority = AssetPriority::Normal,
+                                                  AssetCallback<NestedPakReader> callback = nullptr);
+
+    /**
+     * Request a TGA image from disk.
+     */
+    AssetFuture<TgaImage> requestTga(const std::string& path,
+                                     AssetPriority priority = AssetPriority::Normal,
+                                     AssetCallback<TgaImage> callback = nullptr);
+
+    /**
+     * Dedupe key for a file on disk: lexically normalized, forward
+     * slashes, lowercase (game installs come from case-insensitive
+     * Windows paths), so different spellings of one archive share a load.
+     */
+    static std::string diskKey(const std::string& path);
+
+    /**
+     * Request an arbitrary asset.
+     * Requests with the same key share one load while it is in flight.
+     * @param key Unique key for the asset (used for deduplication)
+     * @param loader Runs on a worker thread; return nullptr on failure
+     */
+    template <typename T>
+    AssetFuture<T> request(const std::string& key, AssetLoader<T> loader,
+                           AssetPriority priority = AssetPriority::Normal,
+                           AssetCallback<T> callback = nullptr);
+
+    /**
+     * Request an asset through AssetCache.
+     * A cached asset resolves immediately (its callback still runs from
+     * update()); otherwise the loaded result is inserted into the cache.
+     * @param key Cache key, also used for deduplication
+     * @param category Cache budget to charge
+     */
+    template <typename T>
+    AssetFuture<T> requestCached(const AssetKey& key, AssetCategory category, AssetLoader<T> loader,
+                                 AssetPriority priority = AssetPriority::Normal,
+                                 AssetCallback<T> callback = nullptr);
+
+    /**
+     * Queue work for the render thread.
+     * Safe to call from any thread.
+     * @param task Work to run (texture creation etc.)
+     * @param bytes Approximate upload size, counted against the budget
+     */
+    void queueUpload(UploadTask task, size_t bytes,
+                     AssetPriority priority = AssetPriority::Normal);
+
+    /**
+     * Hand an object owning render-thread resources (textures created in
+     * an upload task) to the cache, charging its textures to the
+     * category's texture budget. Once the cache holds the only reference
+     * it can be evicted; the object is then destroyed on the render thread.
+     * Call on the render thread.
+     * @param key Cache key; replaces an entry already stored under it
+     * @param textureBytes GPU memory the object holds (width * height * 4 per texture)
+     * @return Handle to keep while drawing it
+     */
+    template <typename T>
+    std::shared_ptr<T> adoptResource(const AssetKey& key, std::unique_ptr<T> resource,
+                                     AssetCategory category, size_t textureBytes);
+
+    /**
+     * Set the per-frame upload budget.
+     * At least one upload runs per frame so progress is never starved.
+     * @param bytesPerFrame Byte budget (0 = unlimited)
+     * @param millisecondsPerFrame Time budget (0 = unlimited)
+     */
+    void setUploadBudget(size_t bytesPerFrame, double millisecondsPerFrame);
+
+    /**
+     * Run main-thread completion callbacks. Call once per frame.
+     * @return Number of finished loads dispatched
+     */
+    size_t update();
+
+    /**
+     * Run queued uploads within the budget. Call from the render thread.
+     * @return Number of uploads run
+     */
+    size_t processUploads();
+
+    /**
+     * Block until every queued load has finished and its callback has run.
+     * Must be called from the main thread.
+     */
+    void waitIdle();
+
+    /**
+     * Get loading statistics.
+     */
+    AssetManagerStats getStats() const;
+
+private:
+    AssetManager() = default;
+    ~AssetManager();
+
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    /**
+     * Type-erased queued load.
+     */
+    struct Job {
+        virtual ~Job() = default;
+        virtual void run() = 0;             // Worker thread
+        virtual void cancel() = 0;          // Resolve with nothing
+        virtual bool succeeded() const = 0;
+        virtual void dispatch() = 0;        // Main thread callbacks
+
+        std::string key;
+        AssetPriority priority = AssetPriority::Normal;
+        std::atomic<bool> claimed{false};   // Set by whichever queue entry runs it
+    };
+
+    template <typename T>
+    struct TypedJob : Job {
+        AssetLoader<T> loader;
+        std::promise<AssetPtr<T>> promise;
+        AssetFuture<T> future;
+        AssetPtr<T> result;
+        std::vector<AssetCallback<T>> callbacks;
+
+        void run() override {
+            try {
+                result = loader();
+            } catch (const std::exception& e) {
+                std::cerr << "AssetManager: Load of " << key << " threw: " << e.what() << "\n";
+                result = nullptr;
+            }
+            promise.set_value(result);
+        }
+
+        void cancel() override { promise.set_value(nullptr); }
+
+        bool succeeded() const override { return result != nullptr; }
+
+        void dispatch() override {
+            for (auto& callback : callbacks) {
+                if (callback) {
+                    callback(result);
+                }
+            }
+        }
+    };
+
+    struct Upload {
+        UploadTask task;
+        size_t bytes = 0;
+    };
+
+    struct ArchivePool;
+
+    void enqueue(const std::shared_ptr<Job>& job);
+    bool reserveRunner();
+    void startRunner();
+    void runNext();
+    void finish(const std::shared_ptr<Job>& job);
+    std::shared_ptr<ArchivePool> getPakPool(const std::string& path);
+
+    /**
+     * Run a task on the render thread before the next uploads, or right
+     * away if the manager is not running (shutdown, on the main thread).
+     */
+    void releaseOnRenderThread(UploadTask task);
+
+    template <typename T>
+    AssetFuture<T> resolved(const std::string& key, AssetPtr<T> asset, AssetCallback<T> callback);
+
+    static constexpr size_t PRIORITY_COUNT = static_cast<size_t>(AssetPriority::Count);
+
+    bool m_initialized = false;
+
+    // Loads run as jobs; each runner takes one queued load, then reschedules
+    size_t m_maxLoads = 0;
+    size_t m_runners = 0;               // Guarded by m_mutex
+    JobCounter m_runnerJobs;
+
+    // Load queue and in-flight table
+    mutable std::mutex m_mutex;
+    std::condition_variable m_idle;
+    std::array<std::deque<std::shared_ptr<Job>>, PRIORITY_COUNT> m_queues;
+    std::unordered_map<std::string, std::shared_ptr<Job>> m_inFlight;
+    size_t m_activeJobs = 0;
+    bool m_stopping = false;
+    AssetManagerStats m_stats;
+
+    // Finished loads waiting for update()
+    std::mutex m_completedMutex;
+    std::vector<std::shared_ptr<Job>> m_completed;
+
+    // Render-thread uploads
+    mutable std::mutex m_uploadMutex;
+    std::array<std::deque<Upload>, PRIORITY_COUNT> m_uploads;
+    std::vector<UploadTask> m_releases;     // Unbudgeted, run before uploads
+    bool m_deferReleases = false;
+    size_t m_uploadBudgetBytes = 2 * 1024 * 1024;
+    double m_uploadBudgetMs = 2.0;
+    size_t m_lastUploadBytes = 0;
+
+    // Archives
+    std::mutex m_archiveMutex;
+    std::unordered_map<std::string, std::shared_ptr<ArchivePool>> m_pakPools;
+};
+
+template <typename T>
+AssetFuture<T> AssetManager::request(const std::string& key, AssetLoader<T> loader,
+                                     AssetPriority priority, AssetCallback<T> callback) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stats.requested++;
+
+    auto it = m_inFlight.find(key);
+    if (it != m_inFlight.end()) {
+        if (auto existing = std::dynamic_pointer_cast<TypedJob<T>>(it->second)) {
+            m_stats.deduplicated++;
+            if (callback) {
+                existing->callbacks.push_back(std::move(callback));
+            }
+            // Promote a queued load; the stale queue entry is skipped when popped
+            if (priority < existing->priority && !existing->claimed) {
+                existing->priority = priority;
+                m_queues[static_cast<size_t>(priority)].push_back(existing);
+            }
+            return existing->future;
+        }
+        std::cerr << "AssetManager: " << key << " requested as two different types\n";
+    }
+
+    auto job = std::make_shared<TypedJob<T>>();
+    job->key = key;
+    job->priority = priority;
+    job->loader = std::move(loader);
+    job->future = job->promise.get_future().share();
+    if (callback) {
+        job->callbacks.push_back(std::move(callback));
+    }
+
+    if (!m_initialized || m_stopping || m_maxLoads == 0) {
+        // No workers: load synchronously so callers still get a result
+        m_activeJobs++;
+        lock.unlock();
+        job->run();
+        finish(job);
+        return job->future;
+    }
+
+    m_inFlight[key] = job;
+    m_queues[static_cast<size_t>(priority)].push_back(job);
+    bool start = reserveRunner();
+    lock.unlock();
+    if (start) {
+        startRunner();
+    }
+    return job->future;
+}
+
+template <typename T>
+AssetFuture<T> AssetManager::requestCached(const AssetKey& key, AssetCategory category,
+                                           AssetLoader<T> loader, AssetPriority priority,
+                                           AssetCallback<T> callback) {
+    if (auto cached = AssetCache::instance().find<T>(key)) {
+        return resolved<T>(key.toString(), std::move(cached), std::move(callback));
+    }
+
+    AssetLoader<T> cachingLoader = [key, category, loader = std::move(loader)]() -> AssetPtr<T> {
+        return AssetCache::instance().insert<T>(key, loader(), category);
+    };
+    return request<T>(key.toString(), std::move(cachingLoader), priority, std::move(callback));
+}
+
+template <typename T>
+std::shared_ptr<T> AssetManager::adoptResource(const AssetKey& key, std::unique_ptr<T> resource,
+                                               AssetCategory category, size_t textureBytes) {
+    if (!resource) {
+        return nullptr;
+    }
+
+    // The last reference can go on any thread (eviction runs under inserts)
+    size_t cpuBytes = assetCpuBytes(*resource);
+    std::shared_ptr<T> handle(resource.release(), [](T* object) {
+        AssetManager::instance().releaseOnRenderThread([object]() { delete object; });
+    });
+
+    auto& cache = AssetCache::instance();
+    cache.erase(key);
+    cache.insert<T>(key, handle, category, cpuBytes, textureBytes);
+    return handle;
+}
+
+template <typename T>
+AssetFuture<T> AssetManager::resolved(const std::string& key, AssetPtr<T> asset,
+                                      AssetCallback<T> callback) {
+    auto job = std::make_shared<TypedJob<T>>();
+    job->key = key;
+    job->result = std::move(asset);
+    job->future = job->promise.get_future().share();
+    job->promise.set_value(job->result);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.requested++;
+        m_stats.cacheHits++;
+    }
+
+    if (callback) {
+        job->callbacks.push_back(std::move(callback));
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completed.push_back(job);
+    }
+    return job->future;
+}
+
+} // namespace mcgng
+
+#endif // MCGNG_ASSET_MANAGER_H
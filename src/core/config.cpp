@@ -17,6 +17,8 @@ ConfigManager::ConfigManager() {
     loadDefaults();
 }
 
+ConfigManager::~ConfigManager() = default;
+
 void ConfigManager::loadDefaults() {
     m_config = GameConfig{};
 
@@ -34,9 +36,11 @@ void ConfigManager::loadDefaults() {
         m_configPath = std::string(home) + "/.mcgoldng/config.cfg";
     }
 #endif
+
+    publish();
 }
 
-bool ConfigManager::load(const std::string& path) {
+bool ConfigManager::parse(const std::string& path, GameConfig& config) {
     FitParser parser;
 
     if (!parser.parseFile(path)) {
@@ -46,51 +50,125 @@ bool ConfigManager::load(const std::string& path) {
 
     // Load Display settings
     if (const auto* display = parser.findBlock("Display")) {
-        if (auto val = display->getInt("WindowWidth")) m_config.windowWidth = static_cast<int>(*val);
-        if (auto val = display->getInt("WindowHeight")) m_config.windowHeight = static_cast<int>(*val);
-        if (auto val = display->getBool("Fullscreen")) m_config.fullscreen = *val;
-        if (auto val = display->getBool("VSync")) m_config.vsync = *val;
-        if (auto val = display->getInt("TargetFPS")) m_config.targetFPS = static_cast<int>(*val);
+        if (auto val = display->getInt("WindowWidth")) config.windowWidth = static_cast<int>(*val);
+        if (auto val = display->getInt("WindowHeight")) config.windowHeight = static_cast<int>(*val);
+        if (auto val = display->getBool("Fullscreen")) config.fullscreen = *val;
+        if (auto val = display->getBool("VSync")) config.vsync = *val;
+        if (auto val = display->getInt("TargetFPS")) config.targetFPS = static_cast<int>(*val);
     }
 
     // Load Graphics settings
     if (const auto* graphics = parser.findBlock("Graphics")) {
-        if (auto val = graphics->getInt("RenderScale")) m_config.renderScale = static_cast<int>(*val);
-        if (auto val = graphics->getBool("SmoothScaling")) m_config.smoothScaling = *val;
-        if (auto val = graphics->getBool("ShowFPS")) m_config.showFPS = *val;
+        if (auto val = graphics->getInt("RenderScale")) config.renderScale = static_cast<int>(*val);
+        if (auto val = graphics->getBool("SmoothScaling")) config.smoothScaling = *val;
+        if (auto val = graphics->getBool("AdaptiveScale")) config.adaptiveScale = *val;
+        if (auto val = graphics->getInt("MinRenderScale")) config.minRenderScale = static_cast<int>(*val);
+        if (auto val = graphics->getBool("ShowFPS")) config.showFPS = *val;
     }
 
     // Load Audio settings
     if (const auto* audio = parser.findBlock("Audio")) {
-        if (auto val = audio->getInt("MasterVolume")) m_config.masterVolume = static_cast<int>(*val);
-        if (auto val = audio->getInt("MusicVolume")) m_config.musicVolume = static_cast<int>(*val);
-        if (auto val = audio->getInt("SFXVolume")) m_config.sfxVolume = static_cast<int>(*val);
-        if (auto val = audio->getInt("VoiceVolume")) m_config.voiceVolume = static_cast<int>(*val);
-        if (auto val = audio->getBool("MuteAudio")) m_config.muteAudio = *val;
+        if (auto val = audio->getInt("MasterVolume")) config.masterVolume = static_cast<int>(*val);
+        if (auto val = audio->getInt("MusicVolume")) config.musicVolume = static_cast<int>(*val);
+        if (auto val = audio->getInt("SFXVolume")) config.sfxVolume = static_cast<int>(*val);
+        if (auto val = audio->getInt("VoiceVolume")) config.voiceVolume = static_cast<int>(*val);
+        if (auto val = audio->getBool("MuteAudio")) config.muteAudio = *val;
     }
 
     // Load Paths
     if (const auto* paths = parser.findBlock("Paths")) {
-        if (auto val = paths->getString("GamePath")) m_config.gamePath = *val;
-        if (auto val = paths->getString("AssetsPath")) m_config.assetsPath = *val;
-        if (auto val = paths->getString("SavePath")) m_config.savePath = *val;
+        if (auto val = paths->getString("GamePath")) config.gamePath = *val;
+        if (auto val = paths->getString("AssetsPath")) config.assetsPath = *val;
+        if (auto val = paths->getString("SavePath")) config.savePath = *val;
     }
 
     // Load Gameplay settings
     if (const auto* gameplay = parser.findBlock("Gameplay")) {
-        if (auto val = gameplay->getFloat("GameSpeed")) m_config.gameSpeed = static_cast<float>(*val);
-        if (auto val = gameplay->getBool("PauseOnFocusLoss")) m_config.pauseOnFocusLoss = *val;
-        if (auto val = gameplay->getInt("Difficulty")) m_config.difficulty = static_cast<int>(*val);
+        if (auto val = gameplay->getFloat("GameSpeed")) config.gameSpeed = static_cast<float>(*val);
+        if (auto val = gameplay->getBool("PauseOnFocusLoss")) config.pauseOnFocusLoss = *val;
+        if (auto val = gameplay->getInt("Difficulty")) config.difficulty = static_cast<int>(*val);
+    }
+
+    // Load Streaming settings
+    if (const auto* streaming = parser.findBlock("Streaming")) {
+        if (auto val = streaming->getInt("LoaderThreads")) config.loaderThreads = static_cast<int>(*val);
+        if (auto val = streaming->getInt("JobThreads")) config.jobThreads = static_cast<int>(*val);
+        if (auto val = streaming->getInt("UploadBudgetKB")) config.uploadBudgetKB = static_cast<int>(*val);
+        if (auto val = streaming->getFloat("UploadBudgetMs")) config.uploadBudgetMs = static_cast<float>(*val);
     }
 
     // Load Debug settings
     if (const auto* debug = parser.findBlock("Debug")) {
-        if (auto val = debug->getBool("DebugMode")) m_config.debugMode = *val;
-        if (auto val = debug->getBool("ShowCollision")) m_config.showCollision = *val;
-        if (auto val = debug->getBool("ShowPathfinding")) m_config.showPathfinding = *val;
+        if (auto val = debug->getBool("DebugMode")) config.debugMode = *val;
+        if (auto val = debug->getBool("ShowCollision")) config.showCollision = *val;
+        if (auto val = debug->getBool("ShowPathfinding")) config.showPathfinding = *val;
+        if (auto val = debug->getBool("SerialFrames")) config.serialFrames = *val;
+    }
+
+    return true;
+}
+
+bool ConfigManager::load(const std::string& path) {
+    GameConfig config = m_config;
+    if (!parse(path, config)) {
+        return false;
     }
 
+    m_config = config;
     m_configPath = path;
+    m_reloadPath = path;
+    std::error_code ec;
+    m_lastWriteTime = fs::last_write_time(path, ec);
+    publish();
+    return true;
+}
+
+void ConfigManager::publish() {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    m_snapshots.push_back(std::make_unique<const GameConfig>(m_config));
+    m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+bool ConfigManager::pollReload() {
+    if (m_reloadPath.empty()) {
+        return false;
+    }
+
+    // A stat per frame is cheap but pointless; check a few times a second
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_nextPoll) {
+        return false;
+    }
+    m_nextPoll = now + std::chrono::milliseconds(RELOAD_POLL_MS);
+
+    std::error_code ec;
+    auto writeTime = fs::last_write_time(m_reloadPath, ec);
+    if (ec || writeTime == m_lastWriteTime) {
+        return false;
+    }
+    m_lastWriteTime = writeTime;
+
+    GameConfig config = m_config;
+    if (!parse(m_reloadPath, config)) {
+        // Probably caught mid-save; the next write retries
+        return false;
+    }
+
+    // Window, path and streaming settings are applied once at startup
+    config.windowWidth = m_config.windowWidth;
+    config.windowHeight = m_config.windowHeight;
+    config.fullscreen = m_config.fullscreen;
+    config.vsync = m_config.vsync;
+    config.gamePath = m_config.gamePath;
+    config.assetsPath = m_config.assetsPath;
+    config.savePath = m_config.savePath;
+    config.loaderThreads = m_config.loaderThreads;
+    config.jobThreads = m_config.jobThreads;
+
+    m_config = config;
+    publish();
+    std::cout << "ConfigManager: Reloaded " << m_reloadPath << "\n";
     return true;
 }
 
@@ -123,6 +201,8 @@ bool ConfigManager::save(const std::string& path) const {
     file << "[Graphics]\n";
     file << "l RenderScale = " << m_config.renderScale << "\n";
     file << "b SmoothScaling = " << (m_config.smoothScaling ? "TRUE" : "FALSE") << "\n";
+    file << "b AdaptiveScale = " << (m_config.adaptiveScale ? "TRUE" : "FALSE") << "\n";
+    file << "l MinRenderScale = " << m_config.minRenderScale << "\n";
     file << "b ShowFPS = " << (m_config.showFPS ? "TRUE" : "FALSE") << "\n";
     file << "\n";
 
@@ -149,11 +229,20 @@ bool ConfigManager::save(const std::string& path) const {
     file << "l Difficulty = " << m_config.difficulty << "\n";
     file << "\n";
 
+    // Streaming settings
+    file << "[Streaming]\n";
+    file << "l LoaderThreads = " << m_config.loaderThreads << "\n";
+    file << "l JobThreads = " << m_config.jobThreads << "\n";
+    file << "l UploadBudgetKB = " << m_config.uploadBudgetKB << "\n";
+    file << "f UploadBudgetMs = " << m_config.uploadBudgetMs << "\n";
+    file << "\n";
+
     // Debug settings
     file << "[Debug]\n";
     file << "b DebugMode = " << (m_config.debugMode ? "TRUE" : "FALSE") << "\n";
     file << "b ShowCollision = " << (m_config.showCollision ? "TRUE" : "FALSE") << "\n";
     file << "b ShowPathfinding = " << (m_config.showPathfinding ? "TRUE" : "FALSE") << "\n";
+    file << "b SerialFrames = " << (m_config.serialFrames ? "TRUE" : "FALSE") << "\n";
     file << "\n";
 
     file << "FITend\n";
@@ -1,10 +1,17 @@
 #ifndef MCGNG_CONFIG_H
 #define MCGNG_CONFIG_H
 
-#include <string>
-#include <variant>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <variant>
+#include <vector>
 
 namespace mcgng {
 
@@ -25,8 +32,10 @@ struct GameConfig {
     int targetFPS = 60;
 
     // Graphics settings
-    int renderScale = 100;      // Percentage (100 = native)
-    bool smoothScaling = true;
+    int renderScale = 100;      // World render resolution, percent of native (25-100)
+    bool smoothScaling = true;  // Linear upscale filter (false = nearest)
+    bool adaptiveScale = false; // Lower renderScale when frames run over budget
+    int minRenderScale = 50;    // Lower bound for adaptive scaling
     bool showFPS = false;
 
     // Audio settings
@@ -46,22 +55,40 @@ struct GameConfig {
     bool pauseOnFocusLoss = true;
     int difficulty = 1;         // 0=Easy, 1=Normal, 2=Hard
 
+    // Streaming
+    int loaderThreads = 0;      // Asset loads running at once on the job workers (0 = auto)
+    int jobThreads = 0;         // Job system workers (0 = auto)
+    int uploadBudgetKB = 2048;  // Texture upload budget per frame
+    float uploadBudgetMs = 2.0f;
+
     // Debug
     bool debugMode = false;
     bool showCollision = false;
     bool showPathfinding = false;
+    bool serialFrames = false;  // Run update and render back to back instead of overlapped
 };
 
 /**
  * Configuration manager.
  * Handles loading, saving, and accessing game settings.
+ *
+ * Settings are edited through get() (startup, command line, options
+ * screens) and made visible to the rest of the engine by publish(), which
+ * swaps in an immutable snapshot. snapshot() is a single atomic load, so
+ * per-frame readers never lock or touch the key/value extras. Published
+ * snapshots are kept until exit so references stay valid; reloads are rare
+ * and a GameConfig is small.
+ *
+ * pollReload() re-reads the loaded file when its modification time
+ * changes, so values like gameSpeed, targetFPS and volumes can be tuned
+ * while the game runs.
  */
 class ConfigManager {
 public:
     static ConfigManager& instance();
 
     /**
-     * Load configuration from file.
+     * Load configuration from file and publish it.
      * @param path Path to config file
      * @return true on success
      */
@@ -75,16 +102,40 @@ public:
     bool save(const std::string& path) const;
 
     /**
-     * Load default configuration.
+     * Load default configuration and publish it.
      */
     void loadDefaults();
 
     /**
-     * Get current configuration.
+     * Get the editable configuration. Changes are seen by snapshot()
+     * readers after publish().
      */
     GameConfig& get() { return m_config; }
     const GameConfig& get() const { return m_config; }
 
+    /**
+     * Publish the editable configuration as the current snapshot.
+     */
+    void publish();
+
+    /**
+     * Get the current published configuration (lock-free, any thread).
+     */
+    const GameConfig& snapshot() const { return *m_snapshot.load(std::memory_order_acquire); }
+
+    /**
+     * Get a counter bumped on every publish, for cheap change detection.
+     */
+    uint32_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+
+    /**
+     * Reload the file passed to load() if it changed on disk (main thread).
+     * Checks the modification time a few times a second. Window size,
+     * paths, vsync and loader threads keep their current values.
+     * @return true if a new snapshot was published
+     */
+    bool pollReload();
+
     /**
      * Get a named value from extras.
      */
@@ -102,11 +153,29 @@ public:
 
 private:
     ConfigManager();
-    ~ConfigManager() = default;
+    ~ConfigManager();
+
+    static constexpr int RELOAD_POLL_MS = 250;
+
+    /**
+     * Parse a config file over existing values.
+     */
+    static bool parse(const std::string& path, GameConfig& config);
 
     GameConfig m_config;
     std::map<std::string, ConfigValue> m_extras;
     std::string m_configPath;
+
+    // Published snapshots
+    std::mutex m_publishMutex;
+    std::vector<std::unique_ptr<const GameConfig>> m_snapshots;
+    std::atomic<const GameConfig*> m_snapshot{nullptr};
+    std::atomic<uint32_t> m_version{0};
+
+    // Hot reload
+    std::string m_reloadPath;
+    std::filesystem::file_time_type m_lastWriteTime{};
+    std::chrono::steady_clock::time_point m_nextPoll{};
 };
 
 } // namespace mcgng
@@ -1,6 +1,13 @@
 #include "core/engine.h"
+#include "core/asset_cache.h"
+#include "core/asset_manager.h"
 #include "core/config.h"
+#include "core/jobs.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include "assets/vfs.h"
 #include "graphics/renderer.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <thread>
@@ -33,6 +40,15 @@ bool Engine::initialize(const EngineOptions& options) {
     m_state = EngineState::Initializing;
     m_headless = options.headless;
     m_assetsPath = options.assetsPath;
+    m_tracePath = options.tracePath;
+    m_frameStatsPath = options.frameStatsPath;
+    m_fixedTargetFPS = options.targetFPS;
+    m_fixedGameSpeed = options.gameSpeed;
+
+    MCGNG_PROFILE_THREAD("Main");
+
+    // Log lines are written by a background thread from here on
+    Log::instance().initialize(options.logPath);
 
     std::cout << "Engine: Initializing...\n";
 
@@ -46,6 +62,7 @@ bool Engine::initialize(const EngineOptions& options) {
     if (!options.assetsPath.empty()) {
         config.get().assetsPath = options.assetsPath;
     }
+    config.publish();
 
     // Initialize subsystems
     if (!initializeSubsystems()) {
@@ -54,6 +71,14 @@ bool Engine::initialize(const EngineOptions& options) {
         return false;
     }
 
+    // Start the job workers and background asset loading
+    const auto& settings = config.snapshot();
+    JobSystem::instance().initialize(static_cast<size_t>(std::max(settings.jobThreads, 0)));
+    auto& assets = AssetManager::instance();
+    assets.initialize(static_cast<size_t>(std::max(settings.loaderThreads, 0)));
+    assets.setUploadBudget(static_cast<size_t>(std::max(settings.uploadBudgetKB, 0)) * 1024,
+                           settings.uploadBudgetMs);
+
     // Initialize timing
     auto now = std::chrono::high_resolution_clock::now();
     m_lastTime = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -71,7 +96,7 @@ bool Engine::initializeSubsystems() {
         return true;
     }
 
-    auto& config = ConfigManager::instance().get();
+    const auto& config = ConfigManager::instance().snapshot();
 
     // Initialize renderer
     auto& renderer = Renderer::instance();
@@ -98,8 +123,30 @@ void Engine::shutdown() {
     m_state = EngineState::ShuttingDown;
     std::cout << "Engine: Shutting down...\n";
 
+    // Stop loaders before the renderer so no upload outlives it
+    AssetManager::instance().shutdown();
+    JobSystem::instance().shutdown();
+    AssetCache::instance().printUsage();
+    AssetCache::instance().clear();
+    Vfs::instance().unmountAll();
     shutdownSubsystems();
 
+    if (m_frameStats.getFrameCount() > 0) {
+        m_frameStats.printSummary();
+        if (!m_frameStatsPath.empty()) {
+            m_frameStats.writeFile(m_frameStatsPath);
+        }
+    }
+
+#ifdef MCGNG_ENABLE_PROFILER
+    if (!m_tracePath.empty()) {
+        Profiler::instance().dumpChromeTrace(m_tracePath);
+    }
+#endif
+
+    // Write out queued log lines; later ones are written synchronously
+    Log::instance().shutdown();
+
     m_state = EngineState::Terminated;
     std::cout << "Engine: Shutdown complete\n";
 }
@@ -116,24 +163,46 @@ void Engine::run() {
         return;
     }
 
-    const auto& config = ConfigManager::instance().get();
-    const float targetFrameTime = config.targetFPS > 0 ? 1.0f / config.targetFPS : 0.0f;
+    auto& configManager = ConfigManager::instance();
+    uint32_t configVersion = configManager.getVersion();
+    applyConfig(configManager.snapshot());
 
     std::cout << "Engine: Starting main loop\n";
 
+    auto frameStart = std::chrono::steady_clock::now();
     while (!m_quitRequested && (m_state == EngineState::Running || m_state == EngineState::Paused)) {
-        auto frameStart = std::chrono::high_resolution_clock::now();
+        m_frameTiming = FrameTiming();
+
+        // Pick up config file edits and settings changed in game
+        configManager.pollReload();
+        if (configManager.getVersion() != configVersion) {
+            configVersion = configManager.getVersion();
+            applyConfig(configManager.snapshot());
+        }
 
+        MCGNG_PROFILE_FRAME_BEGIN();
         processFrame();
+        MCGNG_PROFILE_FRAME_END();
 
         // Frame rate limiting
-        if (targetFrameTime > 0.0f) {
-            auto frameEnd = std::chrono::high_resolution_clock::now();
-            float frameTime = std::chrono::duration<float>(frameEnd - frameStart).count();
+        {
+            MCGNG_PROFILE_ZONE("Engine::sleep");
+            m_frameTiming[FramePhase::Sleep] = m_frameLimiter.wait();
+        }
+
+        auto frameEnd = std::chrono::steady_clock::now();
+        m_frameTiming[FramePhase::Total] =
+            std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+        frameStart = frameEnd;
+
+        m_frameStats.record(m_frameTiming);
 
-            if (frameTime < targetFrameTime) {
-                auto sleepTime = std::chrono::duration<float>(targetFrameTime - frameTime);
-                std::this_thread::sleep_for(sleepTime);
+        // Trade world resolution for frame time on slow machines
+        if (m_adaptiveScale) {
+            int scale = m_scaleController.update(m_frameTiming);
+            auto& renderer = Renderer::instance();
+            if (scale != renderer.getRenderScale()) {
+                renderer.setRenderScale(scale);
             }
         }
     }
@@ -141,7 +210,44 @@ void Engine::run() {
     std::cout << "Engine: Main loop ended\n";
 }
 
+void Engine::applyConfig(const GameConfig& config) {
+    // Frame pacing, game speed and world resolution (UI stays native).
+    // Values fixed through EngineOptions win over the reloadable config.
+    const int targetFPS = m_fixedTargetFPS >= 0 ? m_fixedTargetFPS : config.targetFPS;
+    const double targetFrameTime = targetFPS > 0 ? 1.0 / targetFPS : 0.0;
+    m_frameLimiter.setTargetFrameTime(targetFrameTime);
+    m_frameStats.setBudget(targetFPS > 0 ? 1000.0 / targetFPS : 1000.0 / 60.0);
+    m_gameSpeed = std::clamp(m_fixedGameSpeed > 0.0f ? m_fixedGameSpeed : config.gameSpeed, 0.1f, 4.0f);
+    m_pipelined = !config.serialFrames && !m_headless;
+    Log::instance().setLevel(config.debugMode ? LogLevel::Debug : LogLevel::Info);
+
+    // Restart the resolution controller only when its settings change, so
+    // unrelated edits keep the scale it settled on
+    const GameConfig* previous = m_appliedConfig;
+    bool scaleChanged = !previous || previous->renderScale != config.renderScale ||
+                        previous->minRenderScale != config.minRenderScale ||
+                        previous->adaptiveScale != config.adaptiveScale ||
+                        previous->targetFPS != config.targetFPS;
+    m_appliedConfig = &config;
+
+    m_adaptiveScale = config.adaptiveScale && !m_headless;
+    if (scaleChanged) {
+        m_scaleController.configure(config.minRenderScale, config.renderScale, m_frameStats.getBudget());
+    }
+    if (!m_headless) {
+        auto& renderer = Renderer::instance();
+        renderer.setScaleFilter(config.smoothScaling ? ScaleFilter::Linear : ScaleFilter::Nearest);
+        if (scaleChanged) {
+            renderer.setRenderScale(config.renderScale);
+        }
+    }
+}
+
 void Engine::processFrame() {
+    MCGNG_PROFILE_ZONE("Engine::processFrame");
+    using Clock = std::chrono::steady_clock;
+    auto phaseStart = Clock::now();
+
     // Calculate delta time
     auto now = std::chrono::high_resolution_clock::now();
     uint64_t currentTime = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -167,21 +273,36 @@ void Engine::processFrame() {
         m_fpsFrameCount = 0;
     }
 
-    // Process SDL events
+    // Process SDL events (never initialized when headless)
 #ifdef MCGNG_HAS_SDL2
-    SDL_Event event;
-    while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) {
-            m_quitRequested = true;
-            return;
-        }
-        if (event.type == SDL_KEYDOWN) {
-            if (event.key.keysym.sym == SDLK_ESCAPE) {
+    {
+        MCGNG_PROFILE_ZONE("Engine::pollEvents");
+        SDL_Event event;
+        while (!m_headless && SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
                 m_quitRequested = true;
                 return;
             }
-            if (event.key.keysym.sym == SDLK_F11) {
-                Renderer::instance().toggleFullscreen();
+            if (event.type == SDL_KEYDOWN) {
+                if (event.key.keysym.sym == SDLK_ESCAPE) {
+                    m_quitRequested = true;
+                    return;
+                }
+                if (event.key.keysym.sym == SDLK_F11) {
+                    Renderer::instance().toggleFullscreen();
+                }
+                if (event.key.keysym.sym == SDLK_F10) {
+                    m_frameStats.printSummary();
+                    AssetCache::instance().printUsage();
+                    m_frameStats.writeFile(
+                        m_frameStatsPath.empty() ? "mcgoldng_frames.csv" : m_frameStatsPath);
+                }
+#ifdef MCGNG_ENABLE_PROFILER
+                if (event.key.keysym.sym == SDLK_F9) {
+                    Profiler::instance().dumpChromeTrace(
+                        m_tracePath.empty() ? "mcgoldng_trace.json" : m_tracePath);
+                }
+#endif
             }
         }
     }
@@ -195,16 +316,45 @@ void Engine::processFrame() {
         }
     }
 
-    // Update (skip if paused)
-    if (m_state == EngineState::Running && m_updateCallback) {
-        m_updateCallback(m_deltaTime);
+    // Run jobs that were handed to the main thread
+    JobSystem::instance().processMainThreadJobs();
+
+    // Deliver finished asset loads; headless runs have no GPU to upload to
+    auto& assets = AssetManager::instance();
+    assets.update();
+    if (m_headless) {
+        assets.processUploads();
+    }
+
+    // Update (skip if paused). Pipelined, the next frame simulates while
+    // this one renders from the last snapshot and is joined before the
+    // frame ends, so the picture is never more than one frame behind.
+    auto& jobs = JobSystem::instance();
+    bool simulating = m_state == EngineState::Running && m_updateCallback;
+    bool overlapped = simulating && m_pipelined;
+    if (overlapped) {
+        float deltaTime = m_deltaTime * m_gameSpeed;
+        jobs.run([this, deltaTime]() { simulate(deltaTime); }, &m_simCounter);
+    } else if (simulating) {
+        simulate(m_deltaTime * m_gameSpeed);
     }
 
+    auto updateEnd = Clock::now();
+    m_frameTiming[FramePhase::Update] =
+        std::chrono::duration<double, std::milli>(updateEnd - phaseStart).count();
+
     // Render
     if (!m_headless) {
+        MCGNG_PROFILE_ZONE("Engine::render");
         auto& renderer = Renderer::instance();
         renderer.beginFrame();
 
+        // Create textures for streamed assets, within the per-frame budget
+        AssetManager::instance().processUploads();
+
+        // World pass, possibly at reduced resolution
+        renderer.beginWorld();
+
         // Clear with dark blue
         renderer.clear({20, 30, 50, 255});
 
@@ -227,8 +377,97 @@ void Engine::processFrame() {
             m_renderCallback();
         }
 
-        renderer.endFrame();
+        // Upscale the world, then draw the overlay at native resolution
+        renderer.endWorld();
+        if (m_overlayCallback) {
+            m_overlayCallback();
+        }
+
+        drawProfilerOverlay();
+
+        auto renderEnd = Clock::now();
+        m_frameTiming[FramePhase::Render] =
+            std::chrono::duration<double, std::milli>(renderEnd - updateEnd).count();
+
+        {
+            MCGNG_PROFILE_ZONE("Renderer::present");
+            renderer.endFrame();
+        }
+
+        m_frameTiming[FramePhase::Present] =
+            std::chrono::duration<double, std::milli>(Clock::now() - renderEnd).count();
+    }
+
+    // Simulation time that rendering did not hide counts as update time
+    if (overlapped) {
+        MCGNG_PROFILE_ZONE("Engine::waitSimulation");
+        auto waitStart = Clock::now();
+        jobs.wait(m_simCounter);
+        m_frameTiming[FramePhase::Update] +=
+            std::chrono::duration<double, std::milli>(Clock::now() - waitStart).count();
+    }
+}
+
+void Engine::simulate(float deltaTime) {
+    {
+        MCGNG_PROFILE_ZONE("Engine::update");
+        m_updateCallback(deltaTime);
+    }
+    if (m_captureCallback) {
+        MCGNG_PROFILE_ZONE("Engine::capture");
+        m_captureCallback();
+    }
+}
+
+void Engine::drawProfilerOverlay() {
+#ifdef MCGNG_ENABLE_PROFILER
+    const auto& config = ConfigManager::instance().snapshot();
+    if (!config.showFPS && !config.debugMode) {
+        return;
+    }
+
+    // Stacked bar of last frame's top-level zones, scaled to the frame
+    // budget; second row shows their children. Overruns are drawn in red.
+    static const Color ZONE_COLORS[] = {
+        {230, 80, 80, 220}, {80, 200, 90, 220}, {80, 140, 230, 220}, {230, 200, 60, 220},
+        {200, 90, 220, 220}, {60, 210, 210, 220}, {240, 140, 50, 220}, {160, 160, 160, 220}
+    };
+    constexpr int COLOR_COUNT = static_cast<int>(sizeof(ZONE_COLORS) / sizeof(ZONE_COLORS[0]));
+
+    const int barX = 10;
+    const int barY = 40;
+    const int barWidth = 300;
+    const int rowHeight = 8;
+
+    const double budgetMs = config.targetFPS > 0 ? 1000.0 / config.targetFPS : 1000.0 / 60.0;
+    const double pixelsPerMs = barWidth / budgetMs;
+
+    auto& renderer = Renderer::instance();
+    renderer.setDrawColor({0, 0, 0, 160});
+    renderer.drawRect({barX - 2, barY - 2, barWidth + 4, rowHeight * 2 + 6});
+
+    const auto& zones = Profiler::instance().getLastFrameBreakdown();
+    int offsets[2] = {0, 0};
+    int colorIndex = 0;
+    for (const auto& zone : zones) {
+        int row = static_cast<int>(zone.depth);
+        int width = std::max(1, static_cast<int>(zone.milliseconds * pixelsPerMs));
+        width = std::min(width, barWidth - offsets[row]);
+        if (width <= 0) {
+            continue;
+        }
+
+        renderer.setDrawColor(ZONE_COLORS[colorIndex++ % COLOR_COUNT]);
+        renderer.drawRect({barX + offsets[row], barY + row * (rowHeight + 2), width, rowHeight});
+        offsets[row] += width;
     }
+
+    // Whole-frame marker against the budget
+    double frameMs = Profiler::instance().getLastFrameTime();
+    int frameWidth = std::min(barWidth, static_cast<int>(frameMs * pixelsPerMs));
+    renderer.setDrawColor(frameMs > budgetMs ? Color{255, 40, 40, 255} : Color{255, 255, 255, 255});
+    renderer.drawRectOutline({barX, barY, std::max(1, frameWidth), rowHeight * 2 + 2});
+#endif
 }
 
 void Engine::quit() {
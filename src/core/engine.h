@@ -5,11 +5,14 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include "core/frame_stats.h"
+#include "core/jobs.h"
 
 namespace mcgng {
 
 // Forward declarations
 class ConfigManager;
+struct GameConfig;
 
 /**
  * Engine state enumeration.
@@ -27,6 +30,7 @@ enum class EngineState {
  * Main game loop callback types.
  */
 using UpdateCallback = std::function<void(float deltaTime)>;
+using CaptureCallback = std::function<void()>;
 using RenderCallback = std::function<void()>;
 using EventCallback = std::function<bool()>;  // Return false to quit
 
@@ -37,7 +41,12 @@ struct EngineOptions {
     std::string windowTitle = "MechCommander Gold: Next Generation";
     std::string configPath;         // Path to config file (optional)
     std::string assetsPath;         // Path to extracted assets
-    bool headless = false;          // Run without graphics (for tools)
+    bool headless = false;          // Run without graphics or input (tools, dedicated server)
+    std::string tracePath;          // Write a profiler trace here on shutdown (optional)
+    std::string frameStatsPath;     // Write frame statistics (.csv/.json) on shutdown (optional)
+    std::string logPath;            // Also write timestamped log lines here (optional)
+    int targetFPS = -1;             // Pace at this rate instead of the config's, across reloads (0 = unpaced, -1 = config)
+    float gameSpeed = 0.0f;         // Game speed instead of the config's, across reloads (0 = config)
 };
 
 /**
@@ -102,16 +111,40 @@ public:
      */
     void setUpdateCallback(UpdateCallback callback) { m_updateCallback = std::move(callback); }
 
+    /**
+     * Set the capture callback. Runs after every update on the same thread
+     * and should publish the render snapshot (see RenderState).
+     */
+    void setCaptureCallback(CaptureCallback callback) { m_captureCallback = std::move(callback); }
+
     /**
      * Set the render callback.
+     * When pipelined, it runs while the next frame is simulated, so it
+     * must draw from the published snapshot rather than live game state.
      */
     void setRenderCallback(RenderCallback callback) { m_renderCallback = std::move(callback); }
 
+    /**
+     * Set the overlay callback (UI, HUD). Runs after the world has been
+     * upscaled, so it always draws at native resolution.
+     */
+    void setOverlayCallback(RenderCallback callback) { m_overlayCallback = std::move(callback); }
+
     /**
      * Set the event callback.
      */
     void setEventCallback(EventCallback callback) { m_eventCallback = std::move(callback); }
 
+    /**
+     * Check if running without renderer and input (dedicated server, tools).
+     */
+    bool isHeadless() const { return m_headless; }
+
+    /**
+     * Check if simulation and rendering overlap (SerialFrames off).
+     */
+    bool isPipelined() const { return m_pipelined; }
+
     /**
      * Get delta time from last frame.
      */
@@ -132,6 +165,11 @@ public:
      */
     uint64_t getFrameCount() const { return m_frameCount; }
 
+    /**
+     * Get frame timing statistics.
+     */
+    const FrameStats& getFrameStats() const { return m_frameStats; }
+
     /**
      * Get the assets path.
      */
@@ -147,6 +185,9 @@ private:
     bool initializeSubsystems();
     void shutdownSubsystems();
     void processFrame();
+    void simulate(float deltaTime);
+    void drawProfilerOverlay();
+    void applyConfig(const GameConfig& config);
 
     EngineState m_state = EngineState::Uninitialized;
     bool m_quitRequested = false;
@@ -162,12 +203,31 @@ private:
     float m_fpsAccumulator = 0.0f;
     int m_fpsFrameCount = 0;
 
+    // Frame pacing and telemetry
+    FrameStats m_frameStats;
+    FrameLimiter m_frameLimiter;
+    FrameTiming m_frameTiming;
+    RenderScaleController m_scaleController;
+    bool m_adaptiveScale = false;
+    const GameConfig* m_appliedConfig = nullptr;  // Last applied snapshot (kept until exit)
+    float m_gameSpeed = 1.0f;  // Scales the update callback's delta time
+    int m_fixedTargetFPS = -1;      // EngineOptions overrides, not reloadable
+    float m_fixedGameSpeed = 0.0f;
+
+    // Simulation of frame N+1 runs as a job while frame N renders
+    bool m_pipelined = false;
+    JobCounter m_simCounter;
+
     // Paths
     std::string m_assetsPath;
+    std::string m_tracePath;
+    std::string m_frameStatsPath;
 
     // Callbacks
     UpdateCallback m_updateCallback;
+    CaptureCallback m_captureCallback;
     RenderCallback m_renderCallback;
+    RenderCallback m_overlayCallback;
     EventCallback m_eventCallback;
 
     // Headless mode (no graphics)
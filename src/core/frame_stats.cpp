@@ -0,0 +1,278 @@
+#include "core/frame_stats.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace mcgng {
+
+// FrameHistogram implementation
+
+FrameHistogram::FrameHistogram() : m_buckets(BUCKET_COUNT, 0) {
+}
+
+void FrameHistogram::record(double ms) {
+    if (ms < 0.0) {
+        ms = 0.0;
+    }
+
+    size_t bucket = static_cast<size_t>(ms / BUCKET_MS);
+    m_buckets[std::min(bucket, BUCKET_COUNT - 1)]++;
+
+    m_count++;
+    m_sum += ms;
+    m_max = std::max(m_max, ms);
+}
+
+void FrameHistogram::reset() {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_max = 0.0;
+}
+
+double FrameHistogram::percentile(double fraction) const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(m_count - 1)) + 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // Report the bucket's upper edge, never more than the true max
+            return std::min((static_cast<double>(i) + 1.0) * BUCKET_MS, m_max);
+        }
+    }
+    return m_max;
+}
+
+FramePhaseSummary FrameHistogram::summarize() const {
+    FramePhaseSummary summary;
+    summary.count = m_count;
+    if (m_count > 0) {
+        summary.mean = m_sum / static_cast<double>(m_count);
+        summary.p50 = percentile(0.50);
+        summary.p95 = percentile(0.95);
+        summary.p99 = percentile(0.99);
+        summary.max = m_max;
+    }
+    return summary;
+}
+
+// FrameStats implementation
+
+FrameStats::FrameStats() = default;
+
+const char* FrameStats::getPhaseName(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::Update:  return "update";
+        case FramePhase::Render:  return "render";
+        case FramePhase::Present: return "present";
+        case FramePhase::Sleep:   return "sleep";
+        case FramePhase::Total:   return "total";
+        default:                  return "unknown";
+    }
+}
+
+void FrameStats::record(const FrameTiming& timing) {
+    for (size_t i = 0; i < FRAME_PHASE_COUNT; ++i) {
+        m_histograms[i].record(timing.ms[i]);
+    }
+
+    // Sleeping is not work; judge the frame on what it actually cost
+    double busy = timing[FramePhase::Total] - timing[FramePhase::Sleep];
+    if (busy > m_budgetMs) {
+        m_overBudget++;
+    }
+    if (timing[FramePhase::Total] > m_budgetMs * 2.0) {
+        m_hitches++;
+    }
+
+    m_last = timing;
+}
+
+void FrameStats::reset() {
+    for (auto& histogram : m_histograms) {
+        histogram.reset();
+    }
+    m_last = FrameTiming();
+    m_overBudget = 0;
+    m_hitches = 0;
+}
+
+FramePhaseSummary FrameStats::getSummary(FramePhase phase) const {
+    return m_histograms[static_cast<size_t>(phase)].summarize();
+}
+
+bool FrameStats::writeCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "FrameStats: Failed to open: " << path << "\n";
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "phase,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    for (size_t i = 0; i < FRAME_PHASE_COUNT; ++i) {
+        FramePhaseSummary s = m_histograms[i].summarize();
+        file << getPhaseName(static_cast<FramePhase>(i)) << ","
+             << s.count << "," << s.mean << "," << s.p50 << ","
+             << s.p95 << "," << s.p99 << "," << s.max << "\n";
+    }
+    file << "# budget_ms=" << m_budgetMs
+         << " over_budget=" << m_overBudget
+         << " hitches=" << m_hitches << "\n";
+
+    std::cout << "FrameStats: Wrote " << path << "\n";
+    return static_cast<bool>(file);
+}
+
+bool FrameStats::writeJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "FrameStats: Failed to open: " << path << "\n";
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\n";
+    file << "  \"frames\": " << getFrameCount() << ",\n";
+    file << "  \"budget_ms\": " << m_budgetMs << ",\n";
+    file << "  \"over_budget\": " << m_overBudget << ",\n";
+    file << "  \"hitches\": " << m_hitches << ",\n";
+    file << "  \"phases\": {\n";
+    for (size_t i = 0; i < FRAME_PHASE_COUNT; ++i) {
+        FramePhaseSummary s = m_histograms[i].summarize();
+        file << "    \"" << getPhaseName(static_cast<FramePhase>(i)) << "\": {"
+             << "\"count\": " << s.count
+             << ", \"mean_ms\": " << s.mean
+             << ", \"p50_ms\": " << s.p50
+             << ", \"p95_ms\": " << s.p95
+             << ", \"p99_ms\": " << s.p99
+             << ", \"max_ms\": " << s.max << "}"
+             << (i + 1 < FRAME_PHASE_COUNT ? ",\n" : "\n");
+    }
+    file << "  }\n";
+    file << "}\n";
+
+    std::cout << "FrameStats: Wrote " << path << "\n";
+    return static_cast<bool>(file);
+}
+
+bool FrameStats::writeFile(const std::string& path) const {
+    std::string ext = path.size() >= 5 ? path.substr(path.size() - 5) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".json") {
+        return writeJson(path);
+    }
+    return writeCsv(path);
+}
+
+void FrameStats::printSummary() const {
+    std::cout << "FrameStats: " << getFrameCount() << " frames, budget "
+              << std::fixed << std::setprecision(2) << m_budgetMs << " ms, "
+              << m_overBudget << " over budget, " << m_hitches << " hitches\n";
+    for (size_t i = 0; i < FRAME_PHASE_COUNT; ++i) {
+        FramePhaseSummary s = m_histograms[i].summarize();
+        std::cout << "  " << std::left << std::setw(8) << getPhaseName(static_cast<FramePhase>(i))
+                  << std::right
+                  << " p50 " << std::setw(7) << s.p50
+                  << "  p95 " << std::setw(7) << s.p95
+                  << "  p99 " << std::setw(7) << s.p99
+                  << "  max " << std::setw(7) << s.max << " ms\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+// FrameLimiter implementation
+
+void FrameLimiter::setTargetFrameTime(double seconds) {
+    m_target = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(0.0, seconds)));
+    reset();
+}
+
+void FrameLimiter::reset() {
+    m_started = false;
+}
+
+double FrameLimiter::wait() {
+    if (m_target.count() <= 0) {
+        return 0.0;
+    }
+
+    Clock::time_point start = Clock::now();
+    if (!m_started) {
+        m_deadline = start + m_target;
+        m_started = true;
+        return 0.0;
+    }
+
+    // Coarse sleep up to the spin margin
+    auto margin = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(m_spinMargin));
+    Clock::time_point wakeTarget = m_deadline - margin;
+    if (start < wakeTarget) {
+        std::this_thread::sleep_until(wakeTarget);
+
+        // Track the scheduler's overshoot so the margin follows reality
+        double overshoot = std::chrono::duration<double>(Clock::now() - wakeTarget).count();
+        m_spinMargin = std::max(m_spinMargin * 0.99, overshoot + 0.00025);
+        m_spinMargin = std::clamp(m_spinMargin, 0.0005, 0.004);
+    }
+
+    // Fine wait for the remainder
+    while (Clock::now() < m_deadline) {
+        std::this_thread::yield();
+    }
+
+    Clock::time_point end = Clock::now();
+
+    // Fixed cadence; resync if we fell more than a frame behind
+    m_deadline += m_target;
+    if (end > m_deadline) {
+        m_deadline = end + m_target;
+    }
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// RenderScaleController implementation
+
+void RenderScaleController::configure(int minScale, int maxScale, double budgetMs) {
+    m_maxScale = std::clamp(maxScale, 25, 100);
+    m_minScale = std::clamp(minScale, 25, m_maxScale);
+    m_scale = m_maxScale;
+    m_budgetMs = budgetMs > 0.0 ? budgetMs : 1000.0 / 60.0;
+    m_smoothedMs = 0.0;
+    m_cooldown = COOLDOWN_FRAMES;
+}
+
+int RenderScaleController::update(const FrameTiming& timing) {
+    double busyMs = std::max(0.0, timing[FramePhase::Total] - timing[FramePhase::Sleep]);
+    m_smoothedMs = m_smoothedMs > 0.0 ? m_smoothedMs * 0.9 + busyMs * 0.1 : busyMs;
+
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return m_scale;
+    }
+
+    if (m_smoothedMs > m_budgetMs * 1.05 && m_scale > m_minScale) {
+        m_scale = std::max(m_minScale, m_scale - STEP_DOWN);
+        m_cooldown = COOLDOWN_FRAMES;
+    } else if (m_smoothedMs < m_budgetMs * 0.75 && m_scale < m_maxScale) {
+        m_scale = std::min(m_maxScale, m_scale + STEP_UP);
+        m_cooldown = COOLDOWN_FRAMES;
+    }
+    return m_scale;
+}
+
+} // namespace mcgng
@@ -0,0 +1,227 @@
+#ifndef MCGNG_FRAME_STATS_H
+#define MCGNG_FRAME_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Phases of a single frame that are timed separately.
+ */
+enum class FramePhase {
+    Update,     // Event processing and game update
+    Render,     // Draw call submission
+    Present,    // Renderer::endFrame (buffer swap / vsync wait)
+    Sleep,      // Frame limiter wait
+    Total,      // Start of frame to start of next frame
+    Count
+};
+
+constexpr size_t FRAME_PHASE_COUNT = static_cast<size_t>(FramePhase::Count);
+
+/**
+ * Durations of one frame, in milliseconds.
+ */
+struct FrameTiming {
+    std::array<double, FRAME_PHASE_COUNT> ms{};
+
+    double& operator[](FramePhase phase) { return ms[static_cast<size_t>(phase)]; }
+    double operator[](FramePhase phase) const { return ms[static_cast<size_t>(phase)]; }
+};
+
+/**
+ * Summary statistics for one phase.
+ */
+struct FramePhaseSummary {
+    uint64_t count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * Fixed-size frame time histogram.
+ *
+ * Samples are bucketed at 0.05 ms resolution up to MAX_MS; anything larger
+ * lands in the last bucket but still updates the exact maximum. Recording is
+ * constant time and never allocates, so it is safe to call every frame.
+ */
+class FrameHistogram {
+public:
+    static constexpr double BUCKET_MS = 0.05;
+    static constexpr double MAX_MS = 250.0;
+    static constexpr size_t BUCKET_COUNT = static_cast<size_t>(MAX_MS / BUCKET_MS) + 1;
+
+    FrameHistogram();
+
+    void record(double ms);
+    void reset();
+
+    /**
+     * Get the value below which the given fraction of samples fall.
+     * @param fraction Percentile in the range [0, 1]
+     */
+    double percentile(double fraction) const;
+
+    FramePhaseSummary summarize() const;
+
+    uint64_t getCount() const { return m_count; }
+
+private:
+    std::vector<uint32_t> m_buckets;
+    uint64_t m_count = 0;
+    double m_sum = 0.0;
+    double m_max = 0.0;
+};
+
+/**
+ * Frame timing telemetry.
+ *
+ * Keeps one histogram per frame phase plus over-budget and hitch counters.
+ * A frame is over budget when its busy time (total minus limiter sleep)
+ * exceeds the target frame time, and a hitch when its total time, sleep
+ * included, exceeds twice the target.
+ */
+class FrameStats {
+public:
+    FrameStats();
+
+    /**
+     * Set the frame budget in milliseconds (1000 / targetFPS).
+     */
+    void setBudget(double budgetMs) { m_budgetMs = budgetMs; }
+    double getBudget() const { return m_budgetMs; }
+
+    /**
+     * Record one completed frame.
+     */
+    void record(const FrameTiming& timing);
+
+    /**
+     * Clear all recorded samples.
+     */
+    void reset();
+
+    FramePhaseSummary getSummary(FramePhase phase) const;
+
+    uint64_t getFrameCount() const { return m_histograms[static_cast<size_t>(FramePhase::Total)].getCount(); }
+    uint64_t getOverBudgetCount() const { return m_overBudget; }
+    uint64_t getHitchCount() const { return m_hitches; }
+    const FrameTiming& getLastFrame() const { return m_last; }
+
+    /**
+     * Write per-phase summaries as CSV.
+     * @return true on success
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * Write per-phase summaries as JSON.
+     * @return true on success
+     */
+    bool writeJson(const std::string& path) const;
+
+    /**
+     * Write CSV or JSON depending on the file extension.
+     */
+    bool writeFile(const std::string& path) const;
+
+    /**
+     * Print a one-line-per-phase summary to stdout.
+     */
+    void printSummary() const;
+
+    static const char* getPhaseName(FramePhase phase);
+
+private:
+    std::array<FrameHistogram, FRAME_PHASE_COUNT> m_histograms;
+    FrameTiming m_last;
+    double m_budgetMs = 1000.0 / 60.0;
+    uint64_t m_overBudget = 0;
+    uint64_t m_hitches = 0;
+};
+
+/**
+ * Hybrid sleep/spin frame limiter.
+ *
+ * sleep_for routinely overshoots by a millisecond or more, which is enough
+ * to miss a 60 Hz deadline. The limiter sleeps until shortly before the
+ * deadline, then yields in a loop for the remainder. The spin margin tracks
+ * the worst recently observed sleep overshoot.
+ */
+class FrameLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Set the target frame time in seconds (0 disables limiting).
+     */
+    void setTargetFrameTime(double seconds);
+
+    /**
+     * Wait until the next frame deadline.
+     * @return Time spent waiting in milliseconds
+     */
+    double wait();
+
+    /**
+     * Restart pacing from now (e.g. after a pause or long load).
+     */
+    void reset();
+
+    double getSpinMargin() const { return m_spinMargin; }
+
+private:
+    Clock::duration m_target{};
+    Clock::time_point m_deadline{};
+    double m_spinMargin = 0.002;  // Seconds
+    bool m_started = false;
+};
+
+/**
+ * Adaptive render scale.
+ *
+ * Watches the busy part of each frame (total minus limiter sleep) and
+ * steps the internal render resolution down when frames run over budget
+ * and back up once there is headroom again. Decisions use a smoothed
+ * frame time and a cooldown, so single hitches and the frames right after
+ * a change do not cause oscillation.
+ */
+class RenderScaleController {
+public:
+    /**
+     * Set the allowed range and the starting scale (percent).
+     */
+    void configure(int minScale, int maxScale, double budgetMs);
+
+    /**
+     * Feed one frame.
+     * @return Render scale (percent) to use from the next frame on
+     */
+    int update(const FrameTiming& timing);
+
+    int getScale() const { return m_scale; }
+    double getSmoothedMs() const { return m_smoothedMs; }
+
+private:
+    static constexpr int STEP_DOWN = 10;        // Percent per decrease
+    static constexpr int STEP_UP = 5;           // Percent per increase
+    static constexpr int COOLDOWN_FRAMES = 30;  // Frames between changes
+
+    int m_minScale = 50;
+    int m_maxScale = 100;
+    int m_scale = 100;
+    double m_budgetMs = 1000.0 / 60.0;
+    double m_smoothedMs = 0.0;
+    int m_cooldown = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_FRAME_STATS_H
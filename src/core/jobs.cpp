@@ -0,0 +1,284 @@
+#include "core/jobs.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <string>
+
+namespace mcgng {
+
+namespace {
+
+// Index of the calling thread's queue: 0 for non-workers, i + 1 for worker i
+thread_local size_t t_queueIndex = 0;
+
+} // anonymous namespace
+
+JobSystem& JobSystem::instance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+bool JobSystem::initialize(size_t workerCount) {
+    if (m_initialized) {
+        return true;
+    }
+
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    m_mainThread = std::this_thread::get_id();
+    m_stopping = false;
+    m_queues.clear();
+    for (size_t i = 0; i <= workerCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+
+    m_initialized = true;
+    MCGNG_LOG_INFO(Core, "JobSystem: Started {} worker threads", workerCount);
+    return true;
+}
+
+void JobSystem::shutdown() {
+    if (!m_initialized) {
+        return;
+    }
+
+    // Workers drain their queues before exiting
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    // Anything pushed from the main thread with no workers, then main-thread jobs
+    Job job;
+    while (popOwn(job)) {
+        execute(job);
+    }
+    processMainThreadJobs();
+
+    m_queues.clear();
+    m_initialized = false;
+}
+
+void JobSystem::run(std::function<void()> function, JobCounter* counter) {
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job job{std::move(function), counter};
+
+    if (!m_initialized) {
+        execute(job);
+        return;
+    }
+    push(std::move(job));
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter) {
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job job{std::move(function), counter};
+
+    {
+        // Checked under the lock that the finishing job takes to release continuations
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.isDone()) {
+            dependency.m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+
+    if (!m_initialized) {
+        execute(job);
+        return;
+    }
+    push(std::move(job));
+}
+
+void JobSystem::runOnMainThread(std::function<void()> function, JobCounter* counter) {
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(m_mainQueue.mutex);
+    m_mainQueue.jobs.push_back(Job{std::move(function), counter});
+}
+
+void JobSystem::push(Job job) {
+    size_t index = t_queueIndex < m_queues.size() ? t_queueIndex : 0;
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(std::move(job));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep lock orders this push before a sleeper's predicate check
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+}
+
+bool JobSystem::popOwn(Job& job) {
+    if (t_queueIndex >= m_queues.size()) {
+        return false;
+    }
+    WorkQueue& queue = *m_queues[t_queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(Job& job, size_t start) {
+    const size_t count = m_queues.size();
+    for (size_t i = 0; i < count; ++i) {
+        size_t index = (start + i) % count;
+        if (index == t_queueIndex) {
+            continue;
+        }
+        WorkQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::popMainThread(Job& job) {
+    std::lock_guard<std::mutex> lock(m_mainQueue.mutex);
+    if (m_mainQueue.jobs.empty()) {
+        return false;
+    }
+    job = std::move(m_mainQueue.jobs.front());
+    m_mainQueue.jobs.pop_front();
+    return true;
+}
+
+bool JobSystem::tryRunOne() {
+    Job job;
+    if ((isMainThread() && popMainThread(job)) || popOwn(job) || steal(job, t_queueIndex + 1)) {
+        execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Job& job) {
+    job.function();
+
+    JobCounter* counter = job.counter;
+    if (!counter) {
+        return;
+    }
+    uint32_t pending = counter->m_pending.load(std::memory_order_relaxed);
+    while (pending > 1) {
+        if (counter->m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+
+    // Possibly the last job of the group. The final decrement happens under
+    // the lock so runAfter() and wait() see it together with the continuations.
+    std::vector<Job> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        continuations.swap(counter->m_continuations);
+    }
+    for (Job& continuation : continuations) {
+        if (m_initialized) {
+            push(std::move(continuation));
+        } else {
+            execute(continuation);
+        }
+    }
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!tryRunOne()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // The finishing job may still hold the lock; the counter can be destroyed once it lets go
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) {
+        return;
+    }
+    const size_t count = end - begin;
+    if (grain == 0) {
+        size_t chunks = (m_workers.size() + 1) * 4;
+        grain = std::max<size_t>(1, (count + chunks - 1) / chunks);
+    }
+    if (count <= grain || m_workers.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t start = begin; start < end; start += grain) {
+        size_t stop = std::min(end, start + grain);
+        run([&body, start, stop]() { body(start, stop); }, &counter);
+    }
+    wait(counter);
+}
+
+size_t JobSystem::processMainThreadJobs() {
+    size_t count = 0;
+    Job job;
+    while (popMainThread(job)) {
+        execute(job);
+        ++count;
+    }
+    return count;
+}
+
+void JobSystem::workerLoop(size_t index) {
+    t_queueIndex = index + 1;
+    MCGNG_PROFILE_THREAD("JobWorker" + std::to_string(index));
+
+    while (true) {
+        if (tryRunOne()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() {
+            return m_queued.load(std::memory_order_acquire) > 0 || m_stopping;
+        });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+    }
+}
+
+} // namespace mcgng
@@ -0,0 +1,169 @@
+#ifndef MCGNG_JOBS_H
+#define MCGNG_JOBS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcgng {
+
+class JobCounter;
+
+/**
+ * A unit of work. Jobs must not throw.
+ */
+struct Job {
+    std::function<void()> function;
+    JobCounter* counter = nullptr;      // Decremented when the job finishes
+};
+
+/**
+ * Completion counter for a group of jobs.
+ *
+ * Every job scheduled with a counter increments it and decrements it when
+ * done. Jobs scheduled with runAfter() start once the counter reaches zero,
+ * which is how dependencies are expressed. A counter must outlive its jobs
+ * and any runAfter() continuations; after JobSystem::wait() returns it is
+ * safe to destroy (isDone() alone does not guarantee that).
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+    uint32_t getPending() const { return m_pending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_pending{0};
+    std::mutex m_mutex;                 // Guards m_continuations
+    std::vector<Job> m_continuations;
+};
+
+/**
+ * Work-stealing job scheduler.
+ *
+ * Each worker owns a deque: it pushes and pops its own jobs at the back
+ * (newest first, cache-warm) and steals from the front of other deques
+ * when it runs dry. Jobs scheduled from other threads go to a shared
+ * injection deque that workers steal from. Idle workers sleep.
+ *
+ * Threads that wait() on a counter run jobs while they wait, so waiting
+ * from inside a job cannot deadlock the pool and parallelFor() also makes
+ * progress with zero workers.
+ *
+ * Jobs that must run on the main thread (SDL calls, texture creation) go
+ * through runOnMainThread(); they run in processMainThreadJobs() or while
+ * the main thread waits.
+ */
+class JobSystem {
+public:
+    static JobSystem& instance();
+
+    /**
+     * Start the workers.
+     * Call from the main thread; it becomes the main-thread affinity target.
+     * @param workerCount Worker threads (0 = hardware concurrency - 1)
+     */
+    bool initialize(size_t workerCount = 0);
+
+    /**
+     * Finish queued jobs and stop the workers.
+     */
+    void shutdown();
+
+    bool isInitialized() const { return m_initialized; }
+
+    /**
+     * Get number of worker threads (not counting the main thread).
+     */
+    size_t getWorkerCount() const { return m_workers.size(); }
+
+    /**
+     * Schedule a job on any worker.
+     * @param counter Optional counter to track completion
+     */
+    void run(std::function<void()> function, JobCounter* counter = nullptr);
+
+    /**
+     * Schedule a job to start after every job tracked by a dependency
+     * counter has finished.
+     */
+    void runAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter = nullptr);
+
+    /**
+     * Schedule a job on the main thread.
+     */
+    void runOnMainThread(std::function<void()> function, JobCounter* counter = nullptr);
+
+    /**
+     * Run jobs until a counter reaches zero.
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * Run body(rangeBegin, rangeEnd) over [begin, end) in chunks of at
+     * most grain items, and wait for all of them.
+     * @param grain Items per job (0 = about four chunks per thread)
+     */
+    void parallelFor(size_t begin, size_t end, size_t grain,
+                     const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * Run queued main-thread jobs. Call once per frame from the main thread.
+     * @return Number of jobs run
+     */
+    size_t processMainThreadJobs();
+
+    /**
+     * Check if the calling thread is the main thread.
+     */
+    bool isMainThread() const { return std::this_thread::get_id() == m_mainThread; }
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void push(Job job);
+    bool popOwn(Job& job);
+    bool steal(Job& job, size_t start);
+    bool popMainThread(Job& job);
+    bool tryRunOne();
+    void execute(Job& job);
+    void workerLoop(size_t index);
+
+    bool m_initialized = false;
+    std::thread::id m_mainThread = std::this_thread::get_id();
+
+    // Queue 0 takes jobs from non-worker threads; queue i + 1 is worker i's
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    WorkQueue m_mainQueue;
+    std::vector<std::thread> m_workers;
+
+    std::atomic<size_t> m_queued{0};    // Jobs waiting in m_queues
+    std::atomic<bool> m_stopping{false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_JOBS_H
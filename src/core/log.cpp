@@ -0,0 +1,371 @@
+#include "core/log.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+constexpr auto WRITER_POLL = std::chrono::milliseconds(10);
+
+void appendHex(std::string& out, const uint8_t* data, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; ++i) {
+        if (i > 0) {
+            out += ' ';
+        }
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 0xF];
+    }
+}
+
+} // anonymous namespace
+
+bool LogRateLimit::allow(uint32_t& suppressed) {
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // New one-second window; a lost race here only shifts the window slightly
+    int64_t start = m_windowStart.load(std::memory_order_relaxed);
+    if (start < 0 || now - start >= 1000) {
+        if (m_windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            m_count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if (m_count.fetch_add(1, std::memory_order_relaxed) < BURST) {
+        suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+Log& Log::instance() {
+    static Log instance;
+    return instance;
+}
+
+Log::Log() : m_start(std::chrono::steady_clock::now()) {
+    for (auto& level : m_levels) {
+        level.store(static_cast<uint8_t>(LogLevel::Info), std::memory_order_relaxed);
+    }
+}
+
+Log::~Log() {
+    shutdown();
+}
+
+bool Log::initialize(const std::string& filePath) {
+    if (isRunning()) {
+        return true;
+    }
+
+    if (!filePath.empty()) {
+        m_file.open(filePath, std::ios::out | std::ios::trunc);
+        if (!m_file.is_open()) {
+            std::cerr << "Log: Failed to open " << filePath << std::endl;
+        }
+    }
+
+    m_cells.reset(new Cell[QUEUE_SIZE]);
+    for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_enqueuePos.store(0, std::memory_order_relaxed);
+    m_dequeuePos.store(0, std::memory_order_relaxed);
+    m_stopping = false;
+    m_start = std::chrono::steady_clock::now();
+
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&Log::writerLoop, this);
+    return true;
+}
+
+void Log::shutdown() {
+    if (!isRunning()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+
+    // Records claimed after the writer's last pass go out synchronously
+    m_running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        drain();
+    }
+
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    std::cout.flush();
+}
+
+void Log::flush() {
+    if (!isRunning()) {
+        std::cout.flush();
+        return;
+    }
+
+    // Wait for the writer to pass everything claimed so far
+    const size_t target = m_enqueuePos.load(std::memory_order_acquire);
+    while (isRunning() && m_dequeuePos.load(std::memory_order_acquire) < target) {
+        m_wake.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Log::setLevel(LogCategory category, LogLevel level) {
+    m_levels[static_cast<size_t>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Log::setLevel(LogLevel level) {
+    for (auto& entry : m_levels) {
+        entry.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+}
+
+LogLevel Log::getLevel(LogCategory category) const {
+    return static_cast<LogLevel>(m_levels[static_cast<size_t>(category)].load(std::memory_order_relaxed));
+}
+
+LogStats Log::getStats() const {
+    LogStats stats;
+    stats.written = m_written.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* Log::getLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+const char* Log::getCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::Core: return "Core";
+        case LogCategory::Assets: return "Assets";
+        case LogCategory::Graphics: return "Graphics";
+        case LogCategory::Game: return "Game";
+        case LogCategory::Audio: return "Audio";
+        case LogCategory::Video: return "Video";
+        case LogCategory::Net: return "Net";
+        default: return "?";
+    }
+}
+
+void Log::encodeArg(LogRecord& record, ArgType type, const void* data, size_t size) {
+    if (record.argBytes + 1 + size > LogRecord::ARG_BYTES) {
+        return;     // Out of room: remaining placeholders print as "{}"
+    }
+    record.args[record.argBytes++] = static_cast<uint8_t>(type);
+    std::memcpy(record.args + record.argBytes, data, size);
+    record.argBytes = static_cast<uint16_t>(record.argBytes + size);
+}
+
+void Log::encodeString(LogRecord& record, ArgType type, const char* data, size_t size) {
+    // Tag, length byte, bytes; long strings are truncated to fit
+    size_t room = LogRecord::ARG_BYTES - record.argBytes;
+    if (room < 2) {
+        return;
+    }
+    size = std::min({size, room - 2, size_t(255)});
+    record.args[record.argBytes++] = static_cast<uint8_t>(type);
+    record.args[record.argBytes++] = static_cast<uint8_t>(size);
+    std::memcpy(record.args + record.argBytes, data, size);
+    record.argBytes = static_cast<uint16_t>(record.argBytes + size);
+}
+
+std::string Log::formatMessage(const LogRecord& record) {
+    std::string out;
+    out.reserve(128);
+    size_t argPos = 0;
+
+    auto appendArg = [&]() -> bool {
+        if (argPos >= record.argBytes) {
+            return false;
+        }
+        const uint8_t* p = record.args + argPos;
+        ArgType type = static_cast<ArgType>(*p++);
+        char buffer[32];
+        switch (type) {
+            case ArgType::Int: {
+                int64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(v));
+                out += buffer;
+                argPos += 1 + sizeof(v);
+                break;
+            }
+            case ArgType::UInt: {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(v));
+                out += buffer;
+                argPos += 1 + sizeof(v);
+                break;
+            }
+            case ArgType::Float: {
+                double v;
+                std::memcpy(&v, p, sizeof(v));
+                std::snprintf(buffer, sizeof(buffer), "%g", v);
+                out += buffer;
+                argPos += 1 + sizeof(v);
+                break;
+            }
+            case ArgType::Pointer: {
+                uint64_t v;
+                std::memcpy(&v, p, sizeof(v));
+                std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(v));
+                out += buffer;
+                argPos += 1 + sizeof(v);
+                break;
+            }
+            case ArgType::Bool:
+                out += *p ? "true" : "false";
+                argPos += 2;
+                break;
+            case ArgType::Char:
+                out += static_cast<char>(*p);
+                argPos += 2;
+                break;
+            case ArgType::String:
+            case ArgType::Hex: {
+                size_t size = *p++;
+                if (type == ArgType::String) {
+                    out.append(reinterpret_cast<const char*>(p), size);
+                } else {
+                    appendHex(out, p, size);
+                }
+                argPos += 2 + size;
+                break;
+            }
+            default:
+                argPos = record.argBytes;
+                return false;
+        }
+        return true;
+    };
+
+    for (const char* f = record.format; f && *f; ++f) {
+        if (f[0] == '{' && f[1] == '}') {
+            if (!appendArg()) {
+                out += "{}";
+            }
+            ++f;
+        } else if ((f[0] == '{' && f[1] == '{') || (f[0] == '}' && f[1] == '}')) {
+            out += *f;
+            ++f;
+        } else {
+            out += *f;
+        }
+    }
+
+    if (record.suppressed > 0) {
+        out += " (" + std::to_string(record.suppressed) + " similar messages suppressed)";
+    }
+    return out;
+}
+
+LogRecord* Log::claim(Cell*& cell) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &m_cells[pos & (QUEUE_SIZE - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &cell->record;
+            }
+        } else if (diff < 0) {
+            return nullptr;     // Full
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Log::commit(Cell* cell) {
+    size_t pos = cell->sequence.load(std::memory_order_relaxed);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Log::writeRecord(const LogRecord& record) {
+    std::string message = formatMessage(record);
+
+    if (m_console.load(std::memory_order_relaxed)) {
+        if (record.level >= LogLevel::Warning) {
+            std::cerr << message << '\n';
+        } else {
+            std::cout << message << '\n';
+        }
+    }
+
+    if (m_file.is_open()) {
+        char prefix[48];
+        std::snprintf(prefix, sizeof(prefix), "[%10.4f] %-5s %-8s ",
+                      static_cast<double>(record.time) / 1e9,
+                      getLevelName(record.level), getCategoryName(record.category));
+        m_file << prefix << message << '\n';
+    }
+}
+
+size_t Log::drain() {
+    size_t count = 0;
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = m_cells[pos & (QUEUE_SIZE - 1)];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != pos + 1) {
+            break;      // Empty, or the next record is still being filled
+        }
+
+        writeRecord(cell.record);
+        cell.sequence.store(pos + QUEUE_SIZE, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+
+    if (count > 0) {
+        std::cout.flush();
+        if (m_file.is_open()) {
+            m_file.flush();
+        }
+        m_written.fetch_add(count, std::memory_order_relaxed);
+        m_dequeuePos.store(pos, std::memory_order_release);
+    }
+    return count;
+}
+
+void Log::writerLoop() {
+    while (true) {
+        if (drain() > 0) {
+            continue;
+        }
+        if (m_stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_for(lock, WRITER_POLL);
+    }
+}
+
+uint64_t Log::now() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+}
+
+} // namespace mcgng
@@ -0,0 +1,339 @@
+#ifndef MCGNG_LOG_H
+#define MCGNG_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+/**
+ * Lowest level compiled in (0 = Trace ... 4 = Error). Calls below it
+ * compile to nothing. Set from CMake (MCGNG_LOG_MIN_LEVEL).
+ */
+#ifndef MCGNG_LOG_MIN_LEVEL
+#define MCGNG_LOG_MIN_LEVEL 1
+#endif
+
+namespace mcgng {
+
+/**
+ * Log severity.
+ */
+enum class LogLevel : uint8_t {
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5
+};
+
+/**
+ * Log category (one per engine module), each with its own runtime level.
+ */
+enum class LogCategory : uint8_t {
+    Core,
+    Assets,
+    Graphics,
+    Game,
+    Audio,
+    Video,
+    Net,
+    Count
+};
+
+/**
+ * Hex dump argument. Up to MAX_BYTES bytes are copied into the record.
+ */
+struct LogHex {
+    static constexpr size_t MAX_BYTES = 32;
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * Per-call-site rate limiter used by the logging macros.
+ * Lets BURST messages through per second and counts the rest, which are
+ * reported with the next message that gets through.
+ */
+class LogRateLimit {
+public:
+    static constexpr uint32_t BURST = 5;
+
+    /**
+     * @param suppressed Receives the number of messages dropped since the
+     *                   last one allowed
+     * @return true if this message may be logged
+     */
+    bool allow(uint32_t& suppressed);
+
+private:
+    std::atomic<int64_t> m_windowStart{-1};     // Milliseconds
+    std::atomic<uint32_t> m_count{0};
+    std::atomic<uint32_t> m_suppressed{0};
+};
+
+/**
+ * One queued log message. Arguments are stored raw (numbers, copied
+ * strings) and only formatted on the writer thread.
+ */
+struct LogRecord {
+    static constexpr size_t ARG_BYTES = 224;
+
+    const char* format = nullptr;   // Must be a string literal
+    uint64_t time = 0;              // Nanoseconds since Log::initialize()
+    uint32_t suppressed = 0;        // Messages from this call site dropped by rate limiting
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::Core;
+    uint16_t argBytes = 0;
+    uint8_t args[ARG_BYTES];
+};
+
+/**
+ * Log counters.
+ */
+struct LogStats {
+    uint64_t written = 0;       // Records written by the writer thread
+    uint64_t dropped = 0;       // Records lost because the queue was full
+};
+
+/**
+ * Asynchronous logger.
+ *
+ * Producers encode the message into a slot of a fixed-size lock-free
+ * multi-producer ring and return; a background thread formats the "{}"
+ * placeholders and writes to the console and an optional file. Logging
+ * never blocks the caller: when the ring is full the record is dropped
+ * and counted. Before initialize() (tools, early startup) messages are
+ * formatted and written synchronously.
+ *
+ * Use the MCGNG_LOG_* macros, which check the compile-time and runtime
+ * levels before evaluating any argument and rate-limit each call site:
+ *
+ *     MCGNG_LOG_WARN(Assets, "ShapeReader: Bad shape {} in {}", index, path);
+ */
+class Log {
+public:
+    static Log& instance();
+
+    /**
+     * Start the writer thread.
+     * @param filePath Also write timestamped lines here (optional)
+     */
+    bool initialize(const std::string& filePath = "");
+
+    /**
+     * Write everything queued and stop the writer thread.
+     */
+    void shutdown();
+
+    /**
+     * Block until everything queued so far has been written.
+     */
+    void flush();
+
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    /**
+     * Enable or disable console output (the log file is unaffected).
+     */
+    void setConsoleOutput(bool enabled) { m_console.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * Set the runtime level of one category, or of all of them.
+     */
+    void setLevel(LogCategory category, LogLevel level);
+    void setLevel(LogLevel level);
+    LogLevel getLevel(LogCategory category) const;
+
+    /**
+     * Check the runtime level (the macros do this before formatting).
+     */
+    bool isEnabled(LogCategory category, LogLevel level) const {
+        return static_cast<uint8_t>(level) >=
+               m_levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Queue a message. Prefer the macros.
+     * @param format String literal with "{}" placeholders
+     */
+    template <typename... Args>
+    void write(LogLevel level, LogCategory category, uint32_t suppressed,
+               const char* format, const Args&... args);
+
+    /**
+     * Get counters.
+     */
+    LogStats getStats() const;
+
+    /**
+     * Format a record's message (without timestamp or level).
+     */
+    static std::string formatMessage(const LogRecord& record);
+
+    static const char* getLevelName(LogLevel level);
+    static const char* getCategoryName(LogCategory category);
+
+private:
+    Log();
+    ~Log();
+
+    Log(const Log&) = delete;
+    Log& operator=(const Log&) = delete;
+
+    // Argument type tags in LogRecord::args
+    enum class ArgType : uint8_t { Int, UInt, Float, Bool, Char, String, Hex, Pointer };
+
+    // Ring slot (Vyukov bounded queue): sequence == index when free,
+    // index + 1 when it holds a record ready to be written
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    static constexpr size_t QUEUE_SIZE = 4096;     // Power of two
+
+    static void encodeArg(LogRecord& record, ArgType type, const void* data, size_t size);
+    template <typename T>
+    static void encodeValue(LogRecord& record, const T& value);
+    static void encodeString(LogRecord& record, ArgType type, const char* data, size_t size);
+
+    LogRecord* claim(Cell*& cell);
+    void commit(Cell* cell);
+    void writeRecord(const LogRecord& record);
+    void writerLoop();
+    size_t drain();
+    uint64_t now() const;
+
+    std::atomic<uint8_t> m_levels[static_cast<size_t>(LogCategory::Count)];
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<size_t> m_enqueuePos{0};
+    std::atomic<size_t> m_dequeuePos{0};            // Advanced by the writer only
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    std::atomic<bool> m_console{true};
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_stopping{false};
+    std::thread m_writer;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    std::mutex m_outputMutex;                       // Synchronous writes before initialize()
+    std::ofstream m_file;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Template implementation
+
+template <typename T>
+void Log::encodeValue(LogRecord& record, const T& value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        uint8_t v = value ? 1 : 0;
+        encodeArg(record, ArgType::Bool, &v, 1);
+    } else if constexpr (std::is_same_v<U, char>) {
+        encodeArg(record, ArgType::Char, &value, 1);
+    } else if constexpr (std::is_enum_v<U>) {
+        int64_t v = static_cast<int64_t>(value);
+        encodeArg(record, ArgType::Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        int64_t v = value;
+        encodeArg(record, ArgType::Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U>) {
+        uint64_t v = value;
+        encodeArg(record, ArgType::UInt, &v, sizeof(v));
+    } else if constexpr (std::is_floating_point_v<U>) {
+        double v = value;
+        encodeArg(record, ArgType::Float, &v, sizeof(v));
+    } else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        const char* s = value ? value : "(null)";
+        encodeString(record, ArgType::String, s, std::strlen(s));
+    } else if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        std::string_view s = value;
+        encodeString(record, ArgType::String, s.data(), s.size());
+    } else if constexpr (std::is_same_v<U, LogHex>) {
+        encodeString(record, ArgType::Hex, reinterpret_cast<const char*>(value.data),
+                     value.size < LogHex::MAX_BYTES ? value.size : LogHex::MAX_BYTES);
+    } else if constexpr (std::is_pointer_v<U>) {
+        uint64_t v = reinterpret_cast<uintptr_t>(value);
+        encodeArg(record, ArgType::Pointer, &v, sizeof(v));
+    } else {
+        static_assert(sizeof(U) == 0, "Unsupported log argument type");
+    }
+}
+
+template <typename... Args>
+void Log::write(LogLevel level, LogCategory category, uint32_t suppressed,
+                const char* format, const Args&... args) {
+    auto fill = [&](LogRecord& record) {
+        record.format = format;
+        record.time = now();
+        record.suppressed = suppressed;
+        record.level = level;
+        record.category = category;
+        record.argBytes = 0;
+        (encodeValue(record, args), ...);
+    };
+
+    if (!isRunning()) {
+        LogRecord record;
+        fill(record);
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        writeRecord(record);
+        return;
+    }
+
+    Cell* cell = nullptr;
+    LogRecord* record = claim(cell);
+    if (!record) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    fill(*record);
+    commit(cell);
+
+    // Errors should reach the console promptly; everything else waits for the next poll
+    if (level >= LogLevel::Warning) {
+        m_wake.notify_one();
+    }
+}
+
+} // namespace mcgng
+
+#define MCGNG_LOG(level, category, ...)                                                     \
+    do {                                                                                    \
+        if (static_cast<int>(level) >= MCGNG_LOG_MIN_LEVEL &&                               \
+            ::mcgng::Log::instance().isEnabled(category, level)) {                          \
+            static ::mcgng::LogRateLimit mcgngLogLimit_;                                    \
+            uint32_t mcgngLogSuppressed_ = 0;                                               \
+            if (mcgngLogLimit_.allow(mcgngLogSuppressed_)) {                                \
+                ::mcgng::Log::instance().write(level, category, mcgngLogSuppressed_,        \
+                                               __VA_ARGS__);                                \
+            }                                                                               \
+        }                                                                                   \
+    } while (0)
+
+#define MCGNG_LOG_TRACE(category, ...) \
+    MCGNG_LOG(::mcgng::LogLevel::Trace, ::mcgng::LogCategory::category, __VA_ARGS__)
+#define MCGNG_LOG_DEBUG(category, ...) \
+    MCGNG_LOG(::mcgng::LogLevel::Debug, ::mcgng::LogCategory::category, __VA_ARGS__)
+#define MCGNG_LOG_INFO(category, ...) \
+    MCGNG_LOG(::mcgng::LogLevel::Info, ::mcgng::LogCategory::category, __VA_ARGS__)
+#define MCGNG_LOG_WARN(category, ...) \
+    MCGNG_LOG(::mcgng::LogLevel::Warning, ::mcgng::LogCategory::category, __VA_ARGS__)
+#define MCGNG_LOG_ERROR(category, ...) \
+    MCGNG_LOG(::mcgng::LogLevel::Error, ::mcgng::LogCategory::category, __VA_ARGS__)
+
+#endif // MCGNG_LOG_H
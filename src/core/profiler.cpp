@@ -0,0 +1,206 @@
+#include "core/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+const auto s_epoch = std::chrono::steady_clock::now();
+
+thread_local ProfileThreadBuffer* t_buffer = nullptr;
+
+void writeJsonString(std::ostream& out, const char* str) {
+    out << '"';
+    for (const char* p = str ? str : "?"; *p; ++p) {
+        char c = *p;
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+// ProfileThreadBuffer implementation
+
+ProfileThreadBuffer::ProfileThreadBuffer(uint32_t threadId)
+    : m_events(new ProfileEvent[CAPACITY]), m_threadId(threadId) {
+    m_name = "Thread " + std::to_string(threadId);
+}
+
+uint64_t ProfileThreadBuffer::copyFrom(uint64_t from, std::vector<ProfileEvent>& out) const {
+    uint64_t head = m_head.load(std::memory_order_acquire);
+
+    // Anything older than one full ring has already been overwritten
+    if (head > CAPACITY && from < head - CAPACITY) {
+        from = head - CAPACITY;
+    }
+
+    size_t oldSize = out.size();
+    for (uint64_t seq = from; seq < head; ++seq) {
+        out.push_back(m_events[seq & (CAPACITY - 1)]);
+    }
+
+    // Drop slots the writer lapped while we were copying
+    uint64_t after = m_head.load(std::memory_order_acquire);
+    if (after > CAPACITY && after - CAPACITY > from) {
+        size_t torn = static_cast<size_t>(std::min(after - CAPACITY - from, head - from));
+        out.erase(out.begin() + oldSize, out.begin() + oldSize + torn);
+    }
+
+    return head;
+}
+
+// Profiler implementation
+
+Profiler& Profiler::instance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() {
+    m_frameEvents.reserve(1024);
+    m_lastFrame.reserve(32);
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+ProfileThreadBuffer& Profiler::getThreadBuffer() {
+    if (!t_buffer) {
+        // Buffers live until the profiler is destroyed so traces can still
+        // be exported after a worker thread exits.
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        m_threads.push_back(std::make_unique<ProfileThreadBuffer>(
+            static_cast<uint32_t>(m_threads.size() + 1)));
+        t_buffer = m_threads.back().get();
+    }
+    return *t_buffer;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ProfileThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer.setName(name);
+}
+
+void Profiler::beginFrame() {
+    m_frameThread = &getThreadBuffer();
+    m_frameStartSeq = m_frameThread->getHead();
+    m_frameStartNs = now();
+}
+
+void Profiler::endFrame() {
+    if (!m_frameThread) {
+        return;
+    }
+
+    m_lastFrameMs = static_cast<double>(now() - m_frameStartNs) / 1.0e6;
+
+    m_frameEvents.clear();
+    m_frameThread->copyFrom(m_frameStartSeq, m_frameEvents);
+
+    // Aggregate the top two levels by name; zone names are literals so
+    // pointer identity is sufficient and keeps this allocation-free.
+    m_lastFrame.clear();
+    for (const auto& event : m_frameEvents) {
+        if (event.depth > 1) {
+            continue;
+        }
+
+        auto it = std::find_if(m_lastFrame.begin(), m_lastFrame.end(),
+            [&event](const ProfileZoneStat& stat) {
+                return stat.name == event.name && stat.depth == event.depth;
+            });
+        if (it == m_lastFrame.end()) {
+            ProfileZoneStat stat;
+            stat.name = event.name;
+            stat.depth = event.depth;
+            m_lastFrame.push_back(stat);
+            it = m_lastFrame.end() - 1;
+        }
+
+        it->calls++;
+        it->milliseconds += static_cast<double>(event.endNs - event.startNs) / 1.0e6;
+    }
+
+    std::sort(m_lastFrame.begin(), m_lastFrame.end(),
+        [](const ProfileZoneStat& a, const ProfileZoneStat& b) {
+            if (a.depth != b.depth) {
+                return a.depth < b.depth;
+            }
+            return a.milliseconds > b.milliseconds;
+        });
+}
+
+bool Profiler::dumpChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Profiler: Failed to open trace file: " << path << "\n";
+        return false;
+    }
+
+    std::vector<ProfileEvent> events;
+    size_t totalEvents = 0;
+
+    // Microseconds with nanosecond decimals; the default 6 significant
+    // digits would round timestamps to 10 us after the first second
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (const auto& thread : m_threads) {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread->getThreadId() << ",\"args\":{\"name\":";
+        writeJsonString(out, thread->getName().c_str());
+        out << "}}";
+
+        events.clear();
+        thread->copyFrom(0, events);
+        totalEvents += events.size();
+
+        for (const auto& event : events) {
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"mcgng\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->getThreadId()
+                << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0
+                << "}";
+        }
+    }
+
+    out << "\n]}\n";
+
+    if (!out) {
+        std::cerr << "Profiler: Failed writing trace file: " << path << "\n";
+        return false;
+    }
+
+    std::cout << "Profiler: Wrote " << totalEvents << " events from "
+              << m_threads.size() << " thread(s) to " << path << "\n";
+    return true;
+}
+
+} // namespace mcgng
@@ -0,0 +1,218 @@
+#ifndef MCGNG_PROFILER_H
+#define MCGNG_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * A single completed profiling zone.
+ *
+ * Names must be string literals (or otherwise outlive the profiler);
+ * only the pointer is stored so recording never allocates.
+ */
+struct ProfileEvent {
+    const char* name = nullptr;
+    uint64_t startNs = 0;       // Nanoseconds since profiler epoch
+    uint64_t endNs = 0;
+    uint32_t depth = 0;         // Nesting depth on the recording thread
+};
+
+/**
+ * Per-thread event ring buffer.
+ *
+ * Single producer (the owning thread), any number of readers. The owner
+ * publishes events by bumping m_head with release semantics; readers copy
+ * the window they are interested in and re-check m_head to discard slots
+ * that were overwritten while copying. No locks are taken on either side.
+ */
+class ProfileThreadBuffer {
+public:
+    static constexpr size_t CAPACITY = 1 << 16;  // Events kept per thread
+
+    explicit ProfileThreadBuffer(uint32_t threadId);
+
+    void push(const ProfileEvent& event) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        m_events[head & (CAPACITY - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * Copy events with sequence numbers in [from, head) into out.
+     * @return Sequence number one past the last event copied
+     */
+    uint64_t copyFrom(uint64_t from, std::vector<ProfileEvent>& out) const;
+
+    uint64_t getHead() const { return m_head.load(std::memory_order_acquire); }
+    uint32_t getThreadId() const { return m_threadId; }
+
+    const std::string& getName() const { return m_name; }
+    void setName(const std::string& name) { m_name = name; }
+
+    uint32_t depth = 0;  // Current zone nesting (owner thread only)
+
+private:
+    std::unique_ptr<ProfileEvent[]> m_events;
+    std::atomic<uint64_t> m_head{0};
+    uint32_t m_threadId;
+    std::string m_name;
+};
+
+/**
+ * Aggregated timing for one zone name within a frame.
+ */
+struct ProfileZoneStat {
+    const char* name = nullptr;
+    uint32_t depth = 0;
+    uint32_t calls = 0;
+    double milliseconds = 0.0;
+};
+
+/**
+ * Low-overhead scoped-timer profiler.
+ *
+ * Zones are recorded into per-thread ring buffers and can be exported as
+ * Chrome trace JSON (chrome://tracing, ui.perfetto.dev). The main thread
+ * also keeps a per-frame breakdown of its top-level zones for the debug
+ * overlay.
+ *
+ * Use the MCGNG_PROFILE_* macros rather than the classes directly so that
+ * instrumentation compiles away when MCGNG_ENABLE_PROFILER is not defined.
+ */
+class Profiler {
+public:
+    static Profiler& instance();
+
+    /**
+     * Enable or disable recording at runtime.
+     */
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Current time in nanoseconds since the profiler epoch.
+     */
+    static uint64_t now();
+
+    /**
+     * Get the calling thread's buffer, registering it on first use.
+     */
+    ProfileThreadBuffer& getThreadBuffer();
+
+    /**
+     * Name the calling thread in exported traces.
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * Mark frame boundaries (main thread only).
+     * endFrame() aggregates the zones recorded since beginFrame().
+     */
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * Per-zone breakdown of the last completed frame (depth 0 and 1 only).
+     */
+    const std::vector<ProfileZoneStat>& getLastFrameBreakdown() const { return m_lastFrame; }
+
+    /**
+     * Wall time of the last completed frame in milliseconds.
+     */
+    double getLastFrameTime() const { return m_lastFrameMs; }
+
+    /**
+     * Write every buffered event as Chrome trace / Perfetto JSON.
+     * @param path Output file path
+     * @return true on success
+     */
+    bool dumpChromeTrace(const std::string& path) const;
+
+private:
+    Profiler();
+    ~Profiler() = default;
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::atomic<bool> m_enabled{true};
+
+    mutable std::mutex m_threadsMutex;  // Guards registration only
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_threads;
+
+    // Frame breakdown (main thread)
+    ProfileThreadBuffer* m_frameThread = nullptr;
+    uint64_t m_frameStartSeq = 0;
+    uint64_t m_frameStartNs = 0;
+    double m_lastFrameMs = 0.0;
+    std::vector<ProfileEvent> m_frameEvents;
+    std::vector<ProfileZoneStat> m_lastFrame;
+};
+
+/**
+ * RAII zone - records its lifetime on destruction.
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) {
+        Profiler& profiler = Profiler::instance();
+        if (!profiler.isEnabled()) {
+            return;
+        }
+        m_buffer = &profiler.getThreadBuffer();
+        m_name = name;
+        m_depth = m_buffer->depth++;
+        m_start = Profiler::now();
+    }
+
+    ~ProfileZone() {
+        if (!m_buffer) {
+            return;
+        }
+        ProfileEvent event;
+        event.name = m_name;
+        event.startNs = m_start;
+        event.endNs = Profiler::now();
+        event.depth = m_depth;
+        m_buffer->push(event);
+        --m_buffer->depth;
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    ProfileThreadBuffer* m_buffer = nullptr;
+    const char* m_name = nullptr;
+    uint64_t m_start = 0;
+    uint32_t m_depth = 0;
+};
+
+} // namespace mcgng
+
+// Instrumentation macros. Compiled out unless MCGNG_ENABLE_PROFILER is set.
+#define MCGNG_PROFILE_CONCAT_INNER(a, b) a##b
+#define MCGNG_PROFILE_CONCAT(a, b) MCGNG_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef MCGNG_ENABLE_PROFILER
+#define MCGNG_PROFILE_ZONE(name) \
+    ::mcgng::ProfileZone MCGNG_PROFILE_CONCAT(mcgngProfileZone_, __LINE__)(name)
+#define MCGNG_PROFILE_FUNCTION() MCGNG_PROFILE_ZONE(__func__)
+#define MCGNG_PROFILE_THREAD(name) ::mcgng::Profiler::instance().setThreadName(name)
+#define MCGNG_PROFILE_FRAME_BEGIN() ::mcgng::Profiler::instance().beginFrame()
+#define MCGNG_PROFILE_FRAME_END() ::mcgng::Profiler::instance().endFrame()
+#else
+#define MCGNG_PROFILE_ZONE(name) ((void)0)
+#define MCGNG_PROFILE_FUNCTION() ((void)0)
+#define MCGNG_PROFILE_THREAD(name) ((void)0)
+#define MCGNG_PROFILE_FRAME_BEGIN() ((void)0)
+#define MCGNG_PROFILE_FRAME_END() ((void)0)
+#endif
+
+#endif // MCGNG_PROFILER_H
@@ -0,0 +1,71 @@
+#ifndef MCGNG_TRIPLE_BUFFER_H
+#define MCGNG_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace mcgng {
+
+/**
+ * Lock-free single-producer, single-consumer triple buffer.
+ *
+ * The producer fills back() and publish()es it; the consumer calls
+ * acquire() to pick up the newest published buffer and reads front().
+ * Neither side ever waits for the other: the producer always has a free
+ * buffer to write and the consumer keeps reading the last one it acquired
+ * until a newer one is published. Intermediate publishes the consumer
+ * never acquired are dropped.
+ *
+ * Buffers are reused, so back() still holds an older state after
+ * publish(); T should be cleared and refilled in place to keep its
+ * allocations.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * Get the buffer being written (producer only).
+     */
+    T& back() { return m_buffers[m_back]; }
+
+    /**
+     * Hand the back buffer to the consumer and take a free one (producer only).
+     */
+    void publish() {
+        m_back = m_ready.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * Switch to the newest published buffer (consumer only).
+     * @return true if a new buffer was published since the last acquire
+     */
+    bool acquire() {
+        if ((m_ready.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        m_front = m_ready.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Get the last acquired buffer (consumer only).
+     */
+    const T& front() const { return m_buffers[m_front]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;   // Ready buffer not yet acquired
+
+    T m_buffers[3];
+    uint8_t m_back = 0;
+    std::atomic<uint8_t> m_ready{1};        // Index | FRESH
+    uint8_t m_front = 2;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_TRIPLE_BUFFER_H
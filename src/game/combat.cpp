@@ -1,5 +1,6 @@
 #include "game/combat.h"
 #include "assets/fit_parser.h"
+#include "core/profiler.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -22,6 +23,7 @@ bool CombatSystem::initialize() {
 }
 
 void CombatSystem::update(float deltaTime) {
+    MCGNG_PROFILE_ZONE("CombatSystem::update");
     // Update all projectiles
     for (auto& proj : m_projectiles) {
         if (proj.active) {
@@ -185,8 +187,7 @@ MechLocation CombatSystem::determineHitLocation(const Mech* target) const {
     }
 
     // Standard hit location table (simplified)
-    std::uniform_int_distribution<int> dist(1, 100);
-    int roll = dist(const_cast<std::mt19937&>(m_rng));
+    int roll = rollPercent();
 
     // Weighted hit locations (roughly based on tabletop BattleTech)
     if (roll <= 10) return MechLocation::Head;
@@ -210,8 +211,17 @@ bool CombatSystem::checkCritical(Mech* target, MechLocation location) {
         critChance *= 3.0f;  // Triple crit chance with no armor
     }
 
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    return dist(m_rng) < critChance;
+    return rollUnit() < critChance;
+}
+
+// The standard distributions are implementation-defined, so rolls are taken
+// straight from the engine's output to stay identical across platforms
+int CombatSystem::rollPercent() const {
+    return static_cast<int>(m_rng() % 100) + 1;
+}
+
+float CombatSystem::rollUnit() const {
+    return static_cast<float>(m_rng() >> 8) * (1.0f / 16777216.0f);
 }
 
 void CombatSystem::fireEvent(const CombatEvent& event) {
@@ -256,8 +266,7 @@ void CombatSystem::resolveHit(Projectile& proj) {
     // Calculate hit chance
     float hitChance = calculateHitChance(proj.source, proj.weapon, proj.target);
 
-    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-    bool hit = dist(m_rng) < hitChance;
+    bool hit = rollUnit() < hitChance;
 
     if (!hit) {
         // Miss
@@ -266,6 +275,8 @@ void CombatSystem::resolveHit(Projectile& proj) {
         event.attacker = proj.source;
         event.target = proj.target;
         event.weapon = proj.weapon;
+        event.x = proj.x;
+        event.y = proj.y;
         fireEvent(event);
         return;
     }
@@ -288,6 +299,8 @@ void CombatSystem::resolveHit(Projectile& proj) {
         critEvent.weapon = proj.weapon;
         critEvent.hitLocation = location;
         critEvent.damage = damage;
+        critEvent.x = proj.x;
+        critEvent.y = proj.y;
         fireEvent(critEvent);
     }
 
@@ -303,6 +316,8 @@ void CombatSystem::resolveHit(Projectile& proj) {
     hitEvent.weapon = proj.weapon;
     hitEvent.hitLocation = location;
     hitEvent.damage = damage;
+    hitEvent.x = proj.x;
+    hitEvent.y = proj.y;
     fireEvent(hitEvent);
 
     // Check for destruction
@@ -311,6 +326,8 @@ void CombatSystem::resolveHit(Projectile& proj) {
         destroyEvent.type = CombatEventType::MechDestroyed;
         destroyEvent.attacker = proj.source;
         destroyEvent.target = proj.target;
+        destroyEvent.x = proj.x;
+        destroyEvent.y = proj.y;
         fireEvent(destroyEvent);
     }
 }
@@ -58,16 +58,30 @@ using CombatEventCallback = std::function<void(const CombatEvent&)>;
 
 /**
  * Combat system - handles weapon fire, damage, and hit resolution.
+ *
+ * The engine uses the shared instance(); lockstep matches own one each so
+ * that every peer rolls the same dice (see seed()).
  */
 class CombatSystem {
 public:
     static CombatSystem& instance();
 
+    /**
+     * Create a combat system seeded from std::random_device.
+     */
+    CombatSystem();
+
     /**
      * Initialize the combat system.
      */
     bool initialize();
 
+    /**
+     * Reseed the dice. Two systems with the same seed fed the same attacks
+     * produce the same hits, locations and criticals.
+     */
+    void seed(uint32_t value) { m_rng.seed(value); }
+
     /**
      * Update combat state (projectiles, etc).
      */
@@ -142,8 +156,6 @@ public:
     void setCriticalChance(float chance) { m_criticalChance = chance; }
 
 private:
-    CombatSystem();
-
     std::vector<Projectile> m_projectiles;
     std::vector<std::shared_ptr<Mech>>* m_mechs = nullptr;
 
@@ -155,8 +167,10 @@ private:
     float m_movementModifier = 0.1f;
     float m_criticalChance = 0.1f;
 
-    std::mt19937 m_rng;
+    mutable std::mt19937 m_rng;
 
+    int rollPercent() const;
+    float rollUnit() const;
     void fireEvent(const CombatEvent& event);
     void updateProjectile(Projectile& proj, float deltaTime);
     void resolveHit(Projectile& proj);
@@ -0,0 +1,34 @@
+#ifndef MCGNG_COMMAND_H
+#define MCGNG_COMMAND_H
+
+#include <cstdint>
+
+namespace mcgng {
+
+/**
+ * Unit order types.
+ */
+enum class CommandType : uint8_t {
+    Move,           // Walk to (x, y)
+    Attack,         // Fire weapon at unit target
+    AttackGround,   // Fire weapon at (x, y)
+    Stop,           // Halt movement
+    Count
+};
+
+/**
+ * One player order. Orders are the only input to a lockstep match, so
+ * everything a player can do has to be expressible here.
+ */
+struct Command {
+    CommandType type = CommandType::Stop;
+    uint8_t player = 0;         // Issuing player; filled in by the session
+    uint8_t weapon = 0;         // Mounted weapon index
+    uint16_t unit = 0;          // Ordered unit
+    uint16_t target = 0;        // Target unit (Attack)
+    float x = 0.0f, y = 0.0f;   // Target position (Move, AttackGround)
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_COMMAND_H
@@ -1,8 +1,8 @@
 #include "game/mech.h"
 #include "assets/fit_parser.h"
+#include "core/log.h"
 #include <cmath>
 #include <algorithm>
-#include <iostream>
 
 namespace mcgng {
 
@@ -67,9 +67,9 @@ void Mech::update(float deltaTime) {
     dissipateHeat(deltaTime);
 
     // Check for shutdown from overheating
-    if (m_heat >= m_maxHeat) {
+    if (m_heat >= m_maxHeat && !m_shutdown) {
         m_shutdown = true;
-        std::cout << m_callsign << " shutdown from overheating!\n";
+        MCGNG_LOG_INFO(Game, "{} shutdown from overheating!", m_callsign);
     }
 
     // Process movement
@@ -127,6 +127,28 @@ void Mech::stop() {
     m_moving = false;
 }
 
+void Mech::setPosition(float x, float y, float heading) {
+    m_x = x;
+    m_y = y;
+    m_heading = heading;
+    m_targetX = x;
+    m_targetY = y;
+    m_moving = false;
+    m_currentSpeed = 0.0f;
+}
+
+void Mech::addWeapon(const Weapon* weapon, MechLocation location, int ammo) {
+    if (!weapon) {
+        return;
+    }
+
+    MountedWeapon mounted;
+    mounted.weapon = weapon;
+    mounted.location = location;
+    mounted.ammo = weapon->ammoPerTon > 0 ? ammo : 0;
+    m_weapons.push_back(mounted);
+}
+
 bool Mech::fireWeapon(int weaponIndex, float targetX, float targetY) {
     if (weaponIndex < 0 || weaponIndex >= static_cast<int>(m_weapons.size())) {
         return false;
@@ -214,7 +236,7 @@ void Mech::dissipateHeat(float deltaTime) {
     // Can recover from shutdown if heat drops enough
     if (m_shutdown && m_heat < m_maxHeat * 0.5f) {
         m_shutdown = false;
-        std::cout << m_callsign << " systems back online.\n";
+        MCGNG_LOG_INFO(Game, "{} systems back online.", m_callsign);
     }
 }
 
@@ -223,7 +245,7 @@ void Mech::checkDestruction() {
     if (m_components[static_cast<int>(MechLocation::CenterTorso)].destroyed ||
         m_components[static_cast<int>(MechLocation::Head)].destroyed) {
         m_destroyed = true;
-        std::cout << m_callsign << " destroyed!\n";
+        MCGNG_LOG_INFO(Game, "{} destroyed!", m_callsign);
         return;
     }
 
@@ -231,7 +253,7 @@ void Mech::checkDestruction() {
     if (m_components[static_cast<int>(MechLocation::LeftLeg)].destroyed &&
         m_components[static_cast<int>(MechLocation::RightLeg)].destroyed) {
         m_destroyed = true;
-        std::cout << m_callsign << " crippled - both legs destroyed!\n";
+        MCGNG_LOG_INFO(Game, "{} crippled - both legs destroyed!", m_callsign);
     }
 }
 
@@ -245,7 +267,7 @@ MechDatabase& MechDatabase::instance() {
 bool MechDatabase::loadFromFile(const std::string& path) {
     FitParser parser;
     if (!parser.parseFile(path)) {
-        std::cerr << "MechDatabase: Failed to load: " << path << "\n";
+        MCGNG_LOG_ERROR(Game, "MechDatabase: Failed to load: {}", path);
         return false;
     }
 
@@ -276,7 +298,7 @@ bool MechDatabase::loadFromFile(const std::string& path) {
         m_chassis.push_back(chassis);
     }
 
-    std::cout << "MechDatabase: Loaded " << m_chassis.size() << " chassis definitions\n";
+    MCGNG_LOG_INFO(Game, "MechDatabase: Loaded {} chassis definitions", m_chassis.size());
     return true;
 }
 
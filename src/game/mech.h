@@ -152,6 +152,11 @@ public:
      */
     void stop();
 
+    /**
+     * Place the mech immediately (spawning, teleport).
+     */
+    void setPosition(float x, float y, float heading = 0.0f);
+
     /**
      * Get current position.
      */
@@ -186,6 +191,14 @@ public:
      */
     void applyDamage(MechLocation location, int damage);
 
+    /**
+     * Mount a weapon.
+     * @param weapon Weapon definition (must outlive the mech)
+     * @param location Mount location
+     * @param ammo Starting ammunition (ignored for energy weapons)
+     */
+    void addWeapon(const Weapon* weapon, MechLocation location, int ammo = 0);
+
     /**
      * Get mounted weapons.
      */
@@ -1,5 +1,6 @@
 #include "game/mission.h"
 #include "assets/fit_parser.h"
+#include "core/profiler.h"
 #include <filesystem>
 #include <iostream>
 #include <algorithm>
@@ -122,9 +123,7 @@ bool Mission::initialize() {
         mech->setName(spawn.id);
         mech->setCallsign(spawn.pilot);
         mech->setTeam(spawn.team);
-
-        // TODO: Set initial position via internal method
-        // For now, mechs start at origin
+        mech->setPosition(spawn.x, spawn.y, spawn.heading);
 
         m_mechs.push_back(mech);
     }
@@ -133,6 +132,7 @@ bool Mission::initialize() {
 }
 
 void Mission::update(float deltaTime) {
+    MCGNG_PROFILE_ZONE("Mission::update");
     if (m_state != MissionState::InProgress) {
         return;
     }
@@ -157,6 +157,7 @@ public:
 
     const std::vector<MissionObjective>& getObjectives() const { return m_objectives; }
     const std::vector<std::shared_ptr<Mech>>& getMechs() const { return m_mechs; }
+    const std::vector<SpawnPoint>& getSpawnPoints() const { return m_spawnPoints; }
 
     /**
      * Get player mechs.
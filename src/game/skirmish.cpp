@@ -0,0 +1,193 @@
+#include "game/skirmish.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include <cstring>
+
+namespace mcgng {
+
+namespace {
+
+constexpr uint32_t FNV_OFFSET = 2166136261u;
+constexpr uint32_t FNV_PRIME = 16777619u;
+
+class Hasher {
+public:
+    void add(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash = (m_hash ^ bytes[i]) * FNV_PRIME;
+        }
+    }
+
+    void add(uint32_t value) { add(&value, sizeof(value)); }
+    void add(int value) { add(static_cast<uint32_t>(value)); }
+    void add(bool value) { add(static_cast<uint32_t>(value ? 1 : 0)); }
+
+    // Bit pattern, so the hash changes on any divergence, however small
+    void add(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+
+    uint32_t get() const { return m_hash; }
+
+private:
+    uint32_t m_hash = FNV_OFFSET;
+};
+
+} // anonymous namespace
+
+Skirmish::Skirmish(uint32_t seed) {
+    m_combat.seed(seed);
+    m_combat.setMechList(&m_mechs);
+}
+
+uint16_t Skirmish::addMech(const MechChassis& chassis, int team, float x, float y, float heading) {
+    auto mech = std::make_shared<Mech>();
+    mech->initialize(chassis);
+    mech->setName("unit_" + std::to_string(m_mechs.size()));
+    mech->setCallsign(mech->getName());
+    mech->setTeam(team);
+    mech->setPosition(x, y, heading);
+    m_mechs.push_back(mech);
+    return static_cast<uint16_t>(m_mechs.size() - 1);
+}
+
+size_t Skirmish::addSpawns(const std::vector<SpawnPoint>& spawns) {
+    size_t count = 0;
+    for (const SpawnPoint& spawn : spawns) {
+        const MechChassis* chassis = MechDatabase::instance().getChassis(spawn.mechType);
+        if (!chassis) {
+            MCGNG_LOG_WARN(Game, "Skirmish: Unknown mech type: {}", spawn.mechType);
+            continue;
+        }
+        Mech* mech = getMech(addMech(*chassis, spawn.team, spawn.x, spawn.y, spawn.heading));
+        if (!spawn.pilot.empty()) {
+            mech->setCallsign(spawn.pilot);
+        }
+        ++count;
+    }
+    return count;
+}
+
+void Skirmish::addStandardTeams(int unitsPerTeam) {
+    MechChassis chassis;
+    chassis.name = "Standard";
+    chassis.variant = "STD-1";
+    chassis.tonnage = 50;
+    chassis.maxSpeed = 64;
+    chassis.heatSinks = 10;
+    chassis.headArmor = 9;
+    chassis.centerTorsoArmor = 24;
+    chassis.sideTorsoArmor = 16;
+    chassis.armArmor = 12;
+    chassis.legArmor = 16;
+    chassis.headStructure = 3;
+    chassis.centerTorsoStructure = 16;
+    chassis.sideTorsoStructure = 12;
+    chassis.armStructure = 8;
+    chassis.legStructure = 12;
+
+    const Weapon* laser = WeaponDatabase::instance().getWeapon("Medium Laser");
+    const Weapon* missiles = WeaponDatabase::instance().getWeapon("SRM 4");
+
+    for (int team = 0; team < 2; ++team) {
+        for (int i = 0; i < unitsPerTeam; ++i) {
+            float x = team == 0 ? 0.0f : 600.0f;
+            float y = static_cast<float>(i) * 80.0f;
+            Mech* mech = getMech(addMech(chassis, team, x, y, team == 0 ? 0.0f : 180.0f));
+            mech->addWeapon(laser, MechLocation::RightArm);
+            mech->addWeapon(missiles, MechLocation::LeftTorso, 50);
+        }
+    }
+}
+
+Mech* Skirmish::getMech(uint16_t unit) {
+    return unit < m_mechs.size() ? m_mechs[unit].get() : nullptr;
+}
+
+const Mech* Skirmish::getMech(uint16_t unit) const {
+    return unit < m_mechs.size() ? m_mechs[unit].get() : nullptr;
+}
+
+bool Skirmish::apply(const Command& command) {
+    Mech* mech = getMech(command.unit);
+    if (!mech || mech->isDestroyed() || mech->getTeam() != command.player) {
+        return false;
+    }
+
+    switch (command.type) {
+        case CommandType::Move:
+            mech->moveTo(command.x, command.y);
+            return true;
+        case CommandType::Stop:
+            mech->stop();
+            return true;
+        case CommandType::Attack:
+            return m_combat.attack(mech, command.weapon, getMech(command.target));
+        case CommandType::AttackGround:
+            return m_combat.attackGround(mech, command.weapon, command.x, command.y);
+        default:
+            return false;
+    }
+}
+
+void Skirmish::step(float deltaTime) {
+    MCGNG_PROFILE_ZONE("Skirmish::step");
+    for (auto& mech : m_mechs) {
+        mech->update(deltaTime);
+    }
+    m_combat.update(deltaTime);
+    ++m_tick;
+}
+
+int Skirmish::getWinner() const {
+    int winner = -1;
+    for (const auto& mech : m_mechs) {
+        if (mech->isDestroyed()) {
+            continue;
+        }
+        if (winner >= 0 && mech->getTeam() != winner) {
+            return -1;
+        }
+        winner = mech->getTeam();
+    }
+    return winner;
+}
+
+uint32_t Skirmish::checksum() const {
+    MCGNG_PROFILE_ZONE("Skirmish::checksum");
+    Hasher hash;
+    hash.add(m_tick);
+
+    hash.add(static_cast<uint32_t>(m_mechs.size()));
+    for (const auto& mech : m_mechs) {
+        hash.add(mech->getX());
+        hash.add(mech->getY());
+        hash.add(mech->getHeading());
+        hash.add(mech->getHeat());
+        hash.add(mech->isDestroyed());
+        for (int loc = 0; loc < static_cast<int>(MechLocation::Count); ++loc) {
+            const MechComponent& component = mech->getComponent(static_cast<MechLocation>(loc));
+            hash.add(component.armor);
+            hash.add(component.internalStructure);
+        }
+        for (const MountedWeapon& weapon : mech->getWeapons()) {
+            hash.add(weapon.ammo);
+            hash.add(weapon.cooldownTimer);
+        }
+    }
+
+    const auto& projectiles = m_combat.getProjectiles();
+    hash.add(static_cast<uint32_t>(projectiles.size()));
+    for (const Projectile& projectile : projectiles) {
+        hash.add(projectile.x);
+        hash.add(projectile.y);
+        hash.add(projectile.lifetime);
+        hash.add(projectile.damage);
+    }
+    return hash.get();
+}
+
+} // namespace mcgng
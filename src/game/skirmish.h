@@ -0,0 +1,96 @@
+#ifndef MCGNG_SKIRMISH_H
+#define MCGNG_SKIRMISH_H
+
+#include "game/combat.h"
+#include "game/command.h"
+#include "game/mech.h"
+#include "game/mission.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Self-contained skirmish world for lockstep play.
+ *
+ * Owns its mechs and its own seeded CombatSystem, advances only through
+ * apply() and step(), and never reads clocks or global state, so every
+ * peer that starts from the same setup and feeds the same commands in the
+ * same order computes the same checksum() each tick. Team index equals the
+ * owning player.
+ */
+class Skirmish {
+public:
+    /**
+     * @param seed Shared match seed (combat dice)
+     */
+    explicit Skirmish(uint32_t seed);
+
+    Skirmish(const Skirmish&) = delete;
+    Skirmish& operator=(const Skirmish&) = delete;
+
+    /**
+     * Spawn a mech. Units are numbered in spawn order.
+     * @return Unit id
+     */
+    uint16_t addMech(const MechChassis& chassis, int team, float x, float y, float heading = 0.0f);
+
+    /**
+     * Spawn a mission's units (chassis from MechDatabase).
+     * @return Number of units spawned; unknown mech types are skipped
+     */
+    size_t addSpawns(const std::vector<SpawnPoint>& spawns);
+
+    /**
+     * Spawn two facing lines of a built-in medium mech with a laser and an
+     * SRM rack, for bot matches and tests that run without game data.
+     */
+    void addStandardTeams(int unitsPerTeam);
+
+    /**
+     * Get a unit (nullptr if the id is out of range).
+     */
+    Mech* getMech(uint16_t unit);
+    const Mech* getMech(uint16_t unit) const;
+
+    const std::vector<std::shared_ptr<Mech>>& getMechs() const { return m_mechs; }
+    const CombatSystem& getCombat() const { return m_combat; }
+
+    /**
+     * Execute an order. Orders for units the player doesn't own, or for
+     * destroyed units, are ignored.
+     * @return true if the order was valid
+     */
+    bool apply(const Command& command);
+
+    /**
+     * Advance one fixed tick.
+     */
+    void step(float deltaTime);
+
+    /**
+     * Get the number of ticks stepped.
+     */
+    uint32_t getTick() const { return m_tick; }
+
+    /**
+     * Get the winning team, or -1 while more than one team has units left.
+     */
+    int getWinner() const;
+
+    /**
+     * Hash of mech and projectile state (FNV-1a over the raw bits), used
+     * to detect desyncs between peers.
+     */
+    uint32_t checksum() const;
+
+private:
+    std::vector<std::shared_ptr<Mech>> m_mechs;
+    CombatSystem m_combat;
+    uint32_t m_tick = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_SKIRMISH_H
@@ -0,0 +1,71 @@
+#include "game/skirmish_bot.h"
+#include "game/skirmish.h"
+#include <cmath>
+
+namespace mcgng {
+
+namespace {
+
+constexpr float ENGAGE_RANGE = 250.0f;     // Inside every standard weapon's reach
+constexpr float MOVE_JITTER = 40.0f;
+
+} // anonymous namespace
+
+SkirmishBot::SkirmishBot(int team, uint32_t seed) : m_team(team), m_rng(seed) {
+}
+
+float SkirmishBot::jitter() {
+    // Spelled out rather than a std distribution so every peer agrees
+    float unit = static_cast<float>(m_rng() - std::minstd_rand::min()) /
+                 static_cast<float>(std::minstd_rand::max() - std::minstd_rand::min());
+    return (unit * 2.0f - 1.0f) * MOVE_JITTER;
+}
+
+void SkirmishBot::think(const Skirmish& world, std::vector<Command>& out) {
+    const auto& mechs = world.getMechs();
+
+    for (uint16_t unit = 0; unit < mechs.size(); ++unit) {
+        const Mech& mech = *mechs[unit];
+        if (mech.getTeam() != m_team || mech.isDestroyed()) {
+            continue;
+        }
+
+        int target = -1;
+        float bestDistance = 0.0f;
+        for (uint16_t other = 0; other < mechs.size(); ++other) {
+            const Mech& enemy = *mechs[other];
+            if (enemy.getTeam() == m_team || enemy.isDestroyed()) {
+                continue;
+            }
+            float distance = std::hypot(enemy.getX() - mech.getX(), enemy.getY() - mech.getY());
+            if (target < 0 || distance < bestDistance) {
+                target = other;
+                bestDistance = distance;
+            }
+        }
+        if (target < 0) {
+            return;     // Nobody left to fight
+        }
+
+        Command command;
+        command.player = static_cast<uint8_t>(m_team);
+        command.unit = unit;
+        if (bestDistance > ENGAGE_RANGE) {
+            const Mech& enemy = *mechs[target];
+            command.type = CommandType::Move;
+            command.x = enemy.getX() + jitter();
+            command.y = enemy.getY() + jitter();
+            out.push_back(command);
+            continue;
+        }
+
+        command.type = CommandType::Attack;
+        command.target = static_cast<uint16_t>(target);
+        for (size_t weapon = 0; weapon < mech.getWeapons().size(); ++weapon) {
+            command.weapon = static_cast<uint8_t>(weapon);
+            out.push_back(command);
+        }
+    }
+}
+
+} // namespace mcgng
@@ -0,0 +1,43 @@
+#ifndef MCGNG_SKIRMISH_BOT_H
+#define MCGNG_SKIRMISH_BOT_H
+
+#include "game/command.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace mcgng {
+
+class Skirmish;
+
+/**
+ * Simple skirmish AI: each unit closes on the nearest enemy and fires
+ * every weapon once in range. It only reads the world and emits orders,
+ * so it can drive one side of a lockstep or server match like a player.
+ */
+class SkirmishBot {
+public:
+    /**
+     * @param team Team (player) the bot commands
+     * @param seed Seed for its movement jitter
+     */
+    SkirmishBot(int team, uint32_t seed);
+
+    /**
+     * Decide orders for the bot's units.
+     * @param out Receives the orders (appended)
+     */
+    void think(const Skirmish& world, std::vector<Command>& out);
+
+    int getTeam() const { return m_team; }
+
+private:
+    float jitter();
+
+    int m_team;
+    std::minstd_rand m_rng;     // Small, and identical on every standard library
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_SKIRMISH_BOT_H
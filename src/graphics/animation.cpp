@@ -0,0 +1,231 @@
+#include "graphics/animation.h"
+#include <algorithm>
+
+namespace mcgng {
+
+// AnimationLibrary implementation
+
+AnimClipId AnimationLibrary::addClip(const Animation& anim) {
+    if (anim.frames.empty()) {
+        return INVALID_ANIM_CLIP;
+    }
+
+    AnimClip clip;
+    clip.firstFrame = static_cast<uint32_t>(m_frames.size());
+    clip.frameCount = static_cast<uint32_t>(anim.frames.size());
+    clip.frameTime = std::max(anim.frameTime, 0.001f);
+    clip.loop = anim.loop;
+
+    auto it = m_names.find(anim.name);
+    if (it != m_names.end()) {
+        AnimClip& old = m_clips[it->second];
+        bool atEnd = old.firstFrame + old.frameCount == m_frames.size();
+        if (clip.frameCount <= old.frameCount) {
+            // Overwrite in place; a shorter clip leaves its tail unused
+            clip.firstFrame = old.firstFrame;
+            m_unusedFrames += old.frameCount - clip.frameCount;
+        } else if (atEnd) {
+            clip.firstFrame = old.firstFrame;
+            m_frames.resize(old.firstFrame);
+        } else {
+            m_unusedFrames += old.frameCount;
+        }
+
+        if (clip.firstFrame == m_frames.size()) {
+            m_frames.insert(m_frames.end(), anim.frames.begin(), anim.frames.end());
+        } else {
+            std::copy(anim.frames.begin(), anim.frames.end(), m_frames.begin() + clip.firstFrame);
+        }
+        old = clip;
+
+        if (m_unusedFrames * 2 > m_frames.size()) {
+            compact();
+        }
+        return it->second;
+    }
+
+    if (m_clips.size() >= INVALID_ANIM_CLIP) {
+        return INVALID_ANIM_CLIP;
+    }
+    m_frames.insert(m_frames.end(), anim.frames.begin(), anim.frames.end());
+    AnimClipId id = static_cast<AnimClipId>(m_clips.size());
+    m_clips.push_back(clip);
+    m_names.emplace(anim.name, id);
+    return id;
+}
+
+void AnimationLibrary::compact() {
+    std::vector<int> frames;
+    frames.reserve(m_frames.size() - m_unusedFrames);
+    for (AnimClip& clip : m_clips) {
+        auto first = m_frames.begin() + clip.firstFrame;
+        clip.firstFrame = static_cast<uint32_t>(frames.size());
+        frames.insert(frames.end(), first, first + clip.frameCount);
+    }
+    m_frames = std::move(frames);
+    m_unusedFrames = 0;
+}
+
+AnimClipId AnimationLibrary::findClip(const std::string& name) const {
+    auto it = m_names.find(name);
+    return it != m_names.end() ? it->second : INVALID_ANIM_CLIP;
+}
+
+// AnimationSystem implementation
+
+AnimationSystem& AnimationSystem::instance() {
+    static AnimationSystem instance;
+    return instance;
+}
+
+uint32_t AnimationSystem::denseIndex(AnimHandle handle) const {
+    uint32_t slot = static_cast<uint32_t>((handle & SLOT_MASK) - 1);
+    if (handle == INVALID_ANIM || slot >= m_slotDense.size() ||
+        m_slotGeneration[slot] != (handle >> SLOT_BITS)) {
+        return NONE;
+    }
+    return m_slotDense[slot];
+}
+
+AnimHandle AnimationSystem::create(std::shared_ptr<const AnimationLibrary> library) {
+    if (!library) {
+        return INVALID_ANIM;
+    }
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        if (m_slotDense.size() >= UINT32_MAX - 1) {
+            return INVALID_ANIM;
+        }
+        slot = static_cast<uint32_t>(m_slotDense.size());
+        m_slotDense.push_back(NONE);
+        m_slotGeneration.push_back(0);
+    }
+
+    uint32_t dense = static_cast<uint32_t>(m_handles.size());
+    AnimHandle handle = (static_cast<AnimHandle>(m_slotGeneration[slot]) << SLOT_BITS) | (slot + 1);
+    m_slotDense[slot] = dense;
+
+    m_timers.push_back(0.0f);
+    m_positions.push_back(0);
+    m_clips.push_back(INVALID_ANIM_CLIP);
+    m_playing.push_back(0);
+    m_frames.push_back(0);
+    m_libraries.push_back(library.get());
+    m_handles.push_back(handle);
+    m_libraryRefs.push_back(std::move(library));
+    return handle;
+}
+
+void AnimationSystem::destroy(AnimHandle handle) {
+    uint32_t dense = denseIndex(handle);
+    if (dense == NONE) {
+        return;
+    }
+
+    // Swap-remove keeps the arrays dense
+    uint32_t last = static_cast<uint32_t>(m_handles.size()) - 1;
+    if (dense != last) {
+        m_timers[dense] = m_timers[last];
+        m_positions[dense] = m_positions[last];
+        m_clips[dense] = m_clips[last];
+        m_playing[dense] = m_playing[last];
+        m_frames[dense] = m_frames[last];
+        m_libraries[dense] = m_libraries[last];
+        m_handles[dense] = m_handles[last];
+        m_libraryRefs[dense] = std::move(m_libraryRefs[last]);
+        m_slotDense[static_cast<uint32_t>(m_handles[dense] & SLOT_MASK) - 1] = dense;
+    }
+    m_timers.pop_back();
+    m_positions.pop_back();
+    m_clips.pop_back();
+    m_playing.pop_back();
+    m_frames.pop_back();
+    m_libraries.pop_back();
+    m_handles.pop_back();
+    m_libraryRefs.pop_back();
+
+    releaseSlot(static_cast<uint32_t>(handle & SLOT_MASK) - 1);
+}
+
+void AnimationSystem::releaseSlot(uint32_t slot) {
+    m_slotDense[slot] = NONE;
+
+    // A slot whose generation would wrap is retired, so no old handle
+    // can ever match a new instance
+    if (++m_slotGeneration[slot] != UINT32_MAX) {
+        m_freeSlots.push_back(slot);
+    }
+}
+
+void AnimationSystem::play(AnimHandle handle, AnimClipId clip, bool restart) {
+    uint32_t dense = denseIndex(handle);
+    if (dense == NONE || !m_libraries[dense]->isValid(clip)) {
+        return;
+    }
+
+    if (restart || m_clips[dense] != clip) {
+        m_clips[dense] = clip;
+        m_timers[dense] = 0.0f;
+        m_positions[dense] = 0;
+        const AnimationLibrary* library = m_libraries[dense];
+        m_frames[dense] = library->getFrame(library->getClip(clip), 0);
+    }
+    m_playing[dense] = 1;
+}
+
+void AnimationSystem::stop(AnimHandle handle) {
+    uint32_t dense = denseIndex(handle);
+    if (dense != NONE) {
+        m_playing[dense] = 0;
+    }
+}
+
+void AnimationSystem::update(float deltaTime) {
+    const size_t count = m_handles.size();
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_playing[i]) {
+            continue;
+        }
+
+        const AnimationLibrary* library = m_libraries[i];
+        const AnimClip& clip = library->getClip(m_clips[i]);
+        uint32_t position = m_positions[i];
+        if (!AnimationLibrary::advance(clip, deltaTime, m_timers[i], position)) {
+            m_playing[i] = 0;
+        }
+        if (position != m_positions[i]) {
+            m_positions[i] = position;
+            m_frames[i] = library->getFrame(clip, position);
+        }
+    }
+}
+
+int AnimationSystem::getFrame(AnimHandle handle) const {
+    uint32_t dense = denseIndex(handle);
+    return dense != NONE ? m_frames[dense] : 0;
+}
+
+bool AnimationSystem::isPlaying(AnimHandle handle) const {
+    uint32_t dense = denseIndex(handle);
+    return dense != NONE && m_playing[dense] != 0;
+}
+
+void AnimationSystem::clear() {
+    for (AnimHandle handle : m_handles) {
+        releaseSlot(static_cast<uint32_t>(handle & SLOT_MASK) - 1);
+    }
+    m_timers.clear();
+    m_positions.clear();
+    m_clips.clear();
+    m_playing.clear();
+    m_frames.clear();
+    m_libraries.clear();
+    m_handles.clear();
+    m_libraryRefs.clear();
+}
+
+} // namespace mcgng
@@ -0,0 +1,224 @@
+#ifndef MCGNG_ANIMATION_H
+#define MCGNG_ANIMATION_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Animation sequence.
+ */
+struct Animation {
+    std::string name;
+    std::vector<int> frames;    // Frame indices
+    float frameTime = 0.1f;     // Seconds per frame
+    bool loop = true;
+};
+
+/**
+ * Animation clip id within an AnimationLibrary.
+ */
+using AnimClipId = uint16_t;
+constexpr AnimClipId INVALID_ANIM_CLIP = 0xFFFF;
+
+/**
+ * Compiled clip: a run of the library's frame table.
+ */
+struct AnimClip {
+    uint32_t firstFrame = 0;    // Into the library's frame table
+    uint32_t frameCount = 0;
+    float frameTime = 0.1f;
+    bool loop = true;
+};
+
+/**
+ * Set of animation clips with integer ids.
+ *
+ * Built once (usually per unit type) and then shared read-only between
+ * every sprite or animation instance that uses it. Names are only needed
+ * to look up ids at setup time; playback works on ids alone.
+ */
+class AnimationLibrary {
+public:
+    /**
+     * Add a clip, or replace the clip with the same name (keeping its id).
+     * A replacement reuses the old frame range when it fits; frames left
+     * unused by replacements are compacted once they outnumber the rest.
+     * Frame times are clamped to at least 1ms.
+     * @return Clip id, or INVALID_ANIM_CLIP if the clip has no frames
+     */
+    AnimClipId addClip(const Animation& anim);
+
+    /**
+     * Find a clip id by name (INVALID_ANIM_CLIP if absent).
+     */
+    AnimClipId findClip(const std::string& name) const;
+
+    /**
+     * Check if an id refers to a clip.
+     */
+    bool isValid(AnimClipId id) const { return id < m_clips.size(); }
+
+    /**
+     * Get a clip by id (must be valid).
+     */
+    const AnimClip& getClip(AnimClipId id) const { return m_clips[id]; }
+
+    /**
+     * Get the sprite frame at a position within a clip.
+     */
+    int getFrame(const AnimClip& clip, uint32_t index) const { return m_frames[clip.firstFrame + index]; }
+
+    /**
+     * Get number of clips.
+     */
+    size_t getClipCount() const { return m_clips.size(); }
+
+    /**
+     * Advance a playback position.
+     * @param clip Clip being played
+     * @param timer Time into the current frame (updated)
+     * @param index Position within the clip (updated)
+     * @return false if a non-looping clip reached its end
+     */
+    static bool advance(const AnimClip& clip, float deltaTime, float& timer, uint32_t& index) {
+        timer += deltaTime;
+        if (timer < clip.frameTime) {
+            return true;
+        }
+
+        uint32_t steps = static_cast<uint32_t>(timer / clip.frameTime);
+        timer -= static_cast<float>(steps) * clip.frameTime;
+        index += steps;
+        if (index < clip.frameCount) {
+            return true;
+        }
+        if (clip.loop) {
+            index %= clip.frameCount;
+            return true;
+        }
+        index = clip.frameCount - 1;
+        return false;
+    }
+
+    /**
+     * Get the size of the frame table (including frames not yet compacted).
+     */
+    size_t getFrameTableSize() const { return m_frames.size(); }
+
+private:
+    void compact();
+
+    std::vector<AnimClip> m_clips;
+    std::vector<int> m_frames;
+    std::unordered_map<std::string, AnimClipId> m_names;
+    size_t m_unusedFrames = 0;      // Left behind by replaced clips
+};
+
+/**
+ * Handle to an instance in the AnimationSystem (0 = none).
+ * Low 32 bits: slot + 1, high 32 bits: slot generation.
+ */
+using AnimHandle = uint64_t;
+constexpr AnimHandle INVALID_ANIM = 0;
+
+/**
+ * Batched animation playback.
+ *
+ * Instance state (timer, clip position, clip id, resolved frame) lives in
+ * parallel dense arrays, so update() advances every animation in one
+ * pass with no lookups. Handles stay valid while instances are created
+ * and destroyed around them; stale handles are detected by a generation.
+ *
+ * Game thread only.
+ */
+class AnimationSystem {
+public:
+    static AnimationSystem& instance();
+
+    /**
+     * Create an instance playing clips from a library.
+     */
+    AnimHandle create(std::shared_ptr<const AnimationLibrary> library);
+
+    /**
+     * Destroy an instance (ignores invalid handles).
+     */
+    void destroy(AnimHandle handle);
+
+    /**
+     * Play a clip.
+     * @param restart Restart even if this clip is already playing
+     */
+    void play(AnimHandle handle, AnimClipId clip, bool restart = false);
+
+    /**
+     * Stop on the current frame.
+     */
+    void stop(AnimHandle handle);
+
+    /**
+     * Advance all playing instances.
+     */
+    void update(float deltaTime);
+
+    /**
+     * Get the current sprite frame of an instance (0 if invalid).
+     */
+    int getFrame(AnimHandle handle) const;
+
+    /**
+     * Check if an instance is playing.
+     */
+    bool isPlaying(AnimHandle handle) const;
+
+    /**
+     * Check if a handle refers to a live instance.
+     */
+    bool isValid(AnimHandle handle) const { return denseIndex(handle) != NONE; }
+
+    /**
+     * Get number of live instances.
+     */
+    size_t getInstanceCount() const { return m_handles.size(); }
+
+    /**
+     * Destroy all instances.
+     */
+    void clear();
+
+private:
+    AnimationSystem() = default;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint32_t SLOT_BITS = 32;
+    static constexpr AnimHandle SLOT_MASK = (AnimHandle(1) << SLOT_BITS) - 1;
+
+    uint32_t denseIndex(AnimHandle handle) const;
+    void releaseSlot(uint32_t slot);
+
+    // Dense per-instance state, walked by update()
+    std::vector<float> m_timers;
+    std::vector<uint32_t> m_positions;      // Index within the clip
+    std::vector<AnimClipId> m_clips;
+    std::vector<uint8_t> m_playing;
+    std::vector<int> m_frames;              // Resolved sprite frame
+    std::vector<const AnimationLibrary*> m_libraries;
+
+    // Cold per-instance data, touched on create/destroy only
+    std::vector<AnimHandle> m_handles;
+    std::vector<std::shared_ptr<const AnimationLibrary>> m_libraryRefs;
+
+    // Handle slot -> dense index, with generations for stale handles
+    std::vector<uint32_t> m_slotDense;
+    std::vector<uint32_t> m_slotGeneration;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_ANIMATION_H
@@ -0,0 +1,207 @@
+#include "graphics/combat_effects.h"
+#include "game/mech.h"
+#include <cmath>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+// Default atlas frames (ParticleSystem::DEFAULT_ATLAS_FRAMES)
+constexpr uint16_t FRAME_SPARK = 0;
+constexpr uint16_t FRAME_PUFF = 3;
+
+enum class WeaponClass { Energy, Ballistic, Missile };
+
+WeaponClass classify(const Weapon* weapon) {
+    if (!weapon) {
+        return WeaponClass::Ballistic;
+    }
+    switch (weapon->type) {
+        case WeaponType::Laser:
+        case WeaponType::PulseLaser:
+        case WeaponType::LargeLaser:
+        case WeaponType::PPC:
+            return WeaponClass::Energy;
+        case WeaponType::SRM:
+        case WeaponType::LRM:
+        case WeaponType::Streak:
+            return WeaponClass::Missile;
+        default:
+            return WeaponClass::Ballistic;
+    }
+}
+
+} // anonymous namespace
+
+bool CombatEffects::initialize() {
+    auto& particles = ParticleSystem::instance();
+    if (!particles.isInitialized()) {
+        std::cerr << "CombatEffects: ParticleSystem not initialized" << std::endl;
+        return false;
+    }
+
+    ParticleEffect energy;
+    energy.count = 6;
+    energy.speedMin = 30.0f;
+    energy.speedMax = 90.0f;
+    energy.spread = 0.6f;
+    energy.lifeMin = 0.08f;
+    energy.lifeMax = 0.15f;
+    energy.colorStart = {120, 200, 255, 255};
+    energy.colorEnd = {40, 80, 255, 0};
+    energy.sizeStart = 10.0f;
+    energy.sizeEnd = 4.0f;
+    m_energyFlash = particles.addEffect(energy);
+
+    ParticleEffect ballistic = energy;
+    ballistic.count = 8;
+    ballistic.speedMax = 140.0f;
+    ballistic.spread = 0.4f;
+    ballistic.colorStart = {255, 230, 140, 255};
+    ballistic.colorEnd = {255, 120, 20, 0};
+    m_ballisticFlash = particles.addEffect(ballistic);
+
+    ParticleEffect launch;
+    launch.count = 10;
+    launch.speedMin = 10.0f;
+    launch.speedMax = 40.0f;
+    launch.spread = 1.2f;
+    launch.lifeMin = 0.4f;
+    launch.lifeMax = 0.8f;
+    launch.colorStart = {200, 200, 200, 160};
+    launch.colorEnd = {120, 120, 120, 0};
+    launch.sizeStart = 6.0f;
+    launch.sizeEnd = 14.0f;
+    launch.firstFrame = 1;
+    launch.frameCount = 3;
+    launch.blend = BlendMode::Alpha;
+    m_missileLaunch = particles.addEffect(launch);
+
+    ParticleEffect sparks;
+    sparks.count = 12;
+    sparks.speedMin = 40.0f;
+    sparks.speedMax = 120.0f;
+    sparks.lifeMin = 0.2f;
+    sparks.lifeMax = 0.4f;
+    sparks.gravity = 200.0f;
+    sparks.colorStart = {255, 240, 180, 255};
+    sparks.colorEnd = {255, 80, 0, 0};
+    sparks.sizeStart = 5.0f;
+    sparks.sizeEnd = 2.0f;
+    sparks.firstFrame = FRAME_SPARK;
+    m_hitSparks = particles.addEffect(sparks);
+
+    ParticleEffect critical = sparks;
+    critical.count = 24;
+    critical.speedMax = 180.0f;
+    critical.sizeStart = 7.0f;
+    m_criticalSparks = particles.addEffect(critical);
+
+    ParticleEffect dust;
+    dust.count = 6;
+    dust.speedMin = 5.0f;
+    dust.speedMax = 20.0f;
+    dust.lifeMin = 0.5f;
+    dust.lifeMax = 0.9f;
+    dust.colorStart = {150, 130, 100, 140};
+    dust.colorEnd = {150, 130, 100, 0};
+    dust.sizeStart = 6.0f;
+    dust.sizeEnd = 12.0f;
+    dust.firstFrame = FRAME_PUFF;
+    dust.blend = BlendMode::Alpha;
+    m_missDust = particles.addEffect(dust);
+
+    ParticleEffect explosion;
+    explosion.count = 48;
+    explosion.speedMin = 20.0f;
+    explosion.speedMax = 110.0f;
+    explosion.lifeMin = 0.4f;
+    explosion.lifeMax = 0.9f;
+    explosion.colorStart = {255, 220, 120, 255};
+    explosion.colorEnd = {200, 40, 0, 0};
+    explosion.sizeStart = 14.0f;
+    explosion.sizeEnd = 28.0f;
+    explosion.firstFrame = 1;
+    explosion.frameCount = 3;
+    m_explosion = particles.addEffect(explosion);
+
+    ParticleEffect smoke;
+    smoke.count = 24;
+    smoke.speedMin = 5.0f;
+    smoke.speedMax = 30.0f;
+    smoke.lifeMin = 1.5f;
+    smoke.lifeMax = 2.5f;
+    smoke.gravity = -15.0f;
+    smoke.colorStart = {60, 60, 60, 200};
+    smoke.colorEnd = {90, 90, 90, 0};
+    smoke.sizeStart = 12.0f;
+    smoke.sizeEnd = 32.0f;
+    smoke.firstFrame = FRAME_PUFF;
+    smoke.blend = BlendMode::Alpha;
+    m_smoke = particles.addEffect(smoke);
+
+    ParticleEffect steam = smoke;
+    steam.count = 8;
+    steam.lifeMin = 0.6f;
+    steam.lifeMax = 1.0f;
+    steam.gravity = -40.0f;
+    steam.colorStart = {230, 230, 240, 140};
+    steam.colorEnd = {230, 230, 240, 0};
+    steam.sizeStart = 6.0f;
+    steam.sizeEnd = 18.0f;
+    m_steam = particles.addEffect(steam);
+
+    m_initialized = true;
+    return true;
+}
+
+void CombatEffects::emit(ParticleEffectId effect, float x, float y, float direction) {
+    ParticleSystem::instance().emit(effect, x, y, direction);
+}
+
+void CombatEffects::onCombatEvent(const CombatEvent& event) {
+    if (!m_initialized) {
+        return;
+    }
+
+    switch (event.type) {
+        case CombatEventType::WeaponFired: {
+            float direction = 0.0f;
+            if (event.target) {
+                direction = std::atan2(event.target->getY() - event.y, event.target->getX() - event.x);
+            }
+            switch (classify(event.weapon)) {
+                case WeaponClass::Energy:
+                    emit(m_energyFlash, event.x, event.y, direction);
+                    break;
+                case WeaponClass::Ballistic:
+                    emit(m_ballisticFlash, event.x, event.y, direction);
+                    break;
+                case WeaponClass::Missile:
+                    emit(m_missileLaunch, event.x, event.y, direction);
+                    break;
+            }
+            break;
+        }
+        case CombatEventType::Hit:
+            emit(m_hitSparks, event.x, event.y);
+            break;
+        case CombatEventType::CriticalHit:
+        case CombatEventType::ComponentDestroyed:
+            emit(m_criticalSparks, event.x, event.y);
+            break;
+        case CombatEventType::Miss:
+            emit(m_missDust, event.x, event.y);
+            break;
+        case CombatEventType::MechDestroyed:
+            emit(m_explosion, event.x, event.y);
+            emit(m_smoke, event.x, event.y);
+            break;
+        case CombatEventType::Overheat:
+            emit(m_steam, event.x, event.y, -1.5707963f);
+            break;
+    }
+}
+
+} // namespace mcgng
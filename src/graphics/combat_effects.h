@@ -0,0 +1,45 @@
+#ifndef MCGNG_COMBAT_EFFECTS_H
+#define MCGNG_COMBAT_EFFECTS_H
+
+#include "graphics/particles.h"
+#include "game/combat.h"
+
+namespace mcgng {
+
+/**
+ * Turns combat events into particle effects.
+ *
+ * Register onCombatEvent() as (or from) the CombatSystem event callback:
+ *
+ *     combat.setEventCallback([&](const CombatEvent& e) { effects.onCombatEvent(e); });
+ */
+class CombatEffects {
+public:
+    /**
+     * Register the effect set with the ParticleSystem (must be initialized).
+     */
+    bool initialize();
+
+    /**
+     * Spawn the effects for one combat event.
+     */
+    void onCombatEvent(const CombatEvent& event);
+
+private:
+    void emit(ParticleEffectId effect, float x, float y, float direction = 0.0f);
+
+    bool m_initialized = false;
+    ParticleEffectId m_energyFlash = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_ballisticFlash = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_missileLaunch = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_hitSparks = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_criticalSparks = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_missDust = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_explosion = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_smoke = INVALID_PARTICLE_EFFECT;
+    ParticleEffectId m_steam = INVALID_PARTICLE_EFFECT;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_COMBAT_EFFECTS_H
@@ -0,0 +1,322 @@
+#include "graphics/font.h"
+#include "assets/vfs.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace mcgng {
+
+// Font implementation
+
+Font::~Font() {
+    if (m_texture != INVALID_TEXTURE) {
+        Renderer::instance().destroyTexture(m_texture);
+    }
+}
+
+bool Font::load(const FontReader& reader, int spacing) {
+    if (!reader.isLoaded()) {
+        return false;
+    }
+
+    m_glyphs.fill(Glyph());
+    m_glyphHeight = reader.getHeight();
+    m_lineHeight = 0;
+
+    // Shelf-pack glyphs (all the same height) into rows with 1px padding
+    int x = 0;
+    int y = 0;
+    int glyphCount = 0;
+    for (int ch = 0; ch < reader.getCharacterCount(); ++ch) {
+        int width = reader.getGlyphWidth(ch);
+        if (!reader.hasGlyph(ch)) {
+            continue;
+        }
+        if (x + width > ATLAS_WIDTH) {
+            x = 0;
+            y += m_glyphHeight + 1;
+        }
+        m_glyphs[ch].src = {x, y, width, m_glyphHeight};
+        m_glyphs[ch].advance = width + spacing;
+        x += width + 1;
+        ++glyphCount;
+    }
+
+    if (glyphCount == 0) {
+        return false;
+    }
+
+    int atlasHeight = y + m_glyphHeight;
+    std::vector<uint8_t> rgba(static_cast<size_t>(ATLAS_WIDTH) * atlasHeight * 4, 0);
+    for (int ch = 0; ch < reader.getCharacterCount(); ++ch) {
+        const uint8_t* pixels = reader.getGlyphPixels(ch);
+        const Rect& src = m_glyphs[ch].src;
+        if (!pixels) {
+            continue;
+        }
+        bool hasInk = false;
+        for (int gy = 0; gy < src.height; ++gy) {
+            uint8_t* row = rgba.data() + (static_cast<size_t>(src.y + gy) * ATLAS_WIDTH + src.x) * 4;
+            for (int gx = 0; gx < src.width; ++gx) {
+                if (reader.isInk(pixels[gy * src.width + gx])) {
+                    row[gx * 4 + 0] = 255;
+                    row[gx * 4 + 1] = 255;
+                    row[gx * 4 + 2] = 255;
+                    row[gx * 4 + 3] = 255;
+                    hasInk = true;
+                }
+            }
+        }
+        // Blank glyphs (space) only advance; they emit no quad
+        if (!hasInk) {
+            m_glyphs[ch].src.width = 0;
+        }
+    }
+
+    if (m_texture != INVALID_TEXTURE) {
+        Renderer::instance().destroyTexture(m_texture);
+    }
+    m_texture = Renderer::instance().createTexture(rgba.data(), ATLAS_WIDTH, atlasHeight);
+
+    // Fonts without a space glyph still need word gaps
+    m_space = m_glyphs[' '];
+    if (m_space.advance == 0) {
+        m_space.src = {};
+        m_space.advance = std::max(1, m_glyphHeight / 3) + spacing;
+    }
+    m_lineHeight = m_glyphHeight + 1;
+    return true;
+}
+
+const Font::Glyph& Font::glyphFor(unsigned char ch) const {
+    if (m_glyphs[ch].advance > 0) {
+        return m_glyphs[ch];
+    }
+    // Many MCG fonts are upper-case only
+    unsigned char upper = static_cast<unsigned char>(std::toupper(ch));
+    if (m_glyphs[upper].advance > 0) {
+        return m_glyphs[upper];
+    }
+    return m_space;
+}
+
+void Font::layout(const std::string& text, TextLayout& layout) const {
+    layout.texture = m_texture;
+    layout.quads.clear();
+    layout.width = 0;
+    layout.height = 0;
+
+    if (!isLoaded() || text.empty()) {
+        return;
+    }
+
+    layout.quads.reserve(text.size());
+    int x = 0;
+    int y = 0;
+    for (char c : text) {
+        if (c == '\n') {
+            layout.width = std::max(layout.width, x);
+            x = 0;
+            y += m_lineHeight;
+            continue;
+        }
+
+        const Glyph& glyph = glyphFor(static_cast<unsigned char>(c));
+        if (glyph.src.width > 0) {
+            layout.quads.push_back({glyph.src, {x, y, glyph.src.width, glyph.src.height}, Color::white()});
+        }
+        x += glyph.advance;
+    }
+
+    layout.width = std::max(layout.width, x);
+    layout.height = y + m_glyphHeight;
+}
+
+int Font::measure(const std::string& text) const {
+    int width = 0;
+    int x = 0;
+    for (char c : text) {
+        if (c == '\n') {
+            width = std::max(width, x);
+            x = 0;
+        } else {
+            x += glyphFor(static_cast<unsigned char>(c)).advance;
+        }
+    }
+    return std::max(width, x);
+}
+
+// FontManager implementation
+
+FontManager& FontManager::instance() {
+    static FontManager instance;
+    return instance;
+}
+
+bool FontManager::loadFont(const std::string& name, const uint8_t* data, size_t size) {
+    FontReader reader;
+    if (!reader.load(data, size)) {
+        std::cerr << "FontManager: Failed to parse font " << name << std::endl;
+        return false;
+    }
+
+    auto font = std::make_unique<Font>();
+    if (!font->load(reader)) {
+        std::cerr << "FontManager: Font " << name << " has no glyphs" << std::endl;
+        return false;
+    }
+
+    m_fonts[name] = std::move(font);
+    if (m_defaultFont.empty()) {
+        m_defaultFont = name;
+    }
+    return true;
+}
+
+size_t FontManager::loadGameFonts() {
+    auto& vfs = Vfs::instance();
+    size_t loaded = 0;
+
+    for (const auto& path : vfs.list()) {
+        if (path.size() < 4 || path.compare(path.size() - 4, 4, ".fnt") != 0) {
+            continue;
+        }
+
+        size_t slash = path.find_last_of('/');
+        std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+        name.resize(name.size() - 4);
+
+        VfsView view = vfs.read(path);
+        if (view && loadFont(name, view.data(), view.size())) {
+            ++loaded;
+        }
+    }
+
+    std::cout << "FontManager: Loaded " << loaded << " fonts";
+    if (!m_defaultFont.empty()) {
+        std::cout << " (default: " << m_defaultFont << ")";
+    }
+    std::cout << std::endl;
+    return loaded;
+}
+
+const Font* FontManager::getFont(const std::string& name) const {
+    auto it = m_fonts.find(name);
+    return it != m_fonts.end() ? it->second.get() : nullptr;
+}
+
+void FontManager::shutdown() {
+    m_fonts.clear();
+    m_defaultFont.clear();
+}
+
+// TextRenderer implementation
+
+TextRenderer& TextRenderer::instance() {
+    static TextRenderer instance;
+    return instance;
+}
+
+void TextRenderer::drawText(const TextLayout& layout, int x, int y, const Color& color) {
+    if (layout.quads.empty() || layout.texture == INVALID_TEXTURE) {
+        return;
+    }
+
+    auto it = std::find_if(m_batches.begin(), m_batches.end(),
+                           [&layout](const Batch& batch) { return batch.texture == layout.texture; });
+    if (it == m_batches.end()) {
+        m_batches.push_back({layout.texture, {}});
+        it = m_batches.end() - 1;
+    }
+
+    std::vector<TexturedQuad>& quads = it->quads;
+    size_t first = quads.size();
+    quads.insert(quads.end(), layout.quads.begin(), layout.quads.end());
+    for (size_t i = first; i < quads.size(); ++i) {
+        quads[i].dst.x += x;
+        quads[i].dst.y += y;
+        quads[i].color = color;
+    }
+}
+
+void TextRenderer::drawText(const Font& font, const std::string& text, int x, int y, const Color& color) {
+    font.layout(text, m_scratch);
+    drawText(m_scratch, x, y, color);
+}
+
+void TextRenderer::flush() {
+    auto& renderer = Renderer::instance();
+    for (auto& batch : m_batches) {
+        if (!batch.quads.empty()) {
+            renderer.drawTextureQuads(batch.texture, batch.quads.data(), batch.quads.size());
+            batch.quads.clear();
+        }
+    }
+}
+
+size_t TextRenderer::getPendingQuads() const {
+    size_t count = 0;
+    for (const auto& batch : m_batches) {
+        count += batch.quads.size();
+    }
+    return count;
+}
+
+// CachedText implementation
+
+void CachedText::setText(const std::string& text) {
+    if (text != m_text) {
+        m_text = text;
+        m_dirty = true;
+    }
+}
+
+void CachedText::setFont(const Font* font) {
+    if (font != m_font) {
+        m_font = font;
+        m_dirty = true;
+    }
+}
+
+const TextLayout* CachedText::getLayout() {
+    const Font* font = m_font ? m_font : FontManager::instance().getDefaultFont();
+    if (!font) {
+        return nullptr;
+    }
+
+    if (m_dirty || font != m_layoutFont) {
+        font->layout(m_text, m_layout);
+        m_layoutFont = font;
+        m_dirty = false;
+        ++m_layoutCount;
+    }
+    return &m_layout;
+}
+
+void CachedText::draw(const Rect& bounds, int hAlign, int vAlign, const Color& color) {
+    if (m_text.empty()) {
+        return;
+    }
+
+    const TextLayout* layout = getLayout();
+    if (!layout) {
+        return;
+    }
+
+    int x = bounds.x;
+    int y = bounds.y;
+    if (hAlign == 1) {
+        x += (bounds.width - layout->width) / 2;
+    } else if (hAlign == 2) {
+        x += bounds.width - layout->width;
+    }
+    if (vAlign == 1) {
+        y += (bounds.height - layout->height) / 2;
+    } else if (vAlign == 2) {
+        y += bounds.height - layout->height;
+    }
+
+    TextRenderer::instance().drawText(*layout, x, y, color);
+}
+
+} // namespace mcgng
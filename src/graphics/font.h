@@ -0,0 +1,231 @@
+#ifndef MCGNG_FONT_H
+#define MCGNG_FONT_H
+
+#include "graphics/renderer.h"
+#include "assets/font_reader.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Laid-out string: glyph quads relative to the text origin (top-left).
+ * Colors are applied when the layout is drawn, so recoloring text does
+ * not need a new layout.
+ */
+struct TextLayout {
+    TextureHandle texture = INVALID_TEXTURE;
+    std::vector<TexturedQuad> quads;
+    int width = 0;
+    int height = 0;
+};
+
+/**
+ * Bitmap font with all glyphs packed into one atlas texture.
+ */
+class Font {
+public:
+    static constexpr int ATLAS_WIDTH = 256;
+
+    Font() = default;
+    ~Font();
+
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
+    /**
+     * Build glyph metrics and the atlas texture from a parsed font.
+     * Ink pixels become opaque white so text can be tinted per draw.
+     * Metrics are usable even if no renderer is available.
+     * @param reader Parsed VFX font
+     * @param spacing Extra pixels between characters
+     * @return true if the font has any glyphs
+     */
+    bool load(const FontReader& reader, int spacing = 1);
+
+    /**
+     * Check if loaded.
+     */
+    bool isLoaded() const { return m_lineHeight > 0; }
+
+    /**
+     * Lay out a string (handles '\n').
+     * Characters without a glyph fall back to their upper-case form, then
+     * advance like a space.
+     * @param text Text to lay out
+     * @param layout Receives the quads (previous contents are replaced)
+     */
+    void layout(const std::string& text, TextLayout& layout) const;
+
+    /**
+     * Get the width of the widest line of a string.
+     */
+    int measure(const std::string& text) const;
+
+    /**
+     * Get height of one line including line spacing.
+     */
+    int getLineHeight() const { return m_lineHeight; }
+
+    /**
+     * Get the atlas texture.
+     */
+    TextureHandle getTexture() const { return m_texture; }
+
+private:
+    struct Glyph {
+        Rect src;           // In the atlas; width 0 = no glyph
+        int advance = 0;
+    };
+
+    const Glyph& glyphFor(unsigned char ch) const;
+
+    std::array<Glyph, 256> m_glyphs{};
+    Glyph m_space;
+    TextureHandle m_texture = INVALID_TEXTURE;
+    int m_glyphHeight = 0;
+    int m_lineHeight = 0;
+};
+
+/**
+ * Fonts by name. Render thread only.
+ */
+class FontManager {
+public:
+    static FontManager& instance();
+
+    /**
+     * Load a font from VFX font data.
+     * @param name Name to register it under (replaces an existing font)
+     * @return true on success
+     */
+    bool loadFont(const std::string& name, const uint8_t* data, size_t size);
+
+    /**
+     * Load every .fnt file in the VFS (MCG keeps them in MISC.FST).
+     * Fonts are named by file stem, e.g. "misc.fst/font1.fnt" -> "font1".
+     * The first font loaded becomes the default.
+     * @return Number of fonts loaded
+     */
+    size_t loadGameFonts();
+
+    /**
+     * Get a font by name (nullptr if not loaded).
+     */
+    const Font* getFont(const std::string& name) const;
+
+    /**
+     * Get the font used when a widget has none set.
+     */
+    const Font* getDefaultFont() const { return getFont(m_defaultFont); }
+
+    /**
+     * Set the default font by name.
+     */
+    void setDefaultFont(const std::string& name) { m_defaultFont = name; }
+
+    /**
+     * Release all fonts and their atlas textures.
+     */
+    void shutdown();
+
+private:
+    FontManager() = default;
+
+    std::unordered_map<std::string, std::unique_ptr<Font>> m_fonts;
+    std::string m_defaultFont;
+};
+
+/**
+ * Collects glyph quads for the frame and draws them in one batch per
+ * atlas texture. Flushed at the end of the UI pass and before present.
+ * Render thread only.
+ */
+class TextRenderer {
+public:
+    static TextRenderer& instance();
+
+    /**
+     * Queue a laid-out string with its origin at (x, y).
+     */
+    void drawText(const TextLayout& layout, int x, int y, const Color& color);
+
+    /**
+     * Lay out and queue a one-off string. Prefer a cached TextLayout for
+     * text that is drawn every frame.
+     */
+    void drawText(const Font& font, const std::string& text, int x, int y, const Color& color);
+
+    /**
+     * Draw all queued text.
+     */
+    void flush();
+
+    /**
+     * Get the number of queued glyph quads.
+     */
+    size_t getPendingQuads() const;
+
+private:
+    TextRenderer() = default;
+
+    struct Batch {
+        TextureHandle texture = INVALID_TEXTURE;
+        std::vector<TexturedQuad> quads;
+    };
+
+    std::vector<Batch> m_batches;   // One per atlas; few fonts, so a linear search
+    TextLayout m_scratch;
+};
+
+/**
+ * Text with a cached layout. The layout is rebuilt only when the text or
+ * the font changes; moving, resizing or recoloring reuses it.
+ */
+class CachedText {
+public:
+    /**
+     * Set the text (no-op if unchanged).
+     */
+    void setText(const std::string& text);
+    const std::string& getText() const { return m_text; }
+
+    /**
+     * Set the font (nullptr = FontManager default).
+     */
+    void setFont(const Font* font);
+
+    /**
+     * Get the layout, rebuilding it if stale.
+     * @return nullptr if there is no font
+     */
+    const TextLayout* getLayout();
+
+    /**
+     * Queue the text aligned inside a rectangle.
+     * @param hAlign 0=left, 1=center, 2=right
+     * @param vAlign 0=top, 1=center, 2=bottom
+     */
+    void draw(const Rect& bounds, int hAlign, int vAlign, const Color& color);
+
+    /**
+     * Get how many times the layout has been built (for diagnostics).
+     */
+    uint32_t getLayoutCount() const { return m_layoutCount; }
+
+private:
+    std::string m_text;
+    const Font* m_font = nullptr;
+    const Font* m_layoutFont = nullptr;     // Font the layout was built with
+    TextLayout m_layout;
+    bool m_dirty = true;
+    uint32_t m_layoutCount = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_FONT_H
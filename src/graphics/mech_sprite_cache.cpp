@@ -0,0 +1,379 @@
+#include "graphics/mech_sprite_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+int wrapIndex(int value, int count) {
+    return ((value % count) + count) % count;
+}
+
+/**
+ * Header of a serialized MechFrameCache, followed by facingCount pairs of
+ * int32 (first frame, flip), frameCount MechFrameInfo and the pixels.
+ */
+struct MechFrameCacheHeader {
+    char magic[4];              // "MFC1"
+    uint32_t facingCount;
+    uint32_t frameCount;
+    uint32_t pixelBytes;
+    int32_t framesPerDirection;
+    int32_t storedFacings;
+};
+
+constexpr char MECH_FRAMES_MAGIC[4] = {'M', 'F', 'C', '1'};
+
+static_assert(sizeof(MechFrameCacheHeader) == 24, "MechFrameCacheHeader layout changed");
+static_assert(sizeof(MechFrameInfo) == 12, "MechFrameInfo layout changed");
+
+} // anonymous namespace
+
+// MechFrameCache implementation
+
+bool MechFrameCache::build(const MechSpriteSet& set, const MechAnimLayout& layout) {
+    m_facings.clear();
+    m_frames.clear();
+    m_pixels.clear();
+    m_framesPerDirection = 0;
+    m_storedFacings = 0;
+
+    bool mechFormat = set.getMechFrameCount() > 0;
+    int total = static_cast<int>(mechFormat ? set.getMechFrameCount() : set.getFrameCount());
+    if (total == 0) {
+        return false;
+    }
+    int directions = std::max(1, std::min(layout.directions, total));
+
+    m_framesPerDirection = total / directions;
+    if (layout.framesPerDirection > 0) {
+        m_framesPerDirection = std::min(layout.framesPerDirection, m_framesPerDirection);
+    }
+
+    // Upper bound on pixel storage, so frames decode straight into place
+    if (mechFormat) {
+        size_t bytes = 0;
+        for (int i = 0; i < directions * m_framesPerDirection; ++i) {
+            const MechShapeReader* frame = set.getMechFrame(static_cast<uint32_t>(i));
+            bytes += static_cast<size_t>(frame->getWidth()) * frame->getHeight();
+        }
+        m_pixels.reserve(bytes);
+    }
+    m_frames.reserve(static_cast<size_t>(directions) * m_framesPerDirection);
+    m_facings.resize(directions);
+
+    for (int facing = 0; facing < directions; ++facing) {
+        int mirrorOf = (directions - facing) % directions;
+        if (layout.mirror && mirrorOf < facing && !m_facings[mirrorOf].flipH &&
+            mirrorMatches(set, facing, mirrorOf, layout.mirrorTolerance)) {
+            m_facings[facing].firstFrame = m_facings[mirrorOf].firstFrame;
+            m_facings[facing].flipH = true;
+            continue;
+        }
+
+        m_facings[facing].firstFrame = static_cast<int>(m_frames.size());
+        decodeFacing(set, facing);
+        ++m_storedFacings;
+    }
+
+    m_pixels.shrink_to_fit();
+    return m_storedFacings > 0;
+}
+
+void MechFrameCache::decodeFacing(const MechSpriteSet& set, int sourceFacing) {
+    for (int f = 0; f < m_framesPerDirection; ++f) {
+        MechFrameInfo info;
+        uint32_t index = static_cast<uint32_t>(sourceFacing * m_framesPerDirection + f);
+        // Failed frames keep an empty slot so indices stay in draw order
+        decodeSourceFrame(set, index, m_pixels, info);
+        m_frames.push_back(info);
+    }
+}
+
+bool MechFrameCache::decodeSourceFrame(const MechSpriteSet& set, uint32_t index,
+                                       std::vector<uint8_t>& pixels, MechFrameInfo& info) const {
+    info.offset = static_cast<uint32_t>(pixels.size());
+
+    if (set.getMechFrameCount() > 0) {
+        const MechShapeReader* frame = set.getMechFrame(index);
+        if (!frame || !frame->isLoaded()) {
+            return false;
+        }
+        info.width = static_cast<uint16_t>(frame->getWidth());
+        info.height = static_cast<uint16_t>(frame->getHeight());
+        info.hotspotX = static_cast<int16_t>(info.width / 2);
+        info.hotspotY = static_cast<int16_t>(info.height / 2);
+        pixels.resize(pixels.size() + static_cast<size_t>(info.width) * info.height, 0);
+        frame->decodeTo(pixels.data() + info.offset, info.width);
+        return true;
+    }
+
+    const ShapeReader* frame = set.getFrame(index);
+    if (!frame || frame->getShapeCount() == 0) {
+        return false;
+    }
+    ShapeData shape = frame->decodeShape(0);
+    if (shape.pixels.empty() || shape.width > 0xFFFF || shape.height > 0xFFFF) {
+        return false;
+    }
+    info.width = static_cast<uint16_t>(shape.width);
+    info.height = static_cast<uint16_t>(shape.height);
+    info.hotspotX = static_cast<int16_t>(shape.hotspotX);
+    info.hotspotY = static_cast<int16_t>(shape.hotspotY);
+    pixels.insert(pixels.end(), shape.pixels.begin(), shape.pixels.end());
+    return true;
+}
+
+bool MechFrameCache::mirrorMatches(const MechSpriteSet& set, int facing, int mirrorOf,
+                                   float tolerance) const {
+    // Compare the first animation frame only; that costs one decode per
+    // mirrored facing instead of framesPerDirection.
+    const MechFrameInfo& stored = m_frames[m_facings[mirrorOf].firstFrame];
+    std::vector<uint8_t> pixels;
+    MechFrameInfo info;
+    if (!decodeSourceFrame(set, static_cast<uint32_t>(facing * m_framesPerDirection), pixels, info) ||
+        info.width != stored.width || info.height != stored.height || stored.width == 0) {
+        return false;
+    }
+
+    size_t allowed = static_cast<size_t>(tolerance * info.width * info.height);
+    size_t differing = 0;
+    const uint8_t* source = getPixels(stored);
+    for (int y = 0; y < info.height; ++y) {
+        const uint8_t* row = pixels.data() + static_cast<size_t>(y) * info.width;
+        const uint8_t* mirrored = source + static_cast<size_t>(y) * info.width;
+        for (int x = 0; x < info.width; ++x) {
+            if (row[x] != mirrored[info.width - 1 - x] && ++differing > allowed) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> MechFrameCache::toBinary() const {
+    MechFrameCacheHeader header{};
+    std::memcpy(header.magic, MECH_FRAMES_MAGIC, sizeof(header.magic));
+    header.facingCount = static_cast<uint32_t>(m_facings.size());
+    header.frameCount = static_cast<uint32_t>(m_frames.size());
+    header.pixelBytes = static_cast<uint32_t>(m_pixels.size());
+    header.framesPerDirection = m_framesPerDirection;
+    header.storedFacings = m_storedFacings;
+
+    std::vector<uint8_t> data(sizeof(header) + m_facings.size() * 2 * sizeof(int32_t) +
+                              m_frames.size() * sizeof(MechFrameInfo) + m_pixels.size());
+    uint8_t* out = data.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+
+    for (const Facing& facing : m_facings) {
+        int32_t values[2] = {facing.firstFrame, facing.flipH ? 1 : 0};
+        std::memcpy(out, values, sizeof(values));
+        out += sizeof(values);
+    }
+    if (!m_frames.empty()) {
+        std::memcpy(out, m_frames.data(), m_frames.size() * sizeof(MechFrameInfo));
+        out += m_frames.size() * sizeof(MechFrameInfo);
+    }
+    if (!m_pixels.empty()) {
+        std::memcpy(out, m_pixels.data(), m_pixels.size());
+    }
+    return data;
+}
+
+bool MechFrameCache::loadBinary(const uint8_t* data, size_t size) {
+    m_facings.clear();
+    m_frames.clear();
+    m_pixels.clear();
+    m_framesPerDirection = 0;
+    m_storedFacings = 0;
+
+    MechFrameCacheHeader header;
+    if (!data || size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    uint64_t expected = sizeof(header) + static_cast<uint64_t>(header.facingCount) * 2 * sizeof(int32_t) +
+                        static_cast<uint64_t>(header.frameCount) * sizeof(MechFrameInfo) + header.pixelBytes;
+    if (std::memcmp(header.magic, MECH_FRAMES_MAGIC, sizeof(header.magic)) != 0 ||
+        expected != size || header.facingCount == 0 || header.framesPerDirection <= 0 ||
+        header.storedFacings <= 0) {
+        return false;
+    }
+    const uint8_t* in = data + sizeof(header);
+
+    m_facings.resize(header.facingCount);
+    for (Facing& facing : m_facings) {
+        int32_t values[2];
+        std::memcpy(values, in, sizeof(values));
+        in += sizeof(values);
+        facing.firstFrame = values[0];
+        facing.flipH = values[1] != 0;
+        if (facing.firstFrame < 0 ||
+            static_cast<uint64_t>(facing.firstFrame) + header.framesPerDirection > header.frameCount) {
+            m_facings.clear();
+            return false;
+        }
+    }
+
+    m_frames.resize(header.frameCount);
+    std::memcpy(m_frames.data(), in, m_frames.size() * sizeof(MechFrameInfo));
+    in += m_frames.size() * sizeof(MechFrameInfo);
+    for (const MechFrameInfo& info : m_frames) {
+        if (static_cast<uint64_t>(info.offset) + static_cast<uint64_t>(info.width) * info.height >
+            header.pixelBytes) {
+            m_facings.clear();
+            m_frames.clear();
+            return false;
+        }
+    }
+
+    m_pixels.assign(in, in + header.pixelBytes);
+    m_framesPerDirection = header.framesPerDirection;
+    m_storedFacings = header.storedFacings;
+    return true;
+}
+
+int MechFrameCache::getStoredIndex(int facing, int frame, bool& flipH) const {
+    flipH = false;
+    if (m_facings.empty() || m_framesPerDirection == 0) {
+        return -1;
+    }
+
+    const Facing& entry = m_facings[wrapIndex(facing, static_cast<int>(m_facings.size()))];
+    if (entry.firstFrame < 0) {
+        return -1;
+    }
+    flipH = entry.flipH;
+    return entry.firstFrame + wrapIndex(frame, m_framesPerDirection);
+}
+
+const MechFrameInfo* MechFrameCache::getFrame(int facing, int frame, bool& flipH) const {
+    int index = getStoredIndex(facing, frame, flipH);
+    return index >= 0 ? &m_frames[index] : nullptr;
+}
+
+bool MechFrameCache::isMirrored(int facing) const {
+    if (m_facings.empty()) {
+        return false;
+    }
+    return m_facings[wrapIndex(facing, static_cast<int>(m_facings.size()))].flipH;
+}
+
+size_t MechFrameCache::getMemoryUsage() const {
+    return m_pixels.capacity() + m_frames.capacity() * sizeof(MechFrameInfo) +
+           m_facings.capacity() * sizeof(Facing);
+}
+
+// MechSprite implementation
+
+bool MechSprite::load(std::shared_ptr<const MechFrameCache> cache, const Palette& palette) {
+    if (!cache || cache->getFrames().empty()) {
+        return false;
+    }
+
+    auto& renderer = Renderer::instance();
+    std::vector<SpriteFrame> frames;
+    frames.reserve(cache->getFrames().size());
+    std::vector<uint8_t> rgba;
+    m_textureBytes = 0;
+
+    for (const auto& info : cache->getFrames()) {
+        SpriteFrame frame;
+        frame.width = info.width;
+        frame.height = info.height;
+        frame.offsetX = info.hotspotX;
+        frame.offsetY = info.hotspotY;
+
+        if (info.width > 0 && info.height > 0) {
+            size_t pixelCount = static_cast<size_t>(info.width) * info.height;
+            rgba.resize(pixelCount * 4);
+            palette.convertToRGBA(cache->getPixels(info), rgba.data(), pixelCount, 0);
+            frame.texture = renderer.createTexture(rgba.data(), info.width, info.height);
+            if (frame.texture != INVALID_TEXTURE) {
+                m_textureBytes += pixelCount * 4;
+            }
+        }
+        frames.push_back(frame);
+    }
+
+    m_cache = std::move(cache);
+    m_variants = nullptr;
+    if (!m_sprite.loadFrames(std::move(frames))) {
+        std::cerr << "MechSprite: Failed to create frames" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MechSprite::load(std::shared_ptr<const MechFrameCache> cache, PaletteVariantCache& variants,
+                      uint32_t imageBase) {
+    if (!cache || cache->getFrames().empty()) {
+        return false;
+    }
+
+    // Textures are looked up per draw in select()
+    std::vector<SpriteFrame> frames;
+    frames.reserve(cache->getFrames().size());
+    for (const auto& info : cache->getFrames()) {
+        SpriteFrame frame;
+        frame.width = info.width;
+        frame.height = info.height;
+        frame.offsetX = info.hotspotX;
+        frame.offsetY = info.hotspotY;
+        frames.push_back(frame);
+    }
+
+    m_cache = std::move(cache);
+    m_variants = &variants;
+    m_imageBase = imageBase;
+    m_textureBytes = 0;
+    return m_sprite.loadSharedFrames(std::move(frames));
+}
+
+bool MechSprite::select(int facing, int frame) {
+    if (!m_cache) {
+        return false;
+    }
+
+    bool flipH = false;
+    int index = m_cache->getStoredIndex(facing, frame, flipH);
+    if (index < 0) {
+        return false;
+    }
+    if (m_variants) {
+        const MechFrameInfo& info = m_cache->getFrames()[index];
+        if (info.width == 0 || info.height == 0) {
+            return false;
+        }
+        m_sprite.setFrameTexture(index, m_variants->getTexture(m_imageBase + static_cast<uint32_t>(index),
+                                                               m_cache->getPixels(info), info.width,
+                                                               info.height, m_remapId));
+    }
+    m_sprite.setFrame(index);
+    m_sprite.setFlip(flipH, false);
+    return true;
+}
+
+void MechSprite::draw(int facing, int frame, int x, int y) {
+    if (select(facing, frame)) {
+        m_sprite.draw(x, y);
+    }
+}
+
+void MechSprite::drawScaled(int facing, int frame, int x, int y, float scaleX, float scaleY) {
+    if (select(facing, frame)) {
+        m_sprite.drawScaled(x, y, scaleX, scaleY);
+    }
+}
+
+void MechSprite::submit(SceneRenderer& scene, uint32_t depth, int facing, int frame, int x, int y) {
+    if (select(facing, frame)) {
+        m_sprite.submit(scene, depth, x, y);
+    }
+}
+
+} // namespace mcgng
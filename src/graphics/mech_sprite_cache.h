@@ -0,0 +1,230 @@
+#ifndef MCGNG_MECH_SPRITE_CACHE_H
+#define MCGNG_MECH_SPRITE_CACHE_H
+
+#include "graphics/palette_effects.h"
+#include "graphics/sprite.h"
+#include "assets/nested_pak_reader.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * How the frames of a mech torso/leg set are arranged.
+ *
+ * Frames are stored facing-major: all animation frames of facing 0, then
+ * facing 1, ... Facings run clockwise from north, so facing d and facing
+ * (directions - d) are horizontal mirrors of each other.
+ */
+struct MechAnimLayout {
+    int directions = 8;             // Facings in the set
+    int framesPerDirection = 0;     // 0 = frame count / directions
+    bool mirror = true;             // Reuse mirrored facings where the art is symmetric
+    float mirrorTolerance = 0.0f;   // Fraction of pixels allowed to differ from the mirror
+};
+
+/**
+ * One decoded frame in a MechFrameCache.
+ */
+struct MechFrameInfo {
+    uint32_t offset = 0;    // Into the cache's pixel buffer
+    uint16_t width = 0;
+    uint16_t height = 0;
+    int16_t hotspotX = 0;
+    int16_t hotspotY = 0;
+};
+
+/**
+ * Decoded animation frames of one mech type, one entry per facing.
+ *
+ * Each stored facing is decoded exactly once into a single contiguous
+ * 8-bit buffer, laid out in draw order (facing, then animation frame).
+ * Facings on the left half whose art matches the horizontally flipped
+ * right half are not stored; they resolve to the right-hand facing with
+ * a flip flag, roughly halving decode time and memory.
+ *
+ * Immutable once built, so it can be built on a loader thread and shared
+ * through the AssetManager cache.
+ */
+class MechFrameCache {
+public:
+    MechFrameCache() = default;
+
+    /**
+     * Decode all frames of a sprite set.
+     * Uses the mech-format frames if present, otherwise the first shape of
+     * each standard frame.
+     * @param set Loaded sprite set
+     * @param layout Frame arrangement
+     * @return true if at least one facing was decoded
+     */
+    bool build(const MechSpriteSet& set, const MechAnimLayout& layout = MechAnimLayout());
+
+    /**
+     * Serialize the decoded frames (mcg-bake stores them in baked packs).
+     */
+    std::vector<uint8_t> toBinary() const;
+
+    /**
+     * Load frames produced by toBinary(); a copy, no decoding.
+     * @return true if the data is valid and holds at least one facing
+     */
+    bool loadBinary(const uint8_t* data, size_t size);
+
+    /**
+     * Look up the frame to draw for a facing.
+     * @param facing Facing index (wrapped into range)
+     * @param frame Animation frame (wrapped into range)
+     * @param flipH Set to true if the frame must be drawn mirrored
+     * @return Frame info, or nullptr if not built
+     */
+    const MechFrameInfo* getFrame(int facing, int frame, bool& flipH) const;
+
+    /**
+     * Index of a frame in draw order (as uploaded to a MechSprite).
+     * @return -1 if not built
+     */
+    int getStoredIndex(int facing, int frame, bool& flipH) const;
+
+    /**
+     * Get pixels of a frame (width * height, tightly packed).
+     */
+    const uint8_t* getPixels(const MechFrameInfo& info) const { return m_pixels.data() + info.offset; }
+
+    /**
+     * Get all stored frames in draw order.
+     */
+    const std::vector<MechFrameInfo>& getFrames() const { return m_frames; }
+
+    int getDirectionCount() const { return static_cast<int>(m_facings.size()); }
+    int getFramesPerDirection() const { return m_framesPerDirection; }
+
+    /**
+     * Get number of facings that are actually stored (not mirrored).
+     */
+    int getStoredFacingCount() const { return m_storedFacings; }
+
+    /**
+     * Check if a facing is drawn as a mirror of another one.
+     */
+    bool isMirrored(int facing) const;
+
+    /**
+     * Get bytes held by the cache.
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    struct Facing {
+        int firstFrame = -1;    // Index into m_frames
+        bool flipH = false;
+    };
+
+    void decodeFacing(const MechSpriteSet& set, int sourceFacing);
+    bool decodeSourceFrame(const MechSpriteSet& set, uint32_t index, std::vector<uint8_t>& pixels,
+                           MechFrameInfo& info) const;
+    bool mirrorMatches(const MechSpriteSet& set, int facing, int mirrorOf, float tolerance) const;
+
+    std::vector<Facing> m_facings;
+    std::vector<MechFrameInfo> m_frames;
+    std::vector<uint8_t> m_pixels;
+    int m_framesPerDirection = 0;
+    int m_storedFacings = 0;
+};
+
+/**
+ * Cache budgeting for MechFrameCache (see assetCpuBytes in asset_cache.h).
+ */
+inline size_t assetCpuBytes(const MechFrameCache& cache) {
+    return sizeof(cache) + cache.getMemoryUsage();
+}
+
+/**
+ * Drawable mech sprite backed by a MechFrameCache.
+ * Create and draw on the render thread.
+ */
+class MechSprite {
+public:
+    MechSprite() = default;
+
+    /**
+     * Create textures for every stored frame.
+     * @param cache Decoded frames
+     * @param palette Palette for color conversion (index 0 is transparent)
+     * @return true on success
+     */
+    bool load(std::shared_ptr<const MechFrameCache> cache, const Palette& palette);
+
+    /**
+     * Draw through a variant cache instead of fixed textures, so remaps
+     * (team colors) and palette cycling apply. A frame's texture is built
+     * when that variant is first drawn and belongs to the variant cache.
+     * @param cache Decoded frames
+     * @param variants Texture cache; must outlive the sprite
+     * @param imageBase Variant image id of stored frame 0 (frame i uses imageBase + i)
+     * @return true on success
+     */
+    bool load(std::shared_ptr<const MechFrameCache> cache, PaletteVariantCache& variants,
+              uint32_t imageBase);
+
+    /**
+     * Set the remap used by later draws (variant mode only).
+     * @param remapId PaletteVariantCache::NO_REMAP or an id from addRemap()
+     */
+    void setRemap(uint32_t remapId) { m_remapId = remapId; }
+
+    /**
+     * Check if loaded.
+     */
+    bool isLoaded() const { return m_sprite.isLoaded(); }
+
+    /**
+     * Draw a facing / animation frame with its hotspot at (x, y).
+     */
+    void draw(int facing, int frame, int x, int y);
+
+    /**
+     * Draw with scaling.
+     */
+    void drawScaled(int facing, int frame, int x, int y, float scaleX, float scaleY);
+
+    /**
+     * Queue a facing / animation frame into a scene.
+     * @param depth Depth key (see SceneRenderer::depthKey)
+     */
+    void submit(SceneRenderer& scene, uint32_t depth, int facing, int frame, int x, int y);
+
+    /**
+     * Get the frame cache.
+     */
+    const MechFrameCache* getCache() const { return m_cache.get(); }
+
+    /**
+     * Get the GPU memory of the created textures (RGBA, 4 bytes per pixel).
+     */
+    size_t getTextureBytes() const { return m_textureBytes; }
+
+private:
+    bool select(int facing, int frame);
+
+    std::shared_ptr<const MechFrameCache> m_cache;
+    Sprite m_sprite;
+    size_t m_textureBytes = 0;
+    PaletteVariantCache* m_variants = nullptr;
+    uint32_t m_imageBase = 0;
+    uint32_t m_remapId = PaletteVariantCache::NO_REMAP;
+};
+
+/**
+ * Cache budgeting for MechSprite: its frame table only. The shared frame
+ * cache is charged under its own key and the textures as texture bytes.
+ */
+inline size_t assetCpuBytes(const MechSprite& sprite) {
+    const MechFrameCache* cache = sprite.getCache();
+    return sizeof(sprite) + (cache ? cache->getFrames().size() * sizeof(SpriteFrame) : 0);
+}
+
+} // namespace mcgng
+
+#endif // MCGNG_MECH_SPRITE_CACHE_H
@@ -173,20 +173,17 @@ PaletteManager& PaletteManager::instance() {
 }
 
 bool PaletteManager::loadPalette(const std::string& name, const std::string& path) {
-    // Check if already loaded
-    for (auto& pair : m_palettes) {
-        if (pair.first == name) {
-            return pair.second.loadFromFile(path);
-        }
+    // Reload in place if already loaded
+    auto it = m_palettes.find(name);
+    if (it != m_palettes.end()) {
+        return it->second.loadFromFile(path);
     }
 
-    // Add new palette
-    m_palettes.emplace_back();
-    m_palettes.back().first = name;
-    if (!m_palettes.back().second.loadFromFile(path)) {
-        m_palettes.pop_back();
+    Palette palette;
+    if (!palette.loadFromFile(path)) {
         return false;
     }
+    m_palettes.emplace(name, palette);
 
     // Set as default if first palette loaded
     if (m_defaultPalette.empty()) {
@@ -198,12 +195,8 @@ bool PaletteManager::loadPalette(const std::string& name, const std::string& pat
 }
 
 const Palette* PaletteManager::getPalette(const std::string& name) const {
-    for (const auto& pair : m_palettes) {
-        if (pair.first == name) {
-            return &pair.second;
-        }
-    }
-    return nullptr;
+    auto it = m_palettes.find(name);
+    return it != m_palettes.end() ? &it->second : nullptr;
 }
 
 const Palette* PaletteManager::getDefaultPalette() const {
@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <unordered_map>
 
 namespace mcgng {
 
@@ -146,7 +147,7 @@ public:
 private:
     PaletteManager() = default;
 
-    std::vector<std::pair<std::string, Palette>> m_palettes;
+    std::unordered_map<std::string, Palette> m_palettes;
     std::string m_defaultPalette;
 };
 
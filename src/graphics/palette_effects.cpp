@@ -0,0 +1,224 @@
+#include "graphics/palette_effects.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mcgng {
+
+// RemapTable implementation
+
+RemapTable RemapTable::range(uint8_t first, int count, uint8_t targetFirst) {
+    RemapTable remap;
+    count = std::min({count, Palette::NUM_COLORS - first, Palette::NUM_COLORS - targetFirst});
+    for (int i = 0; i < count; ++i) {
+        if (first + i != 0) {
+            remap.table[first + i] = static_cast<uint8_t>(targetFirst + i);
+        }
+    }
+    return remap;
+}
+
+RemapTable RemapTable::tint(const Palette& palette, const Color& color, float amount) {
+    RemapTable remap;
+    amount = std::max(0.0f, std::min(1.0f, amount));
+
+    for (int i = 1; i < Palette::NUM_COLORS; ++i) {
+        uint8_t index = static_cast<uint8_t>(i);
+        float r = palette.getRed(index) + (color.r - palette.getRed(index)) * amount;
+        float g = palette.getGreen(index) + (color.g - palette.getGreen(index)) * amount;
+        float b = palette.getBlue(index) + (color.b - palette.getBlue(index)) * amount;
+
+        // Closest opaque entry (index 0 stays transparent)
+        int best = i;
+        float bestDistance = 1e30f;
+        for (int j = 1; j < Palette::NUM_COLORS; ++j) {
+            uint8_t candidate = static_cast<uint8_t>(j);
+            float dr = palette.getRed(candidate) - r;
+            float dg = palette.getGreen(candidate) - g;
+            float db = palette.getBlue(candidate) - b;
+            float distance = dr * dr + dg * dg + db * db;
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = j;
+            }
+        }
+        remap.table[i] = static_cast<uint8_t>(best);
+    }
+    return remap;
+}
+
+// PaletteEffects implementation
+
+void PaletteEffects::setBasePalette(const Palette& palette) {
+    m_base = palette;
+    for (auto& cycle : m_cycles) {
+        cycle.accumulator = 0.0f;
+        cycle.offset = 0;
+    }
+    rebuild();
+}
+
+bool PaletteEffects::addCycle(uint8_t first, int count, float stepsPerSecond) {
+    if (count < 2 || first + count > Palette::NUM_COLORS ||
+        static_cast<int>(m_cycles.size()) >= MAX_CYCLES) {
+        return false;
+    }
+
+    Cycle cycle;
+    cycle.first = first;
+    cycle.count = count;
+    cycle.stepsPerSecond = stepsPerSecond;
+    m_cycles.push_back(cycle);
+    for (int i = 0; i < count; ++i) {
+        m_cycleMask[first + i] |= static_cast<uint8_t>(1u << (m_cycles.size() - 1));
+    }
+    ++m_cycleVersion;
+    rebuild();
+    return true;
+}
+
+void PaletteEffects::clearCycles() {
+    m_cycles.clear();
+    m_cycleMask.fill(0);
+    ++m_cycleVersion;
+    rebuild();
+}
+
+bool PaletteEffects::update(float deltaTime) {
+    bool changed = false;
+    for (auto& cycle : m_cycles) {
+        cycle.accumulator += deltaTime * std::fabs(cycle.stepsPerSecond);
+        if (cycle.accumulator < 1.0f) {
+            continue;
+        }
+        int steps = static_cast<int>(cycle.accumulator);
+        cycle.accumulator -= static_cast<float>(steps);
+        steps %= cycle.count;
+        if (cycle.stepsPerSecond < 0.0f) {
+            steps = cycle.count - steps;
+        }
+        int offset = (cycle.offset + steps) % cycle.count;
+        if (offset != cycle.offset) {
+            cycle.offset = offset;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        rebuild();
+    }
+    return changed;
+}
+
+void PaletteEffects::rebuild() {
+    m_current = m_base;
+    m_phaseKey = 0;
+
+    for (size_t c = 0; c < m_cycles.size(); ++c) {
+        const Cycle& cycle = m_cycles[c];
+        for (int i = 0; i < cycle.count; ++i) {
+            uint8_t source = static_cast<uint8_t>(cycle.first + i);
+            uint8_t target = static_cast<uint8_t>(cycle.first + (i + cycle.offset) % cycle.count);
+            m_current.setColor(target, m_base.getRed(source), m_base.getGreen(source),
+                               m_base.getBlue(source));
+        }
+        m_phaseKey |= static_cast<uint64_t>(cycle.offset & 0xFF) << (c * 8);
+    }
+}
+
+uint64_t PaletteEffects::getPhaseKey(uint8_t cycleMask) const {
+    uint64_t key = 0;
+    for (size_t c = 0; c < m_cycles.size(); ++c) {
+        if (cycleMask & (1u << c)) {
+            key |= m_phaseKey & (0xFFull << (c * 8));
+        }
+    }
+    return key;
+}
+
+void PaletteEffects::buildVariantPalette(const RemapTable* remap, Palette& out) const {
+    if (!remap) {
+        out = m_current;
+        return;
+    }
+    for (int i = 0; i < Palette::NUM_COLORS; ++i) {
+        uint8_t source = (*remap)[static_cast<uint8_t>(i)];
+        out.setColor(static_cast<uint8_t>(i), m_current.getRed(source), m_current.getGreen(source),
+                     m_current.getBlue(source));
+    }
+}
+
+// PaletteVariantCache implementation
+
+PaletteVariantCache::~PaletteVariantCache() {
+    clear();
+}
+
+uint32_t PaletteVariantCache::addRemap(const RemapTable& remap) {
+    m_remaps.push_back(remap);
+    return static_cast<uint32_t>(m_remaps.size());
+}
+
+TextureHandle PaletteVariantCache::getTexture(uint32_t imageId, const uint8_t* pixels,
+                                              int width, int height, uint32_t remapId) {
+    if (!pixels || width <= 0 || height <= 0 || remapId > m_remaps.size()) {
+        return INVALID_TEXTURE;
+    }
+    const RemapTable* remap = remapId != NO_REMAP ? &m_remaps[remapId - 1] : nullptr;
+    size_t pixelCount = static_cast<size_t>(width) * height;
+
+    // Art depends only on the phases of the cycles its (remapped) indices use
+    if (m_cycleVersion != m_effects.getCycleVersion()) {
+        m_cycleMasks.clear();
+        m_cycleVersion = m_effects.getCycleVersion();
+    }
+    uint64_t usageKey = (static_cast<uint64_t>(imageId) << 32) | remapId;
+    auto usage = m_cycleMasks.find(usageKey);
+    if (usage == m_cycleMasks.end()) {
+        uint8_t mask = 0;
+        for (size_t i = 0; i < pixelCount; ++i) {
+            if (pixels[i] != 0) {
+                mask |= m_effects.getCycleMask(remap ? (*remap)[pixels[i]] : pixels[i]);
+            }
+        }
+        usage = m_cycleMasks.emplace(usageKey, mask).first;
+    }
+
+    Key key{imageId, remapId, usage->second ? m_effects.getPhaseKey(usage->second) : 0};
+    auto it = m_textures.find(key);
+    if (it != m_textures.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return it->second->texture;
+    }
+
+    m_effects.buildVariantPalette(remap, m_variant);
+    m_rgba.resize(pixelCount * 4);
+    m_variant.convertToRGBA(pixels, m_rgba.data(), pixelCount);
+
+    TextureHandle texture = Renderer::instance().createTexture(m_rgba.data(), width, height);
+    m_lru.push_front({key, texture});
+    m_textures.emplace(key, m_lru.begin());
+    ++m_buildCount;
+    return texture;
+}
+
+void PaletteVariantCache::beginFrame() {
+    auto& renderer = Renderer::instance();
+    while (m_lru.size() > m_capacity) {
+        const Entry& oldest = m_lru.back();
+        renderer.destroyTexture(oldest.texture);
+        m_textures.erase(oldest.key);
+        m_lru.pop_back();
+    }
+}
+
+void PaletteVariantCache::clear() {
+    auto& renderer = Renderer::instance();
+    for (const auto& entry : m_lru) {
+        renderer.destroyTexture(entry.texture);
+    }
+    m_lru.clear();
+    m_textures.clear();
+    m_cycleMasks.clear();
+}
+
+} // namespace mcgng
@@ -0,0 +1,236 @@
+#ifndef MCGNG_PALETTE_EFFECTS_H
+#define MCGNG_PALETTE_EFFECTS_H
+
+#include "graphics/palette.h"
+#include "graphics/renderer.h"
+#include <array>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Index-to-index remap applied before palette lookup (team colors,
+ * damage tint, fog). Index 0 (transparent) always maps to itself.
+ */
+struct RemapTable {
+    std::array<uint8_t, Palette::NUM_COLORS> table;
+
+    RemapTable() { for (int i = 0; i < Palette::NUM_COLORS; ++i) table[i] = static_cast<uint8_t>(i); }
+
+    uint8_t operator[](uint8_t index) const { return table[index]; }
+
+    /**
+     * Move a run of indices onto another run, e.g. the default team-color
+     * ramp onto a player's ramp.
+     */
+    static RemapTable range(uint8_t first, int count, uint8_t targetFirst);
+
+    /**
+     * Blend every color toward a tint and map it to the closest palette
+     * entry. amount 0 = unchanged, 1 = the tint color.
+     */
+    static RemapTable tint(const Palette& palette, const Color& color, float amount);
+};
+
+/**
+ * Animated palette: a base palette plus color-cycle ranges (water, fire,
+ * blinking lights).
+ *
+ * The animated palette is only rebuilt when a cycle steps. Every cycle
+ * state has a phase key, so textures built for one state can be cached
+ * and reused when the cycle comes around again.
+ */
+class PaletteEffects {
+public:
+    static constexpr int MAX_CYCLES = 8;    // Phase key packs 8 bits per cycle
+
+    /**
+     * Set the base palette (resets cycle positions).
+     */
+    void setBasePalette(const Palette& palette);
+
+    /**
+     * Add a cycle over indices [first, first + count).
+     * @param stepsPerSecond Rotation speed; negative rotates backwards
+     * @return false if the range is invalid or MAX_CYCLES is reached
+     */
+    bool addCycle(uint8_t first, int count, float stepsPerSecond);
+
+    /**
+     * Remove all cycles.
+     */
+    void clearCycles();
+
+    /**
+     * Advance cycles.
+     * @return true if the palette changed
+     */
+    bool update(float deltaTime);
+
+    /**
+     * Get the palette for the current cycle state.
+     */
+    const Palette& getPalette() const { return m_current; }
+
+    /**
+     * Get a key identifying the current cycle state (0 = no cycles moved).
+     */
+    uint64_t getPhaseKey() const { return m_phaseKey; }
+
+    /**
+     * Get the phase key of only some cycles, so art that uses one cycle
+     * does not change key when another one steps.
+     * @param cycleMask Bit c selects cycle c (see getCycleMask)
+     */
+    uint64_t getPhaseKey(uint8_t cycleMask) const;
+
+    /**
+     * Get a counter that changes whenever cycles are added or removed.
+     */
+    uint32_t getCycleVersion() const { return m_cycleVersion; }
+
+    /**
+     * Check if an index is part of any cycle.
+     */
+    bool isCycled(uint8_t index) const { return m_cycleMask[index] != 0; }
+
+    /**
+     * Get the cycles an index belongs to (bit c = cycle c).
+     */
+    uint8_t getCycleMask(uint8_t index) const { return m_cycleMask[index]; }
+
+    /**
+     * Compose the current palette with a remap into one 256-color palette,
+     * so remapped indexed art converts in a single lookup.
+     */
+    void buildVariantPalette(const RemapTable* remap, Palette& out) const;
+
+private:
+    struct Cycle {
+        uint8_t first = 0;
+        int count = 0;
+        float stepsPerSecond = 0.0f;
+        float accumulator = 0.0f;
+        int offset = 0;
+    };
+
+    void rebuild();
+
+    Palette m_base;
+    Palette m_current;
+    std::vector<Cycle> m_cycles;
+    std::array<uint8_t, Palette::NUM_COLORS> m_cycleMask{};
+    uint64_t m_phaseKey = 0;
+    uint32_t m_cycleVersion = 0;
+};
+
+/**
+ * Textures for indexed images under remaps and palette cycling.
+ *
+ * A texture is built the first time an (image, remap, phase) combination
+ * is drawn and reused afterwards. The phase only covers the cycles the
+ * image's (remapped) pixels actually use, so static art is built once and
+ * animated art once per state of its own cycles. Nothing is converted per
+ * frame. Call clear() after changing the base palette.
+ *
+ * At most getCapacity() textures are kept; beginFrame() destroys the
+ * least recently drawn ones beyond that.
+ *
+ * Render thread only.
+ */
+class PaletteVariantCache {
+public:
+    static constexpr uint32_t NO_REMAP = 0;
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+    explicit PaletteVariantCache(const PaletteEffects& effects, size_t capacity = DEFAULT_CAPACITY)
+        : m_effects(effects), m_capacity(capacity) {}
+    ~PaletteVariantCache();
+
+    PaletteVariantCache(const PaletteVariantCache&) = delete;
+    PaletteVariantCache& operator=(const PaletteVariantCache&) = delete;
+
+    /**
+     * Register a remap table.
+     * @return Remap id for getTexture()
+     */
+    uint32_t addRemap(const RemapTable& remap);
+
+    /**
+     * Get the texture for an indexed image in the current cycle state.
+     * @param imageId Caller-chosen stable id for the pixels
+     * @param pixels 8-bit indexed pixels (index 0 = transparent)
+     * @param remapId NO_REMAP or an id from addRemap()
+     */
+    TextureHandle getTexture(uint32_t imageId, const uint8_t* pixels, int width, int height,
+                             uint32_t remapId = NO_REMAP);
+
+    /**
+     * Start a frame: evict least recently drawn textures above capacity.
+     * Textures handed out during a frame may still be queued for drawing,
+     * so eviction only happens here.
+     */
+    void beginFrame();
+
+    /**
+     * Destroy all cached textures (e.g. on scene change).
+     */
+    void clear();
+
+    /**
+     * Get the maximum number of textures kept across frames.
+     */
+    size_t getCapacity() const { return m_capacity; }
+
+    /**
+     * Get number of cached textures.
+     */
+    size_t getTextureCount() const { return m_textures.size(); }
+
+    /**
+     * Get how many textures have been built (for diagnostics).
+     */
+    uint32_t getBuildCount() const { return m_buildCount; }
+
+private:
+    struct Key {
+        uint32_t imageId;
+        uint32_t remapId;
+        uint64_t phase;
+
+        bool operator==(const Key& other) const {
+            return imageId == other.imageId && remapId == other.remapId && phase == other.phase;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            uint64_t h = (static_cast<uint64_t>(key.imageId) << 32) ^ key.remapId;
+            h ^= key.phase + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        TextureHandle texture;
+    };
+
+    const PaletteEffects& m_effects;
+    size_t m_capacity;
+    std::vector<RemapTable> m_remaps;
+    std::list<Entry> m_lru;                              // Most recently drawn first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_textures;
+    std::unordered_map<uint64_t, uint8_t> m_cycleMasks;  // Per (image, remap)
+    uint32_t m_cycleVersion = 0;
+    std::vector<uint8_t> m_rgba;                         // Conversion scratch
+    Palette m_variant;
+    uint32_t m_buildCount = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_PALETTE_EFFECTS_H
@@ -0,0 +1,285 @@
+#include "graphics/particles.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MCGNG_PARTICLES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace mcgng {
+
+namespace {
+
+constexpr int DEFAULT_FRAME_SIZE = 16;
+
+uint8_t lerpChannel(uint8_t a, uint8_t b, float t) {
+    return static_cast<uint8_t>(a + (static_cast<float>(b) - a) * t + 0.5f);
+}
+
+/**
+ * White frames with alpha falloff, hardest (sparks) to softest (smoke).
+ */
+std::vector<uint8_t> buildDefaultAtlas(int frames, int frameSize) {
+    int width = frames * frameSize;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * frameSize * 4);
+    float radius = frameSize * 0.5f;
+
+    for (int frame = 0; frame < frames; ++frame) {
+        float falloff = 4.0f - 3.0f * frame / std::max(1, frames - 1);
+        for (int y = 0; y < frameSize; ++y) {
+            for (int x = 0; x < frameSize; ++x) {
+                float dx = (x + 0.5f - radius) / radius;
+                float dy = (y + 0.5f - radius) / radius;
+                float d = std::min(1.0f, std::sqrt(dx * dx + dy * dy));
+                float alpha = std::pow(1.0f - d, 1.0f / falloff);
+                uint8_t* px = &rgba[(static_cast<size_t>(y) * width + frame * frameSize + x) * 4];
+                px[0] = px[1] = px[2] = 255;
+                px[3] = static_cast<uint8_t>(alpha * 255.0f + 0.5f);
+            }
+        }
+    }
+    return rgba;
+}
+
+} // anonymous namespace
+
+// Pool implementation
+
+void ParticleSystem::Pool::allocate(uint32_t size) {
+    capacity = (size + 3) & ~3u;
+    count = 0;
+    for (auto* array : {&x, &y, &vx, &vy, &ay, &life, &invLifetime}) {
+        array->assign(capacity, 0.0f);
+    }
+    effect.assign(capacity, 0);
+}
+
+void ParticleSystem::Pool::removeDead() {
+    uint32_t i = 0;
+    while (i < count) {
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        uint32_t last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        ay[i] = ay[last];
+        life[i] = life[last];
+        invLifetime[i] = invLifetime[last];
+        effect[i] = effect[last];
+    }
+}
+
+// ParticleSystem implementation
+
+ParticleSystem& ParticleSystem::instance() {
+    static ParticleSystem instance;
+    return instance;
+}
+
+bool ParticleSystem::initialize(uint32_t capacityPerPool) {
+    if (m_initialized) {
+        return true;
+    }
+    if (capacityPerPool == 0) {
+        std::cerr << "ParticleSystem: Capacity must be non-zero" << std::endl;
+        return false;
+    }
+
+    m_alpha.blend = BlendMode::Alpha;
+    m_alpha.allocate(capacityPerPool);
+    m_additive.blend = BlendMode::Additive;
+    m_additive.allocate(capacityPerPool);
+    m_quads.reserve(m_alpha.capacity);
+    m_stats = ParticleStats();
+    m_stats.capacity = m_alpha.capacity + m_additive.capacity;
+
+    if (m_atlas == INVALID_TEXTURE) {
+        std::vector<uint8_t> rgba = buildDefaultAtlas(DEFAULT_ATLAS_FRAMES, DEFAULT_FRAME_SIZE);
+        m_defaultAtlas = Renderer::instance().createTexture(
+            rgba.data(), DEFAULT_ATLAS_FRAMES * DEFAULT_FRAME_SIZE, DEFAULT_FRAME_SIZE);
+        setAtlas(m_defaultAtlas, DEFAULT_FRAME_SIZE, DEFAULT_FRAME_SIZE, DEFAULT_ATLAS_FRAMES);
+    }
+
+    m_initialized = true;
+    return true;
+}
+
+void ParticleSystem::shutdown() {
+    if (m_defaultAtlas != INVALID_TEXTURE) {
+        Renderer::instance().destroyTexture(m_defaultAtlas);
+        if (m_atlas == m_defaultAtlas) {
+            m_atlas = INVALID_TEXTURE;
+        }
+        m_defaultAtlas = INVALID_TEXTURE;
+    }
+    m_alpha = Pool();
+    m_additive = Pool();
+    m_effects.clear();
+    m_quads = std::vector<TexturedQuad>();
+    m_stats = ParticleStats();
+    m_initialized = false;
+}
+
+void ParticleSystem::setAtlas(TextureHandle texture, int frameWidth, int frameHeight, int columns) {
+    m_atlas = texture;
+    m_frameWidth = frameWidth;
+    m_frameHeight = frameHeight;
+    m_atlasColumns = std::max(1, columns);
+}
+
+ParticleEffectId ParticleSystem::addEffect(const ParticleEffect& effect) {
+    if (m_effects.size() >= INVALID_PARTICLE_EFFECT) {
+        return INVALID_PARTICLE_EFFECT;
+    }
+    ParticleEffect stored = effect;
+    stored.frameCount = std::max<uint16_t>(1, stored.frameCount);
+    stored.lifeMin = std::max(0.001f, stored.lifeMin);
+    stored.lifeMax = std::max(stored.lifeMin, stored.lifeMax);
+    if (stored.blend != BlendMode::Additive) {
+        stored.blend = BlendMode::Alpha;
+    }
+    m_effects.push_back(stored);
+    return static_cast<ParticleEffectId>(m_effects.size() - 1);
+}
+
+float ParticleSystem::random01() {
+    // xorshift32: cheap, and good enough for visual noise
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+    return static_cast<float>(m_rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+uint32_t ParticleSystem::emit(ParticleEffectId effectId, float x, float y, float direction) {
+    if (!m_initialized || effectId >= m_effects.size()) {
+        return 0;
+    }
+    const ParticleEffect& effect = m_effects[effectId];
+    Pool& pool = poolFor(effect.blend);
+
+    uint32_t requested = static_cast<uint32_t>(std::max(0, effect.count));
+    uint32_t spawn = std::min(requested, pool.capacity - pool.count);
+    m_stats.dropped += requested - spawn;
+    m_stats.spawned += spawn;
+
+    for (uint32_t n = 0; n < spawn; ++n) {
+        uint32_t i = pool.count++;
+        float angle = direction + (random01() - 0.5f) * effect.spread;
+        float speed = effect.speedMin + (effect.speedMax - effect.speedMin) * random01();
+        float lifetime = effect.lifeMin + (effect.lifeMax - effect.lifeMin) * random01();
+
+        pool.x[i] = x;
+        pool.y[i] = y;
+        pool.vx[i] = std::cos(angle) * speed;
+        pool.vy[i] = std::sin(angle) * speed;
+        pool.ay[i] = effect.gravity;
+        pool.life[i] = lifetime;
+        pool.invLifetime[i] = 1.0f / lifetime;
+        pool.effect[i] = effectId;
+    }
+    return spawn;
+}
+
+void ParticleSystem::integrate(float* x, float* y, float* vx, float* vy, const float* ay,
+                               float* life, uint32_t count, float deltaTime) {
+#ifdef MCGNG_PARTICLES_SSE2
+    // Pools are padded to a multiple of 4, so the last group may run past count
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    for (uint32_t i = 0; i < count; i += 4) {
+        __m128 vxs = _mm_loadu_ps(vx + i);
+        __m128 vys = _mm_loadu_ps(vy + i);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vxs, dt)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vys, dt)));
+        _mm_storeu_ps(vy + i, _mm_add_ps(vys, _mm_mul_ps(_mm_loadu_ps(ay + i), dt)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), dt));
+    }
+#else
+    for (uint32_t i = 0; i < count; ++i) {
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        vy[i] += ay[i] * deltaTime;
+        life[i] -= deltaTime;
+    }
+#endif
+}
+
+void ParticleSystem::update(float deltaTime) {
+    MCGNG_PROFILE_ZONE("ParticleSystem::update");
+
+    for (Pool* pool : {&m_alpha, &m_additive}) {
+        if (pool->count == 0) {
+            continue;
+        }
+        integrate(pool->x.data(), pool->y.data(), pool->vx.data(), pool->vy.data(),
+                  pool->ay.data(), pool->life.data(), pool->count, deltaTime);
+        pool->removeDead();
+    }
+
+    m_stats.alive = m_alpha.count + m_additive.count;
+    m_stats.lastSpawned = m_stats.spawned;
+    m_stats.lastDropped = m_stats.dropped;
+    m_stats.spawned = 0;
+    m_stats.dropped = 0;
+}
+
+void ParticleSystem::render(float cameraX, float cameraY) {
+    MCGNG_PROFILE_ZONE("ParticleSystem::render");
+    if (m_atlas == INVALID_TEXTURE) {
+        return;
+    }
+
+    auto& renderer = Renderer::instance();
+
+    // Alpha-blended smoke first, additive flashes on top
+    for (BlendMode blend : {BlendMode::Alpha, BlendMode::Additive}) {
+        buildQuads(blend, m_quads, cameraX, cameraY);
+        if (!m_quads.empty()) {
+            renderer.drawTextureQuads(m_atlas, m_quads.data(), m_quads.size(), blend);
+        }
+    }
+}
+
+void ParticleSystem::buildQuads(BlendMode blend, std::vector<TexturedQuad>& quads,
+                                float cameraX, float cameraY) const {
+    quads.clear();
+    if (m_atlas == INVALID_TEXTURE) {
+        return;
+    }
+
+    const Pool& pool = poolFor(blend);
+    for (uint32_t i = 0; i < pool.count; ++i) {
+        const ParticleEffect& effect = m_effects[pool.effect[i]];
+        float t = std::min(1.0f, std::max(0.0f, 1.0f - pool.life[i] * pool.invLifetime[i]));
+
+        int frame = effect.firstFrame +
+                    std::min<int>(static_cast<int>(t * effect.frameCount), effect.frameCount - 1);
+        float size = effect.sizeStart + (effect.sizeEnd - effect.sizeStart) * t;
+        int extent = std::max(1, static_cast<int>(size + 0.5f));
+
+        TexturedQuad quad;
+        quad.src = {(frame % m_atlasColumns) * m_frameWidth, (frame / m_atlasColumns) * m_frameHeight,
+                    m_frameWidth, m_frameHeight};
+        quad.dst = {static_cast<int>(pool.x[i] - cameraX) - extent / 2,
+                    static_cast<int>(pool.y[i] - cameraY) - extent / 2, extent, extent};
+        quad.color = {lerpChannel(effect.colorStart.r, effect.colorEnd.r, t),
+                      lerpChannel(effect.colorStart.g, effect.colorEnd.g, t),
+                      lerpChannel(effect.colorStart.b, effect.colorEnd.b, t),
+                      lerpChannel(effect.colorStart.a, effect.colorEnd.a, t)};
+        quads.push_back(quad);
+    }
+}
+
+void ParticleSystem::clear() {
+    m_alpha.count = 0;
+    m_additive.count = 0;
+    m_stats.alive = 0;
+}
+
+} // namespace mcgng
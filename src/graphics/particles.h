@@ -0,0 +1,191 @@
+#ifndef MCGNG_PARTICLES_H
+#define MCGNG_PARTICLES_H
+
+#include "graphics/renderer.h"
+#include <cstdint>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Particle effect description (muzzle flash, sparks, explosion, smoke).
+ *
+ * Each emit() spawns `count` particles at a point, moving in a cone around
+ * a direction. Color, size and atlas frame are interpolated over each
+ * particle's life, so per-particle state stays small.
+ */
+struct ParticleEffect {
+    int count = 8;                  // Particles per emit
+    float speedMin = 20.0f;         // Pixels per second
+    float speedMax = 60.0f;
+    float spread = 6.2831853f;      // Cone width in radians (2*pi = all around)
+    float lifeMin = 0.3f;           // Seconds
+    float lifeMax = 0.6f;
+    float gravity = 0.0f;           // Pixels per second squared, +y is down
+    Color colorStart = Color::white();
+    Color colorEnd = {255, 255, 255, 0};
+    float sizeStart = 8.0f;         // Pixels
+    float sizeEnd = 8.0f;
+    uint16_t firstFrame = 0;        // Atlas frames played over the life
+    uint16_t frameCount = 1;
+    BlendMode blend = BlendMode::Additive;  // Additive or Alpha
+};
+
+/**
+ * Particle effect id within the ParticleSystem.
+ */
+using ParticleEffectId = uint16_t;
+constexpr ParticleEffectId INVALID_PARTICLE_EFFECT = 0xFFFF;
+
+/**
+ * Particle counters for the overlay and profiling.
+ */
+struct ParticleStats {
+    uint32_t alive = 0;         // Live particles across pools
+    uint32_t capacity = 0;      // Total pool capacity
+    uint32_t spawned = 0;       // Spawned since the last update
+    uint32_t dropped = 0;       // Spawns rejected because a pool was full
+    uint32_t lastSpawned = 0;   // spawned as of the last update (for snapshots)
+    uint32_t lastDropped = 0;   // dropped as of the last update (for snapshots)
+};
+
+/**
+ * Pooled particle simulation and batched drawing.
+ *
+ * Particles live in fixed-capacity structure-of-arrays pools, one per
+ * blend mode; nothing is allocated after initialize(). update() integrates
+ * position, velocity and life four particles at a time (SSE2 where
+ * available) and swap-removes dead particles. render() draws each pool as
+ * one drawTextureQuads() batch from a shared frame atlas, so every live
+ * particle costs one draw call per blend mode in total.
+ *
+ * Game thread only.
+ */
+class ParticleSystem {
+public:
+    static ParticleSystem& instance();
+
+    /**
+     * Allocate the pools and build the default atlas.
+     * @param capacityPerPool Particles per blend mode (rounded up to 4)
+     */
+    bool initialize(uint32_t capacityPerPool = 8192);
+
+    /**
+     * Release pools, effects and the default atlas texture.
+     */
+    void shutdown();
+
+    bool isInitialized() const { return m_initialized; }
+
+    /**
+     * Use a custom atlas instead of the default one.
+     * Frames are laid out left to right, top to bottom.
+     * @param texture Atlas texture (not owned)
+     */
+    void setAtlas(TextureHandle texture, int frameWidth, int frameHeight, int columns);
+
+    /**
+     * Register an effect.
+     * @return Effect id for emit()
+     */
+    ParticleEffectId addEffect(const ParticleEffect& effect);
+
+    /**
+     * Spawn an effect's particles.
+     * @param direction Cone center in radians (0 = +x)
+     * @return Number of particles spawned (fewer if the pool is full)
+     */
+    uint32_t emit(ParticleEffectId effect, float x, float y, float direction = 0.0f);
+
+    /**
+     * Advance all particles.
+     */
+    void update(float deltaTime);
+
+    /**
+     * Draw all particles, offset by the camera position.
+     */
+    void render(float cameraX = 0.0f, float cameraY = 0.0f);
+
+    /**
+     * Build the quads render() would draw for one blend mode, without
+     * drawing them (for render snapshots).
+     * @param quads Output (cleared first)
+     */
+    void buildQuads(BlendMode blend, std::vector<TexturedQuad>& quads,
+                    float cameraX = 0.0f, float cameraY = 0.0f) const;
+
+    /**
+     * Get the atlas texture the quads refer to.
+     */
+    TextureHandle getAtlas() const { return m_atlas; }
+
+    /**
+     * Remove all live particles.
+     */
+    void clear();
+
+    /**
+     * Get counters (spawned/dropped cover the interval since the last update,
+     * lastSpawned/lastDropped the interval before it).
+     */
+    const ParticleStats& getStats() const { return m_stats; }
+
+    /**
+     * Atlas frames in the default atlas, from hard spark to soft puff.
+     */
+    static constexpr uint16_t DEFAULT_ATLAS_FRAMES = 4;
+
+    /**
+     * Integrate one pool's arrays (exposed for benchmarking).
+     * x += vx*dt, y += vy*dt, vy += ay*dt, life -= dt for [0, count).
+     * Arrays must have room for count rounded up to 4.
+     */
+    static void integrate(float* x, float* y, float* vx, float* vy, const float* ay, float* life,
+                          uint32_t count, float deltaTime);
+
+private:
+    ParticleSystem() = default;
+    ~ParticleSystem() = default;
+
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    // One structure-of-arrays pool; all arrays have `capacity` entries
+    struct Pool {
+        BlendMode blend = BlendMode::Additive;
+        uint32_t capacity = 0;
+        uint32_t count = 0;
+        std::vector<float> x, y, vx, vy, ay;
+        std::vector<float> life;            // Seconds left
+        std::vector<float> invLifetime;     // 1 / total life
+        std::vector<ParticleEffectId> effect;
+
+        void allocate(uint32_t size);
+        void removeDead();
+    };
+
+    Pool& poolFor(BlendMode blend) { return blend == BlendMode::Additive ? m_additive : m_alpha; }
+    const Pool& poolFor(BlendMode blend) const { return blend == BlendMode::Additive ? m_additive : m_alpha; }
+    float random01();
+
+    bool m_initialized = false;
+    Pool m_alpha;
+    Pool m_additive;
+    std::vector<ParticleEffect> m_effects;
+    std::vector<TexturedQuad> m_quads;      // Render scratch
+
+    TextureHandle m_atlas = INVALID_TEXTURE;
+    TextureHandle m_defaultAtlas = INVALID_TEXTURE;
+    int m_frameWidth = 0;
+    int m_frameHeight = 0;
+    int m_atlasColumns = 1;
+
+    uint32_t m_rngState = 0x9E3779B9u;
+    ParticleStats m_stats;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_PARTICLES_H
@@ -0,0 +1,69 @@
+#include "graphics/render_state.h"
+#include "graphics/particles.h"
+#include "game/combat.h"
+#include <cmath>
+
+namespace mcgng {
+
+void RenderState::clear() {
+    frame = 0;
+    mechs.clear();
+    projectiles.clear();
+    particleAtlas = INVALID_TEXTURE;
+    alphaParticles.clear();
+    additiveParticles.clear();
+    ui = UiRenderState();
+}
+
+void RenderState::captureMech(const Mech& mech, int animationFrame) {
+    MechRenderState state;
+    state.x = mech.getX();
+    state.y = mech.getY();
+    state.heading = mech.getHeading();
+    state.frame = animationFrame;
+    state.team = mech.getTeam();
+    state.destroyed = mech.isDestroyed();
+    mechs.push_back(state);
+}
+
+void RenderState::captureProjectiles(const CombatSystem& combat) {
+    for (const Projectile& projectile : combat.getProjectiles()) {
+        if (!projectile.active) {
+            continue;
+        }
+        ProjectileRenderState state;
+        state.x = projectile.x;
+        state.y = projectile.y;
+        state.heading = std::atan2(projectile.targetY - projectile.y, projectile.targetX - projectile.x);
+        state.weapon = projectile.weapon ? projectile.weapon->type : WeaponType::None;
+        projectiles.push_back(state);
+    }
+}
+
+void RenderState::captureParticles(const ParticleSystem& particles) {
+    particleAtlas = particles.getAtlas();
+    particles.buildQuads(BlendMode::Alpha, alphaParticles);
+    particles.buildQuads(BlendMode::Additive, additiveParticles);
+
+    const ParticleStats& stats = particles.getStats();
+    ui.particlesAlive = stats.alive;
+    ui.particleCapacity = stats.capacity;
+    ui.particlesDropped = stats.lastDropped;
+}
+
+void RenderState::drawParticles() const {
+    if (particleAtlas == INVALID_TEXTURE) {
+        return;
+    }
+    auto& renderer = Renderer::instance();
+    if (!alphaParticles.empty()) {
+        renderer.drawTextureQuads(particleAtlas, alphaParticles.data(), alphaParticles.size(),
+                                  BlendMode::Alpha);
+    }
+    if (!additiveParticles.empty()) {
+        renderer.drawTextureQuads(particleAtlas, additiveParticles.data(), additiveParticles.size(),
+                                  BlendMode::Additive);
+    }
+}
+
+} // namespace mcgng
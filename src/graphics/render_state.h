@@ -0,0 +1,96 @@
+#ifndef MCGNG_RENDER_STATE_H
+#define MCGNG_RENDER_STATE_H
+
+#include "graphics/renderer.h"
+#include "game/mech.h"
+#include <cstdint>
+#include <vector>
+
+namespace mcgng {
+
+class CombatSystem;
+class ParticleSystem;
+
+/**
+ * Mech as the renderer sees it.
+ */
+struct MechRenderState {
+    float x = 0.0f;
+    float y = 0.0f;
+    float heading = 0.0f;       // Degrees (Mech::getHeading)
+    int frame = 0;              // Animation frame
+    int team = 0;
+    bool destroyed = false;
+};
+
+/**
+ * Projectile in flight.
+ */
+struct ProjectileRenderState {
+    float x = 0.0f;
+    float y = 0.0f;
+    float heading = 0.0f;       // Radians, toward the target point
+    WeaponType weapon = WeaponType::None;
+};
+
+/**
+ * HUD values computed by the simulation.
+ */
+struct UiRenderState {
+    uint32_t particlesAlive = 0;
+    uint32_t particleCapacity = 0;
+    uint32_t particlesDropped = 0;  // Spawns rejected by full pools during the last update
+    int cursorFrame = 0;
+};
+
+/**
+ * Immutable snapshot of everything the renderer draws for one simulated
+ * frame.
+ *
+ * The simulation fills a snapshot after each update and publishes it
+ * through a TripleBuffer; render callbacks draw only from the snapshot, so
+ * the next frame can be simulated while this one renders. clear() keeps
+ * the vectors' capacity, so refilling a reused snapshot does not allocate.
+ */
+struct RenderState {
+    uint64_t frame = 0;         // Engine frame that produced the snapshot
+
+    std::vector<MechRenderState> mechs;
+    std::vector<ProjectileRenderState> projectiles;
+
+    TextureHandle particleAtlas = INVALID_TEXTURE;
+    std::vector<TexturedQuad> alphaParticles;
+    std::vector<TexturedQuad> additiveParticles;
+
+    UiRenderState ui;
+
+    /**
+     * Reset for refilling, keeping allocations.
+     */
+    void clear();
+
+    /**
+     * Append a mech.
+     * @param frame Current animation frame
+     */
+    void captureMech(const Mech& mech, int frame);
+
+    /**
+     * Copy active projectiles.
+     */
+    void captureProjectiles(const CombatSystem& combat);
+
+    /**
+     * Copy particle quads and counters.
+     */
+    void captureParticles(const ParticleSystem& particles);
+
+    /**
+     * Draw the captured particles, alpha first and additive on top.
+     */
+    void drawParticles() const;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_RENDER_STATE_H
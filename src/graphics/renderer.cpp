@@ -1,4 +1,6 @@
 #include "graphics/renderer.h"
+#include "graphics/font.h"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -18,6 +20,20 @@ struct TextureData {
 static std::unordered_map<TextureHandle, TextureData> s_textures;
 static TextureHandle s_nextTextureId = 1;
 
+namespace {
+
+SDL_BlendMode toSdlBlendMode(BlendMode mode) {
+    switch (mode) {
+        case BlendMode::None:     return SDL_BLENDMODE_NONE;
+        case BlendMode::Additive: return SDL_BLENDMODE_ADD;
+        case BlendMode::Multiply: return SDL_BLENDMODE_MOD;
+        case BlendMode::Alpha:    break;
+    }
+    return SDL_BLENDMODE_BLEND;
+}
+
+} // anonymous namespace
+
 Renderer& Renderer::instance() {
     static Renderer instance;
     return instance;
@@ -97,6 +113,8 @@ void Renderer::shutdown() {
         return;
     }
 
+    destroyWorldTarget();
+
     // Destroy all textures
     for (auto& pair : s_textures) {
         if (pair.second.texture) {
@@ -128,9 +146,14 @@ void Renderer::beginFrame() {
 }
 
 void Renderer::endFrame() {
+    // Text queued outside the UI pass goes on top of everything
+    TextRenderer::instance().flush();
+
     if (m_renderer) {
         SDL_RenderPresent(static_cast<SDL_Renderer*>(m_renderer));
     }
+    m_lastDrawCalls = m_drawCalls;
+    m_drawCalls = 0;
 }
 
 void Renderer::clear(const Color& color) {
@@ -178,6 +201,7 @@ void Renderer::drawRect(const Rect& rect) {
     SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
     SDL_SetRenderDrawColor(renderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
     SDL_RenderFillRect(renderer, &sdlRect);
+    ++m_drawCalls;
 }
 
 void Renderer::drawRectOutline(const Rect& rect) {
@@ -187,6 +211,7 @@ void Renderer::drawRectOutline(const Rect& rect) {
     SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
     SDL_SetRenderDrawColor(renderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
     SDL_RenderDrawRect(renderer, &sdlRect);
+    ++m_drawCalls;
 }
 
 void Renderer::drawLine(int x1, int y1, int x2, int y2) {
@@ -195,6 +220,7 @@ void Renderer::drawLine(int x1, int y1, int x2, int y2) {
     SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
     SDL_SetRenderDrawColor(renderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
     SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+    ++m_drawCalls;
 }
 
 void Renderer::drawPoint(int x, int y) {
@@ -203,6 +229,7 @@ void Renderer::drawPoint(int x, int y) {
     SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
     SDL_SetRenderDrawColor(renderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
     SDL_RenderDrawPoint(renderer, x, y);
+    ++m_drawCalls;
 }
 
 TextureHandle Renderer::createTexture(const uint8_t* pixels, int width, int height) {
@@ -280,6 +307,7 @@ void Renderer::drawTexture(TextureHandle texture, int x, int y) {
 
     SDL_Rect dstRect = {x, y, it->second.width, it->second.height};
     SDL_RenderCopy(static_cast<SDL_Renderer*>(m_renderer), it->second.texture, nullptr, &dstRect);
+    ++m_drawCalls;
 }
 
 void Renderer::drawTexture(TextureHandle texture, const Rect* srcRect, const Rect* dstRect) {
@@ -303,6 +331,7 @@ void Renderer::drawTexture(TextureHandle texture, const Rect* srcRect, const Rec
     }
 
     SDL_RenderCopy(static_cast<SDL_Renderer*>(m_renderer), it->second.texture, src, dst);
+    ++m_drawCalls;
 }
 
 void Renderer::drawTextureEx(TextureHandle texture, const Rect* srcRect, const Rect* dstRect,
@@ -332,6 +361,79 @@ void Renderer::drawTextureEx(TextureHandle texture, const Rect* srcRect, const R
 
     SDL_RenderCopyEx(static_cast<SDL_Renderer*>(m_renderer), it->second.texture,
                      src, dst, angle, nullptr, flip);
+    ++m_drawCalls;
+}
+
+void Renderer::drawTextureQuads(TextureHandle texture, const TexturedQuad* quads, size_t count,
+                                BlendMode blend) {
+    auto it = s_textures.find(texture);
+    if (it == s_textures.end() || !it->second.texture || !m_renderer || !quads || count == 0) {
+        return;
+    }
+
+    SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
+    SDL_Texture* sdlTexture = it->second.texture;
+    if (blend != BlendMode::Alpha) {
+        SDL_SetTextureBlendMode(sdlTexture, toSdlBlendMode(blend));
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Reused between calls; only the render thread draws
+    static std::vector<SDL_Vertex> vertices;
+    static std::vector<int> indices;
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(count * 4);
+    indices.reserve(count * 6);
+
+    float invWidth = 1.0f / static_cast<float>(it->second.width);
+    float invHeight = 1.0f / static_cast<float>(it->second.height);
+
+    for (size_t i = 0; i < count; ++i) {
+        const TexturedQuad& quad = quads[i];
+        SDL_Color color = {quad.color.r, quad.color.g, quad.color.b, quad.color.a};
+        float x0 = static_cast<float>(quad.dst.x);
+        float y0 = static_cast<float>(quad.dst.y);
+        float x1 = static_cast<float>(quad.dst.x + quad.dst.width);
+        float y1 = static_cast<float>(quad.dst.y + quad.dst.height);
+        float u0 = quad.src.x * invWidth;
+        float v0 = quad.src.y * invHeight;
+        float u1 = (quad.src.x + quad.src.width) * invWidth;
+        float v1 = (quad.src.y + quad.src.height) * invHeight;
+
+        int base = static_cast<int>(vertices.size());
+        vertices.push_back({{x0, y0}, color, {u0, v0}});
+        vertices.push_back({{x1, y0}, color, {u1, v0}});
+        vertices.push_back({{x1, y1}, color, {u1, v1}});
+        vertices.push_back({{x0, y1}, color, {u0, v1}});
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+
+    SDL_RenderGeometry(renderer, sdlTexture, vertices.data(), static_cast<int>(vertices.size()),
+                       indices.data(), static_cast<int>(indices.size()));
+    ++m_drawCalls;
+#else
+    Color current = Color::white();
+    for (size_t i = 0; i < count; ++i) {
+        const TexturedQuad& quad = quads[i];
+        if (i == 0 || quad.color.r != current.r || quad.color.g != current.g ||
+            quad.color.b != current.b || quad.color.a != current.a) {
+            current = quad.color;
+            SDL_SetTextureColorMod(sdlTexture, current.r, current.g, current.b);
+            SDL_SetTextureAlphaMod(sdlTexture, current.a);
+        }
+        SDL_Rect src = {quad.src.x, quad.src.y, quad.src.width, quad.src.height};
+        SDL_Rect dst = {quad.dst.x, quad.dst.y, quad.dst.width, quad.dst.height};
+        SDL_RenderCopy(renderer, sdlTexture, &src, &dst);
+        ++m_drawCalls;
+    }
+    SDL_SetTextureColorMod(sdlTexture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(sdlTexture, 255);
+#endif
+
+    if (blend != BlendMode::Alpha) {
+        SDL_SetTextureBlendMode(sdlTexture, SDL_BLENDMODE_BLEND);
+    }
 }
 
 void Renderer::setLogicalSize(int logicalWidth, int logicalHeight) {
@@ -344,6 +446,108 @@ void Renderer::setLogicalSize(int logicalWidth, int logicalHeight) {
     }
 }
 
+void Renderer::setRenderScale(int percent) {
+    m_renderScale = std::max(25, std::min(100, percent));
+}
+
+void Renderer::setScaleFilter(ScaleFilter filter) {
+    if (filter == m_scaleFilter) {
+        return;
+    }
+    m_scaleFilter = filter;
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    if (m_worldTarget) {
+        SDL_SetTextureScaleMode(static_cast<SDL_Texture*>(m_worldTarget),
+                                filter == ScaleFilter::Linear ? SDL_ScaleModeLinear : SDL_ScaleModeNearest);
+    }
+#else
+    // The filter is fixed at creation time; rebuild on next use
+    destroyWorldTarget();
+#endif
+}
+
+bool Renderer::ensureWorldTarget() {
+    if (m_renderScale >= 100 || !m_renderer) {
+        destroyWorldTarget();
+        return false;
+    }
+
+    int width = std::max(1, m_logicalWidth * m_renderScale / 100);
+    int height = std::max(1, m_logicalHeight * m_renderScale / 100);
+    if (m_worldTarget && width == m_worldWidth && height == m_worldHeight) {
+        return true;
+    }
+    destroyWorldTarget();
+
+    SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
+    if (!SDL_RenderTargetSupported(renderer)) {
+        std::cerr << "Renderer: Render targets not supported, rendering at native resolution" << std::endl;
+        m_renderScale = 100;
+        return false;
+    }
+
+#if !SDL_VERSION_ATLEAST(2, 0, 12)
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, m_scaleFilter == ScaleFilter::Linear ? "1" : "0");
+#endif
+    SDL_Texture* target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                            SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!target) {
+        std::cerr << "Renderer: Failed to create world target: " << SDL_GetError() << std::endl;
+        m_renderScale = 100;
+        return false;
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    SDL_SetTextureScaleMode(target, m_scaleFilter == ScaleFilter::Linear ? SDL_ScaleModeLinear
+                                                                         : SDL_ScaleModeNearest);
+#endif
+
+    m_worldTarget = target;
+    m_worldWidth = width;
+    m_worldHeight = height;
+    return true;
+}
+
+void Renderer::destroyWorldTarget() {
+    if (m_worldTarget) {
+        SDL_DestroyTexture(static_cast<SDL_Texture*>(m_worldTarget));
+        m_worldTarget = nullptr;
+    }
+    m_worldWidth = 0;
+    m_worldHeight = 0;
+}
+
+void Renderer::beginWorld() {
+    if (m_inWorld || !ensureWorldTarget()) {
+        return;
+    }
+
+    SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
+    SDL_SetRenderTarget(renderer, static_cast<SDL_Texture*>(m_worldTarget));
+
+    // Keep world code in logical coordinates
+    SDL_RenderSetScale(renderer, static_cast<float>(m_worldWidth) / m_logicalWidth,
+                       static_cast<float>(m_worldHeight) / m_logicalHeight);
+    m_inWorld = true;
+}
+
+void Renderer::endWorld() {
+    if (!m_inWorld) {
+        return;
+    }
+    m_inWorld = false;
+
+    // Back to the window (SDL restores its logical size and scale)
+    SDL_Renderer* renderer = static_cast<SDL_Renderer*>(m_renderer);
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, m_drawColor.r, m_drawColor.g, m_drawColor.b, m_drawColor.a);
+
+    SDL_Rect dst = {0, 0, m_logicalWidth, m_logicalHeight};
+    SDL_RenderCopy(renderer, static_cast<SDL_Texture*>(m_worldTarget), nullptr, &dst);
+    ++m_drawCalls;
+}
+
 void Renderer::toggleFullscreen() {
     if (!m_window) return;
 
@@ -403,7 +607,9 @@ void Renderer::shutdown() {
 }
 
 void Renderer::beginFrame() {}
-void Renderer::endFrame() {}
+void Renderer::endFrame() {
+    TextRenderer::instance().flush();
+}
 void Renderer::clear(const Color&) {}
 void Renderer::setBlendMode(BlendMode mode) { m_blendMode = mode; }
 void Renderer::setDrawColor(const Color& color) { m_drawColor = color; }
@@ -429,7 +635,12 @@ void Renderer::destroyTexture(TextureHandle) {}
 void Renderer::drawTexture(TextureHandle, int, int) {}
 void Renderer::drawTexture(TextureHandle, const Rect*, const Rect*) {}
 void Renderer::drawTextureEx(TextureHandle, const Rect*, const Rect*, float, bool, bool) {}
+void Renderer::drawTextureQuads(TextureHandle, const TexturedQuad*, size_t, BlendMode) {}
 void Renderer::setLogicalSize(int w, int h) { m_logicalWidth = w; m_logicalHeight = h; }
+void Renderer::setRenderScale(int percent) { m_renderScale = std::max(25, std::min(100, percent)); }
+void Renderer::setScaleFilter(ScaleFilter filter) { m_scaleFilter = filter; }
+void Renderer::beginWorld() {}
+void Renderer::endWorld() {}
 void Renderer::toggleFullscreen() { m_fullscreen = !m_fullscreen; }
 void Renderer::setVSync(bool) {}
 
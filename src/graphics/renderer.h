@@ -17,6 +17,14 @@ enum class BlendMode {
     Multiply
 };
 
+/**
+ * Filter used when upscaling the world render target.
+ */
+enum class ScaleFilter {
+    Nearest,    // Sharp pixels
+    Linear      // Smooth
+};
+
 /**
  * Color structure (RGBA).
  */
@@ -59,6 +67,16 @@ struct Rect {
 using TextureHandle = uint32_t;
 constexpr TextureHandle INVALID_TEXTURE = 0;
 
+/**
+ * One textured quad of a batch: a source rectangle of the texture drawn
+ * into a destination rectangle, modulated by a color.
+ */
+struct TexturedQuad {
+    Rect src;
+    Rect dst;
+    Color color;
+};
+
 /**
  * Main renderer class.
  * Handles window management and 2D rendering via SDL2 + OpenGL.
@@ -173,6 +191,21 @@ public:
     void drawTextureEx(TextureHandle texture, const Rect* srcRect, const Rect* dstRect,
                        float angle, bool flipH = false, bool flipV = false);
 
+    /**
+     * Draw many quads from one texture (glyph runs, atlas sprites).
+     * Issued as a single geometry draw where SDL supports it (2.0.18+),
+     * otherwise one copy per quad.
+     * @param blend Blend mode for this batch (the texture is restored to
+     *              alpha blending afterwards)
+     */
+    void drawTextureQuads(TextureHandle texture, const TexturedQuad* quads, size_t count,
+                          BlendMode blend = BlendMode::Alpha);
+
+    /**
+     * Get the number of draw calls issued in the last completed frame.
+     */
+    uint32_t getDrawCallCount() const { return m_lastDrawCalls; }
+
     /**
      * Get window dimensions.
      */
@@ -186,6 +219,33 @@ public:
      */
     void setLogicalSize(int logicalWidth, int logicalHeight);
 
+    /**
+     * Set the world render resolution as a percentage of the logical size
+     * (clamped to 25-100). Below 100, draws between beginWorld() and
+     * endWorld() go to an offscreen target of that size, which endWorld()
+     * upscales to the full view. Anything drawn afterwards (UI, text) stays
+     * at native resolution.
+     */
+    void setRenderScale(int percent);
+    int getRenderScale() const { return m_renderScale; }
+
+    /**
+     * Set the filter used to upscale the world target.
+     */
+    void setScaleFilter(ScaleFilter filter);
+    ScaleFilter getScaleFilter() const { return m_scaleFilter; }
+
+    /**
+     * Redirect drawing to the world target (no-op at 100% scale).
+     * World code keeps drawing in logical coordinates.
+     */
+    void beginWorld();
+
+    /**
+     * Upscale the world target into the view and resume drawing there.
+     */
+    void endWorld();
+
     /**
      * Toggle fullscreen mode.
      */
@@ -218,6 +278,20 @@ private:
 
     Color m_drawColor = Color::white();
     BlendMode m_blendMode = BlendMode::Alpha;
+
+    // Scaled world rendering
+    bool ensureWorldTarget();
+    void destroyWorldTarget();
+
+    void* m_worldTarget = nullptr;  // SDL_Texture*
+    int m_worldWidth = 0;
+    int m_worldHeight = 0;
+    int m_renderScale = 100;
+    ScaleFilter m_scaleFilter = ScaleFilter::Linear;
+    bool m_inWorld = false;
+
+    uint32_t m_drawCalls = 0;       // In the current frame
+    uint32_t m_lastDrawCalls = 0;
 };
 
 } // namespace mcgng
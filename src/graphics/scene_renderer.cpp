@@ -0,0 +1,131 @@
+#include "graphics/scene_renderer.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mcgng {
+
+namespace {
+
+constexpr uint32_t DIAGONAL_BITS = 19;     // 16 fractional steps per tile
+constexpr uint32_t DIAGONAL_MAX = (1u << DIAGONAL_BITS) - 1;
+constexpr uint32_t SORTED_PASS = 1u << 31; // Everything but flat ground
+
+} // anonymous namespace
+
+uint32_t SceneRenderer::depthKey(float tileX, float tileY, SceneLayer layer, int height) {
+    float diagonal = std::max(0.0f, (tileX + tileY) * 16.0f);
+    uint32_t d = std::min(DIAGONAL_MAX, static_cast<uint32_t>(diagonal));
+    uint32_t h = static_cast<uint32_t>(std::max(0, std::min(255, height)));
+    uint32_t pass = (layer == SceneLayer::Ground && h == 0) ? 0 : SORTED_PASS;
+    return pass | (d << 12) | ((static_cast<uint32_t>(layer) & 0xF) << 8) | h;
+}
+
+void SceneRenderer::begin() {
+    m_items.clear();
+    m_order.clear();
+}
+
+void SceneRenderer::add(uint32_t depth, const SceneItem& item) {
+    if (item.texture == INVALID_TEXTURE) {
+        return;
+    }
+    m_order.push_back((static_cast<uint64_t>(depth) << 32) | m_items.size());
+    m_items.push_back(item);
+}
+
+void SceneRenderer::add(uint32_t depth, TextureHandle texture, int x, int y, int width, int height) {
+    SceneItem item;
+    item.texture = texture;
+    item.src = {0, 0, width, height};
+    item.dst = {x, y, width, height};
+    add(depth, item);
+}
+
+void SceneRenderer::radixSort(std::vector<uint64_t>& entries, std::vector<uint64_t>& scratch) {
+    const size_t count = entries.size();
+    if (count < 2) {
+        return;
+    }
+
+    // One histogram pass for all four key bytes
+    uint32_t histogram[4][256] = {};
+    for (uint64_t entry : entries) {
+        uint32_t key = static_cast<uint32_t>(entry >> 32);
+        ++histogram[0][key & 0xFF];
+        ++histogram[1][(key >> 8) & 0xFF];
+        ++histogram[2][(key >> 16) & 0xFF];
+        ++histogram[3][key >> 24];
+    }
+
+    scratch.resize(count);
+    uint64_t* source = entries.data();
+    uint64_t* target = scratch.data();
+
+    for (int pass = 0; pass < 4; ++pass) {
+        uint32_t* counts = histogram[pass];
+        uint32_t shift = 32 + pass * 8;
+        if (counts[(source[0] >> shift) & 0xFF] == count) {
+            continue;   // Every entry has the same byte here
+        }
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            uint32_t n = counts[bucket];
+            counts[bucket] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t entry = source[i];
+            target[counts[(entry >> shift) & 0xFF]++] = entry;
+        }
+        std::swap(source, target);
+    }
+
+    if (source != entries.data()) {
+        entries.swap(scratch);
+    }
+}
+
+void SceneRenderer::flush() {
+    MCGNG_PROFILE_ZONE("SceneRenderer::flush");
+    m_batchCount = 0;
+    if (m_items.empty()) {
+        return;
+    }
+
+    radixSort(m_order, m_scratch);
+
+    auto& renderer = Renderer::instance();
+    TextureHandle batchTexture = INVALID_TEXTURE;
+    m_batch.clear();
+
+    auto drawBatch = [&]() {
+        if (!m_batch.empty()) {
+            renderer.drawTextureQuads(batchTexture, m_batch.data(), m_batch.size());
+            m_batch.clear();
+            ++m_batchCount;
+        }
+    };
+
+    for (uint64_t entry : m_order) {
+        const SceneItem& item = m_items[static_cast<uint32_t>(entry)];
+
+        if (item.flipH || item.flipV) {
+            // Mirrored frames can't go through the quad path
+            drawBatch();
+            renderer.drawTextureEx(item.texture, &item.src, &item.dst, 0.0f, item.flipH, item.flipV);
+            ++m_batchCount;
+            continue;
+        }
+
+        if (item.texture != batchTexture) {
+            drawBatch();
+            batchTexture = item.texture;
+        }
+        m_batch.push_back({item.src, item.dst, item.color});
+    }
+    drawBatch();
+}
+
+} // namespace mcgng
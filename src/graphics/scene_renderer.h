@@ -0,0 +1,105 @@
+#ifndef MCGNG_SCENE_RENDERER_H
+#define MCGNG_SCENE_RENDERER_H
+
+#include "graphics/renderer.h"
+#include <cstdint>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Draw layers within one isometric depth (ground under units under effects).
+ */
+enum class SceneLayer : uint8_t {
+    Ground = 0,     // Terrain tiles
+    Object = 1,     // Buildings, trees, wrecks
+    Unit = 2,       // Mechs and vehicles
+    Effect = 3      // Sprite-based effects
+};
+
+/**
+ * One queued draw.
+ */
+struct SceneItem {
+    TextureHandle texture = INVALID_TEXTURE;
+    Rect src;
+    Rect dst;
+    Color color;
+    bool flipH = false;
+    bool flipV = false;
+};
+
+/**
+ * Per-frame isometric draw list.
+ *
+ * Terrain, objects and units are queued with a depth key from their tile
+ * position, layer and height, then flush() sorts the list back to front
+ * with a stable radix sort and draws it. Consecutive items that share a
+ * texture go out as one drawTextureQuads() batch.
+ *
+ * Render thread only.
+ */
+class SceneRenderer {
+public:
+    /**
+     * Build a depth key. Flat ground (Ground layer, height 0) never covers
+     * anything, so it is drawn first as its own pass. Everything else
+     * (raised tiles, objects, units, effects) is interleaved: items further
+     * down-screen (larger tileX + tileY) draw later; within a diagonal,
+     * lower layers draw first, then lower heights. Tile coordinates are
+     * resolved to 1/16 of a tile.
+     * @param tileX Tile X (fractional for units between tiles)
+     * @param tileY Tile Y
+     * @param height Elevation level (0-255)
+     */
+    static uint32_t depthKey(float tileX, float tileY, SceneLayer layer, int height = 0);
+
+    /**
+     * Start a new frame (clears the queue).
+     */
+    void begin();
+
+    /**
+     * Queue a draw.
+     */
+    void add(uint32_t depth, const SceneItem& item);
+
+    /**
+     * Queue a whole texture at (x, y).
+     */
+    void add(uint32_t depth, TextureHandle texture, int x, int y, int width, int height);
+
+    /**
+     * Sort and draw everything queued since begin().
+     */
+    void flush();
+
+    /**
+     * Get number of queued items.
+     */
+    size_t getItemCount() const { return m_items.size(); }
+
+    /**
+     * Get number of batches drawn by the last flush().
+     */
+    uint32_t getBatchCount() const { return m_batchCount; }
+
+    /**
+     * Stable LSD radix sort of (key << 32 | index) entries by key.
+     * Passes over bytes that are equal for every entry are skipped.
+     * @param entries Entries to sort (in place)
+     * @param scratch Scratch buffer (resized as needed)
+     */
+    static void radixSort(std::vector<uint64_t>& entries, std::vector<uint64_t>& scratch);
+
+private:
+    std::vector<SceneItem> m_items;
+    std::vector<uint64_t> m_order;      // Depth key << 32 | item index
+    std::vector<uint64_t> m_scratch;
+    std::vector<TexturedQuad> m_batch;
+    uint32_t m_batchCount = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_SCENE_RENDERER_H
@@ -1,7 +1,7 @@
 #include "graphics/sprite.h"
+#include "graphics/scene_renderer.h"
 #include <algorithm>
 #include <iostream>
-#include <set>
 
 namespace mcgng {
 
@@ -13,15 +13,17 @@ Sprite::~Sprite() {
 
 Sprite::Sprite(Sprite&& other) noexcept
     : m_frames(std::move(other.m_frames))
-    , m_animations(std::move(other.m_animations))
+    , m_library(std::move(other.m_library))
+    , m_ownedLibrary(std::move(other.m_ownedLibrary))
     , m_currentFrame(other.m_currentFrame)
-    , m_currentAnimation(std::move(other.m_currentAnimation))
+    , m_currentClip(other.m_currentClip)
     , m_animating(other.m_animating)
     , m_animTimer(other.m_animTimer)
     , m_animFrameIndex(other.m_animFrameIndex)
     , m_color(other.m_color)
     , m_flipH(other.m_flipH)
-    , m_flipV(other.m_flipV) {
+    , m_flipV(other.m_flipV)
+    , m_sharedTextures(other.m_sharedTextures) {
     other.m_currentFrame = 0;
     other.m_animating = false;
 }
@@ -30,15 +32,17 @@ Sprite& Sprite::operator=(Sprite&& other) noexcept {
     if (this != &other) {
         destroyTextures();
         m_frames = std::move(other.m_frames);
-        m_animations = std::move(other.m_animations);
+        m_library = std::move(other.m_library);
+        m_ownedLibrary = std::move(other.m_ownedLibrary);
         m_currentFrame = other.m_currentFrame;
-        m_currentAnimation = std::move(other.m_currentAnimation);
+        m_currentClip = other.m_currentClip;
         m_animating = other.m_animating;
         m_animTimer = other.m_animTimer;
         m_animFrameIndex = other.m_animFrameIndex;
         m_color = other.m_color;
         m_flipH = other.m_flipH;
         m_flipV = other.m_flipV;
+        m_sharedTextures = other.m_sharedTextures;
         other.m_currentFrame = 0;
         other.m_animating = false;
     }
@@ -48,12 +52,13 @@ Sprite& Sprite::operator=(Sprite&& other) noexcept {
 void Sprite::destroyTextures() {
     auto& renderer = Renderer::instance();
     for (auto& frame : m_frames) {
-        if (frame.texture != INVALID_TEXTURE) {
+        if (frame.texture != INVALID_TEXTURE && !m_sharedTextures) {
             renderer.destroyTexture(frame.texture);
-            frame.texture = INVALID_TEXTURE;
         }
+        frame.texture = INVALID_TEXTURE;
     }
     m_frames.clear();
+    m_sharedTextures = false;
 }
 
 bool Sprite::loadFrames(std::vector<SpriteFrame>&& frames) {
@@ -63,6 +68,18 @@ bool Sprite::loadFrames(std::vector<SpriteFrame>&& frames) {
     return !m_frames.empty();
 }
 
+bool Sprite::loadSharedFrames(std::vector<SpriteFrame>&& frames) {
+    bool loaded = loadFrames(std::move(frames));
+    m_sharedTextures = true;
+    return loaded;
+}
+
+void Sprite::setFrameTexture(int frame, TextureHandle texture) {
+    if (m_sharedTextures && frame >= 0 && frame < static_cast<int>(m_frames.size())) {
+        m_frames[frame].texture = texture;
+    }
+}
+
 bool Sprite::createSingle(const uint8_t* pixels, int width, int height) {
     destroyTextures();
 
@@ -197,26 +214,45 @@ bool Sprite::loadFromShapes(const ShapeReader& reader, const Palette& palette,
 }
 
 void Sprite::addAnimation(const Animation& anim) {
-    m_animations[anim.name] = anim;
+    // Copy-on-write: never modify a library other sprites can see
+    if (!m_ownedLibrary || m_ownedLibrary.use_count() > 2) {
+        m_ownedLibrary = m_library ? std::make_shared<AnimationLibrary>(*m_library)
+                                   : std::make_shared<AnimationLibrary>();
+        m_library = m_ownedLibrary;
+    }
+    if (m_ownedLibrary->addClip(anim) == m_currentClip) {
+        // Replaced the playing clip; its frame count may have changed
+        m_animFrameIndex = 0;
+        m_animTimer = 0.0f;
+    }
+}
+
+void Sprite::setAnimationLibrary(std::shared_ptr<const AnimationLibrary> library) {
+    m_library = std::move(library);
+    m_ownedLibrary.reset();
+    m_currentClip = INVALID_ANIM_CLIP;
+    m_animating = false;
 }
 
 void Sprite::playAnimation(const std::string& name) {
-    auto it = m_animations.find(name);
-    if (it == m_animations.end()) {
+    if (m_library) {
+        playAnimation(m_library->findClip(name));
+    }
+}
+
+void Sprite::playAnimation(AnimClipId clip) {
+    if (!m_library || !m_library->isValid(clip)) {
         return;
     }
 
-    if (m_currentAnimation != name) {
-        m_currentAnimation = name;
+    if (m_currentClip != clip) {
+        m_currentClip = clip;
         m_animFrameIndex = 0;
         m_animTimer = 0.0f;
+        m_currentFrame = m_library->getFrame(m_library->getClip(clip), 0);
     }
 
     m_animating = true;
-
-    if (!it->second.frames.empty()) {
-        m_currentFrame = it->second.frames[0];
-    }
 }
 
 void Sprite::stopAnimation() {
@@ -224,34 +260,15 @@ void Sprite::stopAnimation() {
 }
 
 void Sprite::update(float deltaTime) {
-    if (!m_animating || m_currentAnimation.empty()) {
+    if (!m_animating || !m_library || !m_library->isValid(m_currentClip)) {
         return;
     }
 
-    auto it = m_animations.find(m_currentAnimation);
-    if (it == m_animations.end() || it->second.frames.empty()) {
-        return;
+    const AnimClip& clip = m_library->getClip(m_currentClip);
+    if (!AnimationLibrary::advance(clip, deltaTime, m_animTimer, m_animFrameIndex)) {
+        m_animating = false;
     }
-
-    const auto& anim = it->second;
-    m_animTimer += deltaTime;
-
-    while (m_animTimer >= anim.frameTime) {
-        m_animTimer -= anim.frameTime;
-        ++m_animFrameIndex;
-
-        if (m_animFrameIndex >= static_cast<int>(anim.frames.size())) {
-            if (anim.loop) {
-                m_animFrameIndex = 0;
-            } else {
-                m_animFrameIndex = static_cast<int>(anim.frames.size()) - 1;
-                m_animating = false;
-                break;
-            }
-        }
-    }
-
-    m_currentFrame = anim.frames[m_animFrameIndex];
+    m_currentFrame = m_library->getFrame(clip, m_animFrameIndex);
 }
 
 void Sprite::draw(int x, int y) {
@@ -268,17 +285,9 @@ void Sprite::draw(int x, int y) {
     auto& renderer = Renderer::instance();
     renderer.setDrawColor(m_color);
 
-    int drawX = x - frame.offsetX;
-    int drawY = y - frame.offsetY;
-
-    // Debug (only log once per texture)
-    static std::set<TextureHandle> loggedTextures;
-    if (loggedTextures.find(frame.texture) == loggedTextures.end()) {
-        std::cout << "Sprite::draw: tex=" << frame.texture
-                  << " at (" << drawX << "," << drawY << ") size "
-                  << frame.width << "x" << frame.height << std::endl;
-        loggedTextures.insert(frame.texture);
-    }
+    // Mirrored frames keep their hotspot on the same art pixel
+    int drawX = x - (m_flipH ? frame.width - 1 - frame.offsetX : frame.offsetX);
+    int drawY = y - (m_flipV ? frame.height - 1 - frame.offsetY : frame.offsetY);
 
     if (m_flipH || m_flipV) {
         Rect dstRect = {drawX, drawY, frame.width, frame.height};
@@ -288,6 +297,24 @@ void Sprite::draw(int x, int y) {
     }
 }
 
+void Sprite::submit(SceneRenderer& scene, uint32_t depth, int x, int y) const {
+    if (m_currentFrame < 0 || m_currentFrame >= static_cast<int>(m_frames.size())) {
+        return;
+    }
+
+    const auto& frame = m_frames[m_currentFrame];
+    SceneItem item;
+    item.texture = frame.texture;
+    item.src = {0, 0, frame.width, frame.height};
+    item.dst = {x - (m_flipH ? frame.width - 1 - frame.offsetX : frame.offsetX),
+                y - (m_flipV ? frame.height - 1 - frame.offsetY : frame.offsetY),
+                frame.width, frame.height};
+    item.color = m_color;
+    item.flipH = m_flipH;
+    item.flipV = m_flipV;
+    scene.add(depth, item);
+}
+
 void Sprite::drawScaled(int x, int y, float scaleX, float scaleY) {
     if (m_frames.empty() || m_currentFrame < 0 ||
         m_currentFrame >= static_cast<int>(m_frames.size())) {
@@ -302,20 +329,13 @@ void Sprite::drawScaled(int x, int y, float scaleX, float scaleY) {
     auto& renderer = Renderer::instance();
     renderer.setDrawColor(m_color);
 
-    int drawX = x - static_cast<int>(frame.offsetX * scaleX);
-    int drawY = y - static_cast<int>(frame.offsetY * scaleY);
+    int offsetX = m_flipH ? frame.width - 1 - frame.offsetX : frame.offsetX;
+    int offsetY = m_flipV ? frame.height - 1 - frame.offsetY : frame.offsetY;
+    int drawX = x - static_cast<int>(offsetX * scaleX);
+    int drawY = y - static_cast<int>(offsetY * scaleY);
     int drawW = static_cast<int>(frame.width * scaleX);
     int drawH = static_cast<int>(frame.height * scaleY);
 
-    // Debug (log once per texture for scaled draws)
-    static std::set<TextureHandle> loggedScaled;
-    if (loggedScaled.find(frame.texture) == loggedScaled.end()) {
-        std::cout << "Sprite::drawScaled: tex=" << frame.texture
-                  << " at (" << drawX << "," << drawY << ") size "
-                  << drawW << "x" << drawH << std::endl;
-        loggedScaled.insert(frame.texture);
-    }
-
     Rect dstRect = {drawX, drawY, drawW, drawH};
     renderer.drawTextureEx(frame.texture, nullptr, &dstRect, 0.0f, m_flipH, m_flipV);
 }
@@ -334,8 +354,9 @@ void Sprite::drawRotated(int x, int y, float angle) {
     auto& renderer = Renderer::instance();
     renderer.setDrawColor(m_color);
 
-    int drawX = x - frame.offsetX;
-    int drawY = y - frame.offsetY;
+    // Mirrored frames keep their hotspot on the same art pixel
+    int drawX = x - (m_flipH ? frame.width - 1 - frame.offsetX : frame.offsetX);
+    int drawY = y - (m_flipV ? frame.height - 1 - frame.offsetY : frame.offsetY);
 
     Rect dstRect = {drawX, drawY, frame.width, frame.height};
     renderer.drawTextureEx(frame.texture, nullptr, &dstRect, angle, m_flipH, m_flipV);
@@ -2,16 +2,18 @@
 #define MCGNG_SPRITE_H
 
 #include "graphics/renderer.h"
+#include "graphics/animation.h"
 #include "graphics/palette.h"
 #include "assets/shape_reader.h"
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
-#include <unordered_map>
 
 namespace mcgng {
 
+class SceneRenderer;
+
 /**
  * Single frame of a sprite.
  */
@@ -23,16 +25,6 @@ struct SpriteFrame {
     int offsetY = 0;
 };
 
-/**
- * Animation sequence.
- */
-struct Animation {
-    std::string name;
-    std::vector<int> frames;    // Frame indices
-    float frameTime = 0.1f;     // Seconds per frame
-    bool loop = true;
-};
-
 /**
  * Sprite class - handles multi-frame sprites with animation.
  */
@@ -53,6 +45,18 @@ public:
      */
     bool loadFrames(std::vector<SpriteFrame>&& frames);
 
+    /**
+     * Use frames whose textures are owned elsewhere (e.g. a
+     * PaletteVariantCache); the sprite never destroys them.
+     * @return true on success
+     */
+    bool loadSharedFrames(std::vector<SpriteFrame>&& frames);
+
+    /**
+     * Point a shared frame at another texture (see loadSharedFrames).
+     */
+    void setFrameTexture(int frame, TextureHandle texture);
+
     /**
      * Create a single-frame sprite from pixel data.
      * @param pixels RGBA pixel data
@@ -93,15 +97,31 @@ public:
                         uint32_t startIndex = 0, uint32_t count = 0);
 
     /**
-     * Add an animation sequence.
+     * Add an animation sequence to this sprite's clip library.
+     * A shared library is copied first, so other sprites are unaffected.
      */
     void addAnimation(const Animation& anim);
 
     /**
-     * Play an animation by name.
+     * Use a shared clip library (e.g. one per unit type).
+     */
+    void setAnimationLibrary(std::shared_ptr<const AnimationLibrary> library);
+
+    /**
+     * Get the clip library (may be null).
+     */
+    const std::shared_ptr<const AnimationLibrary>& getAnimationLibrary() const { return m_library; }
+
+    /**
+     * Play an animation by name (looks up its clip id).
      */
     void playAnimation(const std::string& name);
 
+    /**
+     * Play an animation by clip id. Continues if already playing it.
+     */
+    void playAnimation(AnimClipId clip);
+
     /**
      * Stop animation.
      */
@@ -130,6 +150,12 @@ public:
      */
     void drawRotated(int x, int y, float angle);
 
+    /**
+     * Queue the current frame into a scene instead of drawing it.
+     * @param depth Depth key (see SceneRenderer::depthKey)
+     */
+    void submit(SceneRenderer& scene, uint32_t depth, int x, int y) const;
+
     /**
      * Get current frame index.
      */
@@ -181,17 +207,19 @@ public:
 
 private:
     std::vector<SpriteFrame> m_frames;
-    std::unordered_map<std::string, Animation> m_animations;
+    std::shared_ptr<const AnimationLibrary> m_library;
+    std::shared_ptr<AnimationLibrary> m_ownedLibrary;   // Set when addAnimation built m_library
 
     int m_currentFrame = 0;
-    std::string m_currentAnimation;
+    AnimClipId m_currentClip = INVALID_ANIM_CLIP;
     bool m_animating = false;
     float m_animTimer = 0.0f;
-    int m_animFrameIndex = 0;
+    uint32_t m_animFrameIndex = 0;
 
     Color m_color = Color::white();
     bool m_flipH = false;
     bool m_flipV = false;
+    bool m_sharedTextures = false;
 
     void destroyTextures();
 };
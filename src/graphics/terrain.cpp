@@ -1,4 +1,6 @@
 #include "graphics/terrain.h"
+#include "core/log.h"
+#include "core/profiler.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -64,13 +66,13 @@ int TerrainTileset::addTile(const uint8_t* pixels, const uint8_t* palette, int w
     for (int i = 0; i < width * height; ++i) {
         if (pixels[i] != 0) ++nonZero;
     }
-    std::cout << "TerrainTileset::addTile: " << width << "x" << height
-              << ", non-zero: " << nonZero << "/" << (width * height) << std::endl;
+    MCGNG_LOG_DEBUG(Graphics, "TerrainTileset::addTile: {}x{}, non-zero: {}/{}",
+                    width, height, nonZero, width * height);
 
     auto& renderer = Renderer::instance();
     TextureHandle texture = renderer.createTextureIndexed(pixels, palette, width, height);
 
-    std::cout << "  texture handle: " << texture << std::endl;
+    MCGNG_LOG_DEBUG(Graphics, "TerrainTileset::addTile: texture handle {}", texture);
 
     if (texture == INVALID_TEXTURE) {
         return -1;
@@ -173,24 +175,11 @@ void TerrainMap::tileToScreen(int tileX, int tileY, int cameraX, int cameraY,
     outScreenY = isoY - cameraY;
 }
 
-void TerrainMap::render(int cameraX, int cameraY, int viewWidth, int viewHeight) {
-    if (m_tiles.empty() || !m_tileset) {
-        return;
-    }
-
-    auto& renderer = Renderer::instance();
-
-    // Calculate visible tile range
-    // For isometric rendering, we need to account for the diamond shape
-    int halfTile = m_tileSize / 2;
-    int quarterTile = m_tileSize / 4;
-
+void TerrainMap::getVisibleRange(int cameraX, int cameraY, int viewWidth, int viewHeight,
+                                 int& startTileX, int& startTileY, int& endTileX, int& endTileY) const {
     // Expand view bounds to account for partially visible tiles
     int margin = 2;
 
-    // Convert camera bounds to tile coordinates
-    int startTileX, startTileY, endTileX, endTileY;
-
     // Get corners of view in world space and convert to tile coords
     // This is a simplified version - full implementation would be more accurate
     screenToTile(0, 0, cameraX, cameraY, startTileX, startTileY);
@@ -201,6 +190,19 @@ void TerrainMap::render(int cameraX, int cameraY, int viewWidth, int viewHeight)
     startTileY = std::max(0, startTileY - margin);
     endTileX = std::min(m_width - 1, endTileX + margin);
     endTileY = std::min(m_height - 1, endTileY + margin);
+}
+
+void TerrainMap::render(int cameraX, int cameraY, int viewWidth, int viewHeight) {
+    MCGNG_PROFILE_ZONE("TerrainMap::render");
+    if (m_tiles.empty() || !m_tileset) {
+        return;
+    }
+
+    auto& renderer = Renderer::instance();
+    int quarterTile = m_tileSize / 4;
+
+    int startTileX, startTileY, endTileX, endTileY;
+    getVisibleRange(cameraX, cameraY, viewWidth, viewHeight, startTileX, startTileY, endTileX, endTileY);
 
     // Render tiles in back-to-front order (painter's algorithm)
     // For isometric, we render diagonally
@@ -225,4 +227,37 @@ void TerrainMap::render(int cameraX, int cameraY, int viewWidth, int viewHeight)
     }
 }
 
+void TerrainMap::submit(SceneRenderer& scene, int cameraX, int cameraY, int viewWidth, int viewHeight) const {
+    MCGNG_PROFILE_ZONE("TerrainMap::submit");
+    if (m_tiles.empty() || !m_tileset) {
+        return;
+    }
+
+    int quarterTile = m_tileSize / 4;
+    int tileWidth = m_tileset->getTileWidth();
+    int tileHeight = m_tileset->getTileHeight();
+
+    int startTileX, startTileY, endTileX, endTileY;
+    getVisibleRange(cameraX, cameraY, viewWidth, viewHeight, startTileX, startTileY, endTileX, endTileY);
+
+    for (int row = startTileY; row <= endTileY; ++row) {
+        for (int col = startTileX; col <= endTileX; ++col) {
+            const TerrainTile* tile = getTile(col, row);
+            if (!tile) continue;
+
+            TextureHandle texture = m_tileset->getTileTexture(tile->tileIndex);
+            if (texture == INVALID_TEXTURE) continue;
+
+            int screenX, screenY;
+            tileToScreen(col, row, cameraX, cameraY, screenX, screenY);
+            screenY -= tile->height * quarterTile;
+
+            // Buildings stand up from the ground and occlude like objects
+            SceneLayer layer = tile->isBuilding() ? SceneLayer::Object : SceneLayer::Ground;
+            scene.add(SceneRenderer::depthKey(static_cast<float>(col), static_cast<float>(row), layer, tile->height),
+                      texture, screenX, screenY, tileWidth, tileHeight);
+        }
+    }
+}
+
 } // namespace mcgng
@@ -2,6 +2,7 @@
 #define MCGNG_TERRAIN_H
 
 #include "graphics/renderer.h"
+#include "graphics/scene_renderer.h"
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -121,6 +122,12 @@ public:
      */
     void render(int cameraX, int cameraY, int viewWidth, int viewHeight);
 
+    /**
+     * Queue the visible tiles into a scene instead of drawing them, so
+     * tall terrain and buildings sort against units.
+     */
+    void submit(SceneRenderer& scene, int cameraX, int cameraY, int viewWidth, int viewHeight) const;
+
     /**
      * Convert screen coordinates to tile coordinates.
      * @param screenX Screen X position
@@ -171,6 +178,9 @@ private:
     int m_height = 0;
     int m_tileSize = 45;  // Default to 45-pixel tiles
 
+    void getVisibleRange(int cameraX, int cameraY, int viewWidth, int viewHeight,
+                         int& startTileX, int& startTileY, int& endTileX, int& endTileY) const;
+
     // Isometric projection helpers
     void worldToIso(int worldX, int worldY, int& isoX, int& isoY) const;
     void isoToWorld(int isoX, int isoY, int& worldX, int& worldY) const;
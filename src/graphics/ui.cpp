@@ -1,10 +1,14 @@
 #include "graphics/ui.h"
+#include "graphics/ui_screen.h"
+#include "core/profiler.h"
 #include <algorithm>
 
 namespace mcgng {
 
 // UIElement implementation
 
+uint32_t UIElement::s_layoutVersion = 0;
+
 void UIElement::update(float deltaTime) {
     if (!m_visible) return;
 
@@ -16,6 +20,7 @@ void UIElement::update(float deltaTime) {
 void UIElement::render() {
     if (!m_visible) return;
 
+    drawSelf();
     for (auto& child : m_children) {
         child->render();
     }
@@ -38,6 +43,7 @@ void UIElement::addChild(std::shared_ptr<UIElement> child) {
     if (child) {
         child->m_parent = this;
         m_children.push_back(std::move(child));
+        markLayoutChanged();
     }
 }
 
@@ -48,6 +54,7 @@ void UIElement::removeChild(UIElement* child) {
                 return elem.get() == child;
             }),
         m_children.end());
+    markLayoutChanged();
 }
 
 void UIElement::clearChildren() {
@@ -55,6 +62,7 @@ void UIElement::clearChildren() {
         child->m_parent = nullptr;
     }
     m_children.clear();
+    markLayoutChanged();
 }
 
 bool UIElement::containsPoint(int x, int y) const {
@@ -63,9 +71,7 @@ bool UIElement::containsPoint(int x, int y) const {
 
 // UIPanel implementation
 
-void UIPanel::render() {
-    if (!m_visible) return;
-
+void UIPanel::drawSelf() {
     auto& renderer = Renderer::instance();
 
     // Draw background
@@ -86,16 +92,11 @@ void UIPanel::render() {
         Rect rect = {m_x, m_y, m_width, m_height};
         renderer.drawRectOutline(rect);
     }
-
-    // Render children
-    UIElement::render();
 }
 
 // UIButton implementation
 
-void UIButton::render() {
-    if (!m_visible) return;
-
+void UIButton::drawSelf() {
     auto& renderer = Renderer::instance();
 
     // Select texture based on state
@@ -133,29 +134,25 @@ void UIButton::render() {
         renderer.drawRectOutline(rect);
     }
 
-    // Draw text (placeholder - actual text rendering requires font system)
-    // For now, just draw a centered marker if there's text
-    if (!m_text.empty()) {
-        // TODO: Render text when font system is available
-    }
-
-    UIElement::render();
+    // Text is batched by TextRenderer and drawn when the UI pass ends
+    Color textColor = m_enabled ? m_textColor : Color{160, 160, 160, 255};
+    m_text.draw(getBounds(), 1, 1, textColor);
 }
 
 bool UIButton::handleEvent(UIEvent& event) {
     if (!m_visible || !m_enabled) return false;
 
-    bool wasHovered = m_hovered;
-    m_hovered = containsPoint(event.mouseX, event.mouseY);
-
     switch (event.type) {
         case UIEventType::MouseEnter:
+            m_hovered = true;
+            break;
+
         case UIEventType::MouseLeave:
-            // Handled by hover state check above
+            m_hovered = false;
             break;
 
         case UIEventType::MouseDown:
-            if (m_hovered && event.mouseButton == 0) {
+            if (event.mouseButton == 0 && containsPoint(event.mouseX, event.mouseY)) {
                 m_pressed = true;
                 event.handled = true;
                 return true;
@@ -165,7 +162,8 @@ bool UIButton::handleEvent(UIEvent& event) {
         case UIEventType::MouseUp:
             if (m_pressed && event.mouseButton == 0) {
                 m_pressed = false;
-                if (m_hovered && m_onClick) {
+                // Releasing outside the button cancels the click
+                if (containsPoint(event.mouseX, event.mouseY) && m_onClick) {
                     m_onClick();
                 }
                 event.handled = true;
@@ -182,20 +180,13 @@ bool UIButton::handleEvent(UIEvent& event) {
 
 // UILabel implementation
 
-void UILabel::render() {
-    if (!m_visible || m_text.empty()) return;
-
-    // TODO: Render text when font system is available
-    // For now, this is a placeholder
-
-    UIElement::render();
+void UILabel::drawSelf() {
+    m_text.draw(getBounds(), m_hAlign, m_vAlign, m_textColor);
 }
 
 // UIImage implementation
 
-void UIImage::render() {
-    if (!m_visible) return;
-
+void UIImage::drawSelf() {
     auto& renderer = Renderer::instance();
     renderer.setDrawColor(m_tint);
 
@@ -206,15 +197,11 @@ void UIImage::render() {
         Rect dstRect = {m_x, m_y, m_width, m_height};
         renderer.drawTexture(m_texture, nullptr, &dstRect);
     }
-
-    UIElement::render();
 }
 
 // UIProgressBar implementation
 
-void UIProgressBar::render() {
-    if (!m_visible) return;
-
+void UIProgressBar::drawSelf() {
     auto& renderer = Renderer::instance();
 
     // Draw background
@@ -233,8 +220,97 @@ void UIProgressBar::render() {
     // Draw border
     renderer.setDrawColor(m_borderColor);
     renderer.drawRectOutline(bgRect);
+}
+
+// UIHitIndex implementation
+
+void UIHitIndex::build(UIElement* root) {
+    m_entries.clear();
+    m_cells.clear();
+    m_area = {};
+    m_columns = 0;
+    m_rows = 0;
 
-    UIElement::render();
+    if (root) {
+        collect(root);
+    }
+    if (m_entries.empty()) {
+        return;
+    }
+
+    // Grid covers the union of all target bounds
+    int minX = m_entries[0].bounds.x;
+    int minY = m_entries[0].bounds.y;
+    int maxX = minX + m_entries[0].bounds.width;
+    int maxY = minY + m_entries[0].bounds.height;
+    for (const auto& entry : m_entries) {
+        minX = std::min(minX, entry.bounds.x);
+        minY = std::min(minY, entry.bounds.y);
+        maxX = std::max(maxX, entry.bounds.x + entry.bounds.width);
+        maxY = std::max(maxY, entry.bounds.y + entry.bounds.height);
+    }
+    m_area = {minX, minY, maxX - minX, maxY - minY};
+
+    // Grow cells for very large layouts so the grid stays bounded
+    m_cellSize = CELL_SIZE;
+    while ((m_area.width + m_cellSize - 1) / m_cellSize > MAX_CELLS ||
+           (m_area.height + m_cellSize - 1) / m_cellSize > MAX_CELLS) {
+        m_cellSize *= 2;
+    }
+    m_columns = std::max(1, (m_area.width + m_cellSize - 1) / m_cellSize);
+    m_rows = std::max(1, (m_area.height + m_cellSize - 1) / m_cellSize);
+    m_cells.resize(static_cast<size_t>(m_columns) * m_rows);
+
+    // Insert topmost first so a lookup can stop at the first hit
+    for (size_t i = m_entries.size(); i-- > 0;) {
+        const Rect& bounds = m_entries[i].bounds;
+        int x0 = (bounds.x - m_area.x) / m_cellSize;
+        int y0 = (bounds.y - m_area.y) / m_cellSize;
+        int x1 = (bounds.x + bounds.width - 1 - m_area.x) / m_cellSize;
+        int y1 = (bounds.y + bounds.height - 1 - m_area.y) / m_cellSize;
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                m_cells[static_cast<size_t>(cy) * m_columns + cx].push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+}
+
+void UIHitIndex::collect(UIElement* element) {
+    // Hidden or disabled elements hide their whole subtree from input
+    if (!element->isVisible() || !element->isEnabled()) {
+        return;
+    }
+
+    Rect bounds = element->getBounds();
+    if (element->wantsMouse() && bounds.width > 0 && bounds.height > 0) {
+        m_entries.push_back({bounds, element});
+    }
+
+    // Paint order: later children are drawn on top
+    for (const auto& child : element->getChildren()) {
+        collect(child.get());
+    }
+}
+
+UIElement* UIHitIndex::hitTest(int x, int y) const {
+    if (m_cells.empty() || !m_area.contains(x, y)) {
+        return nullptr;
+    }
+
+    int cx = (x - m_area.x) / m_cellSize;
+    int cy = (y - m_area.y) / m_cellSize;
+    for (uint32_t index : m_cells[static_cast<size_t>(cy) * m_columns + cx]) {
+        if (m_entries[index].bounds.contains(x, y)) {
+            return m_entries[index].element;
+        }
+    }
+    return nullptr;
+}
+
+bool UIHitIndex::contains(const UIElement* element) const {
+    return std::any_of(m_entries.begin(), m_entries.end(),
+                       [element](const Entry& entry) { return entry.element == element; });
 }
 
 // UIManager implementation
@@ -251,16 +327,107 @@ void UIManager::update(float deltaTime) {
 }
 
 void UIManager::render() {
-    if (m_root) {
+    MCGNG_PROFILE_ZONE("UIManager::render");
+    if (m_screen) {
+        m_screen->render();
+    } else if (m_root) {
         m_root->render();
     }
+    // All labels and buttons in one draw per font atlas
+    TextRenderer::instance().flush();
+}
+
+void UIManager::setRoot(std::shared_ptr<UIElement> root) {
+    m_root = std::move(root);
+    m_screen = nullptr;
+    m_focusedElement = nullptr;
+    m_hoveredElement = nullptr;
+    m_captureElement = nullptr;
+    m_hitIndexValid = false;
+}
+
+void UIManager::setScreen(UIScreen* screen) {
+    setRoot(screen ? screen->getRoot() : nullptr);
+    m_screen = screen;
+}
+
+const UIHitIndex& UIManager::getHitIndex() {
+    uint32_t version = UIElement::getLayoutVersion();
+    if (!m_hitIndexValid || version != m_hitIndexVersion) {
+        m_hitIndex.build(m_root.get());
+        m_hitIndexVersion = version;
+        m_hitIndexValid = true;
+
+        // Drop pointers to elements that were removed or hidden
+        if (m_hoveredElement && !m_hitIndex.contains(m_hoveredElement)) {
+            m_hoveredElement = nullptr;
+        }
+        if (m_captureElement && !m_hitIndex.contains(m_captureElement)) {
+            m_captureElement = nullptr;
+        }
+    }
+    return m_hitIndex;
 }
 
 bool UIManager::handleEvent(UIEvent& event) {
-    if (m_root) {
-        return m_root->handleEvent(event);
+    if (!m_root) {
+        return false;
+    }
+
+    switch (event.type) {
+        case UIEventType::MouseMove:
+        case UIEventType::MouseDown:
+        case UIEventType::MouseUp:
+            return handleMouseEvent(event);
+        default:
+            break;
+    }
+
+    if (m_focusedElement && m_focusedElement->handleEvent(event)) {
+        return true;
+    }
+    return m_root->handleEvent(event);
+}
+
+bool UIManager::handleMouseEvent(UIEvent& event) {
+    UIElement* target = getHitIndex().hitTest(event.mouseX, event.mouseY);
+    setHoveredElement(target, event);
+
+    if (event.type == UIEventType::MouseUp && m_captureElement) {
+        UIElement* capture = m_captureElement;
+        m_captureElement = nullptr;
+        return capture->handleEvent(event);
+    }
+
+    if (!target) {
+        return false;
+    }
+
+    bool handled = target->handleEvent(event);
+    if (handled && event.type == UIEventType::MouseDown) {
+        m_captureElement = target;
+    }
+    return handled;
+}
+
+void UIManager::setHoveredElement(UIElement* element, const UIEvent& event) {
+    if (element == m_hoveredElement) {
+        return;
+    }
+
+    UIEvent hoverEvent = event;
+    if (m_hoveredElement) {
+        hoverEvent.type = UIEventType::MouseLeave;
+        m_hoveredElement->handleEvent(hoverEvent);
+        m_hoveredElement->setHovered(false);
+    }
+    m_hoveredElement = element;
+    if (m_hoveredElement) {
+        hoverEvent.type = UIEventType::MouseEnter;
+        hoverEvent.handled = false;
+        m_hoveredElement->handleEvent(hoverEvent);
+        m_hoveredElement->setHovered(true);
     }
-    return false;
 }
 
 void UIManager::setFocusedElement(UIElement* element) {
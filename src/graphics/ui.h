@@ -3,11 +3,13 @@
 
 #include "graphics/renderer.h"
 #include "graphics/sprite.h"
+#include "graphics/font.h"
 #include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 
 namespace mcgng {
 
@@ -18,6 +20,7 @@ enum class UIEventType {
     None,
     MouseEnter,
     MouseLeave,
+    MouseMove,
     MouseDown,
     MouseUp,
     Click,
@@ -40,23 +43,52 @@ struct UIEvent {
     bool handled = false;
 };
 
+/**
+ * Widget kinds, used by UIScreen to draw like widgets together.
+ */
+enum class UIKind : uint8_t {
+    Element,
+    Panel,
+    Button,
+    Label,
+    Image,
+    ProgressBar
+};
+
+class UIScreen;
+
 /**
  * Base UI element class.
  */
 class UIElement {
 public:
+    using ChildList = std::pmr::vector<std::shared_ptr<UIElement>>;
+
     UIElement() = default;
+
+    /**
+     * Construct with child storage in a memory resource (see UIScreen).
+     */
+    explicit UIElement(std::pmr::memory_resource* resource) : m_children(resource) {}
+
     virtual ~UIElement() = default;
 
     virtual void update(float deltaTime);
+
+    /**
+     * Draw this element and its children (painter's order).
+     */
     virtual void render();
     virtual bool handleEvent(UIEvent& event);
 
+    virtual UIKind getKind() const { return UIKind::Element; }
+
     // Position and size
-    void setPosition(int x, int y) { m_x = x; m_y = y; }
-    void setSize(int width, int height) { m_width = width; m_height = height; }
+    void setPosition(int x, int y) { m_x = x; m_y = y; markLayoutChanged(); }
+    void setSize(int width, int height) { m_width = width; m_height = height; markLayoutChanged(); }
     void setBounds(int x, int y, int width, int height) {
         m_x = x; m_y = y; m_width = width; m_height = height;
+        markLayoutChanged();
     }
 
     int getX() const { return m_x; }
@@ -66,13 +98,21 @@ public:
     Rect getBounds() const { return {m_x, m_y, m_width, m_height}; }
 
     // Visibility
-    void setVisible(bool visible) { m_visible = visible; }
+    void setVisible(bool visible) {
+        if (visible != m_visible) { m_visible = visible; markLayoutChanged(); }
+    }
     bool isVisible() const { return m_visible; }
 
     // Enabled state
-    void setEnabled(bool enabled) { m_enabled = enabled; }
+    void setEnabled(bool enabled) {
+        if (enabled != m_enabled) { m_enabled = enabled; markLayoutChanged(); }
+    }
     bool isEnabled() const { return m_enabled; }
 
+    // Hover state (driven by UIManager)
+    void setHovered(bool hovered) { m_hovered = hovered; }
+    bool isHovered() const { return m_hovered; }
+
     // Focus
     void setFocused(bool focused) { m_focused = focused; }
     bool isFocused() const { return m_focused; }
@@ -81,12 +121,33 @@ public:
     void addChild(std::shared_ptr<UIElement> child);
     void removeChild(UIElement* child);
     void clearChildren();
-    const std::vector<std::shared_ptr<UIElement>>& getChildren() const { return m_children; }
+    const ChildList& getChildren() const { return m_children; }
 
     // Hit testing
     bool containsPoint(int x, int y) const;
 
+    /**
+     * Whether the element takes mouse input itself. Only these are put in
+     * UIManager's hit-test index; others (panels, labels) let clicks
+     * through to what is beneath.
+     */
+    virtual bool wantsMouse() const { return false; }
+
+    /**
+     * Layout version, bumped whenever any element's bounds, visibility,
+     * enabled state or children change.
+     */
+    static uint32_t getLayoutVersion() { return s_layoutVersion; }
+    static void markLayoutChanged() { ++s_layoutVersion; }
+
 protected:
+    friend class UIScreen;
+
+    /**
+     * Draw only this element (not its children).
+     */
+    virtual void drawSelf() {}
+
     int m_x = 0;
     int m_y = 0;
     int m_width = 0;
@@ -98,7 +159,10 @@ protected:
     bool m_hovered = false;
 
     UIElement* m_parent = nullptr;
-    std::vector<std::shared_ptr<UIElement>> m_children;
+    ChildList m_children;
+
+private:
+    static uint32_t s_layoutVersion;
 };
 
 /**
@@ -106,13 +170,18 @@ protected:
  */
 class UIPanel : public UIElement {
 public:
-    void render() override;
+    using UIElement::UIElement;
+
+    UIKind getKind() const override { return UIKind::Panel; }
 
     void setBackgroundColor(const Color& color) { m_backgroundColor = color; }
     void setBorderColor(const Color& color) { m_borderColor = color; }
     void setBorderWidth(int width) { m_borderWidth = width; }
     void setBackgroundTexture(TextureHandle texture) { m_backgroundTexture = texture; }
 
+protected:
+    void drawSelf() override;
+
 private:
     Color m_backgroundColor = Color::transparent();
     Color m_borderColor = Color::white();
@@ -127,11 +196,17 @@ class UIButton : public UIElement {
 public:
     using ClickCallback = std::function<void()>;
 
-    void render() override;
+    using UIElement::UIElement;
+
+    UIKind getKind() const override { return UIKind::Button; }
     bool handleEvent(UIEvent& event) override;
+    bool wantsMouse() const override { return true; }
 
-    void setText(const std::string& text) { m_text = text; }
-    const std::string& getText() const { return m_text; }
+    void setText(const std::string& text) { m_text.setText(text); }
+    const std::string& getText() const { return m_text.getText(); }
+
+    void setFont(const Font* font) { m_text.setFont(font); }
+    void setTextColor(const Color& color) { m_textColor = color; }
 
     void setOnClick(ClickCallback callback) { m_onClick = std::move(callback); }
 
@@ -140,8 +215,12 @@ public:
     void setPressedTexture(TextureHandle texture) { m_pressedTexture = texture; }
     void setDisabledTexture(TextureHandle texture) { m_disabledTexture = texture; }
 
+protected:
+    void drawSelf() override;
+
 private:
-    std::string m_text;
+    CachedText m_text;
+    Color m_textColor = Color::white();
     ClickCallback m_onClick;
 
     TextureHandle m_normalTexture = INVALID_TEXTURE;
@@ -157,19 +236,25 @@ private:
  */
 class UILabel : public UIElement {
 public:
-    void render() override;
+    using UIElement::UIElement;
 
-    void setText(const std::string& text) { m_text = text; }
-    const std::string& getText() const { return m_text; }
+    UIKind getKind() const override { return UIKind::Label; }
 
+    void setText(const std::string& text) { m_text.setText(text); }
+    const std::string& getText() const { return m_text.getText(); }
+
+    void setFont(const Font* font) { m_text.setFont(font); }
     void setTextColor(const Color& color) { m_textColor = color; }
     void setAlignment(int horizontal, int vertical) {
         m_hAlign = horizontal;
         m_vAlign = vertical;
     }
 
+protected:
+    void drawSelf() override;
+
 private:
-    std::string m_text;
+    CachedText m_text;
     Color m_textColor = Color::white();
     int m_hAlign = 0;  // 0=left, 1=center, 2=right
     int m_vAlign = 0;  // 0=top, 1=center, 2=bottom
@@ -180,12 +265,17 @@ private:
  */
 class UIImage : public UIElement {
 public:
-    void render() override;
+    using UIElement::UIElement;
+
+    UIKind getKind() const override { return UIKind::Image; }
 
     void setTexture(TextureHandle texture) { m_texture = texture; }
     void setSprite(std::shared_ptr<Sprite> sprite) { m_sprite = std::move(sprite); }
     void setTint(const Color& color) { m_tint = color; }
 
+protected:
+    void drawSelf() override;
+
 private:
     TextureHandle m_texture = INVALID_TEXTURE;
     std::shared_ptr<Sprite> m_sprite;
@@ -197,7 +287,9 @@ private:
  */
 class UIProgressBar : public UIElement {
 public:
-    void render() override;
+    using UIElement::UIElement;
+
+    UIKind getKind() const override { return UIKind::ProgressBar; }
 
     void setValue(float value) { m_value = std::max(0.0f, std::min(1.0f, value)); }
     float getValue() const { return m_value; }
@@ -206,6 +298,9 @@ public:
     void setFillColor(const Color& color) { m_fillColor = color; }
     void setBorderColor(const Color& color) { m_borderColor = color; }
 
+protected:
+    void drawSelf() override;
+
 private:
     float m_value = 0.0f;
     Color m_backgroundColor = Color::black();
@@ -213,8 +308,61 @@ private:
     Color m_borderColor = Color::white();
 };
 
+/**
+ * Flattened hit-test index over the UI tree.
+ *
+ * Holds every visible, enabled element that wants mouse input, in paint
+ * order, bucketed into a uniform grid over their bounds. A lookup checks
+ * only the elements overlapping the point's cell, topmost first.
+ */
+class UIHitIndex {
+public:
+    static constexpr int CELL_SIZE = 32;
+    static constexpr int MAX_CELLS = 64;    // Per axis
+
+    /**
+     * Rebuild from a tree.
+     */
+    void build(UIElement* root);
+
+    /**
+     * Get the topmost element containing a point (nullptr if none).
+     */
+    UIElement* hitTest(int x, int y) const;
+
+    /**
+     * Check if an element is in the index.
+     */
+    bool contains(const UIElement* element) const;
+
+    /**
+     * Get number of indexed elements.
+     */
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        Rect bounds;
+        UIElement* element = nullptr;
+    };
+
+    void collect(UIElement* element);
+
+    std::vector<Entry> m_entries;                 // Paint order (last = topmost)
+    std::vector<std::vector<uint32_t>> m_cells;   // Entry indices, topmost first
+    Rect m_area;
+    int m_cellSize = CELL_SIZE;
+    int m_columns = 0;
+    int m_rows = 0;
+};
+
 /**
  * UI Manager - handles UI hierarchy and input.
+ *
+ * Mouse events go straight to the element under the pointer via
+ * UIHitIndex, which is rebuilt only when the layout version changes.
+ * The element that took a MouseDown also gets the matching MouseUp.
+ * Other events go to the focused element, then down the tree.
  */
 class UIManager {
 public:
@@ -225,18 +373,40 @@ public:
 
     bool handleEvent(UIEvent& event);
 
-    void setRoot(std::shared_ptr<UIElement> root) { m_root = std::move(root); }
+    void setRoot(std::shared_ptr<UIElement> root);
     UIElement* getRoot() { return m_root.get(); }
 
+    /**
+     * Show a screen: its root becomes the UI root and it is drawn from
+     * its flattened nodes. Cleared by setRoot() or when the screen dies.
+     */
+    void setScreen(UIScreen* screen);
+    UIScreen* getScreen() { return m_screen; }
+
     void setFocusedElement(UIElement* element);
     UIElement* getFocusedElement() { return m_focusedElement; }
+    UIElement* getHoveredElement() { return m_hoveredElement; }
+
+    /**
+     * Get the hit-test index (rebuilt if the layout changed).
+     */
+    const UIHitIndex& getHitIndex();
 
 private:
     UIManager() = default;
 
+    bool handleMouseEvent(UIEvent& event);
+    void setHoveredElement(UIElement* element, const UIEvent& event);
+
     std::shared_ptr<UIElement> m_root;
+    UIScreen* m_screen = nullptr;
     UIElement* m_focusedElement = nullptr;
     UIElement* m_hoveredElement = nullptr;
+    UIElement* m_captureElement = nullptr;  // Took MouseDown, gets MouseUp
+
+    UIHitIndex m_hitIndex;
+    uint32_t m_hitIndexVersion = 0;
+    bool m_hitIndexValid = false;
 };
 
 } // namespace mcgng
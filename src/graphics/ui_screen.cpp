@@ -0,0 +1,108 @@
+#include "graphics/ui_screen.h"
+#include "core/profiler.h"
+#include <algorithm>
+
+namespace mcgng {
+
+UIScreen::UIScreen()
+    : m_arena(INITIAL_ARENA_SIZE) {
+    m_root = create<UIPanel>();
+}
+
+UIScreen::~UIScreen() {
+    // Elements live in the arena; nothing may keep them past this point
+    auto& ui = UIManager::instance();
+    if (ui.getScreen() == this) {
+        ui.setRoot(nullptr);
+    }
+    m_root.reset();
+}
+
+const std::vector<UINode>& UIScreen::getNodes() {
+    uint32_t version = UIElement::getLayoutVersion();
+    if (!m_nodesValid || version != m_nodesVersion) {
+        flatten();
+        m_nodesVersion = version;
+        m_nodesValid = true;
+    }
+    return m_nodes;
+}
+
+void UIScreen::render() {
+    MCGNG_PROFILE_ZONE("UIScreen::render");
+    getNodes();
+    for (uint32_t index : m_drawOrder) {
+        m_nodes[index].element->drawSelf();
+    }
+}
+
+void UIScreen::flatten() {
+    m_nodes.clear();
+    m_drawOrder.clear();
+    if (m_root && m_root->isVisible()) {
+        flattenNode(m_root.get(), UINode::NONE);
+        buildDrawOrder(0);
+    }
+}
+
+uint32_t UIScreen::flattenNode(UIElement* element, uint32_t parent) {
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    UINode node;
+    node.element = element;
+    node.parent = parent;
+    node.kind = element->getKind();
+    m_nodes.push_back(node);
+
+    // Hidden children drop out with their whole subtree
+    uint32_t previous = UINode::NONE;
+    for (const auto& child : element->getChildren()) {
+        if (!child->isVisible()) {
+            continue;
+        }
+        uint32_t childIndex = flattenNode(child.get(), index);
+        if (previous == UINode::NONE) {
+            m_nodes[index].firstChild = childIndex;
+        } else {
+            m_nodes[previous].nextSibling = childIndex;
+        }
+        previous = childIndex;
+    }
+
+    m_nodes[index].subtreeEnd = static_cast<uint32_t>(m_nodes.size());
+    return index;
+}
+
+void UIScreen::buildDrawOrder(uint32_t index) {
+    m_drawOrder.push_back(index);
+
+    // Leaves that do not overlap can be drawn in any order, so each run of
+    // them is grouped by kind. Overlaps and containers keep painter's order.
+    for (uint32_t child = m_nodes[index].firstChild; child != UINode::NONE;
+         child = m_nodes[child].nextSibling) {
+        if (m_nodes[child].firstChild != UINode::NONE) {
+            flushLeaves();
+            buildDrawOrder(child);
+            continue;
+        }
+
+        Rect bounds = m_nodes[child].element->getBounds();
+        for (uint32_t leaf : m_leaves) {
+            if (bounds.intersects(m_nodes[leaf].element->getBounds())) {
+                flushLeaves();
+                break;
+            }
+        }
+        m_leaves.push_back(child);
+    }
+    flushLeaves();
+}
+
+void UIScreen::flushLeaves() {
+    std::stable_sort(m_leaves.begin(), m_leaves.end(), [this](uint32_t a, uint32_t b) {
+        return m_nodes[a].kind < m_nodes[b].kind;
+    });
+    m_drawOrder.insert(m_drawOrder.end(), m_leaves.begin(), m_leaves.end());
+    m_leaves.clear();
+}
+
+} // namespace mcgng
@@ -0,0 +1,104 @@
+#ifndef MCGNG_UI_SCREEN_H
+#define MCGNG_UI_SCREEN_H
+
+#include "graphics/ui.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Flattened node of a UIScreen, in depth-first order.
+ */
+struct UINode {
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    UIElement* element = nullptr;
+    uint32_t parent = NONE;
+    uint32_t firstChild = NONE;
+    uint32_t nextSibling = NONE;
+    uint32_t subtreeEnd = 0;    // One past the last node of this subtree
+    UIKind kind = UIKind::Element;
+};
+
+/**
+ * Retained UI screen with arena-backed elements and flat rendering.
+ *
+ * Elements made with create() live in one monotonic arena together with
+ * their control blocks and child lists, so building a screen costs a few
+ * block allocations and tearing it down frees them all at once. The usual
+ * UIElement API (addChild, setBounds, setText...) works unchanged.
+ *
+ * For drawing, the visible tree is flattened into a depth-first node array
+ * with parent/sibling indices, rebuilt only when the layout version
+ * changes. The draw order is painter's (tree) order, except that a run of
+ * leaf siblings whose bounds do not overlap is drawn grouped by kind (all
+ * buttons, then all bars, ...); an overlapping leaf or a nested container
+ * ends the run. Nothing drawn on top of something else changes order, so
+ * drawing agrees with UIManager's hit testing.
+ *
+ * Elements created here must not outlive the screen. Removed elements are
+ * not reclaimed until the screen is destroyed.
+ */
+class UIScreen {
+public:
+    static constexpr size_t INITIAL_ARENA_SIZE = 16 * 1024;
+
+    UIScreen();
+    ~UIScreen();
+
+    UIScreen(const UIScreen&) = delete;
+    UIScreen& operator=(const UIScreen&) = delete;
+
+    /**
+     * Create an element in the screen's arena.
+     */
+    template<typename T>
+    std::shared_ptr<T> create() {
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&m_arena), &m_arena);
+    }
+
+    /**
+     * Get the root panel (covers the whole screen, transparent).
+     */
+    const std::shared_ptr<UIPanel>& getRoot() const { return m_root; }
+
+    /**
+     * Draw the screen from the flattened node array.
+     */
+    void render();
+
+    /**
+     * Get the flattened nodes (rebuilt if the layout changed).
+     */
+    const std::vector<UINode>& getNodes();
+
+    /**
+     * Get node indices in draw order (rebuilt with the nodes).
+     */
+    const std::vector<uint32_t>& getDrawOrder() {
+        getNodes();
+        return m_drawOrder;
+    }
+
+private:
+    void flatten();
+    uint32_t flattenNode(UIElement* element, uint32_t parent);
+    void buildDrawOrder(uint32_t index);
+    void flushLeaves();
+
+    std::pmr::monotonic_buffer_resource m_arena;
+    std::shared_ptr<UIPanel> m_root;
+
+    std::vector<UINode> m_nodes;
+    std::vector<uint32_t> m_drawOrder;      // Node indices
+    std::vector<uint32_t> m_leaves;         // Current run of non-overlapping leaves
+    uint32_t m_nodesVersion = 0;
+    bool m_nodesValid = false;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_UI_SCREEN_H
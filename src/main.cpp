@@ -7,23 +7,38 @@
  */
 
 #include "core/engine.h"
+#include "core/asset_manager.h"
 #include "core/config.h"
+#include "core/triple_buffer.h"
 #include "graphics/renderer.h"
 #include "graphics/sprite.h"
+#include "graphics/animation.h"
+#include "graphics/mech_sprite_cache.h"
+#include "graphics/font.h"
 #include "graphics/palette.h"
 #include "graphics/terrain.h"
+#include "graphics/scene_renderer.h"
+#include "graphics/particles.h"
+#include "graphics/combat_effects.h"
+#include "graphics/render_state.h"
+#include "game/combat.h"
 #include "audio/audio_system.h"
 #include "audio/music_manager.h"
 #include "assets/pak_reader.h"
 #include "assets/shape_reader.h"
 #include "assets/nested_pak_reader.h"
-#include "assets/fst_reader.h"
 #include "assets/tga_loader.h"
+#include "assets/vfs.h"
+#include "assets/baked_pack.h"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <memory>
+#include <mutex>
 
 // Debug log file
 std::ofstream g_debugLog;
@@ -51,19 +66,31 @@ void printUsage(const char* programName) {
     std::cout << "  --fullscreen       Start in fullscreen mode\n";
     std::cout << "  --width <n>        Window width\n";
     std::cout << "  --height <n>       Window height\n";
+    std::cout << "  --trace <path>     Write a profiler trace (Chrome/Perfetto JSON) on exit\n";
+    std::cout << "  --frame-stats <path> Write frame time percentiles (.csv or .json) on exit\n";
+    std::cout << "  --serial           Run update and render back to back (debugging)\n";
+    std::cout << "  --log <path>       Also write timestamped log lines to a file\n";
     std::cout << "  --help             Show this help message\n";
 }
 
 // Global sprite for testing
 std::unique_ptr<mcgng::Sprite> g_testSprite;
-std::unique_ptr<mcgng::Sprite> g_mechSprite;
+std::shared_ptr<mcgng::MechSprite> g_mechSprite;   // Registered with the AssetCache
 std::shared_ptr<mcgng::TerrainTileset> g_tileset;
 mcgng::Palette g_palette;
+std::shared_ptr<mcgng::BakedPack> g_bakedPack;   // <assets>/mcgng.pack from mcg-bake, if present
 int g_currentFrame = 0;
 float g_frameTimer = 0.0f;
+mcgng::AnimHandle g_mechAnim = mcgng::INVALID_ANIM;   // Simulation thread only
 
-// Mech sprite data
-mcgng::NestedPakReader g_mechPak;
+// Clips for the mech preview, handed from the upload (render side) to the
+// simulation, which swaps g_mechAnim over at the start of its next update
+std::mutex g_mechClipsMutex;
+std::shared_ptr<const mcgng::AnimationLibrary> g_pendingMechClips;
+mcgng::CachedText g_infoText;
+mcgng::SceneRenderer g_scene;
+mcgng::CombatEffects g_combatEffects;
+mcgng::TripleBuffer<mcgng::RenderState> g_renderStates;  // Simulation -> render snapshots
 
 // Music
 mcgng::MusicHandle g_musicTrack = mcgng::INVALID_MUSIC;
@@ -75,36 +102,74 @@ mcgng::TextureHandle g_uiBackgroundTexture = mcgng::INVALID_TEXTURE;
 // Macro for logging to both console and file
 #define LOG(msg) do { std::cout << msg << std::endl; if (g_debugLog.is_open()) g_debugLog << msg << std::endl; } while(0)
 
-bool loadGamePalette(const std::string& assetsPath) {
-    // Try to load palette from MISC.FST
-    std::vector<std::string> fstPaths = {
-        assetsPath + "\\MISC.FST",
-        assetsPath + "/MISC.FST",
-    };
+/**
+ * Mount the game data into the virtual file system.
+ * Archives and loose files share priority 0 (loose files mounted later win),
+ * a baked pack overrides them and anything under <assets>/mods overrides all.
+ */
+void mountGameAssets(const std::string& assetsPath) {
+    auto& vfs = mcgng::Vfs::instance();
+    std::error_code ec;
+
+    for (const auto& entry : std::filesystem::directory_iterator(assetsPath, ec)) {
+        std::string ext = entry.path().extension().string();
+        for (auto& c : ext) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        if (entry.is_regular_file(ec) && ext == ".FST") {
+            vfs.mountFst(entry.path().string());
+        }
+    }
+    vfs.mountDirectory(assetsPath);
+
+    std::filesystem::path packPath = std::filesystem::path(assetsPath) / "mcgng.pack";
+    if (std::filesystem::exists(packPath, ec)) {
+        auto pack = std::make_shared<mcgng::BakedPack>();
+        if (pack->open(packPath.string())) {
+            g_bakedPack = pack;
+            vfs.mountBaked(pack, 50);
+        }
+    }
 
-    mcgng::FstReader fst;
-    for (const auto& path : fstPaths) {
-        if (fst.open(path)) {
-            // Look for HB.PAL (main game palette)
-            auto palData = fst.readFile("data/palette/HB.PAL");
-
-            if (!palData.empty() && palData.size() >= 700) {
-                // MCG palettes may use 6-bit values (0-63), need to scale to 8-bit
-                bool is6bit = true;
-                for (size_t i = 0; i < std::min(palData.size(), size_t(768)); ++i) {
-                    if (palData[i] > 63) {
-                        is6bit = false;
-                        break;
-                    }
-                }
+    std::filesystem::path mods = std::filesystem::path(assetsPath) / "mods";
+    if (std::filesystem::is_directory(mods, ec)) {
+        vfs.mountDirectory(mods.string(), "", 100);
+    }
 
-                if (g_palette.load(palData.data(), palData.size(), is6bit)) {
-                    LOG("Loaded game palette from MISC.FST (HB.PAL, " +
-                        std::string(is6bit ? "6-bit" : "8-bit") + ")");
-                    return true;
-                }
+    LOG("VFS: " + std::to_string(vfs.getFileCount()) + " files from " +
+        std::to_string(vfs.getMounts().size()) + " sources");
+}
+
+bool loadGamePalette() {
+    // Baked palettes are already expanded to 8 bits
+    if (g_bakedPack) {
+        const mcgng::BakedEntry* entry = g_bakedPack->find("data/palette/hb.pal");
+        if (entry && entry->type == mcgng::BakedEntryType::Palette &&
+            g_palette.load(g_bakedPack->getData(*entry), entry->dataSize, false)) {
+            LOG("Loaded game palette from " + g_bakedPack->getPath() + " (HB.PAL, baked)");
+            return true;
+        }
+    }
+
+    // HB.PAL (main game palette) lives in MISC.FST
+    mcgng::VfsView palData = mcgng::Vfs::instance().read("data/palette/HB.PAL");
+
+    if (palData.size() >= 700) {
+        const uint8_t* bytes = palData.data();
+
+        // MCG palettes may use 6-bit values (0-63), need to scale to 8-bit
+        bool is6bit = true;
+        for (size_t i = 0; i < std::min(palData.size(), size_t(768)); ++i) {
+            if (bytes[i] > 63) {
+                is6bit = false;
+                break;
             }
-            break;
+        }
+
+        if (g_palette.load(bytes, palData.size(), is6bit)) {
+            LOG("Loaded game palette from " + mcgng::Vfs::instance().getSource("data/palette/HB.PAL") +
+                " (HB.PAL, " + std::string(is6bit ? "6-bit" : "8-bit") + ")");
+            return true;
         }
     }
 
@@ -115,23 +180,60 @@ bool loadGamePalette(const std::string& assetsPath) {
 
 bool loadTestSprites(const std::string& assetsPath) {
     // Load game palette first
-    loadGamePalette(assetsPath);
+    loadGamePalette();
 
     LOG("loadTestSprites: assetsPath = " + assetsPath);
 
+    // Pre-decoded cursor shapes from the baked pack: no PAK or RLE work
+    if (g_bakedPack) {
+        std::vector<mcgng::SpriteFrame> frames;
+        auto& renderer = mcgng::Renderer::instance();
+        std::vector<uint8_t> rgba;
+
+        for (size_t i = 0; i < 50; ++i) {
+            mcgng::BakedShape shape;
+            if (!g_bakedPack->getShape("data/sprites/cursors.pak/" + std::to_string(i) + "/0", shape)) {
+                continue;
+            }
+
+            size_t pixelCount = static_cast<size_t>(shape.width) * shape.height;
+            rgba.resize(pixelCount * 4);
+            g_palette.convertToRGBA(shape.pixels, rgba.data(), pixelCount, 0);
+
+            mcgng::TextureHandle tex = renderer.createTexture(rgba.data(), shape.width, shape.height);
+            if (tex != mcgng::INVALID_TEXTURE) {
+                mcgng::SpriteFrame frame;
+                frame.texture = tex;
+                frame.width = shape.width;
+                frame.height = shape.height;
+                frame.offsetX = shape.hotspotX;
+                frame.offsetY = shape.hotspotY;
+                frames.push_back(frame);
+            }
+        }
+
+        if (!frames.empty()) {
+            LOG("Loaded " + std::to_string(frames.size()) + " cursor frames from baked pack");
+            g_testSprite = std::make_unique<mcgng::Sprite>();
+            g_testSprite->loadFrames(std::move(frames));
+            return true;
+        }
+    }
+
     // Try to load sprite PAKs from the game's DATA/SPRITES directory
     // CURSORS.PAK has simple shape tables, mech PAKs have nested PAK structure
     std::vector<std::string> pakPaths = {
-        assetsPath + "\\DATA\\SPRITES\\CURSORS.PAK",
-        assetsPath + "/DATA/SPRITES/CURSORS.PAK",
-        assetsPath + "\\DATA\\SPRITES\\BLIP.PAK",
-        assetsPath + "/DATA/SPRITES/BLIP.PAK",
+        mcgng::Vfs::instance().resolveDiskPath("data/sprites/cursors.pak"),
+        mcgng::Vfs::instance().resolveDiskPath("data/sprites/blip.pak"),
     };
 
     mcgng::PakReader pak;
     bool pakOpened = false;
 
     for (const auto& path : pakPaths) {
+        if (path.empty()) {
+            continue;
+        }
         LOG("Trying to open: " + path);
         if (pak.open(path)) {
             LOG("Opened PAK: " + path);
@@ -210,88 +312,179 @@ bool loadTestSprites(const std::string& assetsPath) {
     return false;
 }
 
+/**
+ * Frame cache of the first mech type in a sprite PAK (decoded off the main thread).
+ * Runs on a loader thread, so it must not LOG; uploadMechSprite reports the result.
+ */
+std::shared_ptr<const mcgng::MechFrameCache> decodeMechFrames(const std::string& path) {
+    mcgng::NestedPakReader mechPak;
+    if (!mechPak.open(path)) {
+        return nullptr;
+    }
+
+    for (uint32_t m = 0; m < mechPak.getMechCount(); ++m) {
+        const mcgng::MechSpriteSet* mech = mechPak.getMech(m);
+        if (!mech) continue;
+
+        auto cache = std::make_shared<mcgng::MechFrameCache>();
+        if (cache->build(*mech)) {
+            return cache;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Create the mech preview's textures on the render thread, under the upload budget.
+ */
+void uploadMechSprite(std::shared_ptr<const mcgng::MechFrameCache> cache, const mcgng::AssetKey& key) {
+    LOG("Mech frames: " + std::to_string(cache->getDirectionCount()) + " facings (" +
+        std::to_string(cache->getStoredFacingCount()) + " stored), " +
+        std::to_string(cache->getFramesPerDirection()) + " frames each, " +
+        std::to_string(cache->getMemoryUsage() / 1024) + " KB");
+    size_t bytes = cache->getMemoryUsage() * 4;
+    mcgng::AssetManager::instance().queueUpload([cache, key]() {
+        auto sprite = std::make_unique<mcgng::MechSprite>();
+        if (sprite->load(cache, g_palette)) {
+            LOG("Loaded mech sprite: " + std::to_string(cache->getFrames().size()) + " frames");
+
+            // Charge the textures to the Sprite budget; the cache
+            // can release them once nothing draws this sprite
+            size_t textureBytes = sprite->getTextureBytes();
+            g_mechSprite = mcgng::AssetManager::instance().adoptResource(
+                key, std::move(sprite), mcgng::AssetCategory::Sprite, textureBytes);
+
+            // One looping clip over a facing's frames, advanced by the AnimationSystem
+            mcgng::Animation walk;
+            walk.name = "walk";
+            for (int frame = 0; frame < cache->getFramesPerDirection(); ++frame) {
+                walk.frames.push_back(frame);
+            }
+            auto library = std::make_shared<mcgng::AnimationLibrary>();
+            library->addClip(walk);
+            std::lock_guard<std::mutex> lock(g_mechClipsMutex);
+            g_pendingMechClips = std::move(library);
+        }
+    }, bytes);
+}
+
+/**
+ * Stream the mech preview from candidates[index], falling back to the next
+ * candidate if that archive cannot be opened or decoded.
+ */
+void streamMechSprites(std::shared_ptr<const std::vector<std::string>> candidates, size_t index) {
+    if (index >= candidates->size()) {
+        LOG("Failed to load mech sprites");
+        return;
+    }
+
+    // Decode on a loader thread; textures are created by the render
+    // thread under the upload budget, so the main loop keeps running.
+    const std::string& path = (*candidates)[index];
+    LOG("Streaming mech PAK: " + path);
+    mcgng::AssetManager::instance().requestCached<mcgng::MechFrameCache>(
+        {mcgng::AssetManager::diskKey(path), "frames"}, mcgng::AssetCategory::Image,
+        [path]() { return decodeMechFrames(path); },
+        mcgng::AssetPriority::High,
+        [candidates, index](const mcgng::AssetPtr<mcgng::MechFrameCache>& cache) {
+            if (!cache) {
+                LOG("No usable mech sprites in " + (*candidates)[index]);
+                streamMechSprites(candidates, index + 1);
+                return;
+            }
+            uploadMechSprite(cache, {mcgng::AssetManager::diskKey((*candidates)[index]), "sprite"});
+        });
+}
+
+/**
+ * Stream the mech preview from frames decoded by mcg-bake: a copy out of
+ * the mapping instead of opening and RLE-decoding the nested PAK.
+ * @return false if the pack has no mech sets for the torsos
+ */
+bool streamBakedMechSprites() {
+    static constexpr const char* TORSOS = "data/sprites/torsos.pak/mech/";
+    static constexpr uint32_t MAX_MECH_TYPES = 256;
+
+    const mcgng::BakedEntry* entry = nullptr;
+    std::string path;
+    for (uint32_t m = 0; m < MAX_MECH_TYPES && !entry; ++m) {
+        path = TORSOS + std::to_string(m);
+        entry = g_bakedPack ? g_bakedPack->find(path) : nullptr;
+        if (entry && entry->type != mcgng::BakedEntryType::MechFrames) {
+            entry = nullptr;
+        }
+    }
+    if (!entry) {
+        return false;
+    }
+
+    LOG("Streaming mech frames: " + path + " (baked)");
+    std::shared_ptr<const mcgng::BakedPack> pack = g_bakedPack;
+    mcgng::AssetManager::instance().requestCached<mcgng::MechFrameCache>(
+        {path, "frames"}, mcgng::AssetCategory::Image,
+        [pack, entry]() -> std::shared_ptr<const mcgng::MechFrameCache> {
+            auto cache = std::make_shared<mcgng::MechFrameCache>();
+            if (!cache->loadBinary(pack->getData(*entry), entry->dataSize)) {
+                return nullptr;
+            }
+            return cache;
+        },
+        mcgng::AssetPriority::High,
+        [path](const mcgng::AssetPtr<mcgng::MechFrameCache>& cache) {
+            if (!cache) {
+                LOG("Invalid baked mech frames: " + path);
+                return;
+            }
+            uploadMechSprite(cache, {path, "sprite"});
+        });
+    return true;
+}
+
 bool loadMechSprites(const std::string& assetsPath) {
-    // Try to load mech torsos
+    if (streamBakedMechSprites()) {
+        return true;
+    }
+
+    // Try to load mech torsos: through the VFS first, then the usual
+    // spellings of the extracted layout (skipping ones naming the same file)
     std::vector<std::string> mechPaths = {
+        mcgng::Vfs::instance().resolveDiskPath("data/sprites/torsos.pak"),
         assetsPath + "\\DATA\\SPRITES\\TORSOS.PAK",
         assetsPath + "/DATA/SPRITES/TORSOS.PAK",
+        assetsPath + "/data/sprites/torsos.pak",
     };
 
+    auto candidates = std::make_shared<std::vector<std::string>>();
+    std::vector<std::string> seen;
     for (const auto& path : mechPaths) {
-        LOG("Trying to open mech PAK: " + path);
-        if (g_mechPak.open(path)) {
-            LOG("Loaded mech PAK with " + std::to_string(g_mechPak.getMechCount()) + " mech types");
-
-            // Try to create sprite from any mech with valid frames
-            for (uint32_t m = 0; m < g_mechPak.getMechCount(); ++m) {
-                const mcgng::MechSpriteSet* mech = g_mechPak.getMech(m);
-                if (!mech) continue;
-
-                // Try mech format first - look for a larger frame
-                if (mech->getMechFrameCount() > 0) {
-                    // Try to find a larger frame (later frames tend to be bigger)
-                    int bestIdx = -1;
-                    int bestSize = 0;
-                    for (uint32_t f = 0; f < mech->getMechFrameCount(); ++f) {
-                        const mcgng::MechShapeReader* fr = mech->getMechFrame(f);
-                        if (fr && fr->isLoaded()) {
-                            int sz = fr->getWidth() * fr->getHeight();
-                            if (sz > bestSize) {
-                                bestSize = sz;
-                                bestIdx = static_cast<int>(f);
-                            }
-                        }
-                    }
-                    if (bestIdx >= 0) {
-                        const mcgng::MechShapeReader* frame = mech->getMechFrame(static_cast<uint32_t>(bestIdx));
-                        mcgng::ShapeData shapeData = frame->decode();
-                        if (!shapeData.pixels.empty()) {
-                            g_mechSprite = std::make_unique<mcgng::Sprite>();
-                            if (g_mechSprite->loadFromShape(shapeData, g_palette)) {
-                                LOG("Loaded mech sprite from type " + std::to_string(m) +
-                                    ": " + std::to_string(shapeData.width) +
-                                    "x" + std::to_string(shapeData.height));
-                                return true;
-                            }
-                        }
-                    }
-                }
-
-                // Fall back to standard shape format
-                if (mech->getFrameCount() > 0) {
-                    const mcgng::ShapeReader* frame = mech->getFrame(0);
-                    if (frame && frame->getShapeCount() > 0) {
-                        mcgng::ShapeData shapeData = frame->decodeShape(0);
-                        if (!shapeData.pixels.empty()) {
-                            g_mechSprite = std::make_unique<mcgng::Sprite>();
-                            if (g_mechSprite->loadFromShape(shapeData, g_palette)) {
-                                LOG("Loaded mech sprite (std) from type " + std::to_string(m) +
-                                    ": " + std::to_string(shapeData.width) +
-                                    "x" + std::to_string(shapeData.height));
-                                return true;
-                            }
-                        }
-                    }
-                }
-            }
-            break;
+        if (path.empty() || !std::filesystem::exists(path)) {
+            continue;
+        }
+        std::string key = mcgng::AssetManager::diskKey(path);
+        if (std::find(seen.begin(), seen.end(), key) == seen.end()) {
+            seen.push_back(key);
+            candidates->push_back(path);
         }
     }
 
-    LOG("Failed to load mech sprites");
-    return false;
+    if (candidates->empty()) {
+        LOG("Failed to load mech sprites");
+        return false;
+    }
+    streamMechSprites(candidates, 0);
+    return true;
 }
 
-bool loadTerrainTiles(const std::string& assetsPath) {
+bool loadTerrainTiles() {
     // Try to load terrain tiles
     std::vector<std::string> tilePaths = {
-        assetsPath + "\\DATA\\TILES\\TILES.PAK",
-        assetsPath + "/DATA/TILES/TILES.PAK",
+        mcgng::Vfs::instance().resolveDiskPath("data/tiles/tiles.pak"),
     };
 
     mcgng::PakReader pak;
     for (const auto& path : tilePaths) {
-        if (pak.open(path)) {
+        if (!path.empty() && pak.open(path)) {
             LOG("Opened tiles PAK: " + path + " with " + std::to_string(pak.getNumPackets()) + " packets");
 
             // TILES.PAK has null packets at the start, real tiles start around 4014
@@ -354,7 +547,16 @@ bool loadTerrainTiles(const std::string& assetsPath) {
     return false;
 }
 
-bool initializeAudio(const std::string& assetsPath) {
+// Apply volume settings from the published config
+void applyAudioSettings(const mcgng::GameConfig& config) {
+    auto& audio = mcgng::AudioSystem::instance();
+    audio.setMasterVolume(config.masterVolume / 100.0f);
+    audio.setSFXVolume(config.sfxVolume / 100.0f);
+    audio.setMuted(config.muteAudio);
+    mcgng::MusicManager::instance().setVolume(config.musicVolume / 100.0f);
+}
+
+bool initializeAudio() {
     // Initialize audio system
     auto& audio = mcgng::AudioSystem::instance();
     if (!audio.initialize()) {
@@ -370,20 +572,22 @@ bool initializeAudio(const std::string& assetsPath) {
         return false;
     }
     LOG("Music manager initialized");
+    applyAudioSettings(mcgng::ConfigManager::instance().snapshot());
 
     // Try to load a music track
     std::vector<std::string> musicPaths = {
-        assetsPath + "\\DATA\\SOUND\\MUSIC00.WAV",
-        assetsPath + "/DATA/SOUND/MUSIC00.WAV",
+        mcgng::Vfs::instance().resolveDiskPath("data/sound/music00.wav"),
     };
 
     for (const auto& path : musicPaths) {
+        if (path.empty()) {
+            continue;
+        }
         g_musicTrack = music.loadTrack(path);
         if (g_musicTrack != mcgng::INVALID_MUSIC) {
             LOG("Loaded music track: " + path);
             // Start playing with fade in
             music.play(g_musicTrack, 2.0f);  // 2 second fade in
-            music.setVolume(0.5f);  // 50% volume
             LOG("Music playback started");
             return true;
         }
@@ -407,6 +611,19 @@ bool loadUITextures(const std::string& assetsPath) {
 
     auto& renderer = mcgng::Renderer::instance();
 
+    // Extracted ART.FST folder (or a mod override) through the VFS first
+    mcgng::VfsView tgaData = mcgng::Vfs::instance().read("art.fst/bg_exit.tga");
+    if (tgaData) {
+        mcgng::TgaImage img = mcgng::TgaLoader::loadFromMemory(tgaData.data(), tgaData.size());
+        if (img.isValid()) {
+            g_uiButtonTexture = renderer.createTexture(img.pixels.data(), img.width, img.height);
+            if (g_uiButtonTexture != mcgng::INVALID_TEXTURE) {
+                LOG("Loaded UI texture: art.fst/bg_exit.tga (" + std::to_string(img.width) + "x" + std::to_string(img.height) + ")");
+                return true;
+            }
+        }
+    }
+
     for (const auto& path : tgaPaths) {
         mcgng::TgaImage img = mcgng::TgaLoader::loadFromFile(path);
         if (img.isValid()) {
@@ -454,6 +671,14 @@ int main(int argc, char* argv[]) {
             mcgng::ConfigManager::instance().get().windowWidth = std::stoi(argv[++i]);
         } else if (arg == "--height" && i + 1 < argc) {
             mcgng::ConfigManager::instance().get().windowHeight = std::stoi(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--frame-stats" && i + 1 < argc) {
+            options.frameStatsPath = argv[++i];
+        } else if (arg == "--log" && i + 1 < argc) {
+            options.logPath = argv[++i];
+        } else if (arg == "--serial") {
+            mcgng::ConfigManager::instance().get().serialFrames = true;
         } else {
             std::cerr << "Unknown option: " << arg << "\n";
             showHelp = true;
@@ -485,6 +710,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    mountGameAssets(options.assetsPath);
+    mcgng::FontManager::instance().loadGameFonts();
+
     // Try to load test sprites (cursors)
     bool spritesLoaded = loadTestSprites(options.assetsPath);
     if (spritesLoaded) {
@@ -496,13 +724,13 @@ int main(int argc, char* argv[]) {
     // Try to load mech sprites
     bool mechsLoaded = loadMechSprites(options.assetsPath);
     if (mechsLoaded) {
-        std::cout << "Mech sprites loaded successfully!\n";
+        std::cout << "Mech sprites streaming in the background\n";
     } else {
         std::cout << "Could not load mech sprites\n";
     }
 
     // Try to load terrain tiles
-    bool terrainLoaded = loadTerrainTiles(options.assetsPath);
+    bool terrainLoaded = loadTerrainTiles();
     if (terrainLoaded) {
         std::cout << "Terrain tiles loaded successfully!\n";
     } else {
@@ -510,7 +738,7 @@ int main(int argc, char* argv[]) {
     }
 
     // Initialize audio and start music
-    bool audioLoaded = initializeAudio(options.assetsPath);
+    bool audioLoaded = initializeAudio();
     if (audioLoaded) {
         std::cout << "Audio initialized and music playing!\n";
     } else {
@@ -525,20 +753,61 @@ int main(int argc, char* argv[]) {
         std::cout << "Could not load UI textures\n";
     }
 
+    // Weapon and explosion effects, spawned from combat events
+    if (mcgng::ParticleSystem::instance().initialize() && g_combatEffects.initialize()) {
+        mcgng::CombatSystem::instance().setEventCallback([](const mcgng::CombatEvent& event) {
+            g_combatEffects.onCombatEvent(event);
+        });
+    }
+
     // Set up callbacks
     engine.setUpdateCallback([](float deltaTime) {
-        // Update music manager (for fade effects)
-        mcgng::MusicManager::instance().update(deltaTime);
+        // Restart the preview animation on newly uploaded clips
+        std::shared_ptr<const mcgng::AnimationLibrary> mechClips;
+        {
+            std::lock_guard<std::mutex> lock(g_mechClipsMutex);
+            mechClips = std::move(g_pendingMechClips);
+        }
+        if (mechClips) {
+            auto& animations = mcgng::AnimationSystem::instance();
+            mcgng::AnimClipId walk = mechClips->findClip("walk");
+            animations.destroy(g_mechAnim);
+            g_mechAnim = animations.create(std::move(mechClips));
+            animations.play(g_mechAnim, walk);
+        }
 
-        // Animate the test sprite
+        // Animate the test sprite (the renderer applies the frame from the snapshot)
         if (g_testSprite && g_testSprite->getFrameCount() > 1) {
             g_frameTimer += deltaTime;
             if (g_frameTimer >= 0.1f) {  // 10 FPS animation
                 g_frameTimer = 0.0f;
                 g_currentFrame = (g_currentFrame + 1) % g_testSprite->getFrameCount();
-                g_testSprite->setFrame(g_currentFrame);
             }
         }
+
+        // All batched sprite animations in one pass
+        mcgng::AnimationSystem::instance().update(deltaTime);
+
+        mcgng::ParticleSystem::instance().update(deltaTime);
+    });
+
+    // Snapshot what the renderer needs; drawing never touches live game state
+    engine.setCaptureCallback([]() {
+        mcgng::RenderState& state = g_renderStates.back();
+        state.clear();
+        state.frame = mcgng::Engine::instance().getFrameCount();
+        state.ui.cursorFrame = g_currentFrame;
+
+        // Preview mech at the screen center
+        mcgng::MechRenderState preview;
+        preview.x = 400.0f;
+        preview.y = 300.0f;
+        preview.frame = mcgng::AnimationSystem::instance().getFrame(g_mechAnim);
+        state.mechs.push_back(preview);
+
+        state.captureProjectiles(mcgng::CombatSystem::instance());
+        state.captureParticles(mcgng::ParticleSystem::instance());
+        g_renderStates.publish();
     });
 
     // Debug: Check loading status
@@ -549,30 +818,44 @@ int main(int argc, char* argv[]) {
 
     engine.setRenderCallback([]() {
         auto& renderer = mcgng::Renderer::instance();
+        g_renderStates.acquire();
+        const mcgng::RenderState& state = g_renderStates.front();
+
+        // Tiles and mech facings are queued and drawn depth-sorted below
+        g_scene.begin();
 
         // Draw cursor sprites at top
         if (g_testSprite && g_testSprite->isLoaded()) {
+            g_testSprite->setFrame(state.ui.cursorFrame);
             for (int i = 0; i < 8; ++i) {
                 g_testSprite->draw(50 + i * 60, 50);
             }
         }
 
         // Draw mech sprite if loaded
-        if (g_mechSprite && g_mechSprite->isLoaded()) {
+        if (g_mechSprite && g_mechSprite->isLoaded() && !state.mechs.empty()) {
+            const mcgng::MechRenderState& preview = state.mechs.front();
+            int px = static_cast<int>(preview.x);
+            int py = static_cast<int>(preview.y);
+
             // Draw a bright marker behind the mech so we can see if position is correct
             renderer.setDrawColor({255, 0, 255, 255});  // Bright magenta
-            renderer.drawRect({355, 255, 90, 90});  // Box behind scaled mech
+            renderer.drawRect({px - 45, py - 45, 90, 90});  // Box behind scaled mech
 
             // Draw at center, scaled up
-            g_mechSprite->drawScaled(400, 300, 3.0f, 3.0f);
+            int mechFrame = preview.frame;
+            g_mechSprite->drawScaled(0, mechFrame, px, py, 3.0f, 3.0f);
 
-            // Draw markers and smaller versions
+            // Draw markers and every facing (mirrored ones come from the flipped cache entry)
             renderer.setDrawColor({0, 255, 0, 255});  // Bright green
             renderer.drawRect({95, 395, 30, 30});  // Box behind first small mech
 
-            g_mechSprite->draw(100, 400);
-            g_mechSprite->draw(200, 400);
-            g_mechSprite->draw(300, 400);
+            int facings = g_mechSprite->getCache()->getDirectionCount();
+            for (int facing = 0; facing < facings; ++facing) {
+                uint32_t depth = mcgng::SceneRenderer::depthKey(static_cast<float>(facing), 5.0f,
+                                                                mcgng::SceneLayer::Unit);
+                g_mechSprite->submit(g_scene, depth, facing, mechFrame, 100 + facing * 60, 400);
+            }
         } else {
             // Draw placeholder rectangle so we can see something
             renderer.setDrawColor({100, 100, 150, 255});
@@ -590,26 +873,63 @@ int main(int argc, char* argv[]) {
             for (int i = 0; i < maxTiles; ++i) {
                 mcgng::TextureHandle tex = g_tileset->getTileTexture(i);
                 if (tex != mcgng::INVALID_TEXTURE) {
-                    int x = tileX + (tilesDrawn % tilesPerRow) * 50;
-                    int y = tileY + (tilesDrawn / tilesPerRow) * 50;
-                    renderer.drawTexture(tex, x, y);
+                    int col = tilesDrawn % tilesPerRow;
+                    int row = tilesDrawn / tilesPerRow;
+                    uint32_t depth = mcgng::SceneRenderer::depthKey(static_cast<float>(col),
+                                                                    static_cast<float>(row),
+                                                                    mcgng::SceneLayer::Ground);
+                    g_scene.add(depth, tex, tileX + col * 50, tileY + row * 50,
+                                g_tileset->getTileWidth(), g_tileset->getTileHeight());
                     ++tilesDrawn;
                 }
             }
         }
 
+        g_scene.flush();
+
+        // Projectiles in flight
+        renderer.setDrawColor({255, 230, 120, 255});
+        for (const mcgng::ProjectileRenderState& projectile : state.projectiles) {
+            renderer.drawRect({static_cast<int>(projectile.x) - 1, static_cast<int>(projectile.y) - 1, 3, 3});
+        }
+
+        // Effects over the scene, one batch per blend mode
+        state.drawParticles();
+    });
+
+    // HUD at native resolution, over the (possibly upscaled) world
+    engine.setOverlayCallback([]() {
+        auto& renderer = mcgng::Renderer::instance();
+
         // Draw UI texture if loaded
         if (g_uiButtonTexture != mcgng::INVALID_TEXTURE) {
             renderer.drawTexture(g_uiButtonTexture, 600, 500);
         }
 
-        // Draw info panel background
+        // Draw info panel (text is batched and drawn before present)
+        const mcgng::UiRenderState& ui = g_renderStates.front().ui;
         renderer.setDrawColor({30, 30, 40, 220});
-        renderer.drawRect({10, 10, 200, 30});
+        renderer.drawRect({10, 10, 300, 30});
+        g_infoText.setText("Draw calls: " + std::to_string(renderer.getDrawCallCount()) +
+                           "  Particles: " + std::to_string(ui.particlesAlive) + "/" +
+                           std::to_string(ui.particleCapacity) +
+                           (ui.particlesDropped > 0 ? " (" + std::to_string(ui.particlesDropped) + " dropped)" : "") +
+                           "  Scale: " + std::to_string(renderer.getRenderScale()) + "%");
+        g_infoText.draw({18, 10, 284, 30}, 0, 1, mcgng::Color::white());
     });
 
     engine.setEventCallback([]() -> bool {
-        // Event processing here
+        // Audio runs on the main thread, not in the (pipelined) update
+        static uint32_t audioConfigVersion = mcgng::ConfigManager::instance().getVersion();
+        auto& config = mcgng::ConfigManager::instance();
+        if (config.getVersion() != audioConfigVersion) {
+            audioConfigVersion = config.getVersion();
+            applyAudioSettings(config.snapshot());
+        }
+
+        // Update music manager (for fade effects)
+        mcgng::MusicManager::instance().update(mcgng::Engine::instance().getDeltaTime());
+
         // Return false to quit
         return true;
     });
@@ -621,6 +941,13 @@ int main(int argc, char* argv[]) {
     mcgng::MusicManager::instance().shutdown();
     mcgng::AudioSystem::instance().shutdown();
 
+    // Fonts own textures; release them while the renderer is alive
+    g_mechSprite.reset();
+    mcgng::AnimationSystem::instance().clear();
+    mcgng::CombatSystem::instance().setEventCallback(nullptr);
+    mcgng::ParticleSystem::instance().shutdown();
+    mcgng::FontManager::instance().shutdown();
+
     // Cleanup engine
     engine.shutdown();
 
@@ -0,0 +1,325 @@
+#include "net/lockstep.h"
+#include "net/wire.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mcgng {
+
+namespace {
+
+constexpr uint16_t PACKET_MAGIC = 0x4B4C;   // "LK"
+constexpr uint8_t PACKET_VERSION = 1;
+
+constexpr uint32_t MAX_TICKS_AHEAD = 1024;  // Reject ticks this far past ours
+constexpr uint32_t CHECKSUM_HISTORY = 256;
+constexpr auto ACK_DELAY = std::chrono::milliseconds(40);   // Longer than a tick, so acks ride on input
+constexpr auto RESEND_INTERVAL = std::chrono::milliseconds(50);
+constexpr auto KEEPALIVE_INTERVAL = std::chrono::milliseconds(250);
+
+} // anonymous namespace
+
+bool LockstepSession::initialize(const LockstepConfig& config) {
+    if (config.playerCount == 0 || config.localPlayer >= config.playerCount) {
+        MCGNG_LOG_ERROR(Net, "LockstepSession: Bad player {} of {}", config.localPlayer, config.playerCount);
+        return false;
+    }
+
+    m_config = config;
+    m_inputDelay = config.inputDelay;
+    m_tick = 0;
+    m_nextInputTick = 0;
+    m_pending.clear();
+    m_localInputs.clear();
+    m_closeTimes.clear();
+    m_peers.clear();
+    m_checksums.clear();
+    m_lastChecksum = 0;
+    m_desynced = false;
+    m_desyncTick = 0;
+    m_stats = LockstepStats();
+
+    // Nobody can have orders for the first inputDelay ticks
+    while (m_nextInputTick < m_inputDelay) {
+        m_localInputs[m_nextInputTick++];
+    }
+    return true;
+}
+
+bool LockstepSession::addPeer(uint8_t player, Transport* transport) {
+    if (!transport || player >= m_config.playerCount || player == m_config.localPlayer ||
+        findPeer(player)) {
+        MCGNG_LOG_ERROR(Net, "LockstepSession: Cannot add player {}", player);
+        return false;
+    }
+
+    Peer peer;
+    peer.player = player;
+    peer.transport = transport;
+    m_peers.push_back(std::move(peer));
+    return true;
+}
+
+bool LockstepSession::issue(const Command& command) {
+    if (m_pending.size() >= MAX_COMMANDS_PER_TICK) {
+        MCGNG_LOG_WARN(Net, "LockstepSession: Too many orders for tick {}", m_nextInputTick);
+        return false;
+    }
+    m_pending.push_back(command);
+    m_pending.back().player = m_config.localPlayer;
+    return true;
+}
+
+void LockstepSession::update() {
+    MCGNG_PROFILE_ZONE("LockstepSession::update");
+    closeInputTicks();
+
+    for (Peer& peer : m_peers) {
+        receive(peer);
+    }
+
+    auto now = Clock::now();
+    for (Peer& peer : m_peers) {
+        bool unacked = peer.acked < m_nextInputTick;
+        if (peer.dirty ||
+            (peer.ackPending && now - peer.lastSend >= ACK_DELAY) ||
+            (unacked && now - peer.lastSend >= RESEND_INTERVAL) ||
+            now - peer.lastSend >= KEEPALIVE_INTERVAL) {
+            send(peer);
+        }
+    }
+}
+
+bool LockstepSession::isTickReady() const {
+    if (m_nextInputTick <= m_tick) {
+        return false;
+    }
+    for (const Peer& peer : m_peers) {
+        if (peer.received <= m_tick) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<Command>& LockstepSession::getTickCommands() {
+    m_tickCommands.clear();
+    if (!isTickReady()) {
+        return m_tickCommands;
+    }
+
+    for (uint8_t player = 0; player < m_config.playerCount; ++player) {
+        const std::vector<Command>* commands = nullptr;
+        if (player == m_config.localPlayer) {
+            commands = &m_localInputs[m_tick];
+        } else if (Peer* peer = findPeer(player)) {
+            commands = &peer->inputs[m_tick];
+        }
+        if (commands) {
+            m_tickCommands.insert(m_tickCommands.end(), commands->begin(), commands->end());
+        }
+    }
+    return m_tickCommands;
+}
+
+void LockstepSession::advance(uint32_t checksum) {
+    m_checksums[m_tick] = checksum;
+    m_lastChecksum = checksum;
+    ++m_tick;
+
+    // Checksums peers sent before we got this far
+    for (Peer& peer : m_peers) {
+        auto it = peer.checksums.find(m_tick - 1);
+        if (it != peer.checksums.end()) {
+            compareChecksum(peer.player, it->first, it->second);
+        }
+        peer.checksums.erase(peer.checksums.begin(), peer.checksums.lower_bound(m_tick));
+    }
+
+    // Drop what is no longer needed: simulated remote input, local input
+    // every peer has, checksums too old for a peer to still report
+    uint32_t acked = m_tick;
+    for (Peer& peer : m_peers) {
+        peer.inputs.erase(peer.inputs.begin(), peer.inputs.lower_bound(m_tick));
+        acked = std::min(acked, peer.acked);
+    }
+    m_localInputs.erase(m_localInputs.begin(), m_localInputs.lower_bound(acked));
+    m_closeTimes.erase(m_closeTimes.begin(), m_closeTimes.lower_bound(acked));
+    if (m_tick > CHECKSUM_HISTORY) {
+        m_checksums.erase(m_checksums.begin(), m_checksums.lower_bound(m_tick - CHECKSUM_HISTORY));
+    }
+}
+
+uint32_t LockstepSession::suggestInputDelay(float tickRate) const {
+    // Orders have to cross one way before the tick they belong to runs,
+    // plus a tick of slack for jitter and frame alignment
+    float oneWayTicks = m_stats.roundTripMs * 0.5f * tickRate / 1000.0f;
+    return static_cast<uint32_t>(std::ceil(oneWayTicks)) + 1;
+}
+
+LockstepSession::Peer* LockstepSession::findPeer(uint8_t player) {
+    for (Peer& peer : m_peers) {
+        if (peer.player == player) {
+            return &peer;
+        }
+    }
+    return nullptr;
+}
+
+void LockstepSession::closeInputTicks() {
+    uint32_t last = m_tick + m_inputDelay;
+    if (m_nextInputTick > last) {
+        return;     // Delay was lowered; hold orders until the sim catches up
+    }
+
+    auto now = Clock::now();
+    while (m_nextInputTick <= last) {
+        m_closeTimes[m_nextInputTick] = now;
+        m_localInputs[m_nextInputTick++].clear();
+    }
+
+    // Orders go in the newest tick, so a raised delay applies immediately
+    m_stats.commandsSent += m_pending.size();
+    m_localInputs[last].swap(m_pending);
+    m_pending.clear();
+
+    for (Peer& peer : m_peers) {
+        peer.dirty = true;
+    }
+}
+
+void LockstepSession::receive(Peer& peer) {
+    std::vector<uint8_t> packet;
+    while (peer.transport->receive(packet)) {
+        m_stats.bytesReceived += packet.size();
+        ++m_stats.packetsReceived;
+        if (!readPacket(peer, packet)) {
+            ++m_stats.packetsRejected;
+        }
+    }
+}
+
+bool LockstepSession::readPacket(Peer& peer, const std::vector<uint8_t>& packet) {
+    WireReader reader(packet);
+    if (reader.u16() != PACKET_MAGIC || reader.u8() != PACKET_VERSION || reader.u8() != peer.player) {
+        return false;
+    }
+    uint32_t ack = reader.u32();
+    uint32_t ticksDone = reader.u32();
+    uint32_t checksum = reader.u32();
+    uint32_t firstTick = reader.u32();
+    uint8_t tickCount = reader.u8();
+    if (!reader.ok() || ack > m_nextInputTick || firstTick + tickCount > m_tick + MAX_TICKS_AHEAD) {
+        return false;
+    }
+
+    // Decode everything before touching state, so a truncated packet is ignored whole
+    std::vector<std::vector<Command>> ticks(tickCount);
+    for (auto& commands : ticks) {
+        uint8_t count = reader.u8();
+        if (count > MAX_COMMANDS_PER_TICK) {
+            return false;
+        }
+        commands.resize(count);
+        for (Command& command : commands) {
+            if (!readCommand(reader, command)) {
+                return false;
+            }
+            command.player = peer.player;
+        }
+    }
+    if (!reader.ok()) {
+        return false;
+    }
+
+    if (ack > peer.acked) {
+        auto closed = m_closeTimes.find(ack - 1);
+        if (closed != m_closeTimes.end()) {
+            float sample = std::chrono::duration<float, std::milli>(Clock::now() - closed->second).count();
+            m_stats.roundTripMs = m_stats.roundTripMs > 0.0f
+                ? m_stats.roundTripMs * 0.875f + sample * 0.125f
+                : sample;
+        }
+        peer.acked = ack;
+    }
+
+    if (ticksDone > 0) {
+        compareChecksum(peer.player, ticksDone - 1, checksum);
+    }
+
+    uint32_t before = peer.received;
+    for (uint32_t i = 0; i < tickCount; ++i) {
+        uint32_t tick = firstTick + i;
+        if (tick >= peer.received && peer.inputs.find(tick) == peer.inputs.end()) {
+            peer.inputs[tick] = std::move(ticks[i]);
+        }
+    }
+    while (peer.inputs.find(peer.received) != peer.inputs.end()) {
+        ++peer.received;
+    }
+    if (peer.received != before) {
+        peer.ackPending = true;
+    }
+    return true;
+}
+
+void LockstepSession::send(Peer& peer) {
+    m_packet.clear();
+    WireWriter out(m_packet);
+    out.u16(PACKET_MAGIC);
+    out.u8(PACKET_VERSION);
+    out.u8(m_config.localPlayer);
+    out.u32(peer.received);
+    out.u32(m_tick);
+    out.u32(m_lastChecksum);
+    out.u32(peer.acked);
+    size_t countOffset = out.size();
+    out.u8(0);
+
+    // Every tick the peer hasn't acknowledged, as many as fit
+    uint8_t tickCount = 0;
+    for (uint32_t tick = peer.acked; tick < m_nextInputTick && tickCount < 255; ++tick) {
+        auto it = m_localInputs.find(tick);
+        if (it == m_localInputs.end() ||
+            out.size() + 1 + it->second.size() * COMMAND_WIRE_SIZE > Transport::MAX_DATAGRAM) {
+            break;
+        }
+        out.u8(static_cast<uint8_t>(it->second.size()));
+        for (const Command& command : it->second) {
+            writeCommand(out, command);
+        }
+        ++tickCount;
+    }
+    out.patch8(countOffset, tickCount);
+
+    if (peer.transport->send(m_packet.data(), m_packet.size())) {
+        m_stats.bytesSent += m_packet.size();
+        ++m_stats.packetsSent;
+    }
+    peer.dirty = false;
+    peer.ackPending = false;
+    peer.lastSend = Clock::now();
+}
+
+void LockstepSession::compareChecksum(uint8_t player, uint32_t tick, uint32_t checksum) {
+    if (tick >= m_tick) {
+        // Peer is ahead; check once we get there
+        if (Peer* peer = findPeer(player)) {
+            peer->checksums[tick] = checksum;
+        }
+        return;
+    }
+
+    auto it = m_checksums.find(tick);
+    if (it == m_checksums.end() || it->second == checksum || m_desynced) {
+        return;
+    }
+
+    m_desynced = true;
+    m_desyncTick = tick;
+    MCGNG_LOG_ERROR(Net, "LockstepSession: Desync with player {} at tick {} (local {}, remote {})",
+                    player, tick, it->second, checksum);
+}
+
+} // namespace mcgng
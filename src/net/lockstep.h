@@ -0,0 +1,173 @@
+#ifndef MCGNG_LOCKSTEP_H
+#define MCGNG_LOCKSTEP_H
+
+#include "game/command.h"
+#include "net/transport.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Lockstep session settings.
+ */
+struct LockstepConfig {
+    uint8_t localPlayer = 0;
+    uint8_t playerCount = 2;
+    uint32_t inputDelay = 3;        // Ticks between issuing a command and executing it
+};
+
+/**
+ * Session traffic counters.
+ */
+struct LockstepStats {
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t packetsSent = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t packetsRejected = 0;   // Malformed or from the wrong player
+    uint64_t commandsSent = 0;      // Distinct local commands (resends not counted)
+    float roundTripMs = 0.0f;       // Smoothed, from input acknowledgements (includes ack coalescing)
+};
+
+/**
+ * Deterministic lockstep over unreliable transports.
+ *
+ * Peers exchange only their orders: each player closes one input tick per
+ * simulated tick, inputDelay ticks ahead of the simulation, and sends every
+ * closed tick the peer hasn't acknowledged yet (so a lost datagram is
+ * covered by the next one, with no separate resend timer on the hot path).
+ * A tick may be simulated once every player's input for it has arrived;
+ * all peers then apply the same commands in the same order. Each packet
+ * also carries the sender's latest state checksum, and a mismatch flags a
+ * desync. Traffic is a small header plus 14 bytes per command, whatever
+ * the size of the world.
+ *
+ * Typical driver, at a fixed tick rate:
+ *
+ *     session.update();
+ *     while (session.isTickReady()) {
+ *         for (const Command& command : session.getTickCommands()) world.apply(command);
+ *         world.step(dt);
+ *         session.advance(world.checksum());
+ *     }
+ */
+class LockstepSession {
+public:
+    static constexpr size_t MAX_COMMANDS_PER_TICK = 64;
+
+    /**
+     * Start a session at tick 0.
+     */
+    bool initialize(const LockstepConfig& config);
+
+    /**
+     * Attach the link to a remote player. The transport must outlive the
+     * session.
+     */
+    bool addPeer(uint8_t player, Transport* transport);
+
+    /**
+     * Queue a local order for the next input tick. The player field is
+     * filled in.
+     * @return false if this tick already holds MAX_COMMANDS_PER_TICK orders
+     */
+    bool issue(const Command& command);
+
+    /**
+     * Close due input ticks, receive from and send to every peer.
+     * Call at least once per frame.
+     */
+    void update();
+
+    /**
+     * Check if every player's input for the current tick has arrived.
+     */
+    bool isTickReady() const;
+
+    /**
+     * Get the current tick's orders, by player then issue order.
+     * Only valid while isTickReady().
+     */
+    const std::vector<Command>& getTickCommands();
+
+    /**
+     * Finish the current tick.
+     * @param checksum State checksum after simulating it
+     */
+    void advance(uint32_t checksum);
+
+    /**
+     * Change the input delay. Safe at any time: raising it closes extra
+     * empty ticks, lowering it holds new orders until the simulation
+     * catches up with the ticks already sent.
+     */
+    void setInputDelay(uint32_t ticks) { m_inputDelay = ticks; }
+    uint32_t getInputDelay() const { return m_inputDelay; }
+
+    /**
+     * Input delay that hides the measured round trip at the given tick rate.
+     */
+    uint32_t suggestInputDelay(float tickRate) const;
+
+    /**
+     * Get the next tick to simulate.
+     */
+    uint32_t getTick() const { return m_tick; }
+
+    /**
+     * Check if a peer reported a different checksum for a simulated tick.
+     */
+    bool isDesynced() const { return m_desynced; }
+    uint32_t getDesyncTick() const { return m_desyncTick; }
+
+    const LockstepStats& getStats() const { return m_stats; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using TickInputs = std::map<uint32_t, std::vector<Command>>;
+
+    struct Peer {
+        uint8_t player = 0;
+        Transport* transport = nullptr;
+        uint32_t acked = 0;                 // Local ticks the peer has
+        uint32_t received = 0;              // Contiguous ticks we have from the peer
+        bool dirty = true;                  // New local input to send
+        bool ackPending = false;            // New input from it to acknowledge
+        Clock::time_point lastSend;
+        TickInputs inputs;
+        std::map<uint32_t, uint32_t> checksums;     // Reported for ticks we haven't simulated
+    };
+
+    Peer* findPeer(uint8_t player);
+    void closeInputTicks();
+    void receive(Peer& peer);
+    bool readPacket(Peer& peer, const std::vector<uint8_t>& packet);
+    void send(Peer& peer);
+    void compareChecksum(uint8_t player, uint32_t tick, uint32_t checksum);
+
+    LockstepConfig m_config;
+    uint32_t m_inputDelay = 3;
+    uint32_t m_tick = 0;
+    uint32_t m_nextInputTick = 0;           // First local input tick not yet closed
+
+    std::vector<Command> m_pending;         // Issued, not yet assigned to a tick
+    TickInputs m_localInputs;               // Closed, kept until every peer acks
+    std::map<uint32_t, Clock::time_point> m_closeTimes;
+    std::vector<Peer> m_peers;
+    std::vector<Command> m_tickCommands;
+
+    std::map<uint32_t, uint32_t> m_checksums;   // Recent local checksums
+    uint32_t m_lastChecksum = 0;
+    bool m_desynced = false;
+    uint32_t m_desyncTick = 0;
+
+    LockstepStats m_stats;
+    std::vector<uint8_t> m_packet;          // Scratch
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_LOCKSTEP_H
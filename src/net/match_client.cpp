@@ -0,0 +1,75 @@
+#include "net/match_client.h"
+#include "net/wire.h"
+#include "core/log.h"
+
+namespace mcgng {
+
+namespace {
+
+constexpr size_t MAX_COMMANDS_PER_MESSAGE = 64;
+
+} // anonymous namespace
+
+bool MatchClient::connect(const std::string& host, uint16_t port) {
+    if (!UdpSocket::resolve(host, port, m_server)) {
+        MCGNG_LOG_ERROR(Net, "MatchClient: Cannot resolve {}", host);
+        return false;
+    }
+    // Listen on the interface the server is reachable through
+    return m_socket.open(0, m_server.isLoopback());
+}
+
+void MatchClient::close() {
+    m_socket.close();
+}
+
+bool MatchClient::subscribe(uint16_t match) {
+    if (match != m_view.match) {
+        m_view = MatchView();
+        m_view.match = match;
+    }
+    return sendHeaderOnly(ServerMessage::Subscribe, match);
+}
+
+bool MatchClient::unsubscribe(uint16_t match) {
+    return sendHeaderOnly(ServerMessage::Unsubscribe, match);
+}
+
+bool MatchClient::sendCommands(uint16_t match, uint8_t player, const std::vector<Command>& commands) {
+    if (commands.size() > MAX_COMMANDS_PER_MESSAGE) {
+        return false;
+    }
+    m_buffer.clear();
+    WireWriter out(m_buffer);
+    writeServerHeader(out, ServerMessage::Commands, match);
+    out.u8(player);
+    out.u8(static_cast<uint8_t>(commands.size()));
+    for (const Command& command : commands) {
+        writeCommand(out, command);
+    }
+    return m_socket.sendTo(m_server, m_buffer.data(), m_buffer.size());
+}
+
+size_t MatchClient::poll() {
+    size_t applied = 0;
+    SocketAddress sender;
+    while (m_socket.receiveFrom(sender, m_buffer)) {
+        if (sender != m_server) {
+            continue;
+        }
+        m_bytesReceived += m_buffer.size();
+        if (m_view.apply(m_buffer)) {
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+bool MatchClient::sendHeaderOnly(ServerMessage type, uint16_t match) {
+    m_buffer.clear();
+    WireWriter out(m_buffer);
+    writeServerHeader(out, type, match);
+    return m_socket.sendTo(m_server, m_buffer.data(), m_buffer.size());
+}
+
+} // namespace mcgng
@@ -0,0 +1,59 @@
+#ifndef MCGNG_MATCH_CLIENT_H
+#define MCGNG_MATCH_CLIENT_H
+
+#include "game/command.h"
+#include "net/server_protocol.h"
+#include "net/transport.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Observer/player side of the dedicated server protocol.
+ *
+ * Subscribes to one match, rebuilds it from snapshots into a MatchView and
+ * can send orders for one player. The server drops observers that stop
+ * subscribing, so call subscribe() every few seconds as a keepalive.
+ */
+class MatchClient {
+public:
+    /**
+     * Open a socket on an ephemeral local port.
+     */
+    bool connect(const std::string& host, uint16_t port);
+
+    void close();
+
+    bool subscribe(uint16_t match);
+    bool unsubscribe(uint16_t match);
+
+    /**
+     * Send orders for the given player; at most 64 per call.
+     */
+    bool sendCommands(uint16_t match, uint8_t player, const std::vector<Command>& commands);
+
+    /**
+     * Receive and apply pending snapshots.
+     * @return Number of datagrams applied
+     */
+    size_t poll();
+
+    const MatchView& getView() const { return m_view; }
+    uint64_t getBytesReceived() const { return m_bytesReceived; }
+    uint16_t getLocalPort() const { return m_socket.getLocalPort(); }
+
+private:
+    bool sendHeaderOnly(ServerMessage type, uint16_t match);
+
+    UdpSocket m_socket;
+    SocketAddress m_server;
+    MatchView m_view;
+    std::vector<uint8_t> m_buffer;
+    uint64_t m_bytesReceived = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_MATCH_CLIENT_H
@@ -0,0 +1,328 @@
+#include "net/match_server.h"
+#include "core/jobs.h"
+#include "core/log.h"
+#include "core/profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace mcgng {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t BOT_PERIOD = 15;                 // Ticks between bot decisions
+constexpr size_t MAX_COMMANDS_PER_MESSAGE = 64;
+
+} // anonymous namespace
+
+// Match
+
+Match::Match(uint16_t id, uint32_t seed) : m_id(id), m_world(seed) {
+}
+
+void Match::addBot(int team, uint32_t seed) {
+    m_bots.emplace_back(team, seed);
+}
+
+void Match::tick(float deltaTime) {
+    auto start = Clock::now();
+
+    if (!m_bots.empty() && m_world.getTick() % BOT_PERIOD == 0) {
+        m_botOrders.clear();
+        for (SkirmishBot& bot : m_bots) {
+            bot.think(m_world, m_botOrders);
+        }
+        m_queue.insert(m_queue.end(), m_botOrders.begin(), m_botOrders.end());
+    }
+
+    for (const Command& command : m_queue) {
+        if (m_world.apply(command)) {
+            ++m_commands;
+        }
+    }
+    m_queue.clear();
+
+    m_world.step(deltaTime);
+
+    if (!m_finished && m_world.getWinner() >= 0) {
+        m_finished = true;
+        MCGNG_LOG_INFO(Net, "MatchServer: Match {} won by team {} at tick {}",
+                       m_id, m_world.getWinner(), m_world.getTick());
+    }
+
+    ++m_intervalTicks;
+    m_intervalMicros += std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void Match::buildSnapshot(bool keyframe) {
+    const auto& mechs = m_world.getMechs();
+    m_lastSent.resize(mechs.size());
+
+    m_snapshot.begin(m_id, m_world.getTick(), m_world.checksum(), keyframe);
+    for (uint16_t unit = 0; unit < mechs.size(); ++unit) {
+        UnitSnapshot state = UnitSnapshot::capture(unit, *mechs[unit]);
+        if (keyframe || state != m_lastSent[unit]) {
+            m_snapshot.addUnit(state);
+            m_lastSent[unit] = state;
+        }
+    }
+    for (const Projectile& projectile : m_world.getCombat().getProjectiles()) {
+        if (projectile.active) {
+            m_snapshot.addProjectile(ProjectileSnapshot::capture(projectile));
+        }
+    }
+    m_snapshot.finish();
+}
+
+size_t Match::getMemoryUsage() const {
+    size_t bytes = sizeof(Match);
+
+    const auto& mechs = m_world.getMechs();
+    bytes += mechs.capacity() * sizeof(mechs[0]);
+    for (const auto& mech : mechs) {
+        // Object, shared_ptr control block, weapon mounts
+        bytes += sizeof(Mech) + 2 * sizeof(void*) + mech->getWeapons().capacity() * sizeof(MountedWeapon);
+    }
+    bytes += m_world.getCombat().getProjectiles().capacity() * sizeof(Projectile);
+
+    bytes += m_bots.capacity() * sizeof(SkirmishBot);
+    bytes += (m_queue.capacity() + m_botOrders.capacity()) * sizeof(Command);
+    bytes += m_observers.capacity() * sizeof(Observer);
+    bytes += m_lastSent.capacity() * sizeof(UnitSnapshot);
+    bytes += m_snapshot.getCapacity();
+    return bytes;
+}
+
+MatchStats Match::takeStats(float seconds) {
+    MatchStats stats;
+    stats.id = m_id;
+    stats.tick = m_world.getTick();
+    stats.ticksPerSecond = seconds > 0.0f ? m_intervalTicks / seconds : 0.0f;
+    stats.stepMicros = m_intervalTicks > 0 ? static_cast<float>(m_intervalMicros / m_intervalTicks) : 0.0f;
+    stats.memoryBytes = getMemoryUsage();
+    stats.observers = m_observers.size();
+    stats.commands = m_commands;
+    stats.snapshotBytes = m_snapshotBytes;
+    stats.winner = m_world.getWinner();
+
+    m_intervalTicks = 0;
+    m_intervalMicros = 0.0;
+    m_commands = 0;
+    m_snapshotBytes = 0;
+    return stats;
+}
+
+// MatchServer
+
+bool MatchServer::initialize(const ServerConfig& config) {
+    m_config = config;
+    m_config.tickRate = std::max(m_config.tickRate, 1.0f);
+    m_config.snapshotInterval = std::max(m_config.snapshotInterval, 1u);
+    m_config.keyframeInterval = std::max(m_config.keyframeInterval, 1u);
+
+    if (!m_socket.open(m_config.port, m_config.localOnly)) {
+        MCGNG_LOG_ERROR(Net, "MatchServer: Cannot listen on port {}", m_config.port);
+        return false;
+    }
+
+    m_accumulator = 0.0f;
+    m_tickCount = 0;
+    m_lastStats = Clock::now();
+    return true;
+}
+
+void MatchServer::shutdown() {
+    m_socket.close();
+    m_matches.clear();
+}
+
+Match* MatchServer::createMatch(uint32_t seed) {
+    if (m_matches.size() > UINT16_MAX) {
+        return nullptr;
+    }
+    uint16_t id = static_cast<uint16_t>(m_matches.size());
+    m_matches.push_back(std::make_unique<Match>(id, seed));
+    return m_matches.back().get();
+}
+
+Match* MatchServer::getMatch(uint16_t id) {
+    return id < m_matches.size() ? m_matches[id].get() : nullptr;
+}
+
+void MatchServer::update(float deltaTime) {
+    const float tickTime = 1.0f / m_config.tickRate;
+
+    // Drop time we cannot catch up on rather than spiral
+    m_accumulator = std::min(m_accumulator + deltaTime, tickTime * 4.0f);
+    while (m_accumulator >= tickTime) {
+        m_accumulator -= tickTime;
+        tick();
+    }
+}
+
+void MatchServer::tick() {
+    MCGNG_PROFILE_ZONE("MatchServer::tick");
+    receive();
+
+    const float deltaTime = 1.0f / m_config.tickRate;
+    const bool snapshot = m_tickCount % m_config.snapshotInterval == 0;
+    const bool keyframe = (m_tickCount / m_config.snapshotInterval) % m_config.keyframeInterval == 0;
+
+    JobSystem::instance().parallelFor(0, m_matches.size(), 0, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Match& match = *m_matches[i];
+            match.tick(deltaTime);
+            if (snapshot && !match.m_observers.empty()) {
+                match.buildSnapshot(keyframe || match.m_forceKeyframe);
+            }
+        }
+    });
+
+    if (snapshot) {
+        publish();
+    }
+    ++m_tickCount;
+}
+
+std::vector<MatchStats> MatchServer::takeStats() {
+    auto now = Clock::now();
+    float seconds = std::chrono::duration<float>(now - m_lastStats).count();
+    m_lastStats = now;
+
+    std::vector<MatchStats> stats;
+    stats.reserve(m_matches.size());
+    for (auto& match : m_matches) {
+        stats.push_back(match->takeStats(seconds));
+    }
+    return stats;
+}
+
+void MatchServer::report() {
+    std::vector<MatchStats> stats = takeStats();
+
+    float totalTicks = 0.0f;
+    double busyMicros = 0.0;
+    size_t totalMemory = 0;
+    std::cout << "MatchServer: " << stats.size() << " matches, tick " << m_tickCount
+              << ", " << m_rejected << " rejected messages\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const MatchStats& match : stats) {
+        std::cout << "  Match " << std::setw(4) << match.id
+                  << "  tick " << std::setw(7) << match.tick
+                  << "  " << std::setw(6) << match.ticksPerSecond << " ticks/s"
+                  << "  " << std::setw(7) << match.stepMicros << " us/tick"
+                  << "  " << std::setw(6) << match.memoryBytes / 1024.0f << " KB"
+                  << "  " << match.observers << " observers"
+                  << "  " << match.commands << " orders"
+                  << "  " << match.snapshotBytes << " snapshot bytes";
+        if (match.winner >= 0) {
+            std::cout << "  won by team " << match.winner;
+        }
+        std::cout << "\n";
+        totalTicks += match.ticksPerSecond;
+        busyMicros += static_cast<double>(match.stepMicros) * match.ticksPerSecond;
+        totalMemory += match.memoryBytes;
+    }
+    std::cout << "  Total " << totalTicks << " ticks/s, " << busyMicros / 1000.0
+              << " ms of simulation per second, " << totalMemory / 1024.0f << " KB\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+    m_rejected = 0;
+}
+
+void MatchServer::receive() {
+    SocketAddress sender;
+    while (m_socket.receiveFrom(sender, m_receiveBuffer)) {
+        handleMessage(sender, m_receiveBuffer);
+    }
+}
+
+void MatchServer::handleMessage(const SocketAddress& sender, const std::vector<uint8_t>& packet) {
+    WireReader in(packet);
+    ServerMessage type;
+    uint16_t id;
+    Match* match = nullptr;
+    if (!readServerHeader(in, type, id) || !(match = getMatch(id))) {
+        ++m_rejected;
+        return;
+    }
+
+    auto& observers = match->m_observers;
+    auto observer = std::find_if(observers.begin(), observers.end(),
+                                 [&](const Match::Observer& o) { return o.address == sender; });
+
+    switch (type) {
+        case ServerMessage::Subscribe:
+            if (observer != observers.end()) {
+                observer->lastSeen = Clock::now();
+            } else {
+                observers.push_back({sender, Clock::now()});
+                match->m_forceKeyframe = true;
+                MCGNG_LOG_INFO(Net, "MatchServer: {} observing match {}", sender.toString(), id);
+            }
+            break;
+
+        case ServerMessage::Unsubscribe:
+            if (observer != observers.end()) {
+                observers.erase(observer);
+            }
+            break;
+
+        case ServerMessage::Commands: {
+            uint8_t player = in.u8();
+            uint8_t count = in.u8();
+            if (!in.ok() || count > MAX_COMMANDS_PER_MESSAGE ||
+                in.remaining() != count * COMMAND_WIRE_SIZE) {
+                ++m_rejected;
+                return;
+            }
+            // Ownership and targets are checked when the orders are applied
+            for (uint8_t i = 0; i < count; ++i) {
+                Command command;
+                if (!readCommand(in, command)) {
+                    ++m_rejected;
+                    return;
+                }
+                command.player = player;
+                match->queue(command);
+            }
+            break;
+        }
+
+        default:
+            ++m_rejected;
+            break;
+    }
+}
+
+void MatchServer::publish() {
+    MCGNG_PROFILE_ZONE("MatchServer::publish");
+    const auto timeout = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(m_config.observerTimeout));
+    auto now = Clock::now();
+
+    for (auto& match : m_matches) {
+        auto& observers = match->m_observers;
+        observers.erase(std::remove_if(observers.begin(), observers.end(),
+                                       [&](const Match::Observer& o) { return now - o.lastSeen > timeout; }),
+                        observers.end());
+        if (observers.empty()) {
+            continue;
+        }
+
+        // Built during the tick: subscriptions are received before it
+        const SnapshotWriter& snapshot = match->getSnapshot();
+        for (const Match::Observer& observer : observers) {
+            for (size_t i = 0; i < snapshot.getPacketCount(); ++i) {
+                const std::vector<uint8_t>& packet = snapshot.getPacket(i);
+                m_socket.sendTo(observer.address, packet.data(), packet.size());
+            }
+        }
+        match->m_snapshotBytes += snapshot.getBytes();
+        match->m_forceKeyframe = false;
+    }
+}
+
+} // namespace mcgng
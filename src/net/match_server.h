@@ -0,0 +1,186 @@
+#ifndef MCGNG_MATCH_SERVER_H
+#define MCGNG_MATCH_SERVER_H
+
+#include "game/skirmish.h"
+#include "game/skirmish_bot.h"
+#include "net/server_protocol.h"
+#include "net/transport.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Dedicated server settings.
+ */
+struct ServerConfig {
+    uint16_t port = 7100;
+    bool localOnly = true;              // Bind to 127.0.0.1 only
+    float tickRate = 30.0f;             // Fixed simulation ticks per second
+    uint32_t snapshotInterval = 2;      // Ticks between snapshots
+    uint32_t keyframeInterval = 15;     // Snapshots between full keyframes
+    float observerTimeout = 10.0f;      // Seconds without Subscribe before dropping an observer
+};
+
+/**
+ * Per-match counters since the last report.
+ */
+struct MatchStats {
+    uint16_t id = 0;
+    uint32_t tick = 0;
+    float ticksPerSecond = 0.0f;        // Achieved
+    float stepMicros = 0.0f;            // Average cost of one tick
+    size_t memoryBytes = 0;             // Approximate heap + object footprint
+    size_t observers = 0;
+    uint64_t commands = 0;              // Accepted orders
+    uint64_t snapshotBytes = 0;         // Per observer
+    int winner = -1;
+};
+
+/**
+ * One hosted match: a Skirmish plus its order queue, optional bots and
+ * observers. Matches share nothing, so the server ticks them in parallel.
+ */
+class Match {
+public:
+    Match(uint16_t id, uint32_t seed);
+
+    uint16_t getId() const { return m_id; }
+    Skirmish& getWorld() { return m_world; }
+    const Skirmish& getWorld() const { return m_world; }
+
+    /**
+     * Let built-in bots play the given teams.
+     */
+    void addBot(int team, uint32_t seed);
+
+    /**
+     * Queue an order for the next tick.
+     */
+    void queue(const Command& command) { m_queue.push_back(command); }
+
+    /**
+     * Apply queued and bot orders, then advance one tick.
+     */
+    void tick(float deltaTime);
+
+    /**
+     * Encode the snapshot for the current tick.
+     */
+    void buildSnapshot(bool keyframe);
+    const SnapshotWriter& getSnapshot() const { return m_snapshot; }
+
+    /**
+     * Approximate memory held by the match.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Get counters and reset the per-interval ones.
+     * @param seconds Wall time since the last call
+     */
+    MatchStats takeStats(float seconds);
+
+private:
+    friend class MatchServer;
+
+    struct Observer {
+        SocketAddress address;
+        std::chrono::steady_clock::time_point lastSeen;
+    };
+
+    uint16_t m_id;
+    Skirmish m_world;
+    std::vector<SkirmishBot> m_bots;
+    std::vector<Command> m_queue;
+    std::vector<Command> m_botOrders;
+    std::vector<Observer> m_observers;
+    std::vector<UnitSnapshot> m_lastSent;
+    SnapshotWriter m_snapshot;
+    bool m_forceKeyframe = true;
+    bool m_finished = false;
+
+    // Counters since the last report
+    uint32_t m_intervalTicks = 0;
+    double m_intervalMicros = 0.0;
+    uint64_t m_commands = 0;
+    uint64_t m_snapshotBytes = 0;
+};
+
+/**
+ * Dedicated simulation server.
+ *
+ * Hosts any number of independent matches on one fixed tick. Each tick it
+ * drains the local UDP socket (orders and subscriptions), steps every
+ * match as a job, then sends each observer its match's snapshot: a full
+ * keyframe periodically and on subscription, quantized deltas in between.
+ * Nothing here touches the renderer, audio or video.
+ */
+class MatchServer {
+public:
+    /**
+     * Open the socket.
+     */
+    bool initialize(const ServerConfig& config);
+
+    /**
+     * Close the socket and drop all matches.
+     */
+    void shutdown();
+
+    /**
+     * Create an empty match; spawn its units through getWorld().
+     * @return nullptr once 65536 matches exist
+     */
+    Match* createMatch(uint32_t seed);
+
+    Match* getMatch(uint16_t id);
+    size_t getMatchCount() const { return m_matches.size(); }
+
+    /**
+     * Run however many fixed ticks the elapsed time calls for.
+     */
+    void update(float deltaTime);
+
+    /**
+     * Run one fixed tick now: receive, simulate every match, publish.
+     */
+    void tick();
+
+    /**
+     * Get per-match counters since the last call.
+     */
+    std::vector<MatchStats> takeStats();
+
+    /**
+     * Print a line per match and a server summary.
+     */
+    void report();
+
+    uint64_t getTickCount() const { return m_tickCount; }
+
+    /**
+     * Get the port the server listens on (the bound one when configured as 0).
+     */
+    uint16_t getPort() const { return m_socket.getLocalPort(); }
+
+private:
+    void receive();
+    void handleMessage(const SocketAddress& sender, const std::vector<uint8_t>& packet);
+    void publish();
+
+    ServerConfig m_config;
+    UdpSocket m_socket;
+    std::vector<std::unique_ptr<Match>> m_matches;
+    float m_accumulator = 0.0f;
+    uint64_t m_tickCount = 0;
+    uint64_t m_rejected = 0;
+    std::chrono::steady_clock::time_point m_lastStats;
+    std::vector<uint8_t> m_receiveBuffer;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_MATCH_SERVER_H
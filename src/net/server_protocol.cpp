@@ -0,0 +1,248 @@
+#include "net/server_protocol.h"
+#include "net/transport.h"
+#include "game/combat.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mcgng {
+
+namespace {
+
+constexpr size_t SNAPSHOT_HEADER_SIZE = SERVER_HEADER_SIZE + 4 + 4 + 1 + 2;
+
+int16_t quantizePosition(float value) {
+    float halfMeters = std::round(value * 2.0f);
+    return static_cast<int16_t>(std::clamp(halfMeters, -32768.0f, 32767.0f));
+}
+
+uint8_t quantizePercent(float ratio) {
+    return static_cast<uint8_t>(std::clamp(std::round(ratio * 100.0f), 0.0f, 255.0f));
+}
+
+} // anonymous namespace
+
+UnitSnapshot UnitSnapshot::capture(uint16_t unit, const Mech& mech) {
+    UnitSnapshot snapshot;
+    snapshot.unit = unit;
+    snapshot.x = quantizePosition(mech.getX());
+    snapshot.y = quantizePosition(mech.getY());
+
+    float heading = std::fmod(mech.getHeading(), 360.0f);
+    if (heading < 0.0f) {
+        heading += 360.0f;
+    }
+    snapshot.heading = static_cast<uint8_t>(static_cast<int>(std::round(heading * (256.0f / 360.0f))) & 0xFF);
+
+    snapshot.heat = mech.getMaxHeat() > 0.0f ? quantizePercent(mech.getHeat() / mech.getMaxHeat()) : 0;
+
+    int points = 0;
+    int maxPoints = 0;
+    for (int loc = 0; loc < static_cast<int>(MechLocation::Count); ++loc) {
+        const MechComponent& component = mech.getComponent(static_cast<MechLocation>(loc));
+        points += std::max(component.armor, 0) + std::max(component.internalStructure, 0);
+        maxPoints += component.maxArmor + component.maxInternalStructure;
+    }
+    snapshot.health = maxPoints > 0 ? quantizePercent(static_cast<float>(points) / maxPoints) : 0;
+
+    snapshot.flags = static_cast<uint8_t>((mech.getTeam() & 0x0F) << 4);
+    if (mech.isDestroyed()) {
+        snapshot.flags |= DESTROYED;
+    }
+    if (mech.isMoving()) {
+        snapshot.flags |= MOVING;
+    }
+    return snapshot;
+}
+
+ProjectileSnapshot ProjectileSnapshot::capture(const Projectile& projectile) {
+    ProjectileSnapshot snapshot;
+    snapshot.x = quantizePosition(projectile.x);
+    snapshot.y = quantizePosition(projectile.y);
+    snapshot.weapon = static_cast<uint8_t>(projectile.weapon ? projectile.weapon->type : WeaponType::None);
+    return snapshot;
+}
+
+void writeServerHeader(WireWriter& out, ServerMessage type, uint16_t match) {
+    out.u16(SERVER_MAGIC);
+    out.u8(SERVER_PROTOCOL_VERSION);
+    out.u8(static_cast<uint8_t>(type));
+    out.u16(match);
+}
+
+bool readServerHeader(WireReader& in, ServerMessage& type, uint16_t& match) {
+    uint16_t magic = in.u16();
+    uint8_t version = in.u8();
+    uint8_t rawType = in.u8();
+    match = in.u16();
+    type = static_cast<ServerMessage>(rawType);
+    return in.ok() && magic == SERVER_MAGIC && version == SERVER_PROTOCOL_VERSION &&
+           rawType < static_cast<uint8_t>(ServerMessage::Count);
+}
+
+// SnapshotWriter
+
+void SnapshotWriter::begin(uint16_t match, uint32_t tick, uint32_t checksum, bool keyframe) {
+    m_match = match;
+    m_tick = tick;
+    m_checksum = checksum;
+    m_flags = keyframe ? SNAPSHOT_KEYFRAME : 0;
+    m_count = 0;
+    startPacket();
+}
+
+void SnapshotWriter::addUnit(const UnitSnapshot& unit) {
+    if (m_projectileCountOffset != 0 || !fits(UnitSnapshot::WIRE_SIZE + 2)) {
+        endPacket(false);
+        startPacket();
+    }
+    WireWriter out(m_packets[m_count - 1]);
+    out.u16(unit.unit);
+    out.i16(unit.x);
+    out.i16(unit.y);
+    out.u8(unit.heading);
+    out.u8(unit.heat);
+    out.u8(unit.health);
+    out.u8(unit.flags);
+    ++m_units;
+}
+
+void SnapshotWriter::addProjectile(const ProjectileSnapshot& projectile) {
+    size_t needed = ProjectileSnapshot::WIRE_SIZE + (m_projectileCountOffset == 0 ? 2 : 0);
+    if (!fits(needed)) {
+        endPacket(false);
+        startPacket();
+    }
+    WireWriter out(m_packets[m_count - 1]);
+    if (m_projectileCountOffset == 0) {
+        m_projectileCountOffset = out.size();
+        out.u16(0);
+    }
+    out.i16(projectile.x);
+    out.i16(projectile.y);
+    out.u8(projectile.weapon);
+    ++m_projectiles;
+}
+
+void SnapshotWriter::finish() {
+    endPacket(true);
+}
+
+size_t SnapshotWriter::getBytes() const {
+    size_t bytes = 0;
+    for (size_t i = 0; i < m_count; ++i) {
+        bytes += m_packets[i].size();
+    }
+    return bytes;
+}
+
+size_t SnapshotWriter::getCapacity() const {
+    size_t bytes = m_packets.capacity() * sizeof(std::vector<uint8_t>);
+    for (const auto& packet : m_packets) {
+        bytes += packet.capacity();
+    }
+    return bytes;
+}
+
+void SnapshotWriter::startPacket() {
+    if (m_count == m_packets.size()) {
+        m_packets.emplace_back();
+    }
+    std::vector<uint8_t>& packet = m_packets[m_count++];
+    packet.clear();
+
+    WireWriter out(packet);
+    writeServerHeader(out, ServerMessage::Snapshot, m_match);
+    out.u32(m_tick);
+    out.u32(m_checksum);
+    out.u8(m_flags);
+    m_unitCountOffset = out.size();
+    out.u16(0);
+
+    m_projectileCountOffset = 0;
+    m_units = 0;
+    m_projectiles = 0;
+}
+
+void SnapshotWriter::endPacket(bool final) {
+    std::vector<uint8_t>& packet = m_packets[m_count - 1];
+    WireWriter out(packet);
+    out.patch16(m_unitCountOffset, m_units);
+    if (m_projectileCountOffset == 0) {
+        out.u16(0);
+    } else {
+        out.patch16(m_projectileCountOffset, m_projectiles);
+    }
+    if (final) {
+        out.patch8(m_unitCountOffset - 1, static_cast<uint8_t>(m_flags | SNAPSHOT_FINAL));
+    }
+}
+
+bool SnapshotWriter::fits(size_t bytes) const {
+    // Keep room for the projectile count that closes every packet
+    return m_packets[m_count - 1].size() + bytes + 2 <= Transport::MAX_DATAGRAM;
+}
+
+// MatchView
+
+bool MatchView::apply(const std::vector<uint8_t>& packet) {
+    WireReader in(packet);
+    ServerMessage type;
+    uint16_t packetMatch;
+    if (!readServerHeader(in, type, packetMatch) || type != ServerMessage::Snapshot ||
+        packetMatch != match) {
+        return false;
+    }
+
+    uint32_t packetTick = in.u32();
+    uint32_t packetChecksum = in.u32();
+    uint8_t flags = in.u8();
+    uint16_t unitCount = in.u16();
+    if (!in.ok() || in.remaining() < unitCount * UnitSnapshot::WIRE_SIZE + 2) {
+        return false;
+    }
+    if (synced && packetTick < tick) {
+        return true;    // Late part of an older tick
+    }
+    if (!synced && !(flags & SNAPSHOT_KEYFRAME)) {
+        return true;    // Deltas are meaningless until the first keyframe
+    }
+
+    if (packetTick != tick || !synced) {
+        projectiles.clear();
+        tick = packetTick;
+        checksum = packetChecksum;
+    }
+    if (flags & SNAPSHOT_KEYFRAME) {
+        synced = true;
+    }
+
+    for (uint16_t i = 0; i < unitCount; ++i) {
+        UnitSnapshot unit;
+        unit.unit = in.u16();
+        unit.x = in.i16();
+        unit.y = in.i16();
+        unit.heading = in.u8();
+        unit.heat = in.u8();
+        unit.health = in.u8();
+        unit.flags = in.u8();
+        if (unit.unit >= units.size()) {
+            units.resize(unit.unit + 1u);
+        }
+        units[unit.unit] = unit;
+    }
+
+    uint16_t projectileCount = in.u16();
+    if (!in.ok() || in.remaining() < projectileCount * ProjectileSnapshot::WIRE_SIZE) {
+        return false;
+    }
+    for (uint16_t i = 0; i < projectileCount; ++i) {
+        ProjectileSnapshot projectile;
+        projectile.x = in.i16();
+        projectile.y = in.i16();
+        projectile.weapon = in.u8();
+        projectiles.push_back(projectile);
+    }
+    return in.ok();
+}
+
+} // namespace mcgng
@@ -0,0 +1,159 @@
+#ifndef MCGNG_SERVER_PROTOCOL_H
+#define MCGNG_SERVER_PROTOCOL_H
+
+#include "net/wire.h"
+#include <cstdint>
+#include <vector>
+
+namespace mcgng {
+
+class Mech;
+struct Projectile;
+
+/**
+ * Dedicated server datagram protocol. Every message starts with
+ * magic (u16), version (u8), type (u8) and match id (u16).
+ *
+ *   Subscribe    client -> server  Start (or keep) receiving a match's snapshots;
+ *                                  resend every few seconds or the server drops you
+ *   Unsubscribe  client -> server  Stop receiving
+ *   Commands     client -> server  u8 player, u8 count, count * 14-byte commands
+ *   Snapshot     server -> client  u32 tick, u32 checksum, u8 flags,
+ *                                  u16 units, units * 10 bytes,
+ *                                  u16 projectiles, projectiles * 5 bytes
+ *
+ * A tick's snapshot may span several datagrams; the last has SNAPSHOT_FINAL.
+ * Keyframes list every unit, other snapshots only units whose quantized
+ * state changed since the previous one. Projectiles are always complete.
+ */
+constexpr uint16_t SERVER_MAGIC = 0x5653;   // "SV"
+constexpr uint8_t SERVER_PROTOCOL_VERSION = 1;
+constexpr size_t SERVER_HEADER_SIZE = 6;
+
+enum class ServerMessage : uint8_t {
+    Subscribe,
+    Unsubscribe,
+    Commands,
+    Snapshot,
+    Count
+};
+
+constexpr uint8_t SNAPSHOT_KEYFRAME = 0x01;
+constexpr uint8_t SNAPSHOT_FINAL = 0x02;
+
+/**
+ * Quantized unit state (10 bytes on the wire).
+ */
+struct UnitSnapshot {
+    static constexpr uint8_t DESTROYED = 0x01;
+    static constexpr uint8_t MOVING = 0x02;
+    static constexpr size_t WIRE_SIZE = 10;
+
+    uint16_t unit = 0;
+    int16_t x = 0, y = 0;       // Half meters
+    uint8_t heading = 0;        // 256ths of a turn
+    uint8_t heat = 0;           // Percent of shutdown heat
+    uint8_t health = 0;         // Percent of armor and structure left
+    uint8_t flags = 0;          // DESTROYED | MOVING | team << 4
+
+    static UnitSnapshot capture(uint16_t unit, const Mech& mech);
+
+    float getX() const { return x * 0.5f; }
+    float getY() const { return y * 0.5f; }
+    float getHeading() const { return heading * (360.0f / 256.0f); }     // Degrees
+    int getTeam() const { return flags >> 4; }
+    bool isDestroyed() const { return (flags & DESTROYED) != 0; }
+
+    bool operator==(const UnitSnapshot& other) const {
+        return unit == other.unit && x == other.x && y == other.y && heading == other.heading &&
+               heat == other.heat && health == other.health && flags == other.flags;
+    }
+    bool operator!=(const UnitSnapshot& other) const { return !(*this == other); }
+};
+
+/**
+ * Quantized projectile (5 bytes on the wire).
+ */
+struct ProjectileSnapshot {
+    static constexpr size_t WIRE_SIZE = 5;
+
+    int16_t x = 0, y = 0;       // Half meters
+    uint8_t weapon = 0;         // WeaponType
+
+    static ProjectileSnapshot capture(const Projectile& projectile);
+};
+
+void writeServerHeader(WireWriter& out, ServerMessage type, uint16_t match);
+
+/**
+ * @return false on wrong magic/version or unknown type
+ */
+bool readServerHeader(WireReader& in, ServerMessage& type, uint16_t& match);
+
+/**
+ * Encodes one tick's snapshot, split into datagrams of at most
+ * Transport::MAX_DATAGRAM bytes. Add all units, then all projectiles.
+ * Buffers are reused from tick to tick.
+ */
+class SnapshotWriter {
+public:
+    void begin(uint16_t match, uint32_t tick, uint32_t checksum, bool keyframe);
+    void addUnit(const UnitSnapshot& unit);
+    void addProjectile(const ProjectileSnapshot& projectile);
+    void finish();
+
+    size_t getPacketCount() const { return m_count; }
+    const std::vector<uint8_t>& getPacket(size_t index) const { return m_packets[index]; }
+
+    /**
+     * Total encoded bytes of the last snapshot.
+     */
+    size_t getBytes() const;
+
+    /**
+     * Heap bytes held by the packet buffers.
+     */
+    size_t getCapacity() const;
+
+private:
+    void startPacket();
+    void endPacket(bool final);
+    bool fits(size_t bytes) const;
+
+    std::vector<std::vector<uint8_t>> m_packets;
+    size_t m_count = 0;
+
+    uint16_t m_match = 0;
+    uint32_t m_tick = 0;
+    uint32_t m_checksum = 0;
+    uint8_t m_flags = 0;
+
+    // Current packet
+    size_t m_unitCountOffset = 0;
+    size_t m_projectileCountOffset = 0;     // 0 until the first projectile
+    uint16_t m_units = 0;
+    uint16_t m_projectiles = 0;
+};
+
+/**
+ * A match as an observer sees it, rebuilt from snapshots.
+ */
+struct MatchView {
+    uint16_t match = 0;
+    uint32_t tick = 0;
+    uint32_t checksum = 0;
+    bool synced = false;                        // A keyframe has arrived
+    std::vector<UnitSnapshot> units;            // By unit id
+    std::vector<ProjectileSnapshot> projectiles;
+
+    /**
+     * Apply one snapshot datagram (header included). Parts of older ticks
+     * are ignored.
+     * @return false if malformed or for another match
+     */
+    bool apply(const std::vector<uint8_t>& packet);
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_SERVER_PROTOCOL_H
@@ -0,0 +1,336 @@
+#include "net/transport.h"
+#include "core/log.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace mcgng {
+
+namespace {
+
+// Receive failure classes. A send to a peer that isn't up yet comes back
+// as a one-off "refused" error on the next receive, which is just skipped.
+enum class ReceiveError { Empty, Retry, Fatal };
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+bool startSockets() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+
+void closeSocket(SocketHandle socket) {
+    closesocket(socket);
+}
+
+bool setNonBlocking(SocketHandle socket) {
+    u_long mode = 1;
+    return ioctlsocket(socket, FIONBIO, &mode) == 0;
+}
+
+ReceiveError lastReceiveError() {
+    switch (WSAGetLastError()) {
+        case WSAEWOULDBLOCK: return ReceiveError::Empty;
+        case WSAECONNRESET: return ReceiveError::Retry;
+        default: return ReceiveError::Fatal;
+    }
+}
+#else
+using SocketHandle = int;
+
+bool startSockets() {
+    return true;
+}
+
+void closeSocket(SocketHandle socket) {
+    ::close(socket);
+}
+
+bool setNonBlocking(SocketHandle socket) {
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+ReceiveError lastReceiveError() {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return ReceiveError::Empty;
+    }
+    if (errno == ECONNREFUSED || errno == EINTR) {
+        return ReceiveError::Retry;
+    }
+    return ReceiveError::Fatal;
+}
+#endif
+
+SocketHandle toHandle(intptr_t socket) {
+    return static_cast<SocketHandle>(socket);
+}
+
+bool resolveAddress(const std::string& host, uint16_t port, sockaddr_in& address) {
+    if (!startSockets()) {
+        return false;
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        return false;
+    }
+    address = *reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    address.sin_port = htons(port);
+    freeaddrinfo(result);
+    return true;
+}
+
+/**
+ * Create a non-blocking UDP socket bound to ip:port (host byte order).
+ */
+intptr_t openSocket(uint32_t ip, uint16_t port) {
+    if (!startSockets()) {
+        MCGNG_LOG_ERROR(Net, "UdpSocket: Socket startup failed");
+        return -1;
+    }
+
+    SocketHandle socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (socket == toHandle(-1)) {
+        MCGNG_LOG_ERROR(Net, "UdpSocket: Cannot create socket");
+        return -1;
+    }
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(ip);
+    local.sin_port = htons(port);
+    if (bind(socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 ||
+        !setNonBlocking(socket)) {
+        closeSocket(socket);
+        MCGNG_LOG_ERROR(Net, "UdpSocket: Cannot bind port {}", port);
+        return -1;
+    }
+    return static_cast<intptr_t>(socket);
+}
+
+/**
+ * Port a socket is bound to (the one the system picked for port 0).
+ */
+uint16_t boundPort(intptr_t socket) {
+    sockaddr_in local = {};
+    socklen_t length = sizeof(local);
+    if (getsockname(toHandle(socket), reinterpret_cast<sockaddr*>(&local), &length) != 0) {
+        return 0;
+    }
+    return ntohs(local.sin_port);
+}
+
+} // anonymous namespace
+
+// LoopbackTransport
+
+LoopbackTransport::Pair LoopbackTransport::createPair() {
+    auto a = std::make_shared<Channel>();
+    auto b = std::make_shared<Channel>();
+    return Pair(std::unique_ptr<LoopbackTransport>(new LoopbackTransport(a, b)),
+                std::unique_ptr<LoopbackTransport>(new LoopbackTransport(b, a)));
+}
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<Channel> inbox, std::shared_ptr<Channel> outbox)
+    : m_inbox(std::move(inbox)), m_outbox(std::move(outbox)) {
+}
+
+void LoopbackTransport::setLossRate(float rate, uint32_t seed) {
+    m_lossRate = rate;
+    m_lossRng.seed(seed);
+}
+
+bool LoopbackTransport::send(const uint8_t* data, size_t size) {
+    if (m_lossRate > 0.0f &&
+        static_cast<float>(m_lossRng() >> 8) * (1.0f / 16777216.0f) < m_lossRate) {
+        return true;    // Lost on the wire
+    }
+    std::lock_guard<std::mutex> lock(m_outbox->mutex);
+    m_outbox->datagrams.emplace_back(data, data + size);
+    return true;
+}
+
+bool LoopbackTransport::receive(std::vector<uint8_t>& data) {
+    std::lock_guard<std::mutex> lock(m_inbox->mutex);
+    if (m_inbox->datagrams.empty()) {
+        return false;
+    }
+    data = std::move(m_inbox->datagrams.front());
+    m_inbox->datagrams.pop_front();
+    return true;
+}
+
+// UdpTransport
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort) {
+    close();
+
+    sockaddr_in remote = {};
+    if (!resolveAddress(remoteHost, remotePort, remote)) {
+        MCGNG_LOG_ERROR(Net, "UdpTransport: Cannot resolve {}", remoteHost);
+        return false;
+    }
+
+    intptr_t socket = openSocket(INADDR_ANY, localPort);
+    if (socket == INVALID) {
+        return false;
+    }
+
+    // Connecting makes the kernel drop datagrams from anyone but the peer
+    if (connect(toHandle(socket), reinterpret_cast<const sockaddr*>(&remote), sizeof(remote)) != 0) {
+        closeSocket(toHandle(socket));
+        MCGNG_LOG_ERROR(Net, "UdpTransport: Cannot connect to {}:{}", remoteHost, remotePort);
+        return false;
+    }
+
+    m_socket = socket;
+    MCGNG_LOG_INFO(Net, "UdpTransport: Port {} connected to {}:{}", boundPort(m_socket), remoteHost, remotePort);
+    return true;
+}
+
+void UdpTransport::close() {
+    if (m_socket != INVALID) {
+        closeSocket(toHandle(m_socket));
+        m_socket = INVALID;
+    }
+}
+
+bool UdpTransport::send(const uint8_t* data, size_t size) {
+    if (m_socket == INVALID) {
+        return false;
+    }
+    auto sent = ::send(toHandle(m_socket), reinterpret_cast<const char*>(data),
+                       static_cast<int>(size), 0);
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+bool UdpTransport::receive(std::vector<uint8_t>& data) {
+    if (m_socket == INVALID) {
+        return false;
+    }
+    while (true) {
+        data.resize(MAX_DATAGRAM);
+        auto received = recv(toHandle(m_socket), reinterpret_cast<char*>(data.data()),
+                             static_cast<int>(data.size()), 0);
+        if (received >= 0) {
+            data.resize(static_cast<size_t>(received));
+            return true;
+        }
+        ReceiveError error = lastReceiveError();
+        if (error == ReceiveError::Fatal) {
+            MCGNG_LOG_WARN(Net, "UdpTransport: Receive failed");
+        }
+        if (error != ReceiveError::Retry) {
+            return false;
+        }
+    }
+}
+
+// SocketAddress
+
+std::string SocketAddress::toString() const {
+    return std::to_string(ip >> 24) + "." + std::to_string((ip >> 16) & 0xFF) + "." +
+           std::to_string((ip >> 8) & 0xFF) + "." + std::to_string(ip & 0xFF) + ":" +
+           std::to_string(port);
+}
+
+// UdpSocket
+
+UdpSocket::~UdpSocket() {
+    close();
+}
+
+bool UdpSocket::open(uint16_t port, bool localOnly) {
+    close();
+    m_socket = openSocket(localOnly ? INADDR_LOOPBACK : INADDR_ANY, port);
+    if (m_socket == INVALID) {
+        return false;
+    }
+    m_port = boundPort(m_socket);
+    MCGNG_LOG_INFO(Net, "UdpSocket: Listening on {}port {}", localOnly ? "local " : "", m_port);
+    return true;
+}
+
+void UdpSocket::close() {
+    if (m_socket != INVALID) {
+        closeSocket(toHandle(m_socket));
+        m_socket = INVALID;
+    }
+    m_port = 0;
+}
+
+bool UdpSocket::sendTo(const SocketAddress& address, const uint8_t* data, size_t size) {
+    if (m_socket == INVALID) {
+        return false;
+    }
+    sockaddr_in remote = {};
+    remote.sin_family = AF_INET;
+    remote.sin_addr.s_addr = htonl(address.ip);
+    remote.sin_port = htons(address.port);
+    auto sent = sendto(toHandle(m_socket), reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+                       reinterpret_cast<const sockaddr*>(&remote), sizeof(remote));
+    return sent == static_cast<decltype(sent)>(size);
+}
+
+bool UdpSocket::receiveFrom(SocketAddress& address, std::vector<uint8_t>& data) {
+    if (m_socket == INVALID) {
+        return false;
+    }
+    while (true) {
+        sockaddr_in remote = {};
+        socklen_t length = sizeof(remote);
+        data.resize(Transport::MAX_DATAGRAM);
+        auto received = recvfrom(toHandle(m_socket), reinterpret_cast<char*>(data.data()),
+                                 static_cast<int>(data.size()), 0,
+                                 reinterpret_cast<sockaddr*>(&remote), &length);
+        if (received >= 0) {
+            data.resize(static_cast<size_t>(received));
+            address.ip = ntohl(remote.sin_addr.s_addr);
+            address.port = ntohs(remote.sin_port);
+            return true;
+        }
+        ReceiveError error = lastReceiveError();
+        if (error == ReceiveError::Fatal) {
+            MCGNG_LOG_WARN(Net, "UdpSocket: Receive failed");
+        }
+        if (error != ReceiveError::Retry) {
+            return false;
+        }
+    }
+}
+
+bool UdpSocket::resolve(const std::string& host, uint16_t port, SocketAddress& address) {
+    sockaddr_in resolved = {};
+    if (!resolveAddress(host, port, resolved)) {
+        return false;
+    }
+    address.ip = ntohl(resolved.sin_addr.s_addr);
+    address.port = port;
+    return true;
+}
+
+} // namespace mcgng
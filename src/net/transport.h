@@ -0,0 +1,202 @@
+#ifndef MCGNG_TRANSPORT_H
+#define MCGNG_TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Unreliable datagram link to one peer.
+ *
+ * Datagrams may be lost, duplicated or reordered; the lockstep session
+ * handles all of that itself, so transports stay thin.
+ */
+class Transport {
+public:
+    /**
+     * Largest datagram callers should send (fits a typical MTU).
+     */
+    static constexpr size_t MAX_DATAGRAM = 1200;
+
+    virtual ~Transport() = default;
+
+    /**
+     * Send a datagram.
+     * @return false if it could not be queued (the caller just carries on)
+     */
+    virtual bool send(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Receive one datagram without blocking.
+     * @param data Receives the payload
+     * @return false if nothing is waiting
+     */
+    virtual bool receive(std::vector<uint8_t>& data) = 0;
+
+    /**
+     * Check if the link is usable.
+     */
+    virtual bool isOpen() const = 0;
+};
+
+/**
+ * In-process transport: two endpoints joined by mutex-guarded queues.
+ * Either end may be used from its own thread. Optional simulated loss
+ * exercises the session's resend path in tests.
+ */
+class LoopbackTransport : public Transport {
+public:
+    using Pair = std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>>;
+
+    /**
+     * Create two connected endpoints.
+     */
+    static Pair createPair();
+
+    bool send(const uint8_t* data, size_t size) override;
+    bool receive(std::vector<uint8_t>& data) override;
+    bool isOpen() const override { return true; }
+
+    /**
+     * Drop this fraction (0-1) of outgoing datagrams.
+     * @param seed Loss pattern seed, for reproducible runs
+     */
+    void setLossRate(float rate, uint32_t seed = 1);
+
+private:
+    struct Channel {
+        std::mutex mutex;
+        std::deque<std::vector<uint8_t>> datagrams;
+    };
+
+    LoopbackTransport(std::shared_ptr<Channel> inbox, std::shared_ptr<Channel> outbox);
+
+    std::shared_ptr<Channel> m_inbox;
+    std::shared_ptr<Channel> m_outbox;
+    float m_lossRate = 0.0f;
+    std::mt19937 m_lossRng;
+};
+
+/**
+ * UDP transport (IPv4) bound to a local port and connected to one peer.
+ * The socket is non-blocking; nothing is sent until the caller sends.
+ */
+class UdpTransport : public Transport {
+public:
+    UdpTransport() = default;
+    ~UdpTransport() override;
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    /**
+     * Bind and connect.
+     * @param localPort Port to receive on
+     * @param remoteHost Peer host name or dotted address
+     * @param remotePort Peer port
+     * @return true on success
+     */
+    bool open(uint16_t localPort, const std::string& remoteHost, uint16_t remotePort);
+
+    /**
+     * Close the socket.
+     */
+    void close();
+
+    bool send(const uint8_t* data, size_t size) override;
+    bool receive(std::vector<uint8_t>& data) override;
+    bool isOpen() const override { return m_socket != INVALID; }
+
+private:
+    static constexpr intptr_t INVALID = -1;
+
+    intptr_t m_socket = INVALID;    // SOCKET on Windows, fd elsewhere
+};
+
+/**
+ * IPv4 address and port, in host byte order.
+ */
+struct SocketAddress {
+    uint32_t ip = 0;
+    uint16_t port = 0;
+
+    bool operator==(const SocketAddress& other) const {
+        return ip == other.ip && port == other.port;
+    }
+    bool operator!=(const SocketAddress& other) const { return !(*this == other); }
+
+    bool isLoopback() const { return (ip >> 24) == 127; }
+
+    /**
+     * Format as "a.b.c.d:port".
+     */
+    std::string toString() const;
+};
+
+/**
+ * Unconnected non-blocking UDP socket, for a server talking to many peers.
+ */
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    ~UdpSocket();
+
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    /**
+     * Bind to a port.
+     * @param port Port to bind, or 0 for any free port (see getLocalPort)
+     * @param localOnly Accept only from this machine (127.0.0.1)
+     * @return true on success
+     */
+    bool open(uint16_t port, bool localOnly = true);
+
+    /**
+     * Close the socket.
+     */
+    void close();
+
+    bool isOpen() const { return m_socket != INVALID; }
+
+    /**
+     * Get the port the socket is bound to (0 if closed).
+     */
+    uint16_t getLocalPort() const { return m_port; }
+
+    /**
+     * Send a datagram.
+     */
+    bool sendTo(const SocketAddress& address, const uint8_t* data, size_t size);
+
+    /**
+     * Receive one datagram without blocking.
+     * @param address Receives the sender
+     * @param data Receives the payload
+     * @return false if nothing is waiting
+     */
+    bool receiveFrom(SocketAddress& address, std::vector<uint8_t>& data);
+
+    /**
+     * Resolve a host name or dotted address.
+     */
+    static bool resolve(const std::string& host, uint16_t port, SocketAddress& address);
+
+private:
+    static constexpr intptr_t INVALID = -1;
+
+    intptr_t m_socket = INVALID;
+    uint16_t m_port = 0;
+};
+
+} // namespace mcgng
+
+#endif // MCGNG_TRANSPORT_H
@@ -0,0 +1,143 @@
+#ifndef MCGNG_WIRE_H
+#define MCGNG_WIRE_H
+
+#include "game/command.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace mcgng {
+
+/**
+ * Appends little-endian values to a packet buffer.
+ */
+class WireWriter {
+public:
+    explicit WireWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+    void u8(uint8_t value) { m_out.push_back(value); }
+
+    void u16(uint16_t value) {
+        m_out.push_back(static_cast<uint8_t>(value));
+        m_out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void u32(uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            m_out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void i16(int16_t value) { u16(static_cast<uint16_t>(value)); }
+
+    void f32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    /**
+     * Overwrite a value written earlier (counts known only at the end).
+     */
+    void patch8(size_t offset, uint8_t value) { m_out[offset] = value; }
+
+    void patch16(size_t offset, uint16_t value) {
+        m_out[offset] = static_cast<uint8_t>(value);
+        m_out[offset + 1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    size_t size() const { return m_out.size(); }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+/**
+ * Reads little-endian values with bounds checking. Reading past the end
+ * returns zeros and clears ok(), so callers check once at the end.
+ */
+class WireReader {
+public:
+    WireReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+    explicit WireReader(const std::vector<uint8_t>& data) : WireReader(data.data(), data.size()) {}
+
+    bool ok() const { return m_ok; }
+    size_t remaining() const { return m_size - m_pos; }
+
+    uint8_t u8() {
+        if (!need(1)) return 0;
+        return m_data[m_pos++];
+    }
+
+    uint16_t u16() {
+        if (!need(2)) return 0;
+        uint16_t value = static_cast<uint16_t>(m_data[m_pos] | (m_data[m_pos + 1] << 8));
+        m_pos += 2;
+        return value;
+    }
+
+    uint32_t u32() {
+        if (!need(4)) return 0;
+        uint32_t value = 0;
+        for (int i = 3; i >= 0; --i) {
+            value = (value << 8) | m_data[m_pos + i];
+        }
+        m_pos += 4;
+        return value;
+    }
+
+    int16_t i16() { return static_cast<int16_t>(u16()); }
+
+    float f32() {
+        uint32_t bits = u32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+private:
+    bool need(size_t size) {
+        if (size > m_size - m_pos) {
+            m_ok = false;
+        }
+        return m_ok;
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+/**
+ * Encoded size of a Command (the player is implied by the sender).
+ */
+constexpr size_t COMMAND_WIRE_SIZE = 14;
+
+inline void writeCommand(WireWriter& out, const Command& command) {
+    out.u8(static_cast<uint8_t>(command.type));
+    out.u8(command.weapon);
+    out.u16(command.unit);
+    out.u16(command.target);
+    out.f32(command.x);
+    out.f32(command.y);
+}
+
+/**
+ * @return false if the type is unknown (or the reader ran out)
+ */
+inline bool readCommand(WireReader& in, Command& command) {
+    uint8_t type = in.u8();
+    command.type = static_cast<CommandType>(type);
+    command.weapon = in.u8();
+    command.unit = in.u16();
+    command.target = in.u16();
+    command.x = in.f32();
+    command.y = in.f32();
+    return in.ok() && type < static_cast<uint8_t>(CommandType::Count);
+}
+
+} // namespace mcgng
+
+#endif // MCGNG_WIRE_H
@@ -0,0 +1,213 @@
+/**
+ * MCG-NG Dedicated Server
+ *
+ * Runs matches headless (no renderer, audio or video) on a fixed tick,
+ * takes orders over a local UDP socket and streams snapshots to
+ * observers. Watch or play a match with match-observer.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "core/engine.h"
+#include "game/mission.h"
+#include "net/match_server.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+std::atomic<bool> g_interrupted{false};
+
+void onInterrupt(int) {
+    g_interrupted = true;
+}
+
+struct ServerOptions {
+    mcgng::ServerConfig server;
+    int matches = 1;
+    int unitsPerTeam = 4;
+    bool bots = false;
+    bool unpaced = false;
+    uint32_t seed = 1;
+    std::string missionPath;
+    std::string mechsPath;
+    float reportInterval = 5.0f;
+    float duration = 0.0f;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "MCG-NG Dedicated Server\n\n";
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --port <n>          UDP port (default: 7100)\n";
+    std::cout << "  --public            Accept connections from other machines (default: localhost only)\n";
+    std::cout << "  --matches <n>       Number of concurrent matches (default: 1)\n";
+    std::cout << "  --units <n>         Units per team in built-in matches (default: 4)\n";
+    std::cout << "  --mission <path>    Spawn units from a mission file instead\n";
+    std::cout << "  --mechs <path>      Mech definitions (.fit) for --mission\n";
+    std::cout << "  --bots              Let bots play both teams\n";
+    std::cout << "  --tick-rate <n>     Simulation ticks per second (default: 30)\n";
+    std::cout << "  --unpaced           Tick as fast as possible (load testing)\n";
+    std::cout << "  --seed <n>          Seed of the first match (default: 1)\n";
+    std::cout << "  --report <s>        Seconds between match reports, 0 = off (default: 5)\n";
+    std::cout << "  --duration <s>      Stop after this long (default: until Ctrl+C)\n";
+    std::cout << "  --config <path>     Path to configuration file\n";
+    std::cout << "  --trace <path>      Write a profiler trace (Chrome/Perfetto JSON) on exit\n";
+    std::cout << "  --log <path>        Also write timestamped log lines to a file\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+bool parseArgs(int argc, char* argv[], ServerOptions& options, mcgng::EngineOptions& engineOptions) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--port" && hasValue) {
+            options.server.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--public") {
+            options.server.localOnly = false;
+        } else if (arg == "--matches" && hasValue) {
+            options.matches = std::atoi(argv[++i]);
+        } else if (arg == "--units" && hasValue) {
+            options.unitsPerTeam = std::atoi(argv[++i]);
+        } else if (arg == "--mission" && hasValue) {
+            options.missionPath = argv[++i];
+        } else if (arg == "--mechs" && hasValue) {
+            options.mechsPath = argv[++i];
+        } else if (arg == "--bots") {
+            options.bots = true;
+        } else if (arg == "--tick-rate" && hasValue) {
+            options.server.tickRate = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--unpaced") {
+            options.unpaced = true;
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--report" && hasValue) {
+            options.reportInterval = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--duration" && hasValue) {
+            options.duration = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--config" && hasValue) {
+            engineOptions.configPath = argv[++i];
+        } else if (arg == "--trace" && hasValue) {
+            engineOptions.tracePath = argv[++i];
+        } else if (arg == "--log" && hasValue) {
+            engineOptions.logPath = argv[++i];
+        } else {
+            if (arg != "--help" && arg != "-h") {
+                std::cerr << "Unknown option: " << arg << "\n";
+            }
+            return false;
+        }
+    }
+    return options.matches > 0 && options.matches <= 65536 && options.unitsPerTeam > 0 &&
+           options.server.tickRate > 0.0f;
+}
+
+/**
+ * Create the matches and spawn their units.
+ */
+bool createMatches(mcgng::MatchServer& server, const ServerOptions& options) {
+    std::vector<mcgng::SpawnPoint> spawns;
+    if (!options.missionPath.empty()) {
+        if (!options.mechsPath.empty() && !mcgng::MechDatabase::instance().loadFromFile(options.mechsPath)) {
+            std::cerr << "Error: Cannot load mechs from " << options.mechsPath << "\n";
+            return false;
+        }
+        mcgng::Mission mission;
+        if (!mission.load(options.missionPath)) {
+            std::cerr << "Error: Cannot load mission " << options.missionPath << "\n";
+            return false;
+        }
+        spawns = mission.getSpawnPoints();
+    }
+
+    for (int i = 0; i < options.matches; ++i) {
+        uint32_t seed = options.seed + static_cast<uint32_t>(i);
+        mcgng::Match* match = server.createMatch(seed);
+        if (!match) {
+            return false;
+        }
+
+        if (spawns.empty()) {
+            match->getWorld().addStandardTeams(options.unitsPerTeam);
+        } else if (match->getWorld().addSpawns(spawns) == 0) {
+            std::cerr << "Error: No units could be spawned from " << options.missionPath << "\n";
+            return false;
+        }
+
+        if (options.bots) {
+            match->addBot(0, seed * 2654435761u);
+            match->addBot(1, seed * 2654435761u + 1);
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    ServerOptions options;
+    mcgng::EngineOptions engineOptions;
+    engineOptions.windowTitle = "MCG-NG Dedicated Server";
+    engineOptions.headless = true;
+    engineOptions.gameSpeed = 1.0f;
+
+    if (!parseArgs(argc, argv, options, engineOptions)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // The frame limiter paces the ticks; unpaced runs spin. Passed as engine
+    // options so config reloads cannot change the server's pacing.
+    engineOptions.targetFPS = options.unpaced ? 0 : static_cast<int>(options.server.tickRate);
+
+    auto& engine = mcgng::Engine::instance();
+    if (!engine.initialize(engineOptions)) {
+        std::cerr << "Failed to initialize engine\n";
+        return 1;
+    }
+
+    mcgng::MatchServer server;
+    if (!server.initialize(options.server) || !createMatches(server, options)) {
+        engine.shutdown();
+        return 1;
+    }
+
+    std::cout << "Server: " << server.getMatchCount() << " matches on "
+              << (options.server.localOnly ? "127.0.0.1" : "0.0.0.0") << ":" << server.getPort()
+              << " at " << options.server.tickRate << " ticks/s\n";
+
+    std::signal(SIGINT, onInterrupt);
+    std::signal(SIGTERM, onInterrupt);
+
+    float sinceReport = 0.0f;
+    engine.setUpdateCallback([&](float deltaTime) {
+        if (options.unpaced) {
+            server.tick();
+        } else {
+            server.update(deltaTime);
+        }
+
+        sinceReport += deltaTime;
+        if (options.reportInterval > 0.0f && sinceReport >= options.reportInterval) {
+            sinceReport = 0.0f;
+            server.report();
+        }
+    });
+
+    engine.setEventCallback([&]() -> bool {
+        return !g_interrupted &&
+               (options.duration <= 0.0f || engine.getElapsedTime() < options.duration);
+    });
+
+    engine.run();
+
+    server.report();
+    server.shutdown();
+    engine.shutdown();
+    return 0;
+}
@@ -1,5 +1,5 @@
 #include "video/smk_player.h"
-#include <iostream>
+#include "core/log.h"
 #include <fstream>
 #include <cstring>
 
@@ -15,12 +15,12 @@ SmkPlayer::~SmkPlayer() {
 bool SmkPlayer::load(const std::string& path) {
     unload();
 
-    std::cout << "SmkPlayer: Loading video: " << path << "\n";
+    MCGNG_LOG_INFO(Video, "SmkPlayer: Loading video: {}", path);
 
     // Read file
     std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file) {
-        std::cerr << "SmkPlayer: Failed to open file: " << path << "\n";
+        MCGNG_LOG_ERROR(Video, "SmkPlayer: Failed to open file: {}", path);
         return false;
     }
 
@@ -29,7 +29,7 @@ bool SmkPlayer::load(const std::string& path) {
 
     std::vector<uint8_t> data(size);
     if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
-        std::cerr << "SmkPlayer: Failed to read file: " << path << "\n";
+        MCGNG_LOG_ERROR(Video, "SmkPlayer: Failed to read file: {}", path);
         return false;
     }
 
@@ -44,7 +44,7 @@ bool SmkPlayer::loadFromMemory(const uint8_t* data, size_t size) {
     // Check SMK signature
     const char* sig = reinterpret_cast<const char*>(data);
     if (std::strncmp(sig, "SMK2", 4) != 0 && std::strncmp(sig, "SMK4", 4) != 0) {
-        std::cerr << "SmkPlayer: Invalid SMK signature\n";
+        MCGNG_LOG_ERROR(Video, "SmkPlayer: Invalid SMK signature");
         return false;
     }
 
@@ -64,8 +64,8 @@ bool SmkPlayer::loadFromMemory(const uint8_t* data, size_t size) {
         m_frameTime = 1.0f / 15.0f;
     }
 
-    std::cout << "SmkPlayer: Video loaded - " << m_width << "x" << m_height
-              << " @ " << m_frameRate << " fps, " << m_frameCount << " frames\n";
+    MCGNG_LOG_INFO(Video, "SmkPlayer: Video loaded - {}x{} @ {} fps, {} frames",
+                   m_width, m_height, m_frameRate, m_frameCount);
 
     // Allocate frame buffer
     m_frameBuffer.resize(m_width * m_height * 4);  // RGBA
@@ -275,7 +275,7 @@ bool VideoManager::initialize() {
         return true;
     }
 
-    std::cout << "VideoManager: Initializing\n";
+    MCGNG_LOG_INFO(Video, "VideoManager: Initializing");
     m_initialized = true;
     return true;
 }
@@ -285,7 +285,7 @@ void VideoManager::shutdown() {
         return;
     }
 
-    std::cout << "VideoManager: Shutting down\n";
+    MCGNG_LOG_INFO(Video, "VideoManager: Shutting down");
     stopVideo();
     m_initialized = false;
 }
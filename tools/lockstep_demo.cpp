@@ -0,0 +1,293 @@
+/**
+ * Lockstep-Demo: Bot skirmish over the lockstep network layer
+ *
+ * Usage: lockstep-demo [options] --loopback
+ *        lockstep-demo [options] --player <n> --port <local> --peer <host:port>
+ *
+ * Two bot players fight a small synthetic skirmish. Each side only sends
+ * its orders; both simulate the whole match and compare state checksums.
+ * --loopback runs both players in this process over an in-memory link;
+ * otherwise start one process per player, e.g.
+ *
+ *     lockstep-demo --player 0 --port 7000 --peer 127.0.0.1:7001
+ *     lockstep-demo --player 1 --port 7001 --peer 127.0.0.1:7000
+ *
+ * and both should print the same final checksum.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "game/skirmish.h"
+#include "game/skirmish_bot.h"
+#include "net/lockstep.h"
+#include "net/transport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+
+using namespace mcgng;
+
+namespace {
+
+constexpr float TICK_RATE = 30.0f;
+constexpr uint32_t BOT_PERIOD = 15;         // Ticks between bot decisions
+constexpr int UNITS_PER_TEAM = 4;
+constexpr auto STALL_TIMEOUT = std::chrono::seconds(30);
+constexpr auto LINGER_TIME = std::chrono::seconds(1);
+
+struct Options {
+    bool loopback = false;
+    int player = -1;
+    uint16_t port = 0;
+    std::string peerHost;
+    uint16_t peerPort = 0;
+    uint32_t ticks = 1800;
+    uint32_t delay = 3;
+    bool autoDelay = false;
+    uint32_t seed = 1;
+    float loss = 0.0f;
+};
+
+/**
+ * One player's copy of the match.
+ */
+struct Player {
+    Player(uint8_t id, uint32_t seed)
+        : world(seed), bot(id, seed * 2654435761u + id), id(id) {}
+
+    Skirmish world;
+    LockstepSession session;
+    SkirmishBot bot;
+    uint8_t id;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Lockstep-Demo: Bot skirmish over the lockstep network layer\n\n";
+    std::cout << "Usage: " << programName << " [options] --loopback\n";
+    std::cout << "       " << programName << " [options] --player <n> --port <local> --peer <host:port>\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --loopback        Run both players in this process\n";
+    std::cout << "  --player <0|1>    Local player (two-process mode)\n";
+    std::cout << "  --port <n>        Local UDP port\n";
+    std::cout << "  --peer <h:p>      Remote player's address\n";
+    std::cout << "  --ticks <n>       Stop after this many ticks (default: 1800)\n";
+    std::cout << "  --delay <n|auto>  Input delay in ticks (default: 3)\n";
+    std::cout << "  --seed <n>        Match seed; must match on both sides (default: 1)\n";
+    std::cout << "  --loss <0-1>      Simulated packet loss (loopback only)\n";
+    std::cout << "  --help            Show this help message\n";
+}
+
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--loopback") {
+            options.loopback = true;
+        } else if (arg == "--player" && hasValue) {
+            options.player = std::atoi(argv[++i]);
+        } else if (arg == "--port" && hasValue) {
+            options.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--peer" && hasValue) {
+            std::string peer = argv[++i];
+            size_t colon = peer.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "Expected host:port, got " << peer << "\n";
+                return false;
+            }
+            options.peerHost = peer.substr(0, colon);
+            options.peerPort = static_cast<uint16_t>(std::atoi(peer.c_str() + colon + 1));
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--delay" && hasValue) {
+            std::string value = argv[++i];
+            options.autoDelay = value == "auto";
+            if (!options.autoDelay) {
+                options.delay = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+            }
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--loss" && hasValue) {
+            options.loss = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            if (arg != "--help" && arg != "-h") {
+                std::cerr << "Unknown option: " << arg << "\n";
+            }
+            return false;
+        }
+    }
+
+    if (options.loopback) {
+        return true;
+    }
+    return (options.player == 0 || options.player == 1) && options.port != 0 &&
+           !options.peerHost.empty() && options.peerPort != 0;
+}
+
+/**
+ * Queue the bot's orders for this player.
+ */
+void issueBotOrders(Player& player) {
+    std::vector<Command> orders;
+    player.bot.think(player.world, orders);
+    for (const Command& command : orders) {
+        player.session.issue(command);
+    }
+}
+
+bool isFinished(const Player& player, const Options& options) {
+    return player.world.getTick() >= options.ticks || player.world.getWinner() >= 0 ||
+           player.session.isDesynced();
+}
+
+/**
+ * Simulate the current tick if every player's orders are in.
+ */
+bool runTick(Player& player, const Options& options) {
+    if (isFinished(player, options) || !player.session.isTickReady()) {
+        return false;
+    }
+
+    for (const Command& command : player.session.getTickCommands()) {
+        player.world.apply(command);
+    }
+    player.world.step(1.0f / TICK_RATE);
+    player.session.advance(player.world.checksum());
+
+    uint32_t tick = player.world.getTick();
+    if (tick % BOT_PERIOD == 0) {
+        issueBotOrders(player);
+    }
+    if (options.autoDelay && tick % static_cast<uint32_t>(TICK_RATE) == 0) {
+        player.session.setInputDelay(player.session.suggestInputDelay(TICK_RATE));
+    }
+    return true;
+}
+
+void printResult(const Player& player) {
+    const LockstepStats& stats = player.session.getStats();
+    uint32_t ticks = player.world.getTick();
+    char checksum[16];
+    std::snprintf(checksum, sizeof(checksum), "%08x", player.world.checksum());
+
+    std::cout << "Player " << static_cast<int>(player.id) << ": tick " << ticks
+              << ", checksum " << checksum
+              << ", winner " << player.world.getWinner() << "\n";
+    std::cout << "  Sent " << stats.bytesSent << " bytes in " << stats.packetsSent << " packets ("
+              << (ticks > 0 ? stats.bytesSent / ticks : 0) << " bytes/tick) for "
+              << stats.commandsSent << " commands\n";
+    std::cout << "  Received " << stats.packetsReceived << " packets, rejected "
+              << stats.packetsRejected << ", round trip " << stats.roundTripMs
+              << " ms, input delay " << player.session.getInputDelay() << "\n";
+    if (player.session.isDesynced()) {
+        std::cout << "  DESYNC at tick " << player.session.getDesyncTick() << "\n";
+    }
+}
+
+bool startPlayer(Player& player, const Options& options) {
+    LockstepConfig config;
+    config.localPlayer = player.id;
+    config.playerCount = 2;
+    config.inputDelay = options.delay;
+    if (!player.session.initialize(config)) {
+        return false;
+    }
+    player.world.addStandardTeams(UNITS_PER_TEAM);
+    issueBotOrders(player);
+    return true;
+}
+
+int runLoopback(const Options& options) {
+    auto transports = LoopbackTransport::createPair();
+    transports.first->setLossRate(options.loss, options.seed);
+    transports.second->setLossRate(options.loss, options.seed + 1);
+
+    Player a(0, options.seed);
+    Player b(1, options.seed);
+    if (!startPlayer(a, options) || !startPlayer(b, options) ||
+        !a.session.addPeer(1, transports.first.get()) ||
+        !b.session.addPeer(0, transports.second.get())) {
+        return 1;
+    }
+
+    // Unpaced: both sides advance as fast as their orders arrive
+    while (!isFinished(a, options) || !isFinished(b, options)) {
+        a.session.update();
+        b.session.update();
+        bool progress = false;
+        while (runTick(a, options)) progress = true;
+        while (runTick(b, options)) progress = true;
+        if (!progress) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    printResult(a);
+    printResult(b);
+    bool match = a.world.checksum() == b.world.checksum();
+    std::cout << (match ? "Checksums match\n" : "Checksums DIFFER\n");
+    return match && !a.session.isDesynced() && !b.session.isDesynced() ? 0 : 2;
+}
+
+int runUdp(const Options& options) {
+    UdpTransport transport;
+    if (!transport.open(options.port, options.peerHost, options.peerPort)) {
+        return 1;
+    }
+
+    Player player(static_cast<uint8_t>(options.player), options.seed);
+    if (!startPlayer(player, options) ||
+        !player.session.addPeer(static_cast<uint8_t>(1 - options.player), &transport)) {
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto tickTime = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / TICK_RATE));
+    auto nextTick = Clock::now();
+    auto lastProgress = Clock::now();
+
+    std::cout << "Player " << options.player << " waiting for peer...\n";
+    while (!isFinished(player, options)) {
+        player.session.update();
+        auto now = Clock::now();
+        if (now >= nextTick && runTick(player, options)) {
+            // Don't try to catch up on time lost while stalled
+            nextTick = std::max(nextTick + tickTime, now - tickTime);
+            lastProgress = now;
+        } else if (now - lastProgress > STALL_TIMEOUT) {
+            std::cerr << "Error: Peer stopped responding at tick " << player.world.getTick() << "\n";
+            return 1;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // Keep resending our last ticks in case the peer missed them
+    auto lingerEnd = Clock::now() + LINGER_TIME;
+    while (Clock::now() < lingerEnd) {
+        player.session.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    printResult(player);
+    return player.session.isDesynced() ? 2 : 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    return options.loopback ? runLoopback(options) : runUdp(options);
+}
@@ -0,0 +1,223 @@
+/**
+ * Match-Observer: Watch (or play) a match on a dedicated server
+ *
+ * Usage: match-observer [options] --server <host:port> --match <n>
+ *
+ * Subscribes to one match of mcgng-server and prints what the snapshots
+ * show once a second. With --player and --charge it also sends orders for
+ * that team: every unit closes on the nearest enemy and fires.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "net/match_client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcgng;
+
+namespace {
+
+constexpr auto RESUBSCRIBE_INTERVAL = std::chrono::seconds(2);
+constexpr auto ORDER_INTERVAL = std::chrono::milliseconds(500);
+constexpr float ENGAGE_RANGE = 250.0f;
+constexpr int WEAPON_SLOTS = 4;             // Orders for missing weapons are rejected
+
+struct Options {
+    std::string host = "127.0.0.1";
+    uint16_t port = 7100;
+    uint16_t match = 0;
+    int player = -1;
+    bool charge = false;
+    float duration = 0.0f;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Match-Observer: Watch (or play) a match on a dedicated server\n\n";
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --server <h:p>    Server address (default: 127.0.0.1:7100)\n";
+    std::cout << "  --match <n>       Match to watch (default: 0)\n";
+    std::cout << "  --player <n>      Team to command\n";
+    std::cout << "  --charge          Send orders: attack the nearest enemy\n";
+    std::cout << "  --duration <s>    Stop after this long (default: until the match ends)\n";
+    std::cout << "  --help            Show this help message\n";
+}
+
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--server" && hasValue) {
+            std::string server = argv[++i];
+            size_t colon = server.rfind(':');
+            if (colon == std::string::npos) {
+                std::cerr << "Expected host:port, got " << server << "\n";
+                return false;
+            }
+            options.host = server.substr(0, colon);
+            options.port = static_cast<uint16_t>(std::atoi(server.c_str() + colon + 1));
+        } else if (arg == "--match" && hasValue) {
+            options.match = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--player" && hasValue) {
+            options.player = std::atoi(argv[++i]);
+        } else if (arg == "--charge") {
+            options.charge = true;
+        } else if (arg == "--duration" && hasValue) {
+            options.duration = static_cast<float>(std::atof(argv[++i]));
+        } else {
+            if (arg != "--help" && arg != "-h") {
+                std::cerr << "Unknown option: " << arg << "\n";
+            }
+            return false;
+        }
+    }
+    return !options.charge || options.player >= 0;
+}
+
+/**
+ * Orders for our units, computed from the observed state.
+ */
+std::vector<Command> chargeOrders(const MatchView& view, int player) {
+    std::vector<Command> orders;
+    for (const UnitSnapshot& unit : view.units) {
+        if (unit.getTeam() != player || unit.isDestroyed()) {
+            continue;
+        }
+
+        const UnitSnapshot* target = nullptr;
+        float bestDistance = 0.0f;
+        for (const UnitSnapshot& enemy : view.units) {
+            if (enemy.getTeam() == player || enemy.isDestroyed()) {
+                continue;
+            }
+            float distance = std::hypot(enemy.getX() - unit.getX(), enemy.getY() - unit.getY());
+            if (!target || distance < bestDistance) {
+                target = &enemy;
+                bestDistance = distance;
+            }
+        }
+        if (!target) {
+            break;
+        }
+
+        Command command;
+        command.player = static_cast<uint8_t>(player);
+        command.unit = unit.unit;
+        if (bestDistance > ENGAGE_RANGE) {
+            command.type = CommandType::Move;
+            command.x = target->getX();
+            command.y = target->getY();
+            orders.push_back(command);
+            continue;
+        }
+        command.type = CommandType::Attack;
+        command.target = target->unit;
+        for (int weapon = 0; weapon < WEAPON_SLOTS; ++weapon) {
+            command.weapon = static_cast<uint8_t>(weapon);
+            orders.push_back(command);
+        }
+    }
+    return orders;
+}
+
+void printStatus(const MatchView& view, uint64_t bytesPerSecond) {
+    int alive[2] = {0, 0};
+    int total[2] = {0, 0};
+    for (const UnitSnapshot& unit : view.units) {
+        int team = unit.getTeam() & 1;
+        ++total[team];
+        if (!unit.isDestroyed()) {
+            ++alive[team];
+        }
+    }
+    std::cout << "Match " << view.match << "  tick " << std::setw(6) << view.tick
+              << "  team 0: " << alive[0] << "/" << total[0]
+              << "  team 1: " << alive[1] << "/" << total[1]
+              << "  projectiles " << std::setw(3) << view.projectiles.size()
+              << "  " << bytesPerSecond << " bytes/s\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    MatchClient client;
+    if (!client.connect(options.host, options.port) || !client.subscribe(options.match)) {
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto lastSubscribe = start;
+    auto lastOrders = start;
+    auto lastStatus = start;
+    uint64_t lastBytes = 0;
+
+    while (options.duration <= 0.0f ||
+           std::chrono::duration<float>(Clock::now() - start).count() < options.duration) {
+        client.poll();
+        const MatchView& view = client.getView();
+        auto now = Clock::now();
+
+        if (now - lastSubscribe >= RESUBSCRIBE_INTERVAL) {
+            client.subscribe(options.match);
+            lastSubscribe = now;
+        }
+
+        if (options.charge && view.synced && now - lastOrders >= ORDER_INTERVAL) {
+            std::vector<Command> orders = chargeOrders(view, options.player);
+            for (size_t i = 0; i < orders.size(); i += 64) {
+                std::vector<Command> batch(orders.begin() + i,
+                                           orders.begin() + std::min(i + 64, orders.size()));
+                client.sendCommands(options.match, static_cast<uint8_t>(options.player), batch);
+            }
+            lastOrders = now;
+        }
+
+        if (now - lastStatus >= std::chrono::seconds(1)) {
+            if (view.synced) {
+                printStatus(view, client.getBytesReceived() - lastBytes);
+            } else {
+                std::cout << "Waiting for match " << options.match << "...\n";
+            }
+            lastBytes = client.getBytesReceived();
+            lastStatus = now;
+        }
+
+        // Stop once one side is wiped out
+        if (view.synced && !view.units.empty()) {
+            bool teamAlive[2] = {false, false};
+            for (const UnitSnapshot& unit : view.units) {
+                if (!unit.isDestroyed()) {
+                    teamAlive[unit.getTeam() & 1] = true;
+                }
+            }
+            if (!teamAlive[0] || !teamAlive[1]) {
+                printStatus(view, client.getBytesReceived() - lastBytes);
+                std::cout << "Match over: team " << (teamAlive[0] ? 0 : 1) << " wins\n";
+                break;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    client.unsubscribe(options.match);
+    client.close();
+    return 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * MCG-Bake: Runtime asset pack builder for MechCommander Gold: Next Generation
+ *
+ * Usage: mcg-bake <assets-folder> <output.pack>
+ *
+ * Does the load-time work once, ahead of time:
+ * - FST entries are decompressed
+ * - FIT files are parsed and stored in binary form
+ * - Palettes are expanded from 6 to 8 bits per channel
+ * - PAK shape tables are RLE-decoded into 8-bit indexed shapes
+ * - Mech sprite sets (nested PAKs) are decoded into frame caches
+ *
+ * The engine maps the result and uses it in place (see BakedPack).
+ * Paths match the game's VFS: FST entries by their archive path, shapes
+ * as <pak path>/<packet>/<shape>, e.g. data/sprites/cursors.pak/3/0, and
+ * mech sets as <pak path>/mech/<type>, e.g. data/sprites/torsos.pak/mech/0.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "assets/baked_pack.h"
+#include "assets/fit_parser.h"
+#include "assets/fst_reader.h"
+#include "assets/pak_reader.h"
+#include "assets/shape_reader.h"
+#include "assets/vfs.h"
+#include "graphics/mech_sprite_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace mcgng;
+
+namespace {
+
+struct BakeStats {
+    size_t files = 0;
+    size_t fitFiles = 0;
+    size_t palettes = 0;
+    size_t pakFiles = 0;
+    size_t shapes = 0;
+    size_t mechSets = 0;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "MCG-Bake: Runtime asset pack builder\n\n";
+    std::cout << "Usage: " << programName << " <assets-folder> <output.pack>\n\n";
+    std::cout << "Arguments:\n";
+    std::cout << "  assets-folder  Folder passed to mcgoldng --assets (FST archives + DATA/)\n";
+    std::cout << "  output.pack    Pack to write; the game loads <assets>/mcgng.pack\n";
+}
+
+std::string upperExtension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return ext;
+}
+
+bool isFitText(const std::vector<uint8_t>& data) {
+    size_t headerLength = std::strlen(FitParser::FIT_HEADER);
+    return data.size() >= headerLength &&
+           std::memcmp(data.data(), FitParser::FIT_HEADER, headerLength) == 0;
+}
+
+/**
+ * Expand a 256-colour palette to 8 bits per channel, the same way the
+ * game does at load time.
+ */
+std::vector<uint8_t> expandPalette(const std::vector<uint8_t>& data) {
+    constexpr size_t PALETTE_BYTES = 256 * 3;
+    std::vector<uint8_t> rgb(data.begin(), data.begin() + PALETTE_BYTES);
+
+    bool is6bit = std::all_of(data.begin(), data.begin() + std::min(data.size(), PALETTE_BYTES),
+                              [](uint8_t v) { return v <= 63; });
+    if (is6bit) {
+        for (auto& v : rgb) {
+            v = static_cast<uint8_t>((v << 2) | (v >> 4));
+        }
+    }
+    return rgb;
+}
+
+void bakeFst(const fs::path& fstPath, BakedPackWriter& writer, BakeStats& stats) {
+    FstReader reader;
+    if (!reader.open(fstPath.string())) {
+        std::cout << "  [ERROR] Failed to open " << fstPath.filename().string() << "\n";
+        return;
+    }
+
+    std::cout << "  " << fstPath.filename().string() << ": " << reader.getNumFiles() << " files\n";
+
+    for (const auto& entry : reader.getEntries()) {
+        std::vector<uint8_t> data = reader.readFile(entry);
+        if (data.empty()) {
+            continue;
+        }
+
+        std::string ext = upperExtension(entry.filePath);
+        if (isFitText(data)) {
+            FitParser parser;
+            if (parser.parseBuffer(data.data(), data.size())) {
+                writer.addFit(entry.filePath, parser);
+                ++stats.fitFiles;
+                continue;
+            }
+        } else if (ext == ".PAL" && data.size() >= 256 * 3) {
+            writer.addPalette(entry.filePath, expandPalette(data));
+            ++stats.palettes;
+            continue;
+        }
+
+        writer.addRaw(entry.filePath, std::move(data));
+        ++stats.files;
+    }
+}
+
+/**
+ * Decode every mech type of a nested sprite PAK into a frame cache.
+ */
+void bakeMechSets(const fs::path& pakPath, const std::string& virtualPath,
+                  BakedPackWriter& writer, BakeStats& stats) {
+    NestedPakReader reader;
+    if (!reader.open(pakPath.string())) {
+        return;
+    }
+
+    size_t setsBefore = stats.mechSets;
+    for (uint32_t m = 0; m < reader.getMechCount(); ++m) {
+        const MechSpriteSet* set = reader.getMech(m);
+        MechFrameCache cache;
+        if (set && cache.build(*set)) {
+            writer.addMechFrames(virtualPath + "/mech/" + std::to_string(m), cache.toBinary());
+            ++stats.mechSets;
+        }
+    }
+
+    if (stats.mechSets > setsBefore) {
+        std::cout << "  " << virtualPath << ": " << (stats.mechSets - setsBefore) << " mech sets\n";
+    }
+}
+
+void bakePak(const fs::path& pakPath, const std::string& virtualPath,
+             BakedPackWriter& writer, BakeStats& stats) {
+    PakReader reader;
+    if (!reader.open(pakPath.string())) {
+        return;
+    }
+
+    size_t shapesBefore = stats.shapes;
+    bool nested = false;
+    for (size_t i = 0; i < reader.getNumPackets(); ++i) {
+        const PakEntry* entry = reader.getEntry(i);
+        if (!entry || entry->storageType == PakStorageType::NUL) {
+            continue;
+        }
+
+        std::vector<uint8_t> packet = reader.readPacket(i);
+        if (packet.size() < 8) {
+            continue;
+        }
+
+        // Nested PAKs are mech sprite sets, baked whole below
+        uint32_t magic = 0;
+        std::memcpy(&magic, packet.data(), sizeof(magic));
+        if (magic == PakReader::PAK_MAGIC) {
+            nested = true;
+            continue;
+        }
+
+        ShapeReader shapes;
+        if (!shapes.load(packet.data(), packet.size())) {
+            continue;
+        }
+
+        for (uint32_t s = 0; s < shapes.getShapeCount(); ++s) {
+            ShapeData shape = shapes.decodeShape(s);
+            if (shape.pixels.empty() || shape.width <= 0 || shape.height <= 0 ||
+                shape.width > 0xFFFF || shape.height > 0xFFFF) {
+                continue;
+            }
+            writer.addShape(virtualPath + "/" + std::to_string(i) + "/" + std::to_string(s), shape);
+            ++stats.shapes;
+        }
+    }
+
+    if (stats.shapes > shapesBefore) {
+        std::cout << "  " << virtualPath << ": " << (stats.shapes - shapesBefore) << " shapes\n";
+        ++stats.pakFiles;
+    }
+
+    if (nested) {
+        bakeMechSets(pakPath, virtualPath, writer, stats);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "========================================\n";
+    std::cout << "MCG-Bake v0.1.0\n";
+    std::cout << "MechCommander Gold Asset Baker\n";
+    std::cout << "========================================\n\n";
+
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    fs::path assetsPath = argv[1];
+    fs::path outputPath = argv[2];
+
+    std::error_code ec;
+    if (!fs::is_directory(assetsPath, ec)) {
+        std::cerr << "Error: Assets folder does not exist: " << assetsPath << "\n";
+        return 1;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    BakedPackWriter writer;
+    BakeStats stats;
+
+    std::cout << "FST archives:\n";
+    for (const auto& entry : fs::directory_iterator(assetsPath, ec)) {
+        if (entry.is_regular_file(ec) && upperExtension(entry.path()) == ".FST") {
+            bakeFst(entry.path(), writer, stats);
+        }
+    }
+
+    std::cout << "\nPAK shape tables and mech sets:\n";
+    for (const auto& entry : fs::recursive_directory_iterator(assetsPath, ec)) {
+        if (entry.is_regular_file(ec) && upperExtension(entry.path()) == ".PAK") {
+            std::string virtualPath = Vfs::normalizePath(fs::relative(entry.path(), assetsPath, ec).generic_string());
+            bakePak(entry.path(), virtualPath, writer, stats);
+        }
+    }
+
+    if (writer.getEntryCount() == 0) {
+        std::cerr << "\nError: Nothing to bake in " << assetsPath << "\n";
+        return 1;
+    }
+
+    if (!writer.write(outputPath.string())) {
+        return 1;
+    }
+
+    // Re-open to validate what was written
+    BakedPack pack;
+    if (!pack.open(outputPath.string())) {
+        std::cerr << "Error: Written pack failed validation\n";
+        return 1;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "\n========================================\n";
+    std::cout << "Bake Complete!\n";
+    std::cout << "========================================\n";
+    std::cout << "  Files: " << stats.files << "\n";
+    std::cout << "  FIT files (binary): " << stats.fitFiles << "\n";
+    std::cout << "  Palettes: " << stats.palettes << "\n";
+    std::cout << "  Shapes: " << stats.shapes << " from " << stats.pakFiles << " PAKs\n";
+    std::cout << "  Mech sets: " << stats.mechSets << "\n";
+    std::cout << "  Pack size: " << fs::file_size(outputPath, ec) / 1024 << " KB ("
+              << pack.getEntryCount() << " entries)\n";
+    std::cout << "  Total time: " << duration.count() << " ms\n";
+    std::cout << "  Output: " << outputPath << "\n";
+
+    return 0;
+}
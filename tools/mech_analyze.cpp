@@ -1,209 +1,311 @@
-#include <iostream>
+/**
+ * Mech-Analyze: Batch mech sprite statistics for MechCommander Gold
+ *
+ * Usage: mech-analyze [options] <pak-file-or-directory>...
+ *
+ * Finds nested mech sprite sets in PAK files (e.g. DATA/SPRITES/TORSOS.PAK),
+ * decodes every frame in parallel and reports per-frame format, size,
+ * coverage and decode time as JSON/CSV. Decoded frames can be written as
+ * PGM images for inspection.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "assets/nested_pak_reader.h"
+#include "assets/pak_scan.h"
+#include "assets/shape_reader.h"
+#include "core/jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
-#include <cstring>
-#include <cstdint>
-
-// Minimal PAK reader for extracting mech data
-bool readPakPacket(const char* pakPath, int outerIdx, int innerIdx, std::vector<uint8_t>& data) {
-    std::ifstream f(pakPath, std::ios::binary);
-    if (!f) return false;
-
-    // Read outer PAK header
-    uint32_t magic;
-    f.read(reinterpret_cast<char*>(&magic), 4);
-    if (magic != 0xFEEDFACE) return false;
+#include <vector>
 
-    uint32_t firstOffset;
-    f.read(reinterpret_cast<char*>(&firstOffset), 4);
-    uint32_t outerCount = (firstOffset - 8) / 4;
+namespace fs = std::filesystem;
+using namespace mcgng;
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string jsonPath;
+    std::string csvPath;
+    std::string pgmDir;
+    size_t threads = 0;
+};
+
+/**
+ * One decoded frame of a mech sprite set.
+ */
+struct FrameStats {
+    std::string pak;
+    uint32_t mech = 0;          // Outer packet index
+    uint32_t frame = 0;
+    const char* format = "";    // "vfx" (standard shape table) or "mech"
+    int width = 0;
+    int height = 0;
+    size_t opaquePixels = 0;
+    double decodeMicros = 0.0;
+};
+
+/**
+ * Nested PAK packet to decode.
+ */
+struct MechTask {
+    std::string pak;
+    uint32_t index = 0;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Mech-Analyze: Batch mech sprite statistics\n\n";
+    std::cout << "Usage: " << programName << " [options] <pak-file-or-directory>...\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --json <path>   Write per-frame statistics as JSON\n";
+    std::cout << "  --csv <path>    Write per-frame statistics as CSV\n";
+    std::cout << "  --pgm <dir>     Write every decoded frame as a PGM image\n";
+    std::cout << "  -j <n>          Worker threads (default: all cores)\n";
+    std::cout << "  --help          Show this help message\n\n";
+    std::cout << "Example:\n";
+    std::cout << "  " << programName << " --csv mechs.csv D:/mcg/DATA/SPRITES\n";
+}
 
-    if (outerIdx >= (int)outerCount) return false;
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (arg == "--pgm" && hasValue) {
+            options.pgmDir = argv[++i];
+        } else if (arg == "-j" && hasValue) {
+            options.threads = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    return !options.inputs.empty();
+}
 
-    // Read outer seek table
-    std::vector<uint32_t> outerSeek(outerCount);
-    for (uint32_t i = 0; i < outerCount; ++i) {
-        f.seekg(8 + i * 4);
-        f.read(reinterpret_cast<char*>(&outerSeek[i]), 4);
+/**
+ * List the non-empty packets of every PAK; nested ones are found when read.
+ */
+std::vector<MechTask> collectTasks(const std::vector<std::string>& paks) {
+    std::vector<MechTask> tasks;
+    for (const auto& path : paks) {
+        PakReader reader;
+        if (!reader.open(path)) {
+            continue;
+        }
+        for (size_t i = 0; i < reader.getNumPackets(); ++i) {
+            const PakEntry* entry = reader.getEntry(i);
+            if (entry && entry->storageType != PakStorageType::NUL && entry->packedSize >= 8) {
+                tasks.push_back({path, static_cast<uint32_t>(i)});
+            }
+        }
     }
+    return tasks;
+}
 
-    // Get outer packet
-    uint32_t outerOff = outerSeek[outerIdx] & 0x1FFFFFFF;
-    uint32_t outerEnd = (outerIdx + 1 < outerCount) ? (outerSeek[outerIdx + 1] & 0x1FFFFFFF) : 0;
+void writePgm(const std::string& path, const ShapeData& shape) {
+    std::ofstream pgm(path, std::ios::binary);
+    pgm << "P5\n" << shape.width << " " << shape.height << "\n255\n";
+    pgm.write(reinterpret_cast<const char*>(shape.pixels.data()),
+              static_cast<std::streamsize>(shape.pixels.size()));
+}
 
-    f.seekg(outerOff);
+std::vector<FrameStats> analyzeMech(const MechTask& task, const std::string& pgmDir) {
+    std::vector<FrameStats> frames;
 
-    // Read inner PAK from outer packet
-    uint32_t innerMagic;
-    f.read(reinterpret_cast<char*>(&innerMagic), 4);
-    if (innerMagic != 0xFEEDFACE) {
-        std::cerr << "Inner PAK magic mismatch" << std::endl;
-        return false;
+    PakReader reader;
+    if (!reader.open(task.pak)) {
+        return frames;
     }
 
-    uint32_t innerFirstOff;
-    f.read(reinterpret_cast<char*>(&innerFirstOff), 4);
-    uint32_t innerCount = (innerFirstOff - 8) / 4;
-
-    if (innerIdx >= (int)innerCount) return false;
+    std::vector<uint8_t> data = reader.readPacket(task.index);
+    uint32_t magic = 0;
+    if (data.size() < 8 || (std::memcpy(&magic, data.data(), 4), magic != PakReader::PAK_MAGIC)) {
+        return frames;
+    }
 
-    // Read inner seek table
-    std::vector<uint32_t> innerSeek(innerCount);
-    for (uint32_t i = 0; i < innerCount; ++i) {
-        f.seekg(outerOff + 8 + i * 4);
-        f.read(reinterpret_cast<char*>(&innerSeek[i]), 4);
+    MechSpriteSet set;
+    if (!set.load(data.data(), data.size())) {
+        return frames;
     }
 
-    uint32_t pktOff = innerSeek[innerIdx] & 0x1FFFFFFF;
-    uint32_t pktEnd = (innerIdx + 1 < innerCount) ? (innerSeek[innerIdx + 1] & 0x1FFFFFFF) : (outerEnd - outerOff);
+    std::string stem = fs::path(task.pak).stem().string();
+    auto record = [&](uint32_t frameIndex, const char* format, auto&& decode) {
+        auto start = std::chrono::steady_clock::now();
+        ShapeData shape = decode();
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        FrameStats stats;
+        stats.pak = task.pak;
+        stats.mech = task.index;
+        stats.frame = frameIndex;
+        stats.format = format;
+        stats.width = shape.width;
+        stats.height = shape.height;
+        stats.opaquePixels = static_cast<size_t>(
+            std::count_if(shape.pixels.begin(), shape.pixels.end(), [](uint8_t p) { return p != 0; }));
+        stats.decodeMicros = micros;
+        frames.push_back(stats);
+
+        if (!pgmDir.empty() && !shape.pixels.empty()) {
+            writePgm((fs::path(pgmDir) / (stem + "_" + std::to_string(task.index) + "_" +
+                                          std::to_string(frameIndex) + ".pgm")).string(), shape);
+        }
+    };
 
-    if (pktEnd <= pktOff) return false;
+    for (uint32_t f = 0; f < set.getFrameCount(); ++f) {
+        const ShapeReader* frame = set.getFrame(f);
+        if (frame && frame->getShapeCount() > 0) {
+            record(f, "vfx", [frame]() { return frame->decodeShape(0); });
+        }
+    }
+    for (uint32_t f = 0; f < set.getMechFrameCount(); ++f) {
+        const MechShapeReader* frame = set.getMechFrame(f);
+        record(set.getFrameCount() + f, "mech", [frame]() { return frame->decode(); });
+    }
 
-    uint32_t pktSize = pktEnd - pktOff;
-    data.resize(pktSize);
-    f.seekg(outerOff + pktOff);
-    f.read(reinterpret_cast<char*>(data.data()), pktSize);
+    return frames;
+}
 
-    return true;
+void writeJson(const std::string& path, const std::vector<FrameStats>& frames) {
+    std::ofstream out(path);
+    out << "[\n";
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const FrameStats& f = frames[i];
+        out << "  {\"pak\": \"" << escapeJson(f.pak) << "\", \"mech\": " << f.mech
+            << ", \"frame\": " << f.frame << ", \"format\": \"" << f.format << "\""
+            << ", \"width\": " << f.width << ", \"height\": " << f.height
+            << ", \"opaquePixels\": " << f.opaquePixels << ", \"decodeUs\": " << f.decodeMicros << "}"
+            << (i + 1 < frames.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    std::cout << "Wrote " << path << "\n";
 }
 
-int main(int argc, char* argv[]) {
-    const char* pakPath = "D:/mcg/DATA/SPRITES/TORSOS.PAK";
-    std::vector<uint8_t> data;
+void writeCsv(const std::string& path, const std::vector<FrameStats>& frames) {
+    std::ofstream out(path);
+    out << "pak,mech,frame,format,width,height,opaque_pixels,decode_us\n";
+    for (const auto& f : frames) {
+        out << escapeCsv(f.pak) << ',' << f.mech << ',' << f.frame << ',' << f.format << ','
+            << f.width << ',' << f.height << ',' << f.opaquePixels << ',' << f.decodeMicros << '\n';
+    }
+    std::cout << "Wrote " << path << "\n";
+}
 
-    if (!readPakPacket(pakPath, 0, 0, data)) {
-        std::cerr << "Failed to read packet" << std::endl;
-        return 1;
+void printSummary(const std::vector<FrameStats>& frames) {
+    struct PakSummary {
+        std::vector<uint32_t> mechs;
+        size_t vfxFrames = 0;
+        size_t mechFrames = 0;
+        int maxWidth = 0;
+        int maxHeight = 0;
+        double decodeMs = 0.0;
+        double slowestUs = 0.0;
+    };
+
+    std::map<std::string, PakSummary> paks;
+    for (const auto& f : frames) {
+        PakSummary& s = paks[f.pak];
+        if (s.mechs.empty() || s.mechs.back() != f.mech) {
+            s.mechs.push_back(f.mech);
+        }
+        (std::strcmp(f.format, "vfx") == 0 ? s.vfxFrames : s.mechFrames)++;
+        s.maxWidth = std::max(s.maxWidth, f.width);
+        s.maxHeight = std::max(s.maxHeight, f.height);
+        s.decodeMs += f.decodeMicros / 1000.0;
+        s.slowestUs = std::max(s.slowestUs, f.decodeMicros);
     }
 
-    std::cout << "Mech sprite data: " << data.size() << " bytes" << std::endl;
+    std::cout << "\n" << std::left << std::setw(36) << "PAK" << std::right
+              << std::setw(7) << "Mechs" << std::setw(8) << "VFX" << std::setw(8) << "Mech"
+              << std::setw(10) << "Max size" << std::setw(11) << "Decode ms" << std::setw(13) << "Slowest us" << "\n";
+    std::cout << std::string(93, '-') << "\n";
+
+    for (const auto& pair : paks) {
+        const PakSummary& s = pair.second;
+        std::string name = pair.first.size() > 35 ? "..." + pair.first.substr(pair.first.size() - 32) : pair.first;
+        std::string size = std::to_string(s.maxWidth) + "x" + std::to_string(s.maxHeight);
+        std::cout << std::left << std::setw(36) << name << std::right
+                  << std::setw(7) << s.mechs.size() << std::setw(8) << s.vfxFrames << std::setw(8) << s.mechFrames
+                  << std::setw(10) << size << std::fixed << std::setprecision(2)
+                  << std::setw(11) << s.decodeMs << std::setw(13) << s.slowestUs << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+}
 
-    // Save raw data
-    std::ofstream raw("mech_sprite_raw.bin", std::ios::binary);
-    raw.write(reinterpret_cast<char*>(data.data()), data.size());
-    raw.close();
-    std::cout << "Saved: mech_sprite_raw.bin" << std::endl;
+} // anonymous namespace
 
-    // Parse header
-    if (data.size() < 11) {
-        std::cerr << "File too small" << std::endl;
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
         return 1;
     }
 
-    uint16_t type = (data[0] << 8) | data[1];
-    uint16_t anim = (data[2] << 8) | data[3];
-    uint16_t dim1 = (data[4] << 8) | data[5];
-    // Byte 6 is padding
-    std::string version(reinterpret_cast<char*>(&data[7]), 4);
-
-    std::cout << "Type: " << type << ", Anim: " << anim << ", Dim: " << dim1 << std::endl;
-    std::cout << "Version: " << version << std::endl;
-
-    // Find dimensions from header
-    int width = dim1;
-    int height = dim1;
-    if (width == 0 || width > 256) {
-        width = 26; height = 26;  // fallback
+    std::vector<std::string> paks;
+    for (const auto& input : options.inputs) {
+        auto found = findPakFiles(input);
+        paks.insert(paks.end(), found.begin(), found.end());
+    }
+    if (paks.empty()) {
+        std::cerr << "No PAK files found\n";
+        return 1;
     }
 
-    std::cout << "Dimensions: " << width << "x" << height << std::endl;
-
-    // Save raw pixels from different offsets as PGM images
-    std::vector<size_t> offsets = {11, 50, 100, 150, 200, 250};
-    for (size_t off : offsets) {
-        if (off + width * height > data.size()) continue;
-
-        std::string fname = "mech_at_" + std::to_string(off) + ".pgm";
-        std::ofstream pgm(fname, std::ios::binary);
-        pgm << "P5\n" << width << " " << height << "\n255\n";
-        pgm.write(reinterpret_cast<char*>(&data[off]), width * height);
-        pgm.close();
+    if (!options.pgmDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(options.pgmDir, ec);
+    }
 
-        // Analyze pattern
-        int topQ = 0, midH = 0, botQ = 0;
-        for (int row = 0; row < height; ++row) {
-            int nz = 0;
-            for (int col = 0; col < width; ++col) {
-                if (data[off + row * width + col] != 0) nz++;
-            }
-            if (row < height / 4) topQ += nz;
-            else if (row < 3 * height / 4) midH += nz;
-            else botQ += nz;
-        }
-        std::cout << "Offset " << off << ": top=" << topQ << " mid=" << midH << " bot=" << botQ;
-        if (midH > topQ && midH > botQ) std::cout << " [DIAMOND]";
-        std::cout << std::endl;
-    }
-
-    // Also try VFX RLE decode from different offsets
-    std::cout << "\nTrying VFX RLE decode..." << std::endl;
-    for (size_t rleStart = 11; rleStart < 300; rleStart += 10) {
-        std::vector<uint8_t> pixels(width * height, 0);
-        const uint8_t* rle = &data[rleStart];
-        size_t rleSize = data.size() - rleStart;
-        size_t srcPos = 0;
-        int x = 0, y = 0;
-        bool valid = true;
-
-        while (y < height && srcPos < rleSize && valid) {
-            uint8_t marker = rle[srcPos++];
-
-            if (marker == 0) {
-                x = 0; y++;
-            } else if (marker == 1) {
-                if (srcPos >= rleSize) { valid = false; break; }
-                int skip = rle[srcPos++];
-                if (skip > width * 2) { valid = false; break; }
-                x += skip;
-            } else if ((marker & 1) == 0) {
-                if (srcPos >= rleSize) { valid = false; break; }
-                uint8_t color = rle[srcPos++];
-                int count = marker >> 1;
-                if (count > width) { valid = false; break; }
-                for (int i = 0; i < count && x < width; ++i) {
-                    if (y < height) pixels[y * width + x++] = color;
-                }
-            } else {
-                int count = marker >> 1;
-                if (count > width) { valid = false; break; }
-                for (int i = 0; i < count && srcPos < rleSize && x < width; ++i) {
-                    if (y < height) pixels[y * width + x++] = rle[srcPos++];
-                }
-            }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<MechTask> tasks = collectTasks(paks);
+    std::vector<std::vector<FrameStats>> perTask(tasks.size());
+    startScanWorkers(options.threads);
+    JobSystem::instance().parallelFor(0, tasks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            perTask[i] = analyzeMech(tasks[i], options.pgmDir);
         }
+    });
 
-        if (!valid || y < height / 2) continue;
+    std::vector<FrameStats> frames;
+    for (auto& taskFrames : perTask) {
+        frames.insert(frames.end(), taskFrames.begin(), taskFrames.end());
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
 
-        int nonZero = 0;
-        for (uint8_t p : pixels) if (p != 0) nonZero++;
+    if (frames.empty()) {
+        std::cerr << "No mech sprite sets found in " << paks.size() << " PAKs\n";
+        return 1;
+    }
 
-        int topQ = 0, midH = 0, botQ = 0;
-        for (int row = 0; row < height; ++row) {
-            for (int col = 0; col < width; ++col) {
-                if (pixels[row * width + col] != 0) {
-                    if (row < height / 4) topQ++;
-                    else if (row < 3 * height / 4) midH++;
-                    else botQ++;
-                }
-            }
-        }
+    printSummary(frames);
+    std::cout << "\nDecoded " << frames.size() << " frames from " << paks.size() << " PAKs in "
+              << std::fixed << std::setprecision(1) << elapsed.count() << " ms\n";
 
-        bool diamond = (midH > topQ + 10) && (midH > botQ + 10);
-        if (nonZero > 100 && nonZero < width * height) {
-            std::cout << "RLE@" << rleStart << ": " << nonZero << " px, top=" << topQ
-                      << " mid=" << midH << " bot=" << botQ;
-            if (diamond) {
-                std::cout << " [DIAMOND] <-- LIKELY CORRECT";
-                std::string fname = "mech_rle_" + std::to_string(rleStart) + ".pgm";
-                std::ofstream pgm(fname, std::ios::binary);
-                pgm << "P5\n" << width << " " << height << "\n255\n";
-                pgm.write(reinterpret_cast<char*>(pixels.data()), pixels.size());
-                std::cout << " -> " << fname;
-            }
-            std::cout << std::endl;
-        }
+    if (!options.jsonPath.empty()) {
+        writeJson(options.jsonPath, frames);
+    }
+    if (!options.csvPath.empty()) {
+        writeCsv(options.csvPath, frames);
     }
-
     return 0;
 }
@@ -1,106 +1,205 @@
-#include <iostream>
+/**
+ * PAK-Inspect: Batch PAK statistics for MechCommander Gold
+ *
+ * Usage: pak-inspect [options] <pak-file-or-directory>...
+ *
+ * Scans PAK files in parallel and reports, for every packet, its storage
+ * type, compression ratio, read/decompress time, content (data, shape
+ * table, nested PAK) and decoded shape dimensions. The JSON/CSV output is
+ * what we use to pick assets for mcg-bake and the asset cache.
+ *
+ * Part of the MechCommander Gold: Next Generation project.
+ */
+
+#include "assets/pak_scan.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
 #include <vector>
-#include <cstdint>
-#include <cstring>
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: pak_inspect <pakfile> [packet_index]" << std::endl;
-        return 1;
+using namespace mcgng;
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string jsonPath;
+    std::string csvPath;
+    size_t threads = 0;
+    bool decodeShapes = true;
+    size_t top = 10;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "PAK-Inspect: Batch PAK statistics\n\n";
+    std::cout << "Usage: " << programName << " [options] <pak-file-or-directory>...\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --json <path>   Write per-packet statistics as JSON\n";
+    std::cout << "  --csv <path>    Write per-packet statistics as CSV\n";
+    std::cout << "  -j <n>          Worker threads (default: all cores)\n";
+    std::cout << "  --no-decode     Skip shape decoding (storage statistics only)\n";
+    std::cout << "  --top <n>       Show the n most expensive packets (default 10)\n";
+    std::cout << "  --help          Show this help message\n";
+}
+
+bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (arg == "--csv" && hasValue) {
+            options.csvPath = argv[++i];
+        } else if (arg == "-j" && hasValue) {
+            options.threads = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--top" && hasValue) {
+            options.top = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--no-decode") {
+            options.decodeShapes = false;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
     }
+    return !options.inputs.empty();
+}
 
-    std::ifstream file(argv[1], std::ios::binary);
+bool writeOutput(const std::string& path, const std::vector<PacketStats>& stats, bool json) {
+    std::ofstream file(path);
     if (!file) {
-        std::cerr << "Failed to open: " << argv[1] << std::endl;
-        return 1;
+        std::cerr << "Failed to create " << path << "\n";
+        return false;
     }
+    if (json) {
+        writePacketStatsJson(file, stats);
+    } else {
+        writePacketStatsCsv(file, stats);
+    }
+    std::cout << "Wrote " << path << "\n";
+    return true;
+}
 
-    // Read header
-    uint32_t magic;
-    file.read(reinterpret_cast<char*>(&magic), 4);
-    
-    if (magic != 0xFEEDFACE) {
-        std::cerr << "Not a PAK file (magic=" << std::hex << magic << ")" << std::endl;
-        return 1;
+void printSummary(const std::vector<PacketStats>& stats, size_t top) {
+    struct PakSummary {
+        size_t packets = 0;
+        size_t shapes = 0;
+        uint64_t packed = 0;
+        uint64_t unpacked = 0;
+        double readMs = 0.0;
+        double decodeMs = 0.0;
+        std::array<size_t, 8> storage{};
+    };
+
+    std::map<std::string, PakSummary> paks;
+    for (const auto& s : stats) {
+        PakSummary& summary = paks[s.pak];
+        ++summary.packets;
+        summary.shapes += s.shapeCount;
+        summary.packed += s.packedSize;
+        summary.unpacked += s.unpackedSize;
+        summary.readMs += s.readMicros / 1000.0;
+        summary.decodeMs += s.decodeMicros / 1000.0;
+        ++summary.storage[static_cast<size_t>(s.storage) & 7];
     }
 
-    uint32_t firstOffset;
-    file.read(reinterpret_cast<char*>(&firstOffset), 4);
-    
-    uint32_t numPackets = (firstOffset & 0x1FFFFFFF) / 4 - 2;
-    std::cout << "PAK File: " << argv[1] << std::endl;
-    std::cout << "Packets: " << numPackets << std::endl;
-    std::cout << std::endl;
-
-    // Read seek table
-    std::vector<uint32_t> seekTable(numPackets);
-    for (uint32_t i = 0; i < numPackets; ++i) {
-        file.read(reinterpret_cast<char*>(&seekTable[i]), 4);
+    std::cout << "\n" << std::left << std::setw(36) << "PAK" << std::right
+              << std::setw(8) << "Packets" << std::setw(6) << "NUL" << std::setw(6) << "RAW"
+              << std::setw(6) << "LZD" << std::setw(6) << "ZLIB" << std::setw(8) << "Shapes"
+              << std::setw(12) << "Unpacked KB" << std::setw(7) << "Ratio"
+              << std::setw(10) << "Read ms" << std::setw(11) << "Decode ms" << "\n";
+    std::cout << std::string(116, '-') << "\n";
+
+    for (const auto& pair : paks) {
+        const PakSummary& s = pair.second;
+        std::string name = pair.first.size() > 35 ? "..." + pair.first.substr(pair.first.size() - 32) : pair.first;
+        double ratio = s.unpacked > 0 ? static_cast<double>(s.packed) / s.unpacked : 1.0;
+        std::cout << std::left << std::setw(36) << name << std::right
+                  << std::setw(8) << s.packets
+                  << std::setw(6) << s.storage[static_cast<size_t>(PakStorageType::NUL)]
+                  << std::setw(6) << s.storage[static_cast<size_t>(PakStorageType::RAW)]
+                  << std::setw(6) << s.storage[static_cast<size_t>(PakStorageType::LZD)]
+                  << std::setw(6) << s.storage[static_cast<size_t>(PakStorageType::ZLIB)]
+                  << std::setw(8) << s.shapes << std::setw(12) << s.unpacked / 1024
+                  << std::fixed << std::setprecision(2) << std::setw(7) << ratio
+                  << std::setw(10) << s.readMs << std::setw(11) << s.decodeMs << "\n";
+        std::cout.unsetf(std::ios::fixed);
     }
 
-    // Get file size
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-
-    // If specific packet requested
-    int targetPacket = (argc > 2) ? std::atoi(argv[2]) : -1;
-
-    // Find non-null packets
-    int shown = 0;
-    for (uint32_t i = 0; i < numPackets && shown < 10; ++i) {
-        if ((seekTable[i] >> 29) == 7) continue;  // Skip null packets
-        uint32_t offset = seekTable[i] & 0x1FFFFFFF;
-        uint32_t type = seekTable[i] >> 29;
-        
-        // Calculate size
-        uint32_t nextOffset = (i + 1 < numPackets) ? (seekTable[i + 1] & 0x1FFFFFFF) : fileSize;
-        uint32_t size = nextOffset - offset;
-
-        std::cout << "Packet " << i << ": offset=" << offset << " size=" << size << " type=" << type;
-        
-        // Read first 32 bytes
-        file.seekg(offset);
-        uint8_t header[32];
-        file.read(reinterpret_cast<char*>(header), std::min(size, 32u));
-        
-        std::cout << " [";
-        for (int j = 0; j < 16 && j < (int)size; ++j) {
-            printf("%02X ", header[j]);
-        }
-        std::cout << "]" << std::endl;
-
-        // Check for nested PAK
-        uint32_t nestedMagic;
-        std::memcpy(&nestedMagic, header, 4);
-        if (nestedMagic == 0xFEEDFACE) {
-            uint32_t nestedFirstOffset;
-            std::memcpy(&nestedFirstOffset, header + 4, 4);
-            uint32_t nestedPackets = (nestedFirstOffset & 0x1FFFFFFF) / 4 - 2;
-            std::cout << "  -> Nested PAK with " << nestedPackets << " sub-packets" << std::endl;
-            
-            // Read nested seek table
-            file.seekg(offset + 8);
-            for (uint32_t j = 0; j < std::min(nestedPackets, 3u); ++j) {
-                uint32_t entry;
-                file.read(reinterpret_cast<char*>(&entry), 4);
-                uint32_t subOffset = entry & 0x1FFFFFFF;
-                uint32_t subType = entry >> 29;
-                
-                // Read sub-packet header
-                file.seekg(offset + subOffset);
-                uint8_t subHeader[32];
-                file.read(reinterpret_cast<char*>(subHeader), 32);
-                
-                std::cout << "    Sub-" << j << ": offset=" << subOffset << " type=" << subType << " [";
-                for (int k = 0; k < 16; ++k) {
-                    printf("%02X ", subHeader[k]);
-                }
-                std::cout << "]" << std::endl;
-            }
+    if (top == 0) {
+        return;
+    }
+
+    // Packets that cost the most to load are the best prebake candidates
+    std::vector<const PacketStats*> expensive;
+    for (const auto& s : stats) {
+        expensive.push_back(&s);
+    }
+    size_t count = std::min(top, expensive.size());
+    std::partial_sort(expensive.begin(), expensive.begin() + count, expensive.end(),
+                      [](const PacketStats* a, const PacketStats* b) {
+                          return a->readMicros + a->decodeMicros > b->readMicros + b->decodeMicros;
+                      });
+
+    std::cout << "\nMost expensive packets:\n";
+    for (size_t i = 0; i < count; ++i) {
+        const PacketStats& s = *expensive[i];
+        std::cout << "  " << s.pak << " #" << s.index << " " << getStorageTypeName(s.storage)
+                  << " " << getPacketContentName(s.content) << " " << s.unpackedSize << " bytes";
+        if (s.width > 0) {
+            std::cout << " " << s.width << "x" << s.height;
         }
-        ++shown;
+        std::cout << std::fixed << std::setprecision(1)
+                  << " read " << s.readMicros << " us, decode " << s.decodeMicros << " us\n";
+        std::cout.unsetf(std::ios::fixed);
     }
+}
+
+} // anonymous namespace
 
-    return 0;
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> paks;
+    for (const auto& input : options.inputs) {
+        auto found = findPakFiles(input);
+        paks.insert(paks.end(), found.begin(), found.end());
+    }
+    if (paks.empty()) {
+        std::cerr << "No PAK files found\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    startScanWorkers(options.threads);
+    std::vector<PacketStats> stats = scanPaks(paks, options.decodeShapes);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    printSummary(stats, options.top);
+    std::cout << "\nScanned " << paks.size() << " PAKs, " << stats.size() << " packets in "
+              << std::fixed << std::setprecision(1) << elapsed.count() << " ms\n";
+
+    bool ok = true;
+    if (!options.jsonPath.empty()) {
+        ok &= writeOutput(options.jsonPath, stats, true);
+    }
+    if (!options.csvPath.empty()) {
+        ok &= writeOutput(options.csvPath, stats, false);
+    }
+    return ok ? 0 : 1;
 }